@@ -0,0 +1,51 @@
+// src/app/AppOptions.h
+#pragma once
+
+#include <string>
+
+#include "FrameScheduler.h"
+
+/**
+ * AppOptions
+ * Startup options parsed from the command line by the wxApp and handed down
+ * to MainFrame / GLCanvas.
+ *
+ * - render_thread:    run the Renderer on its own thread (RenderThread), which
+ *                     owns the GL context; the UI thread only publishes state.
+ * - frame_mode:       FrameScheduler mode (--frame-mode=continuous|on-demand|animation).
+ * - target_fps:       tick rate for continuous/animation frames (--fps).
+ * - swap_interval:    -1 = driver default, 0 = vsync off, 1 = on (--vsync).
+ * - spin_deg_per_sec: auto-rotation speed; non-zero animates (--spin).
+ * - profile_path:     enables frame-timing scopes and writes them here at
+ *                     exit, CSV or JSON by extension (--profile). Empty = off.
+ * - trace_path:       records the GL calls of the first trace_frames frames
+ *                     for wxgl_replay (--trace, --trace-frames). Empty = off.
+ * - record_input_path: records slider/checkbox/overlay-click input to this
+ *                      InputLog file at exit (--record-input). Empty = off.
+ * - replay_input_path: replays an InputLog with its original timing, then
+ *                      closes the window (--replay-input). Empty = off.
+ * - latency_report_path: per-input input -> present latency percentiles as
+ *                      JSON at exit (--latency-report). Empty = off.
+ * - texture_cache_dir: where overlay icons are cooked for fast later starts
+ *                      (--texture-cache=DIR|off; default: a "texture-cache"
+ *                      folder in the user's local data directory). Empty = off.
+ * - program_cache_dir: where linked shader program binaries are kept
+ *                      (--program-cache=DIR|off; default: a "program-cache"
+ *                      folder next to the texture cache). Empty = off.
+ */
+struct AppOptions
+{
+    bool   render_thread {false};
+    FrameScheduler::Mode frame_mode {FrameScheduler::Mode::OnDemand};
+    double target_fps {60.0};
+    int    swap_interval {-1};
+    double spin_deg_per_sec {0.0};
+    std::string profile_path;
+    std::string trace_path;
+    int    trace_frames {300};
+    std::string record_input_path;
+    std::string replay_input_path;
+    std::string latency_report_path;
+    std::string texture_cache_dir;
+    std::string program_cache_dir;
+};
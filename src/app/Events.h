@@ -20,4 +20,7 @@
 
 // Declare a new event type identifier.
 // Definition must appear once in a .cpp file (we use MainFrame.cpp).
-wxDECLARE_EVENT(wxEVT_WXGL_TOGGLE_SIDEBAR, wxCommandEvent);
\ No newline at end of file
+wxDECLARE_EVENT(wxEVT_WXGL_TOGGLE_SIDEBAR, wxCommandEvent);
+
+// Posted by InputReplayer to its owner after the last event has settled.
+wxDECLARE_EVENT(wxEVT_WXGL_INPUT_REPLAY_DONE, wxCommandEvent);
\ No newline at end of file
@@ -0,0 +1,138 @@
+// src/app/FrameScheduler.cpp
+#include "FrameScheduler.h"
+
+#include <algorithm>
+
+namespace {
+const std::int64_t kNsPerMs = 1000000;
+
+// Frames cheaper than this fraction of the budget count towards recovery.
+const double kRecoverFraction = 0.5;
+const int    kRecoverFrames   = 30;
+
+// Smoothing factor of the frame cost average.
+const double kCostAlpha = 0.1;
+} // namespace
+
+void FrameScheduler::SetMode(Mode mode)
+{
+    if (mode == m_mode)
+        return;
+    m_mode = mode;
+    m_nextDeadline = 0;
+    m_stats.divisor = 1;
+    m_fitStreak = 0;
+}
+
+void FrameScheduler::SetTargetFps(double fps)
+{
+    m_targetFps = std::max(1.0, std::min(fps, 1000.0));
+    m_nextDeadline = 0;
+}
+
+void FrameScheduler::ResetStats()
+{
+    const int divisor = m_stats.divisor;
+    m_stats = Stats{};
+    m_stats.divisor = divisor;
+}
+
+bool FrameScheduler::active() const
+{
+    switch (m_mode) {
+    case Mode::Continuous:    return true;
+    case Mode::AnimationOnly: return m_animating || m_requested;
+    case Mode::OnDemand:      return m_requested;
+    }
+    return false;
+}
+
+std::int64_t FrameScheduler::interval() const
+{
+    return static_cast<std::int64_t>(1e9 / m_targetFps) * m_stats.divisor;
+}
+
+int FrameScheduler::NextTickDelayMs(std::int64_t nowNs)
+{
+    if (!active()) {
+        m_nextDeadline = 0;
+        return -1;
+    }
+
+    if (m_nextDeadline == 0) {
+        // Resume on the old phase when possible, never earlier than now.
+        m_nextDeadline = (m_lastDeadline != 0) ? std::max(nowNs, m_lastDeadline + interval())
+                                               : nowNs;
+    }
+
+    const std::int64_t wait = m_nextDeadline - nowNs;
+    if (wait <= 0)
+        return 0;
+    // Round up: waking early only costs another short timer.
+    return static_cast<int>((wait + kNsPerMs - 1) / kNsPerMs);
+}
+
+bool FrameScheduler::OnTick(std::int64_t nowNs)
+{
+    if (!active())
+        return false;
+    if (m_nextDeadline == 0)
+        NextTickDelayMs(nowNs);
+    if (nowNs < m_nextDeadline)
+        return false;
+
+    const std::int64_t step = interval();
+    m_frameDeadline = m_nextDeadline;
+    m_lastDeadline  = m_nextDeadline;
+    m_nextDeadline += step;
+
+    // Fell behind: skip whole intervals rather than bursting to catch up.
+    if (m_nextDeadline <= nowNs) {
+        const std::int64_t behind = (nowNs - m_nextDeadline) / step + 1;
+        m_nextDeadline += behind * step;
+        m_stats.missed += static_cast<std::uint64_t>(behind);
+    }
+
+    m_requested = false;
+    return true;
+}
+
+void FrameScheduler::FrameDone(std::int64_t startNs, std::int64_t endNs)
+{
+    const std::int64_t budget = static_cast<std::int64_t>(1e9 / m_targetFps);
+    const std::int64_t cost   = endNs - startNs;
+    const double costMs = static_cast<double>(cost) / kNsPerMs;
+
+    ++m_stats.frames;
+    m_stats.worst_frame_ms = std::max(m_stats.worst_frame_ms, costMs);
+    m_stats.avg_frame_ms   = (m_stats.frames == 1)
+                           ? costMs
+                           : m_stats.avg_frame_ms + kCostAlpha * (costMs - m_stats.avg_frame_ms);
+
+    // Presented after the following deadline: the display showed the
+    // previous frame once more.
+    if (m_frameDeadline != 0 && endNs > m_frameDeadline + interval())
+        ++m_stats.missed;
+
+    if (cost > budget)
+        ++m_stats.overruns;
+
+    // Adapt the effective rate only where frames are produced on a clock.
+    if (m_mode == Mode::OnDemand)
+        return;
+
+    const std::int64_t effective = budget * m_stats.divisor;
+    if (cost > effective && m_stats.divisor < kMaxDivisor) {
+        const std::int64_t needed = (cost + budget - 1) / budget;
+        m_stats.divisor = static_cast<int>(std::min<std::int64_t>(needed, kMaxDivisor));
+        m_fitStreak = 0;
+    } else if (m_stats.divisor > 1 &&
+               static_cast<double>(cost) < kRecoverFraction * static_cast<double>(budget * (m_stats.divisor - 1))) {
+        if (++m_fitStreak >= kRecoverFrames) {
+            --m_stats.divisor;
+            m_fitStreak = 0;
+        }
+    } else {
+        m_fitStreak = 0;
+    }
+}
@@ -0,0 +1,85 @@
+// src/app/FrameScheduler.h
+#pragma once
+
+#include <cstdint>
+
+/**
+ * FrameScheduler
+ * Decides when GLCanvas produces frames; GLCanvas turns the answers into
+ * one-shot wxTimer ticks. No wx types, times in steady-clock nanoseconds
+ * (LatencyStats::NowNs).
+ *
+ * Modes:
+ * - Continuous    : a frame every tick at the target FPS, even if nothing
+ *                   changed (benchmarks, external animation).
+ * - OnDemand      : ticks only after RequestFrame(); idle otherwise.
+ * - AnimationOnly : ticks while SetAnimating(true), plus requested frames.
+ *
+ * Pacing:
+ * - Deadlines advance by whole intervals from the previous deadline, not
+ *   from "now", so timer jitter does not accumulate into drift. If the
+ *   loop falls behind, overdue deadlines are skipped (counted as missed)
+ *   instead of being caught up in a burst.
+ * - Frame budget = one interval. When frames keep overrunning it, the
+ *   effective rate drops to target/2, /3, /4 and recovers once frames fit
+ *   again, so presents stay evenly spaced instead of stuttering.
+ */
+class FrameScheduler
+{
+public:
+    enum class Mode { Continuous, OnDemand, AnimationOnly };
+
+    struct Stats {
+        std::uint64_t frames   {0};    // FrameDone() calls
+        std::uint64_t missed   {0};    // deadlines skipped or presented late
+        std::uint64_t overruns {0};    // frames costing more than the budget
+        double avg_frame_ms   {0.0};   // smoothed frame cost
+        double worst_frame_ms {0.0};
+        int    divisor        {1};     // effective FPS = target / divisor
+    };
+
+    static const int kMaxDivisor = 4;
+
+    void SetMode(Mode mode);
+    Mode GetMode() const { return m_mode; }
+
+    void   SetTargetFps(double fps);
+    double TargetFps() const { return m_targetFps; }
+
+    void SetAnimating(bool animating) { m_animating = animating; }
+    void RequestFrame()               { m_requested = true; }
+
+    // True when frames must be produced even without state changes.
+    bool RendersEveryTick() const { return m_mode == Mode::Continuous; }
+
+    // Milliseconds until the next tick (0 = due now), -1 when idle.
+    int NextTickDelayMs(std::int64_t nowNs);
+
+    // Timer fired: true if a frame is due; false for an early wake-up.
+    bool OnTick(std::int64_t nowNs);
+
+    // The frame started by the last successful OnTick() was presented.
+    // In render-thread mode GLCanvas reports it once the thread's timing
+    // arrives, at the latest before the next tick.
+    void FrameDone(std::int64_t startNs, std::int64_t endNs);
+
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats();
+
+private:
+    bool active() const;
+    std::int64_t interval() const;   // effective, includes divisor
+
+private:
+    Mode   m_mode {Mode::OnDemand};
+    double m_targetFps {60.0};
+    bool   m_animating {false};
+    bool   m_requested {false};
+
+    std::int64_t m_nextDeadline  {0};   // 0 = not scheduled
+    std::int64_t m_frameDeadline {0};   // deadline of the frame in flight
+    std::int64_t m_lastDeadline  {0};
+    int          m_fitStreak     {0};   // consecutive frames well within budget
+
+    Stats m_stats;
+};
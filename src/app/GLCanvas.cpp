@@ -1,10 +1,19 @@
 // src/app/GLCanvas.cpp
 #include "GLCanvas.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <wx/dcclient.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
 #include <wx/log.h>
+#include <wx/toplevel.h>
 
 #include "Events.h"               // custom wx event declaration
+#include "GLPlatform.h"           // buffer age, context release
+#include "InputLog.h"             // click recording
+#include "render/Profiler.h"      // frame timing scopes
 #include "render/Renderer.h"      // rendering backend API
 
 // Attribute list for the GL canvas (legacy style works across wx versions)
@@ -18,11 +27,15 @@ namespace {
         WX_GL_STENCIL_SIZE, 8,
         0
     };
+
+    // Longest animation step; longer gaps (suspend, breakpoints) are clamped.
+    const double kMaxAnimStepSec = 0.1;
 }
 
-GLCanvas::GLCanvas(wxWindow* parent, wxWindowID id)
+GLCanvas::GLCanvas(wxWindow* parent, wxWindowID id, const AppOptions& options)
     : wxGLCanvas(parent, id, kGLAttribs, wxDefaultPosition, wxDefaultSize,
                  wxFULL_REPAINT_ON_RESIZE | wxBORDER_NONE, "GLCanvas"),
+      m_options(options),
       m_timer(this)
 {
     // Reduce background erase to avoid flicker; we'll paint everything in GL.
@@ -31,11 +44,24 @@ GLCanvas::GLCanvas(wxWindow* parent, wxWindowID id)
     // Create GL context asap so that size events can safely talk to GL when needed.
     CreateContextIfNeeded();
 
+    m_scheduler.SetMode(m_options.frame_mode);
+    m_scheduler.SetTargetFps(m_options.target_fps);
+    SetSpin(m_options.spin_deg_per_sec);
+    m_probe.SetEnabled(!m_options.latency_report_path.empty() || !m_options.replay_input_path.empty());
+
     // Bind events (modern style)
     Bind(wxEVT_PAINT,        &GLCanvas::OnPaint,       this);
     Bind(wxEVT_SIZE,         &GLCanvas::OnSize,        this);
     Bind(wxEVT_LEFT_DOWN,    &GLCanvas::OnLeftDown,    this);
+    Bind(wxEVT_KEY_DOWN,     &GLCanvas::OnKeyDown,     this);
     Bind(wxEVT_ERASE_BACKGROUND, &GLCanvas::OnEraseBackground, this);
+    Bind(wxEVT_SHOW,         &GLCanvas::OnShow,        this);
+    Bind(wxEVT_TIMER,        &GLCanvas::OnTimer,       this);
+
+    // Minimize/restore is reported to the frame, not to its children.
+    m_topLevel = wxGetTopLevelParent(this);
+    if (m_topLevel)
+        m_topLevel->Bind(wxEVT_ICONIZE, &GLCanvas::OnIconize, this);
 }
 
 GLCanvas::~GLCanvas()
@@ -44,7 +70,12 @@ GLCanvas::~GLCanvas()
     if (m_timer.IsRunning())
         m_timer.Stop();
 
+    if (m_topLevel)
+        m_topLevel->Unbind(wxEVT_ICONIZE, &GLCanvas::OnIconize, this);
+
     // Destroy renderer before context goes away, to ensure GL resources are released.
+    // The render thread does so itself and releases the context before joining.
+    m_renderThread.reset();
     m_renderer.reset();
     m_context.reset();
 }
@@ -97,53 +128,412 @@ void GLCanvas::InitializeRendererIfNeeded()
     // Ensure a current GL context before touching GL in the renderer.
     EnsureCurrent();
 
+    m_renderer->SetProgramCacheDir(CacheDir(m_options.program_cache_dir, "shader programs are compiled"));
     if (!m_renderer->Initialize()) {
         wxLogError("Renderer initialization failed.");
         return;
     }
+    ApplySwapInterval();
+    EnableGpuTiming(*m_renderer);
+
+    // Icons decode off the UI thread; each finished one asks for a frame,
+    // which packs and uploads it (the button is a placeholder until then).
+    std::vector<std::string> icons;
+    std::string toggle;
+    CollectOverlayIcons(icons, toggle);
+    m_renderer->SetTextureCacheDir(CacheDir(m_options.texture_cache_dir, "icons are decoded"));
+    m_renderer->SetTextureReadyCallback([this] { CallAfter(&GLCanvas::RequestRedraw); });
+    m_renderer->LoadOverlayIconSetAsync(icons, &GLCanvas::OnIconLoaded);
+    m_renderer->LoadOverlayIconAsync(toggle, &GLCanvas::OnIconLoaded);
 
+    m_initialized = true;
+}
+
+void GLCanvas::CollectOverlayIcons(std::vector<std::string>& icons, std::string& toggle) const
+{
     // Load the overlay button icon from resources.
     // The top-level CMake defines APP_RESOURCE_DIR pointing to <repo>/resources.
 #ifdef APP_RESOURCE_DIR
-    const std::string iconPath = std::string(APP_RESOURCE_DIR) + "/icons/toggle.png";
+    const std::string iconDir = std::string(APP_RESOURCE_DIR) + "/icons";
 #else
     // Fallback to a relative path when APP_RESOURCE_DIR is not defined.
-    const std::string iconPath = "resources/icons/toggle.png";
+    const std::string iconDir = "resources/icons";
 #endif
-    (void)m_renderer->LoadOverlayIcon(iconPath);
 
+    // Pack every icon shipped in resources/icons into the overlay atlas at once;
+    // the toggle button then resolves to its already packed region.
+    wxArrayString found;
+    if (wxDir::Exists(iconDir))
+        wxDir::GetAllFiles(iconDir, &found, "*.png", wxDIR_FILES);
+    for (const wxString& f : found)
+        icons.push_back(f.ToStdString());
+
+    toggle = iconDir + "/toggle.png";
+}
+
+std::string GLCanvas::CacheDir(const std::string& path, const char* fallback)
+{
+    const wxString dir(path);
+    if (dir.empty())
+        return std::string();
+    if (!wxFileName::DirExists(dir) && !wxFileName::Mkdir(dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+        wxLogWarning("Cannot create cache directory %s; %s on every start.", dir, fallback);
+        return std::string();
+    }
+    return path;
+}
+
+void GLCanvas::OnIconLoaded(const std::string& path, bool ok)
+{
+    // GL thread; wx logging is thread-safe.
+    if (!ok)
+        wxLogWarning("Cannot load overlay icon %s", path);
+}
+
+void GLCanvas::StartRenderThreadIfNeeded()
+{
+    if (m_renderThread)
+        return;
+
+    // Assets are located here (wxDir) and only loaded on the render thread.
+    std::vector<std::string> icons;
+    std::string toggle;
+    CollectOverlayIcons(icons, toggle);
+    const std::string cacheDir   = CacheDir(m_options.texture_cache_dir, "icons are decoded");
+    const std::string programDir = CacheDir(m_options.program_cache_dir, "shader programs are compiled");
+
+    RenderThread::Hooks hooks;
+    hooks.makeCurrent    = [this] { EnsureCurrent(); };
+    hooks.swapBuffers    = [this] { SwapBuffers(); };
+    hooks.releaseCurrent = [] { wxgl::ReleaseCurrentContext(); };
+    hooks.initialize     = [this, icons, toggle, cacheDir, programDir](Renderer& r) {
+        r.SetProgramCacheDir(programDir);
+        if (!r.Initialize()) {
+            wxLogError("Renderer initialization failed.");
+            return false;
+        }
+        ApplySwapInterval();
+        EnableGpuTiming(r);
+        // RenderThread wakes itself when a decode finishes.
+        r.SetTextureCacheDir(cacheDir);
+        r.LoadOverlayIconSetAsync(icons, &GLCanvas::OnIconLoaded);
+        r.LoadOverlayIconAsync(toggle, &GLCanvas::OnIconLoaded);
+        return true;
+    };
+    hooks.overlayClicked = [this] { CallAfter(&GLCanvas::OverlayHit); };
+    hooks.initFailed     = [this] { CallAfter(&GLCanvas::RenderThreadFailed); };
+
+    m_renderThread.reset(new RenderThread(hooks));
+    m_frame.suspended = IsSuspended();
+    m_renderThread->Start(m_frame);
     m_initialized = true;
 }
 
-void GLCanvas::ResizeRendererToClient()
+void GLCanvas::RenderThreadFailed()
 {
-    if (!m_renderer)
+    // The thread has released the context and exited; nothing will present,
+    // so stop feeding it ticks (the error was logged by the initialize hook).
+    m_renderFailed = true;
+    if (m_timer.IsRunning())
+        m_timer.Stop();
+    if (m_renderThread)
+        m_renderThread->Stop();
+}
+
+void GLCanvas::PublishFrame()
+{
+    if (!m_renderThread)
         return;
+    m_frame.suspended = IsSuspended();
+    m_renderThread->Publish(m_frame);
+}
 
+void GLCanvas::ResizeRendererToClient()
+{
     const float scale = GetDPIScale();
     const wxSize sz   = GetClientSize();
     const int w_px    = static_cast<int>(sz.GetWidth()  * scale);
     const int h_px    = static_cast<int>(sz.GetHeight() * scale);
 
+    if (IsThreaded()) {
+        m_frame.width  = w_px;
+        m_frame.height = h_px;
+        m_frame.dpi    = scale;
+        PublishFrame();
+        return;
+    }
+
+    if (!m_renderer)
+        return;
+
     EnsureCurrent();
     m_renderer->Resize(w_px, h_px, scale);
 }
 
+bool GLCanvas::IsSuspended() const
+{
+    const wxTopLevelWindow* tlw = wxDynamicCast(m_topLevel, wxTopLevelWindow);
+    if (tlw && tlw->IsIconized())
+        return true;
+    return !IsShownOnScreen();
+}
+
 void GLCanvas::OnPaint(wxPaintEvent& /*evt*/)
 {
+    WXGL_PROFILE_SCOPE("GLCanvas::OnPaint");
+
     // Required by wx to validate the window for painting.
     wxPaintDC dc(this);
 
+    // Nothing is visible: no GL work at all until restored.
+    if (IsSuspended())
+        return;
+
+    if (IsThreaded()) {
+        // The render thread decides whether a frame is needed.
+        ResizeRendererToClient();
+        StartRenderThreadIfNeeded();
+        ScheduleTick();
+        return;
+    }
+
+    const std::int64_t frameStart = LatencyStats::NowNs();
+    const bool tickFrame = m_tickFrame;
+    m_frameScheduled = false;
+    m_tickFrame      = false;
+
     EnsureCurrent();
     InitializeRendererIfNeeded();
     ResizeRendererToClient(); // protect against first paint before size event
 
+    // Everything the UI changed since the last frame lands here at once.
+    if (m_renderer && m_initialized && !m_pending.Empty()) {
+        m_renderer->Apply(m_pending);
+        m_pending.Clear();
+    }
+
+    // Expose with unchanged content: the last presented frame is still valid.
+    // Continuous ticks present regardless.
+    const bool forced = tickFrame && m_scheduler.RendersEveryTick();
+    if (m_renderer && m_initialized && !m_renderer->NeedsRender() && !forced) {
+        NotePresented(false);
+        ScheduleTick();
+        return;
+    }
+
     if (m_renderer) {
+        // Lets the renderer redraw only damaged regions when the back buffer
+        // still holds a recent frame.
+        m_renderer->SetBufferAge(wxgl::QueryBufferAge());
         m_renderer->Render();
     }
 
     // Present back buffer
-    SwapBuffers();
+    {
+        WXGL_PROFILE_SCOPE("SwapBuffers");
+        SwapBuffers();
+    }
+    WXGL_PROFILE_FRAME();
+    NotePresented(true);
+
+    // Decoded icons left over by the upload budget go into the next frame.
+    if (m_renderer && m_renderer->NeedsRender())
+        m_scheduler.RequestFrame();
+
+    if (tickFrame)
+        NoteFrameDone(frameStart, LatencyStats::NowNs());
+    ScheduleTick();
+}
+
+void GLCanvas::NoteFrameDone(std::int64_t startNs, std::int64_t endNs)
+{
+    m_scheduler.FrameDone(startNs, endNs);
+    const FrameScheduler::Stats& st = m_scheduler.GetStats();
+    if (st.frames % LatencyStats::kWindow == 0) {
+        wxLogVerbose("frames %llu: missed %llu, over budget %llu, avg %.2f ms, worst %.2f ms, rate 1/%d",
+                     static_cast<unsigned long long>(st.frames),
+                     static_cast<unsigned long long>(st.missed),
+                     static_cast<unsigned long long>(st.overruns),
+                     st.avg_frame_ms, st.worst_frame_ms, st.divisor);
+    }
+}
+
+void GLCanvas::CollectFrameTimes()
+{
+    if (!m_renderThread)
+        return;
+    RenderThread::FrameTime t;
+    while (m_renderThread->PopFrameTime(t))
+        NoteFrameDone(t.start_ns, t.end_ns);
+}
+
+void GLCanvas::ScheduleTick()
+{
+    // One paint in flight at a time; nothing at all while not visible.
+    if (m_frameScheduled || m_renderFailed || IsSuspended())
+        return;
+
+    CollectFrameTimes();   // may change the effective interval
+    const std::int64_t now = LatencyStats::NowNs();
+    const int delayMs = m_scheduler.NextTickDelayMs(now);
+    if (delayMs < 0)
+        return;
+    if (delayMs == 0) {
+        if (m_scheduler.OnTick(now))
+            StartFrame(now);
+        return;
+    }
+    if (!m_timer.IsRunning())
+        m_timer.Start(delayMs, wxTIMER_ONE_SHOT);
+}
+
+void GLCanvas::StartFrame(std::int64_t nowNs)
+{
+    AdvanceAnimation(nowNs);
+
+    if (IsThreaded()) {
+        // The render thread presents on its own; ticks only feed it.
+        ++m_frame.tick;
+        m_frame.every_tick = m_scheduler.RendersEveryTick();
+        PublishFrame();
+        ScheduleTick();
+        return;
+    }
+
+    m_frameScheduled = true;
+    m_tickFrame      = true;
+    Refresh(false);
+}
+
+void GLCanvas::AdvanceAnimation(std::int64_t nowNs)
+{
+    if (m_spin == 0.0) {
+        m_lastAnimNs = 0;
+        return;
+    }
+
+    const double dt = (m_lastAnimNs != 0)
+                    ? std::min(static_cast<double>(nowNs - m_lastAnimNs) * 1e-9, kMaxAnimStepSec)
+                    : 0.0;
+    m_lastAnimNs = nowNs;
+
+    const float deg = static_cast<float>(std::fmod(m_frame.state.rotation_deg + m_spin * dt, 360.0));
+    m_frame.state.rotation_deg = deg;
+    m_pending.SetRotation(deg);
+}
+
+void GLCanvas::ApplySwapInterval()
+{
+    if (m_options.swap_interval < 0)
+        return;
+    if (!wxgl::SetSwapInterval(m_options.swap_interval))
+        wxLogVerbose("Swap interval control is not available; using the driver default.");
+}
+
+void GLCanvas::EnableGpuTiming(Renderer& r)
+{
+    // GPU pass times are reported alongside the CPU scopes of --profile.
+    if (!Profiler::Enabled())
+        return;
+    r.SetGpuTiming(true);
+    if (!r.GpuTimingSupported())
+        wxLogVerbose("GL timer queries are not available; GPU pass timing is off.");
+}
+
+void GLCanvas::NoteInput(InputLatencyProbe::Kind kind, std::int64_t ns)
+{
+    const std::int64_t now = ns ? ns : LatencyStats::NowNs();
+    if (m_probe.Enabled()) {
+        CollectPresents();
+        m_frame.input_seq = m_probe.Input(kind, now);
+    }
+    if (IsThreaded()) {
+        // Keep the oldest input the render thread has not presented yet.
+        if (m_frame.input_ns == 0 ||
+            (m_renderThread && m_renderThread->PresentedInput() >= m_frame.input_ns))
+            m_frame.input_ns = now;
+        return;
+    }
+    if (m_pendingInputNs == 0)
+        m_pendingInputNs = now;
+}
+
+void GLCanvas::NotePresented(bool presented)
+{
+    const std::int64_t now = LatencyStats::NowNs();
+
+    // Single-thread mode: every input so far went into this frame.
+    if (presented)
+        m_probe.Presented(m_probe.LastSeq(), now);
+    else
+        m_probe.Discarded(m_probe.LastSeq());
+
+    if (m_pendingInputNs == 0)
+        return;
+
+    // Input that changed nothing visible does not count as a sample.
+    if (presented) {
+        m_latency.AddSince(m_pendingInputNs, now);
+        if (m_latency.Total() % LatencyStats::kWindow == 0) {
+            const LatencyStats::Summary l = m_latency.Summarize();
+            wxLogVerbose("input->present latency: mean %.1f ms, p95 %.1f ms, max %.1f ms (%lu frames)",
+                         l.mean, l.p95, l.max, static_cast<unsigned long>(l.count));
+        }
+    }
+    m_pendingInputNs = 0;
+}
+
+void GLCanvas::CollectPresents()
+{
+    if (!m_renderThread)
+        return;
+    RenderThread::Present p;
+    while (m_renderThread->PopPresent(p)) {
+        if (p.shown)
+            m_probe.Presented(p.seq, p.ns);
+        else
+            m_probe.Discarded(p.seq);
+    }
+}
+
+const InputLatencyProbe& GLCanvas::LatencyProbe()
+{
+    CollectPresents();
+    return m_probe;
+}
+
+LatencyStats::Summary GLCanvas::InputLatency() const
+{
+    if (m_renderThread)
+        return m_renderThread->InputLatency();
+    return m_latency.Summarize();
+}
+
+void GLCanvas::OnIconize(wxIconizeEvent& evt)
+{
+    evt.Skip();
+    if (evt.IsIconized())
+        return;
+
+    // Window contents may be gone after restoring; repaint once in full.
+    if (m_renderer)
+        m_renderer->Invalidate();
+    ++m_frame.invalidate;
+    PublishFrame();
+    Refresh(false);
+}
+
+void GLCanvas::OnShow(wxShowEvent& evt)
+{
+    evt.Skip();
+    if (!evt.IsShown())
+        return;
+
+    if (m_renderer)
+        m_renderer->Invalidate();
+    ++m_frame.invalidate;
+    PublishFrame();
+    Refresh(false);
 }
 
 void GLCanvas::OnSize(wxSizeEvent& evt)
@@ -151,7 +541,7 @@ void GLCanvas::OnSize(wxSizeEvent& evt)
     // Let the default handler process internal bookkeeping
     evt.Skip();
 
-    if (!m_renderer)
+    if (!m_renderer && !m_renderThread)
         return;
 
     ResizeRendererToClient();
@@ -162,32 +552,91 @@ void GLCanvas::OnSize(wxSizeEvent& evt)
 
 void GLCanvas::OnLeftDown(wxMouseEvent& evt)
 {
-    if (!m_renderer) {
+    const wxPoint p = evt.GetPosition();
+    if (m_inputLog)
+        m_inputLog->Record(InputEvent::Kind::Click, p.x, p.y);
+
+    if (!m_renderer && !m_renderThread) {
         evt.Skip();
         return;
     }
 
     // Position is in logical (DIP) units; convert to device pixels for hit-testing.
     const float scale = GetDPIScale();
-    const wxPoint p   = evt.GetPosition();
     const int x_px    = static_cast<int>(p.x * scale);
     const int y_px    = static_cast<int>(p.y * scale);
 
+    // The overlay lives on the render thread; a hit comes back via CallAfter.
+    if (m_renderThread) {
+        if (m_renderThread->PostClick(x_px, y_px))
+            m_clickNs = LatencyStats::NowNs();
+        else
+            evt.Skip();
+        return;
+    }
+
     if (m_renderer->HitTestOverlay(x_px, y_px, scale)) {
-        wxCommandEvent e(wxEVT_WXGL_TOGGLE_SIDEBAR);
-        e.SetEventObject(this);
+        // Only a hit changes the picture (the sidebar toggles).
+        NoteInput(InputLatencyProbe::Kind::Click);
+        NotifyOverlayClicked();
+        return;
+    }
+}
+
+void GLCanvas::InjectClick(int x, int y)
+{
+    wxMouseEvent e(wxEVT_LEFT_DOWN);
+    e.SetEventObject(this);
+    e.SetId(GetId());
+    e.SetPosition(wxPoint(x, y));
+    e.SetLeftDown(true);
+    HandleWindowEvent(e);
+}
+
+void GLCanvas::OverlayHit()
+{
+    // Measured from the click, not from the render thread's hit test.
+    NoteInput(InputLatencyProbe::Kind::Click, m_clickNs);
+    NotifyOverlayClicked();
+}
+
+void GLCanvas::NotifyOverlayClicked()
+{
+    wxCommandEvent e(wxEVT_WXGL_TOGGLE_SIDEBAR);
+    e.SetEventObject(this);
 #ifdef __WXGTK__
-        GetParent()->GetEventHandler()->ProcessEvent(e); // 同步
+    GetParent()->GetEventHandler()->ProcessEvent(e); // 同步
 #else
-        wxPostEvent(GetParent(), e);
+    wxPostEvent(GetParent(), e);
 #endif
+}
+
+void GLCanvas::OnKeyDown(wxKeyEvent& evt)
+{
+    if (evt.GetKeyCode() != WXK_F12) {
+        evt.Skip();
         return;
     }
+
+    // Dump the frame-timing statistics collected so far.
+    const std::string path = m_options.profile_path.empty() ? std::string("wxgl_profile.json")
+                                                            : m_options.profile_path;
+    if (Profiler::Instance().Export(path))
+        wxLogMessage("Frame timings written to %s", path);
+    else
+        wxLogError("Cannot write frame timings to %s", path);
 }
 
 void GLCanvas::OnTimer(wxTimerEvent& /*evt*/)
 {
-    // Lightweight periodic refresh. Consider pausing when unfocused if needed.
+    // Deadline tick from the scheduler; early wake-ups just re-arm.
+    // Render-thread frames are accounted before the next one starts.
+    CollectFrameTimes();
+    const std::int64_t now = LatencyStats::NowNs();
+    if (m_scheduler.OnTick(now))
+        StartFrame(now);
+    else
+        ScheduleTick();
 }
 
 void GLCanvas::OnEraseBackground(wxEraseEvent& /*evt*/)
@@ -197,24 +646,54 @@ void GLCanvas::OnEraseBackground(wxEraseEvent& /*evt*/)
 
 void GLCanvas::SetRotation(float deg)
 {
-    if (m_renderer)
-        m_renderer->SetRotation(deg);
+    NoteInput(InputLatencyProbe::Kind::Rotation);
+    m_frame.state.rotation_deg = deg;
+    PublishFrame();
+
+    m_pending.SetRotation(deg);
 }
 
 void GLCanvas::SetScale(float s)
 {
-    if (m_renderer)
-        m_renderer->SetScale(s);
+    NoteInput(InputLatencyProbe::Kind::Other);
+    m_frame.state.scale = s;
+    PublishFrame();
+
+    m_pending.SetScale(s);
 }
 
 void GLCanvas::SetObjectVisible(bool v)
 {
-    if (m_renderer)
-        m_renderer->SetObjectVisible(v);
+    NoteInput(InputLatencyProbe::Kind::Visibility);
+    m_frame.state.object_visible = v;
+    PublishFrame();
+
+    m_pending.SetObjectVisible(v);
+}
+
+void GLCanvas::SetInstanceCount(int n)
+{
+    NoteInput(InputLatencyProbe::Kind::Other);
+    m_frame.state.instance_count = n;
+    PublishFrame();
+
+    m_pending.SetInstanceCount(n);
 }
 
 void GLCanvas::RequestRedraw()
 {
-    Refresh(false);
-    Update();
+    // Setters already published the state; never block on a frame here.
+    if (IsThreaded())
+        return;
+
+    // Paint at the next frame deadline; later changes join that frame.
+    m_scheduler.RequestFrame();
+    ScheduleTick();
+}
+
+void GLCanvas::SetSpin(double degPerSec)
+{
+    m_spin = std::isfinite(degPerSec) ? degPerSec : 0.0;
+    m_scheduler.SetAnimating(m_spin != 0.0);
+    ScheduleTick();
 }
\ No newline at end of file
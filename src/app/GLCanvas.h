@@ -1,12 +1,23 @@
 // src/app/GLCanvas.h
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <wx/event.h>
 #include <wx/glcanvas.h>
 #include <wx/timer.h>
 
+#include "AppOptions.h"
+#include "FrameScheduler.h"
+#include "InputLatencyProbe.h"
+#include "RenderThread.h"
+#include "render/LatencyStats.h"
+#include "render/RenderState.h"
+
+class InputLog; // from InputLog.h
 class Renderer; // from src/render/Renderer.h
 
 /**
@@ -14,28 +25,64 @@ class Renderer; // from src/render/Renderer.h
  * - Derives from wxGLCanvas and owns a wxGLContext.
  * - Bridges wxWidgets events (paint/resize/mouse) to the rendering backend (Renderer).
  * - Does NOT expose any wxWidgets types to the render module.
+ * - Paints only when the renderer reports a change (Renderer::NeedsRender);
+ *   expose-only paints are validated without rendering or swapping.
+ * - Issues no frames while the top-level window is minimized or the canvas is
+ *   not shown on screen; the first paint after restoring is a full frame.
+ * - UI changes are coalesced: setters only record a pending RenderStateDelta
+ *   and RequestRedraw() asks the FrameScheduler for a frame (never a
+ *   synchronous Update()). The delta is applied right before the frame;
+ *   input -> present latency is tracked (InputLatency, --verbose). With
+ *   AppOptions::latency_report or an input replay, every single input is
+ *   also matched to the swap that shows it (LatencyProbe).
+ * - Frame pacing: m_timer is a one-shot tick re-armed for each deadline of
+ *   the FrameScheduler (continuous / on-demand / animation-only). Spin
+ *   (auto-rotation) is the animation driven by those ticks.
+ * - Render-thread mode (AppOptions::render_thread): a RenderThread owns the
+ *   context and the Renderer. Setters, size changes and clicks are published
+ *   to it without waiting; this class then never touches GL itself.
+ *   Ticks still come from m_timer; the thread reports the cost of each
+ *   tick's frame back, which feeds FrameScheduler::FrameDone().
  */
 class GLCanvas final : public wxGLCanvas
 {
 public:
-    explicit GLCanvas(wxWindow* parent, wxWindowID id);
+    GLCanvas(wxWindow* parent, wxWindowID id, const AppOptions& options = AppOptions());
     ~GLCanvas() override;
 
     // State setters used by SidePanel (UI → Render)
     void SetRotation(float deg);
     void SetScale(float s);
     void SetObjectVisible(bool v);
+    void SetInstanceCount(int n);
+    void SetSpin(double degPerSec);   // 0 = no auto-rotation
 
-    // Manual redraw (optional external trigger)
+    // Schedule a frame for pending changes; returns immediately.
     void RequestRedraw();
 
+    // Time from the first coalesced UI input to the present that showed it.
+    LatencyStats::Summary InputLatency() const;
+    const FrameScheduler::Stats& SchedulerStats() const { return m_scheduler.GetStats(); }
+
+    // Per-input latency; collects pending render-thread reports first.
+    const InputLatencyProbe& LatencyProbe();
+
+    // Records clicks reaching OnLeftDown (not owned, nullptr = off).
+    void SetInputLog(InputLog* log) { m_inputLog = log; }
+
+    // Replays a click through OnLeftDown (client coordinates, DIP).
+    void InjectClick(int x, int y);
+
 private:
     // Event handlers
     void OnPaint(wxPaintEvent& evt);
     void OnSize(wxSizeEvent& evt);
     void OnLeftDown(wxMouseEvent& evt);
+    void OnKeyDown(wxKeyEvent& evt);            // F12: export frame timings
     void OnTimer(wxTimerEvent& evt);
     void OnEraseBackground(wxEraseEvent& evt); // no-op to avoid flicker
+    void OnIconize(wxIconizeEvent& evt);        // bound on the top-level window
+    void OnShow(wxShowEvent& evt);
 
     // Helpers
     void CreateContextIfNeeded();
@@ -43,10 +90,51 @@ private:
     void InitializeRendererIfNeeded();
     float GetDPIScale() const;
     void ResizeRendererToClient();
+    bool IsSuspended() const;                   // minimized / not on screen
+    void CollectOverlayIcons(std::vector<std::string>& icons, std::string& toggle) const;
+    // Cache directory 'path', created on demand; "" = off or not creatable.
+    static std::string CacheDir(const std::string& path, const char* fallback);
+    static void OnIconLoaded(const std::string& path, bool ok);   // async icon result
+    void NotifyOverlayClicked();
+    void OverlayHit();                          // render thread reported a hit on m_clickNs
+    void NoteInput(InputLatencyProbe::Kind kind, std::int64_t ns = 0);   // 0 = now
+    void NotePresented(bool presented);
+    void CollectPresents();                     // render-thread reports -> m_probe
+    void CollectFrameTimes();                   // render-thread frame costs -> m_scheduler
+    void NoteFrameDone(std::int64_t startNs, std::int64_t endNs);   // a tick's frame was presented
+    void ScheduleTick();                        // arm m_timer for the next deadline
+    void StartFrame(std::int64_t nowNs);        // a scheduler tick is due
+    void AdvanceAnimation(std::int64_t nowNs);
+    void ApplySwapInterval();                   // context must be current
+    void EnableGpuTiming(Renderer& r);          // context must be current
+
+    // Render-thread mode
+    bool IsThreaded() const { return m_options.render_thread; }
+    void StartRenderThreadIfNeeded();
+    void RenderThreadFailed();                  // initialize hook failed (UI thread)
+    void PublishFrame();
 
 private:
     std::unique_ptr<wxGLContext> m_context;
-    std::unique_ptr<Renderer>    m_renderer;
-    wxTimer                      m_timer;
+    std::unique_ptr<Renderer>    m_renderer;      // single-thread mode only
+    std::unique_ptr<RenderThread> m_renderThread; // render-thread mode only
+    RenderThread::Frame          m_frame;         // last state published to it
+    AppOptions                   m_options;
+    wxTimer                      m_timer;         // one-shot frame tick
+    FrameScheduler               m_scheduler;
+    bool                         m_tickFrame {false};   // pending paint came from a tick
+    double                       m_spin {0.0};          // deg/s
+    std::int64_t                 m_lastAnimNs {0};
+
+    // Coalescing (single-thread mode)
+    RenderStateDelta             m_pending;
+    std::int64_t                 m_pendingInputNs {0};  // 0 = no input waiting
+    bool                         m_frameScheduled {false};
+    LatencyStats                 m_latency;
+    InputLatencyProbe            m_probe;               // per input, both modes
+    std::int64_t                 m_clickNs {0};         // last click posted to the render thread
+    InputLog*                    m_inputLog {nullptr};  // not owned
+    wxWindow*                    m_topLevel {nullptr};  // for iconize events (not owned)
     bool                         m_initialized {false}; // renderer initialization guard
+    bool                         m_renderFailed {false}; // render thread could not initialize
 };
\ No newline at end of file
@@ -0,0 +1,244 @@
+// src/app/GLPlatform.cpp
+#include "GLPlatform.h"
+
+#include "render/GlCaps.h"
+
+#if defined(__linux__) || (defined(__unix__) && !defined(__APPLE__))
+#  define WXGL_HAVE_DLSYM 1
+#  include <dlfcn.h>
+#else
+#  define WXGL_HAVE_DLSYM 0
+#endif
+
+#if WXGL_HAVE_DLSYM
+namespace {
+// Opaque window-system handles; declared locally so no EGL/GLX headers are needed.
+using EGLDisplay = void*;
+using EGLSurface = void*;
+using EGLContext = void*;
+using EGLBoolean = unsigned int;
+using EGLint     = int;
+using XDisplay   = void;
+using GLXDrawable = unsigned long;
+
+const EGLint kEglExtensions    = 0x3055;  // EGL_EXTENSIONS
+const EGLint kEglDraw          = 0x3059;  // EGL_DRAW
+const EGLint kEglBufferAgeExt  = 0x313D;  // EGL_BUFFER_AGE_EXT
+const int    kGlxBackBufferAge = 0x20F4;  // GLX_BACK_BUFFER_AGE_EXT
+
+typedef EGLContext  (*PFN_eglGetCurrentContext)(void);
+typedef EGLDisplay  (*PFN_eglGetCurrentDisplay)(void);
+typedef EGLSurface  (*PFN_eglGetCurrentSurface)(EGLint);
+typedef const char* (*PFN_eglQueryString)(EGLDisplay, EGLint);
+typedef EGLBoolean  (*PFN_eglQuerySurface)(EGLDisplay, EGLSurface, EGLint, EGLint*);
+typedef EGLBoolean  (*PFN_eglMakeCurrent)(EGLDisplay, EGLSurface, EGLSurface, EGLContext);
+typedef EGLBoolean  (*PFN_eglSwapInterval)(EGLDisplay, EGLint);
+
+typedef void*       (*PFN_glXGetCurrentContext)(void);
+typedef XDisplay*   (*PFN_glXGetCurrentDisplay)(void);
+typedef GLXDrawable (*PFN_glXGetCurrentDrawable)(void);
+typedef const char* (*PFN_glXQueryExtensionsString)(XDisplay*, int);
+typedef void        (*PFN_glXQueryDrawable)(XDisplay*, GLXDrawable, int, unsigned int*);
+typedef int         (*PFN_XDefaultScreen)(XDisplay*);
+typedef int         (*PFN_glXMakeCurrent)(XDisplay*, GLXDrawable, void*);
+typedef int         (*PFN_XInitThreads)(void);
+typedef void*       (*PFN_glXGetProcAddress)(const unsigned char*);
+typedef void        (*PFN_glXSwapIntervalEXT)(XDisplay*, GLXDrawable, int);
+typedef int         (*PFN_glXSwapIntervalMESA)(unsigned int);
+typedef int         (*PFN_glXSwapIntervalSGI)(int);
+
+template <typename T>
+T Sym(const char* name)
+{
+    return reinterpret_cast<T>(dlsym(RTLD_DEFAULT, name));
+}
+
+struct EglApi {
+    PFN_eglGetCurrentContext getContext {Sym<PFN_eglGetCurrentContext>("eglGetCurrentContext")};
+    PFN_eglGetCurrentDisplay getDisplay {Sym<PFN_eglGetCurrentDisplay>("eglGetCurrentDisplay")};
+    PFN_eglGetCurrentSurface getSurface {Sym<PFN_eglGetCurrentSurface>("eglGetCurrentSurface")};
+    PFN_eglQueryString       queryString {Sym<PFN_eglQueryString>("eglQueryString")};
+    PFN_eglQuerySurface      querySurface {Sym<PFN_eglQuerySurface>("eglQuerySurface")};
+    PFN_eglMakeCurrent       makeCurrent {Sym<PFN_eglMakeCurrent>("eglMakeCurrent")};
+    PFN_eglSwapInterval      swapInterval {Sym<PFN_eglSwapInterval>("eglSwapInterval")};
+
+    bool Complete() const {
+        return getContext && getDisplay && getSurface && queryString && querySurface;
+    }
+};
+
+struct GlxApi {
+    PFN_glXGetCurrentContext    getContext {Sym<PFN_glXGetCurrentContext>("glXGetCurrentContext")};
+    PFN_glXGetCurrentDisplay    getDisplay {Sym<PFN_glXGetCurrentDisplay>("glXGetCurrentDisplay")};
+    PFN_glXGetCurrentDrawable   getDrawable {Sym<PFN_glXGetCurrentDrawable>("glXGetCurrentDrawable")};
+    PFN_glXQueryExtensionsString queryExtensions {Sym<PFN_glXQueryExtensionsString>("glXQueryExtensionsString")};
+    PFN_glXQueryDrawable        queryDrawable {Sym<PFN_glXQueryDrawable>("glXQueryDrawable")};
+    PFN_XDefaultScreen          defaultScreen {Sym<PFN_XDefaultScreen>("XDefaultScreen")};
+    PFN_glXMakeCurrent          makeCurrent {Sym<PFN_glXMakeCurrent>("glXMakeCurrent")};
+    PFN_glXGetProcAddress       getProcAddress {Sym<PFN_glXGetProcAddress>("glXGetProcAddressARB")};
+
+    // Extension entry points are not always exported; ask GLX first.
+    template <typename T>
+    T Proc(const char* name) const {
+        void* p = getProcAddress ? getProcAddress(reinterpret_cast<const unsigned char*>(name)) : nullptr;
+        return p ? reinterpret_cast<T>(p) : Sym<T>(name);
+    }
+
+    bool Complete() const {
+        return getContext && getDisplay && getDrawable && queryExtensions &&
+               queryDrawable && defaultScreen;
+    }
+};
+
+// Extension support is per display; remember the answer for the last one.
+struct ExtCache {
+    const void* display {nullptr};
+    bool        supported {false};
+};
+
+int QueryEglAge(const EglApi& egl)
+{
+    static ExtCache cache;
+    EGLDisplay dpy = egl.getDisplay();
+    EGLSurface srf = egl.getSurface(kEglDraw);
+    if (!dpy || !srf)
+        return 0;
+    if (cache.display != dpy) {
+        cache.display   = dpy;
+        cache.supported = GlCaps::HasToken(egl.queryString(dpy, kEglExtensions), "EGL_EXT_buffer_age");
+    }
+    if (!cache.supported)
+        return 0;
+
+    EGLint age = 0;
+    if (!egl.querySurface(dpy, srf, kEglBufferAgeExt, &age))
+        return 0;
+    return age > 0 ? static_cast<int>(age) : 0;
+}
+
+int QueryGlxAge(const GlxApi& glx)
+{
+    static ExtCache cache;
+    XDisplay*   dpy = glx.getDisplay();
+    GLXDrawable drw = glx.getDrawable();
+    if (!dpy || !drw)
+        return 0;
+    if (cache.display != dpy) {
+        cache.display   = dpy;
+        cache.supported = GlCaps::HasToken(glx.queryExtensions(dpy, glx.defaultScreen(dpy)),
+                                       "GLX_EXT_buffer_age");
+    }
+    if (!cache.supported)
+        return 0;
+
+    unsigned int age = 0;
+    glx.queryDrawable(dpy, drw, kGlxBackBufferAge, &age);
+    return static_cast<int>(age);
+}
+
+bool SetGlxSwapInterval(const GlxApi& glx, int interval)
+{
+    XDisplay*   dpy = glx.getDisplay();
+    GLXDrawable drw = glx.getDrawable();
+    if (!dpy || !drw)
+        return false;
+    const char* exts = glx.queryExtensions(dpy, glx.defaultScreen(dpy));
+
+    // Preference: EXT (per drawable, allows 0), MESA (allows 0), SGI (> 0 only).
+    if (GlCaps::HasToken(exts, "GLX_EXT_swap_control")) {
+        PFN_glXSwapIntervalEXT fn = glx.Proc<PFN_glXSwapIntervalEXT>("glXSwapIntervalEXT");
+        if (fn) {
+            fn(dpy, drw, interval);
+            return true;
+        }
+    }
+    if (GlCaps::HasToken(exts, "GLX_MESA_swap_control")) {
+        PFN_glXSwapIntervalMESA fn = glx.Proc<PFN_glXSwapIntervalMESA>("glXSwapIntervalMESA");
+        if (fn)
+            return fn(static_cast<unsigned int>(interval)) == 0;
+    }
+    if (interval > 0 && GlCaps::HasToken(exts, "GLX_SGI_swap_control")) {
+        PFN_glXSwapIntervalSGI fn = glx.Proc<PFN_glXSwapIntervalSGI>("glXSwapIntervalSGI");
+        if (fn)
+            return fn(interval) == 0;
+    }
+    return false;
+}
+
+const EglApi& Egl()
+{
+    static const EglApi egl;
+    return egl;
+}
+
+const GlxApi& Glx()
+{
+    static const GlxApi glx;
+    return glx;
+}
+} // namespace
+#endif // WXGL_HAVE_DLSYM
+
+namespace wxgl {
+
+int QueryBufferAge()
+{
+#if WXGL_HAVE_DLSYM
+    // Whichever API owns the current context answers.
+    const EglApi& egl = Egl();
+    if (egl.Complete() && egl.getContext())
+        return QueryEglAge(egl);
+
+    const GlxApi& glx = Glx();
+    if (glx.Complete() && glx.getContext())
+        return QueryGlxAge(glx);
+#endif
+    return 0;
+}
+
+bool PrepareThreadedGL()
+{
+#if WXGL_HAVE_DLSYM
+    // Xlib is linked by wxGTK, so the symbol is there before any display opens.
+    PFN_XInitThreads initThreads = Sym<PFN_XInitThreads>("XInitThreads");
+    if (initThreads)
+        return initThreads() != 0;
+#endif
+    return true;
+}
+
+bool SetSwapInterval(int interval)
+{
+#if WXGL_HAVE_DLSYM
+    if (interval < 0)
+        return false;
+
+    const EglApi& egl = Egl();
+    if (egl.Complete() && egl.swapInterval && egl.getContext())
+        return egl.swapInterval(egl.getDisplay(), interval) != 0;
+
+    const GlxApi& glx = Glx();
+    if (glx.Complete() && glx.getContext())
+        return SetGlxSwapInterval(glx, interval);
+#else
+    (void)interval;
+#endif
+    return false;
+}
+
+void ReleaseCurrentContext()
+{
+#if WXGL_HAVE_DLSYM
+    const EglApi& egl = Egl();
+    if (egl.Complete() && egl.makeCurrent && egl.getContext()) {
+        egl.makeCurrent(egl.getDisplay(), nullptr, nullptr, nullptr);
+        return;
+    }
+
+    const GlxApi& glx = Glx();
+    if (glx.Complete() && glx.makeCurrent && glx.getContext())
+        glx.makeCurrent(glx.getDisplay(), 0, nullptr);
+#endif
+}
+
+} // namespace wxgl
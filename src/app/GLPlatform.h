@@ -0,0 +1,39 @@
+// src/app/GLPlatform.h
+#pragma once
+
+/**
+ * GLPlatform
+ * Small window-system queries for the current GL drawable that wxWidgets
+ * does not expose. No wxWidgets types; safe to call every frame.
+ *
+ * Entry points (GLX, EGL) are resolved at runtime with dlsym from the
+ * libraries the process already loaded, so no extra link dependency and no
+ * failure when an API is absent. Extension support is checked before any
+ * query (an unsupported GLX attribute would raise an X error).
+ *
+ * Only Linux/X11 (GLX) and EGL (Wayland, or wxGTK built with EGL) are
+ * implemented; other platforms report "unknown".
+ */
+namespace wxgl {
+
+// Age of the back buffer of the current drawable, as defined by
+// GLX_EXT_buffer_age / EGL_EXT_buffer_age: 1 = it holds the previous frame,
+// N = the frame N swaps ago. 0 = contents undefined or age unsupported
+// (redraw everything). Requires the GL context to be current.
+int QueryBufferAge();
+
+// Swap interval of the current drawable: 0 = no vsync, 1 = every vblank.
+// Uses EGL eglSwapInterval or GLX_EXT / _MESA / _SGI_swap_control (SGI
+// cannot disable vsync). Returns false when no extension applies.
+bool SetSwapInterval(int interval);
+
+// Must run before the first X display is opened when GL is used from a
+// second thread (GLCanvas render-thread mode): calls XInitThreads on X11.
+// No-op elsewhere. Returns false if Xlib refused.
+bool PrepareThreadedGL();
+
+// Detach the calling thread's current context (glXMakeCurrent / eglMakeCurrent
+// with no surface), so another thread may destroy or bind it.
+void ReleaseCurrentContext();
+
+} // namespace wxgl
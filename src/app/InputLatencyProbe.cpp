@@ -0,0 +1,115 @@
+// src/app/InputLatencyProbe.cpp
+#include "InputLatencyProbe.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "render/Util.h"
+
+namespace {
+    void PrintDistribution(std::FILE* f, const InputLatencyProbe::Distribution& d)
+    {
+        std::fprintf(f, "{\"count\": %zu, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p90_ms\": %.3f, "
+                        "\"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f}",
+                     d.count, d.mean, d.p50, d.p90, d.p95, d.p99, d.max);
+    }
+}
+
+std::uint32_t InputLatencyProbe::Input(Kind kind, std::int64_t ns)
+{
+    if (!m_enabled)
+        return 0;
+
+    ++m_inputs;
+    if (++m_seq == 0)
+        m_seq = 1;   // 0 means "no input"
+    Pending p;
+    p.seq  = m_seq;
+    p.kind = kind;
+    p.ns   = ns;
+    m_pending.push_back(p);
+    return m_seq;
+}
+
+void InputLatencyProbe::Presented(std::uint32_t seq, std::int64_t ns)
+{
+    while (!m_pending.empty() && m_pending.front().seq <= seq) {
+        const Pending& p = m_pending.front();
+        m_samples[static_cast<int>(p.kind)].push_back(static_cast<double>(ns - p.ns) * 1e-6);
+        m_pending.pop_front();
+    }
+}
+
+void InputLatencyProbe::Discarded(std::uint32_t seq)
+{
+    while (!m_pending.empty() && m_pending.front().seq <= seq) {
+        ++m_discards;
+        m_pending.pop_front();
+    }
+}
+
+InputLatencyProbe::Distribution InputLatencyProbe::summarize(std::vector<double> ms)
+{
+    Distribution d;
+    if (ms.empty())
+        return d;
+
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double v : ms)
+        sum += v;
+    d.count = ms.size();
+    d.mean  = sum / static_cast<double>(ms.size());
+    d.p50   = Util::Percentile(ms, 0.50);
+    d.p90   = Util::Percentile(ms, 0.90);
+    d.p95   = Util::Percentile(ms, 0.95);
+    d.p99   = Util::Percentile(ms, 0.99);
+    d.max   = ms.back();
+    return d;
+}
+
+InputLatencyProbe::Distribution InputLatencyProbe::Summarize() const
+{
+    std::vector<double> all;
+    for (const std::vector<double>& s : m_samples)
+        all.insert(all.end(), s.begin(), s.end());
+    return summarize(std::move(all));
+}
+
+InputLatencyProbe::Distribution InputLatencyProbe::Summarize(Kind kind) const
+{
+    return summarize(m_samples[static_cast<int>(kind)]);
+}
+
+const char* InputLatencyProbe::KindName(Kind kind)
+{
+    switch (kind) {
+    case Kind::Click:      return "click";
+    case Kind::Rotation:   return "rotation";
+    case Kind::Visibility: return "visibility";
+    case Kind::Other:      return "other";
+    }
+    return "?";
+}
+
+bool InputLatencyProbe::WriteJson(const std::string& path) const
+{
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"inputs\": %llu,\n  \"discarded\": %llu,\n  \"unmatched\": %zu,\n",
+                 static_cast<unsigned long long>(m_inputs), static_cast<unsigned long long>(m_discards),
+                 m_pending.size());
+    std::fprintf(f, "  \"all\": ");
+    PrintDistribution(f, Summarize());
+    std::fprintf(f, ",\n  \"by_kind\": {");
+    for (int k = 0; k < kKinds; ++k) {
+        std::fprintf(f, "%s\n    \"%s\": ", k ? "," : "", KindName(static_cast<Kind>(k)));
+        PrintDistribution(f, Summarize(static_cast<Kind>(k)));
+    }
+    std::fprintf(f, "\n  }\n}\n");
+
+    return std::fclose(f) == 0;
+}
@@ -0,0 +1,80 @@
+// src/app/InputLatencyProbe.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * InputLatencyProbe
+ * Input -> present latency of every single UI input, kept for the whole run
+ * (LatencyStats only tracks the oldest input of each frame in a rolling
+ * window). Used for --latency-report and input replays; no wx types.
+ *
+ * - Input() hands out an increasing sequence number per input.
+ * - Presented(seq, ns): the buffer swap at 'ns' shows every input up to
+ *   'seq'; each of them gets one sample.
+ * - Discarded(seq): inputs up to 'seq' reached a frame that changed nothing
+ *   visible (e.g. a click next to the overlay button); no sample.
+ *
+ * Summaries are nearest-rank percentiles (Util::Percentile) over all
+ * samples, overall and per input kind. Disabled probes ignore everything
+ * and cost nothing.
+ */
+class InputLatencyProbe
+{
+public:
+    enum class Kind { Click, Rotation, Visibility, Other };
+    static const int kKinds = 4;
+
+    struct Distribution {
+        std::size_t count {0};
+        double mean {0.0};
+        double p50  {0.0};
+        double p90  {0.0};
+        double p95  {0.0};
+        double p99  {0.0};
+        double max  {0.0};
+    };
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool Enabled() const { return m_enabled; }
+
+    // Returns the input's sequence number, 0 while disabled.
+    std::uint32_t Input(Kind kind, std::int64_t ns);
+    std::uint32_t LastSeq() const { return m_seq; }
+
+    void Presented(std::uint32_t seq, std::int64_t ns);
+    void Discarded(std::uint32_t seq);
+
+    std::uint64_t Inputs()    const { return m_inputs; }
+    std::uint64_t Discards()  const { return m_discards; }
+    std::size_t   Unmatched() const { return m_pending.size(); }   // not presented yet
+
+    Distribution Summarize() const;
+    Distribution Summarize(Kind kind) const;
+
+    // JSON with the overall and per-kind distributions (milliseconds).
+    bool WriteJson(const std::string& path) const;
+
+    static const char* KindName(Kind kind);
+
+private:
+    struct Pending {
+        std::uint32_t seq;
+        Kind          kind;
+        std::int64_t  ns;
+    };
+
+    static Distribution summarize(std::vector<double> ms);
+
+private:
+    bool m_enabled {false};
+    std::uint32_t m_seq {0};
+    std::uint64_t m_inputs {0};
+    std::uint64_t m_discards {0};
+    std::deque<Pending> m_pending;
+    std::vector<double> m_samples[kKinds];   // ms, per Kind
+};
@@ -0,0 +1,114 @@
+// src/app/InputLog.cpp
+#include "InputLog.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "render/LatencyStats.h"
+
+namespace {
+    const char* const kHeader = "# wxgl input log 1";
+}
+
+void InputLog::Record(InputEvent::Kind kind, int a, int b)
+{
+    const std::int64_t now = LatencyStats::NowNs();
+    if (m_events.empty())
+        m_startNs = now;
+
+    InputEvent e;
+    e.t_ns = now - m_startNs;
+    e.kind = kind;
+    e.a    = a;
+    e.b    = b;
+    m_events.push_back(e);
+}
+
+const char* InputLog::KindName(InputEvent::Kind kind)
+{
+    switch (kind) {
+    case InputEvent::Kind::Click:      return "click";
+    case InputEvent::Kind::Rotation:   return "rotation";
+    case InputEvent::Kind::Visibility: return "visibility";
+    }
+    return "?";
+}
+
+bool InputLog::Save(const std::string& path) const
+{
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        m_error = "cannot open " + path;
+        return false;
+    }
+
+    std::fprintf(f, "%s\n", kHeader);
+    for (const InputEvent& e : m_events) {
+        const long long us = static_cast<long long>(e.t_ns / 1000);
+        if (e.kind == InputEvent::Kind::Click)
+            std::fprintf(f, "%lld click %d %d\n", us, e.a, e.b);
+        else
+            std::fprintf(f, "%lld %s %d\n", us, KindName(e.kind), e.a);
+    }
+
+    if (std::fclose(f) != 0) {
+        m_error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool InputLog::Load(const std::string& path)
+{
+    std::FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) {
+        m_error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<InputEvent> events;
+    char line[256];
+    int lineNo = 0;
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), f)) {
+        ++lineNo;
+        const char* p = line;
+        while (*p == ' ' || *p == '\t')
+            ++p;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0')
+            continue;
+
+        long long us = 0;
+        char kind[16] = {};
+        int a = 0, b = 0;
+        const int n = std::sscanf(p, "%lld %15s %d %d", &us, kind, &a, &b);
+
+        InputEvent e;
+        e.t_ns = us * 1000;
+        e.a    = a;
+        e.b    = b;
+        if (n == 4 && std::strcmp(kind, "click") == 0) {
+            e.kind = InputEvent::Kind::Click;
+        } else if (n >= 3 && std::strcmp(kind, "rotation") == 0) {
+            e.kind = InputEvent::Kind::Rotation;
+        } else if (n >= 3 && std::strcmp(kind, "visibility") == 0) {
+            e.kind = InputEvent::Kind::Visibility;
+            e.a    = (a != 0) ? 1 : 0;
+        } else {
+            ok = false;
+        }
+        if (ok && (us < 0 || (!events.empty() && e.t_ns < events.back().t_ns)))
+            ok = false;
+        if (ok)
+            events.push_back(e);
+    }
+    std::fclose(f);
+
+    if (!ok) {
+        m_error = path + ":" + std::to_string(lineNo) + ": malformed or out-of-order event";
+        return false;
+    }
+    m_events.swap(events);
+    m_startNs = 0;
+    return true;
+}
@@ -0,0 +1,51 @@
+// src/app/InputLog.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * InputEvent / InputLog
+ * A recorded sequence of the UI inputs that drive the scene: overlay clicks
+ * reaching GLCanvas::OnLeftDown and the rotation slider / visibility box of
+ * SidePanel. No wx types; InputReplayer plays a log back into the widgets.
+ *
+ * - Record() timestamps an event relative to the first one recorded, so a
+ *   log does not depend on how long the application took to start.
+ * - Save()/Load() use a line-based text file that can be edited by hand:
+ *     # wxgl input log 1
+ *     <t_us> rotation <deg>
+ *     <t_us> visibility <0|1>
+ *     <t_us> click <x> <y>        (canvas client coordinates, DIP)
+ *   Times are microseconds and must not decrease.
+ */
+struct InputEvent
+{
+    enum class Kind { Click, Rotation, Visibility };
+
+    std::int64_t t_ns {0};   // offset from the first event
+    Kind kind {Kind::Click};
+    int  a {0};              // click x | rotation degrees | visible (0/1)
+    int  b {0};              // click y
+};
+
+class InputLog
+{
+public:
+    void Record(InputEvent::Kind kind, int a, int b = 0);
+
+    const std::vector<InputEvent>& Events() const { return m_events; }
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+    const std::string& LastError() const { return m_error; }
+
+    static const char* KindName(InputEvent::Kind kind);
+
+private:
+    std::vector<InputEvent> m_events;
+    std::int64_t m_startNs {0};
+    mutable std::string m_error;
+};
@@ -0,0 +1,90 @@
+// src/app/InputReplayer.cpp
+#include "InputReplayer.h"
+
+#include <algorithm>
+
+#include "Events.h"
+#include "GLCanvas.h"
+#include "SidePanel.h"
+#include "render/LatencyStats.h"
+
+InputReplayer::InputReplayer(wxEvtHandler* owner, GLCanvas* canvas, SidePanel* side,
+                             const std::vector<InputEvent>& events)
+    : m_owner(owner), m_canvas(canvas), m_side(side), m_events(events), m_timer(this)
+{
+    Bind(wxEVT_TIMER, &InputReplayer::OnTimer, this);
+}
+
+InputReplayer::~InputReplayer()
+{
+    if (m_timer.IsRunning())
+        m_timer.Stop();
+}
+
+void InputReplayer::Start(int delayMs)
+{
+    m_next     = 0;
+    m_maxLagNs = 0;
+    m_sumLagNs = 0;
+    m_settling = false;
+
+    const std::int64_t now = LatencyStats::NowNs();
+    m_startNs = now + static_cast<std::int64_t>(delayMs) * 1000000;
+    arm(m_startNs, now);
+}
+
+double InputReplayer::MeanLagMs() const
+{
+    return m_next ? static_cast<double>(m_sumLagNs) * 1e-6 / static_cast<double>(m_next) : 0.0;
+}
+
+void InputReplayer::arm(std::int64_t deadlineNs, std::int64_t nowNs)
+{
+    // Round up: an early wake-up would only re-arm.
+    const std::int64_t ms = std::max<std::int64_t>(1, (deadlineNs - nowNs + 999999) / 1000000);
+    m_timer.Start(static_cast<int>(ms), wxTIMER_ONE_SHOT);
+}
+
+void InputReplayer::OnTimer(wxTimerEvent& /*evt*/)
+{
+    if (m_settling) {
+        wxCommandEvent done(wxEVT_WXGL_INPUT_REPLAY_DONE);
+        wxPostEvent(m_owner, done);
+        return;
+    }
+
+    std::int64_t now = LatencyStats::NowNs();
+    while (m_next < m_events.size() && m_startNs + m_events[m_next].t_ns <= now) {
+        const std::int64_t lag = now - (m_startNs + m_events[m_next].t_ns);
+        m_maxLagNs = std::max(m_maxLagNs, lag);
+        m_sumLagNs += lag;
+        inject(m_events[m_next++]);
+        // Handlers may take a while (synchronous sidebar relayout).
+        now = LatencyStats::NowNs();
+    }
+
+    if (m_next < m_events.size()) {
+        arm(m_startNs + m_events[m_next].t_ns, now);
+    } else {
+        m_settling = true;
+        m_timer.Start(kSettleDelayMs, wxTIMER_ONE_SHOT);
+    }
+}
+
+void InputReplayer::inject(const InputEvent& e)
+{
+    switch (e.kind) {
+    case InputEvent::Kind::Click:
+        if (m_canvas)
+            m_canvas->InjectClick(e.a, e.b);
+        break;
+    case InputEvent::Kind::Rotation:
+        if (m_side)
+            m_side->InjectRotation(e.a);
+        break;
+    case InputEvent::Kind::Visibility:
+        if (m_side)
+            m_side->InjectVisibility(e.a != 0);
+        break;
+    }
+}
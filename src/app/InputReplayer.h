@@ -0,0 +1,62 @@
+// src/app/InputReplayer.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <wx/event.h>
+#include <wx/timer.h>
+
+#include "InputLog.h"
+
+class GLCanvas;   // forward declaration
+class SidePanel;  // forward declaration
+
+/**
+ * InputReplayer
+ * Plays an InputLog back into a running MainFrame: clicks through
+ * GLCanvas::InjectClick, slider/checkbox changes through SidePanel::Inject*,
+ * so they take the same handler path as real input.
+ *
+ * Timing is deterministic: event i is due at start + t_i (absolute
+ * deadlines on the steady clock, like FrameScheduler), a one-shot wxTimer
+ * is re-armed for the next deadline and every event that is due fires in
+ * order. Timer lateness therefore never accumulates; it is reported as lag.
+ *
+ * After the last event and a settle time for the final frames,
+ * wxEVT_WXGL_INPUT_REPLAY_DONE is posted to the owner.
+ */
+class InputReplayer final : public wxEvtHandler
+{
+public:
+    static const int kStartDelayMs  = 1000;   // window shown, first frame presented
+    static const int kSettleDelayMs = 500;
+
+    InputReplayer(wxEvtHandler* owner, GLCanvas* canvas, SidePanel* side,
+                  const std::vector<InputEvent>& events);
+    ~InputReplayer() override;
+
+    void Start(int delayMs = kStartDelayMs);
+
+    std::size_t Injected() const { return m_next; }
+    double MaxLagMs()  const { return static_cast<double>(m_maxLagNs) * 1e-6; }
+    double MeanLagMs() const;
+
+private:
+    void OnTimer(wxTimerEvent& evt);
+    void inject(const InputEvent& e);
+    void arm(std::int64_t deadlineNs, std::int64_t nowNs);
+
+private:
+    wxEvtHandler* m_owner  {nullptr};   // not owned
+    GLCanvas*     m_canvas {nullptr};   // not owned
+    SidePanel*    m_side   {nullptr};   // not owned
+    std::vector<InputEvent> m_events;
+    wxTimer       m_timer;
+    std::size_t   m_next {0};
+    std::int64_t  m_startNs {0};
+    std::int64_t  m_maxLagNs {0};
+    std::int64_t  m_sumLagNs {0};
+    bool          m_settling {false};
+};
@@ -3,34 +3,99 @@
 #include "GLCanvas.h"
 #include "SidePanel.h"
 #include "Events.h"
+#include "InputLog.h"
+#include "InputReplayer.h"
 
+#include <wx/log.h>
 #include <wx/panel.h>
 #include <wx/stattext.h>
 #include <wx/wupdlock.h>
 
 // Define the custom event declared in Events.h once in the program.
 wxDEFINE_EVENT(wxEVT_WXGL_TOGGLE_SIDEBAR, wxCommandEvent);
+wxDEFINE_EVENT(wxEVT_WXGL_INPUT_REPLAY_DONE, wxCommandEvent);
 
-MainFrame::MainFrame(wxWindow* parent, wxWindowID id, const wxString& title)
+MainFrame::MainFrame(wxWindow* parent, wxWindowID id, const wxString& title,
+                     const AppOptions& options)
     : wxFrame(parent, id, title, wxDefaultPosition, wxDefaultSize,
-              wxDEFAULT_FRAME_STYLE | wxCLIP_CHILDREN)
+              wxDEFAULT_FRAME_STYLE | wxCLIP_CHILDREN),
+      m_options(options)
 {
     SetMinClientSize(wxSize(800, 480));
     BuildUi();
 
     // Bind to the custom event fired by GLCanvas when overlay button is clicked.
     Bind(wxEVT_WXGL_TOGGLE_SIDEBAR, &MainFrame::OnToggleSidebar, this);
+    Bind(wxEVT_WXGL_INPUT_REPLAY_DONE, &MainFrame::OnReplayDone, this);
+    Bind(wxEVT_CLOSE_WINDOW, &MainFrame::OnClose, this);
+
+    SetupInputSession();
 }
 
 MainFrame::~MainFrame() = default;
 
+void MainFrame::SetupInputSession()
+{
+    if (!m_options.record_input_path.empty()) {
+        m_inputLog.reset(new InputLog());
+        m_canvas->SetInputLog(m_inputLog.get());
+        m_side->SetInputLog(m_inputLog.get());
+    }
+
+    if (!m_options.replay_input_path.empty()) {
+        InputLog log;
+        if (!log.Load(m_options.replay_input_path)) {
+            wxLogError("Input replay: %s", log.LastError());
+            return;
+        }
+        // Starts counting now; the delay covers showing the window.
+        m_replayer.reset(new InputReplayer(this, m_canvas, m_side, log.Events()));
+        m_replayer->Start();
+    }
+}
+
+void MainFrame::OnReplayDone(wxCommandEvent& /*evt*/)
+{
+    const InputLatencyProbe::Distribution d = m_canvas->LatencyProbe().Summarize();
+    wxLogMessage("Input replay: %lu events (timer lag mean %.2f ms, max %.2f ms); "
+                 "input->present p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms (%lu samples)",
+                 static_cast<unsigned long>(m_replayer->Injected()),
+                 m_replayer->MeanLagMs(), m_replayer->MaxLagMs(),
+                 d.p50, d.p95, d.p99, d.max, static_cast<unsigned long>(d.count));
+    Close();
+}
+
+void MainFrame::OnClose(wxCloseEvent& evt)
+{
+    FinishInputSession();
+    evt.Skip();
+}
+
+void MainFrame::FinishInputSession()
+{
+    if (m_replayer)
+        m_replayer.reset();   // no more injected events while closing
+
+    if (m_inputLog) {
+        m_canvas->SetInputLog(nullptr);
+        m_side->SetInputLog(nullptr);
+        if (!m_inputLog->Save(m_options.record_input_path))
+            wxLogError("Cannot save input recording: %s", m_inputLog->LastError());
+        m_inputLog.reset();
+    }
+
+    if (!m_options.latency_report_path.empty() &&
+        !m_canvas->LatencyProbe().WriteJson(m_options.latency_report_path))
+        wxLogError("Cannot write latency report to %s", m_options.latency_report_path);
+}
+
 void MainFrame::BuildUi()
 {
     // Root horizontal layout: [ GLCanvas | SidePanel ]
     m_rootSizer = new wxBoxSizer(wxHORIZONTAL);
 
     // Left: OpenGL canvas (expands to fill)
-    m_canvas = new GLCanvas(this, wxID_ANY);
+    m_canvas = new GLCanvas(this, wxID_ANY, m_options);
     m_rootSizer->Add(m_canvas, 1, wxEXPAND);
 
     // Right: side panel (fixed width, native controls)
@@ -1,16 +1,23 @@
 // src/app/MainFrame.h
 #pragma once
 
+#include <memory>
+
 #include <wx/frame.h>
 #include <wx/sizer.h>
 
-class GLCanvas;   // forward declaration
-class SidePanel;  // forward declaration
+#include "AppOptions.h"
+
+class GLCanvas;       // forward declaration
+class SidePanel;      // forward declaration
+class InputLog;       // forward declaration
+class InputReplayer;  // forward declaration
 
 class MainFrame final : public wxFrame
 {
 public:
-    MainFrame(wxWindow* parent, wxWindowID id, const wxString& title);
+    MainFrame(wxWindow* parent, wxWindowID id, const wxString& title,
+              const AppOptions& options = AppOptions());
     ~MainFrame() override;
 
     void ToggleSidebar();
@@ -18,11 +25,19 @@ public:
 
 private:
     void OnToggleSidebar(wxCommandEvent& evt);
+    void OnReplayDone(wxCommandEvent& evt);
+    void OnClose(wxCloseEvent& evt);
     void BuildUi();
+    void SetupInputSession();   // --record-input / --replay-input
+    void FinishInputSession();  // save the recording, write the latency report
 
 private:
     wxBoxSizer* m_rootSizer {nullptr};
     GLCanvas*   m_canvas    {nullptr};
     SidePanel*  m_side      {nullptr};
     bool        m_sideVisible {true};
+    AppOptions  m_options;
+
+    std::unique_ptr<InputLog>      m_inputLog;   // recording
+    std::unique_ptr<InputReplayer> m_replayer;
 };
\ No newline at end of file
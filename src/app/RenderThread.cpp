@@ -0,0 +1,198 @@
+// src/app/RenderThread.cpp
+#include "RenderThread.h"
+
+#include <memory>
+
+#include "GLPlatform.h"
+#include "render/Profiler.h"
+#include "render/Renderer.h"
+
+RenderThread::RenderThread(const Hooks& hooks)
+    : m_hooks(hooks)
+{
+}
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+bool RenderThread::Start(const Frame& initial)
+{
+    if (IsRunning())
+        return true;
+    if (m_thread.joinable())
+        m_thread.join();   // a previous run that failed to initialize
+
+    m_stop.store(false);
+    m_running.store(true);
+    m_frames.Publish(initial);
+    m_appliedInvalidate = initial.invalidate;
+    m_appliedTick = initial.tick;
+    m_thread = std::thread(&RenderThread::run, this);
+    return m_thread.joinable();
+}
+
+void RenderThread::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    m_stop.store(true);
+    wake();
+    m_thread.join();
+}
+
+void RenderThread::Publish(const Frame& frame)
+{
+    m_frames.Publish(frame);
+    wake();
+}
+
+bool RenderThread::PostClick(int x_px, int y_px)
+{
+    Click c;
+    c.x = x_px;
+    c.y = y_px;
+    if (!m_clicks.TryPush(c))
+        return false;
+    wake();
+    return true;
+}
+
+bool RenderThread::PopPresent(Present& out)
+{
+    return m_presents.TryPop(out);
+}
+
+bool RenderThread::PopFrameTime(FrameTime& out)
+{
+    return m_frameTimes.TryPop(out);
+}
+
+LatencyStats::Summary RenderThread::InputLatency() const
+{
+    std::lock_guard<std::mutex> lock(m_latencyMutex);
+    return m_latency.Summarize();
+}
+
+void RenderThread::finishInput(bool presented)
+{
+    const Frame& frame = m_frames.Front();
+    if (frame.input_seq != m_reportedSeq) {
+        Present p;
+        p.seq   = frame.input_seq;
+        p.ns    = LatencyStats::NowNs();
+        p.shown = presented;
+        // A full ring is retried with the next frame.
+        if (m_presents.TryPush(p))
+            m_reportedSeq = frame.input_seq;
+    }
+
+    const std::int64_t input = frame.input_ns;
+    if (input == 0 || input == m_presentedInput.load(std::memory_order_relaxed))
+        return;
+
+    // Input that changed nothing visible is acknowledged without a sample.
+    if (presented) {
+        std::lock_guard<std::mutex> lock(m_latencyMutex);
+        m_latency.AddSince(input, LatencyStats::NowNs());
+    }
+    m_presentedInput.store(input, std::memory_order_release);
+}
+
+void RenderThread::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakePending = true;
+    }
+    m_wakeCv.notify_one();
+}
+
+void RenderThread::waitForWork()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wakeCv.wait(lock, [this] { return m_wakePending || m_stop.load(); });
+    m_wakePending = false;
+}
+
+void RenderThread::apply(Renderer& renderer, const Frame& frame)
+{
+    renderer.Resize(frame.width, frame.height, frame.dpi);
+    renderer.SetRotation(frame.state.rotation_deg);
+    renderer.SetScale(frame.state.scale);
+    renderer.SetObjectVisible(frame.state.object_visible);
+    renderer.SetInstanceCount(frame.state.instance_count);
+
+    if (frame.invalidate != m_appliedInvalidate) {
+        m_appliedInvalidate = frame.invalidate;
+        renderer.Invalidate();
+    }
+    if (frame.tick != m_appliedTick) {
+        m_appliedTick = frame.tick;
+        m_tickPending = true;
+    }
+}
+
+void RenderThread::run()
+{
+    if (m_hooks.makeCurrent)
+        m_hooks.makeCurrent();
+
+    std::unique_ptr<Renderer> renderer(new Renderer());
+    // Icons decoded on loader threads are uploaded by the next frame.
+    renderer->SetTextureReadyCallback([this] { wake(); });
+    bool ok = m_hooks.initialize ? m_hooks.initialize(*renderer) : renderer->Initialize();
+
+    // Setters only record state; the snapshot is applied before the first
+    // frame, so the order against initialization does not matter.
+    m_frames.Update();
+    if (ok)
+        apply(*renderer, m_frames.Front());
+
+    while (ok && !m_stop.load()) {
+        if (m_frames.Update())
+            apply(*renderer, m_frames.Front());
+
+        Click c;
+        while (m_clicks.TryPop(c)) {
+            if (renderer->HitTestOverlay(c.x, c.y, m_frames.Front().dpi) && m_hooks.overlayClicked)
+                m_hooks.overlayClicked();
+        }
+
+        const Frame& front = m_frames.Front();
+        if (!front.suspended && (renderer->NeedsRender() || (m_tickPending && front.every_tick))) {
+            FrameTime t;
+            t.start_ns = LatencyStats::NowNs();
+            renderer->SetBufferAge(wxgl::QueryBufferAge());
+            renderer->Render();
+            if (m_hooks.swapBuffers) {
+                WXGL_PROFILE_SCOPE("SwapBuffers");
+                m_hooks.swapBuffers();
+            }
+            WXGL_PROFILE_FRAME();
+            if (m_tickPending) {
+                t.end_ns = LatencyStats::NowNs();
+                m_frameTimes.TryPush(t);
+                m_tickPending = false;
+            }
+            finishInput(true);
+            // State published during the frame is picked up before sleeping.
+            continue;
+        }
+
+        m_tickPending = false;
+        finishInput(false);
+        waitForWork();
+    }
+
+    // GL resources go away on the thread that owns the context.
+    renderer.reset();
+    if (m_hooks.releaseCurrent)
+        m_hooks.releaseCurrent();
+
+    m_running.store(false);
+    if (!ok && m_hooks.initFailed)
+        m_hooks.initFailed();
+}
@@ -0,0 +1,155 @@
+// src/app/RenderThread.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "render/Handoff.h"
+#include "render/LatencyStats.h"
+#include "render/RenderState.h"
+
+class Renderer; // from src/render/Renderer.h
+
+/**
+ * RenderThread
+ * Runs a Renderer on a dedicated thread that owns the GL context, so frame
+ * cost never stalls the wx UI thread and UI layout never delays a frame.
+ * Used by GLCanvas in render-thread mode (--render-thread); no wx types here.
+ *
+ * UI thread -> render thread (lock-free):
+ * - Publish(Frame): RenderState fields, size/DPI and visibility as one
+ *   snapshot through a TripleBuffer; the render thread only ever applies the
+ *   newest one, so a burst of slider events costs at most one frame.
+ * - PostClick(x, y): clicks go through an SpscRing; hit testing runs on the
+ *   render thread and a hit is reported through Hooks::overlayClicked.
+ * Only the wake-up after publishing takes a short, uncontended mutex.
+ *
+ * Latency: Frame::input_ns carries the oldest UI input not yet presented;
+ * after the swap that shows it, the render thread records input -> present
+ * time and reports the timestamp back (PresentedInput) so the UI thread
+ * starts a new measurement with its next input. Frame::input_seq numbers
+ * every input (InputLatencyProbe); the first swap (or no-change frame) that
+ * includes a new sequence number is reported back through PopPresent().
+ *
+ * Frame budget: Frame::tick is bumped by every scheduler tick. The render
+ * thread times each frame it renders for a new tick (Render() through the
+ * swap) and reports it through PopFrameTime(), so the UI thread's
+ * FrameScheduler adapts the rate as it does in single-thread mode. A tick
+ * with nothing to show is dropped without a report, also as there.
+ *
+ * Context / lifecycle:
+ * - Start() spawns the thread, which makes the host's context current
+ *   (Hooks::makeCurrent), creates and initializes the Renderer, and renders
+ *   whenever Renderer::NeedsRender() says so. The UI thread must not issue
+ *   GL calls on that context while the thread runs.
+ * - If initialization fails the thread releases the context, clears
+ *   IsRunning() and reports it through Hooks::initFailed; Stop() joins it.
+ * - Resizes arrive with the snapshot; the viewport is updated right before
+ *   the next frame, never in the middle of one.
+ * - Stop() wakes and joins the thread. The Renderer is destroyed on the
+ *   render thread with the context current, then the context is released
+ *   (Hooks::releaseCurrent) so the host may destroy it.
+ */
+class RenderThread final
+{
+public:
+    // Everything the UI thread hands over; RenderState::version is ignored
+    // (the Renderer re-derives it from the setters).
+    struct Frame {
+        RenderState state;
+        int   width  {1};            // device pixels
+        int   height {1};
+        float dpi    {1.0f};
+        bool  suspended {false};     // minimized / hidden: render nothing
+        unsigned invalidate {0};     // bump to force a full redraw
+        std::int64_t input_ns {0};   // LatencyStats::NowNs() of the oldest
+                                     // input not yet presented, 0 = none
+        unsigned tick {0};           // bumped by every scheduler tick
+        bool  every_tick {false};    // present on each tick even if
+                                     // nothing changed (continuous mode)
+        std::uint32_t input_seq {0}; // newest input included, 0 = none
+    };
+
+    // A frame that included the inputs up to 'seq'.
+    struct Present {
+        std::uint32_t seq {0};
+        std::int64_t  ns  {0};       // LatencyStats::NowNs() after the swap
+        bool          shown {false}; // false: nothing visible changed
+    };
+
+    // Cost of a frame rendered for a scheduler tick.
+    struct FrameTime {
+        std::int64_t start_ns {0};   // LatencyStats::NowNs() before Render()
+        std::int64_t end_ns   {0};   // after the swap
+    };
+
+    // All hooks run on the render thread.
+    struct Hooks {
+        std::function<void()> makeCurrent;
+        std::function<void()> swapBuffers;
+        std::function<void()> releaseCurrent;
+        std::function<bool(Renderer&)> initialize;  // Renderer::Initialize + assets
+        std::function<void()> overlayClicked;       // marshal to the UI thread
+        std::function<void()> initFailed;           // marshal to the UI thread
+    };
+
+    explicit RenderThread(const Hooks& hooks);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    bool Start(const Frame& initial);
+    void Stop();
+    bool IsRunning() const { return m_running.load(); }
+
+    // UI thread only.
+    void Publish(const Frame& frame);
+    bool PostClick(int x_px, int y_px);   // false if the queue is full
+    bool PopPresent(Present& out);        // false if none pending
+    bool PopFrameTime(FrameTime& out);    // false if none pending
+
+    // Any thread.
+    std::int64_t PresentedInput() const { return m_presentedInput.load(std::memory_order_acquire); }
+    LatencyStats::Summary InputLatency() const;
+
+private:
+    struct Click {
+        int x {0};
+        int y {0};
+    };
+
+    void run();
+    void wake();
+    void waitForWork();
+    void apply(Renderer& renderer, const Frame& frame);
+    void finishInput(bool presented);
+
+private:
+    Hooks       m_hooks;
+    std::thread m_thread;
+
+    TripleBuffer<Frame>   m_frames;
+    SpscRing<Click, 64>   m_clicks;
+    unsigned              m_appliedInvalidate {0};   // render thread only
+    unsigned              m_appliedTick {0};
+    bool                  m_tickPending {false};
+
+    SpscRing<Present, 256>    m_presents;
+    SpscRing<FrameTime, 64>   m_frameTimes;          // full ring drops the sample
+    std::uint32_t             m_reportedSeq {0};     // render thread only
+
+    std::atomic<std::int64_t> m_presentedInput {0};
+    mutable std::mutex        m_latencyMutex;
+    LatencyStats              m_latency;
+
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    bool                    m_wakePending {false};
+    std::atomic<bool>       m_stop {false};
+    std::atomic<bool>       m_running {false};   // started and not yet exited
+};
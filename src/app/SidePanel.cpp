@@ -1,6 +1,7 @@
 // src/app/SidePanel.cpp
 #include "SidePanel.h"
 #include "GLCanvas.h"
+#include "InputLog.h"
 
 #include <wx/sizer.h>
 #include <wx/statline.h>
@@ -9,6 +10,9 @@ namespace {
     const int ROT_MIN  = 0;
     const int ROT_MAX  = 360;
     const int ROT_INIT = 0;
+
+    // Instance counts offered by the stress-scene selector (0 = off).
+    const int INSTANCE_COUNTS[] = { 0, 1000, 10000, 100000, 1000000 };
 }
 
 SidePanel::SidePanel(wxWindow* parent, GLCanvas* canvas)
@@ -21,6 +25,7 @@ SidePanel::SidePanel(wxWindow* parent, GLCanvas* canvas)
     // Event bindings
     m_rotation->Bind(wxEVT_SLIDER,  &SidePanel::OnRotationChanged,   this);
     m_visible->Bind(wxEVT_CHECKBOX, &SidePanel::OnVisibilityToggled, this);
+    m_instances->Bind(wxEVT_CHOICE, &SidePanel::OnInstancesChanged,  this);
 }
 
 void SidePanel::BuildUi()
@@ -50,50 +55,85 @@ void SidePanel::BuildUi()
 
     visBox->Add(m_visible, 0, wxALL, 6);
 
+    // --- Stress scene group ---
+    auto* instBox = new wxBoxSizer(wxVERTICAL);
+    wxArrayString choices;
+    choices.Add("Off (single triangle)");
+    choices.Add("1k instances");
+    choices.Add("10k instances");
+    choices.Add("100k instances");
+    choices.Add("1M instances");
+    m_instances = new wxChoice(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, choices);
+    m_instances->SetSelection(0);
+
+    instBox->Add(new wxStaticText(this, wxID_ANY, "Stress scene:"), 0, wxLEFT | wxRIGHT | wxTOP, 6);
+    instBox->Add(m_instances, 0, wxEXPAND | wxALL, 6);
+
     // Layout assembly
     root->Add(rotBox, 0, wxEXPAND | wxALL, 4);
     root->Add(sep,   0, wxEXPAND | wxLEFT | wxRIGHT, 4);
     root->Add(visBox,0, wxEXPAND | wxALL, 4);
+    root->Add(instBox,0, wxEXPAND | wxALL, 4);
     root->AddStretchSpacer(1);
 
     SetSizer(root);
     Layout();
 }
 
+void SidePanel::InjectRotation(int deg)
+{
+    m_rotation->SetValue(deg);
+    wxCommandEvent e(wxEVT_SLIDER, m_rotation->GetId());
+    e.SetEventObject(m_rotation);
+    e.SetInt(m_rotation->GetValue());   // clamped to the slider range
+    m_rotation->HandleWindowEvent(e);
+}
+
+void SidePanel::InjectVisibility(bool visible)
+{
+    m_visible->SetValue(visible);
+    wxCommandEvent e(wxEVT_CHECKBOX, m_visible->GetId());
+    e.SetEventObject(m_visible);
+    e.SetInt(visible ? 1 : 0);
+    m_visible->HandleWindowEvent(e);
+}
+
 void SidePanel::OnRotationChanged(wxCommandEvent& evt)
 {
     const int deg = evt.GetInt();
-    if (m_rotLabel) {
+    if (m_inputLog)
+        m_inputLog->Record(InputEvent::Kind::Rotation, deg);
+    // No forced Update() here: the label repaints with the next event-loop
+    // pass and the canvas coalesces all changes into its next frame.
+    if (m_rotLabel)
         m_rotLabel->SetLabel(wxString::Format(wxS("Rotation: %d°"), deg));
-        m_rotLabel->Refresh();
-        m_rotLabel->Update();
-    }
 
     if (m_canvas) {
         m_canvas->SetRotation(static_cast<float>(deg));
         m_canvas->RequestRedraw();
     }
-
-    this->Refresh();
-    this->Update();
 }
 
 void SidePanel::OnVisibilityToggled(wxCommandEvent& evt)
 {
     const bool visible = evt.IsChecked();
+    if (m_inputLog)
+        m_inputLog->Record(InputEvent::Kind::Visibility, visible ? 1 : 0);
     if (m_canvas) {
         m_canvas->SetObjectVisible(visible);
         m_canvas->RequestRedraw();
     }
-    if (m_visible) {
-        m_visible->SetValue(visible);
-        m_visible->Refresh();
-        m_visible->Update();
-    }
+}
 
-    this->Refresh();
-    this->Update();
-    if (wxWindow* top = wxGetTopLevelParent(this)) {
-        top->Update();
+void SidePanel::OnInstancesChanged(wxCommandEvent& evt)
+{
+    const int sel = evt.GetSelection();
+    const int n   = static_cast<int>(sizeof(INSTANCE_COUNTS) / sizeof(INSTANCE_COUNTS[0]));
+    if (sel < 0 || sel >= n)
+        return;
+
+    if (m_canvas) {
+        m_canvas->SetInstanceCount(INSTANCE_COUNTS[sel]);
+        m_canvas->RequestRedraw();
     }
 }
\ No newline at end of file
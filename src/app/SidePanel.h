@@ -4,17 +4,23 @@
 #include <wx/panel.h>
 #include <wx/slider.h>
 #include <wx/checkbox.h>
+#include <wx/choice.h>
 #include <wx/stattext.h>
 
 class GLCanvas; // forward declaration
+class InputLog; // forward declaration
 
 /**
  * SidePanel
  * Right-side native controls panel.
  * - wxSlider: controls rotation (degrees 0..360)
  * - wxCheckBox: toggles object visibility
+ * - wxChoice: instanced stress scene size (off / 1k / 10k / 100k / 1M)
  *
  * Communicates with the GL canvas via its public setter methods.
+ * Rotation and visibility changes can be recorded (SetInputLog) and replayed
+ * (Inject*): injected values move the control and go through the same
+ * event handlers as user input.
  */
 class SidePanel final : public wxPanel
 {
@@ -22,14 +28,21 @@ public:
     SidePanel(wxWindow* parent, GLCanvas* canvas);
     ~SidePanel() override = default;
 
+    void SetInputLog(InputLog* log) { m_inputLog = log; }   // not owned, nullptr = off
+    void InjectRotation(int deg);
+    void InjectVisibility(bool visible);
+
 private:
     void BuildUi();
     void OnRotationChanged(wxCommandEvent& evt);
     void OnVisibilityToggled(wxCommandEvent& evt);
+    void OnInstancesChanged(wxCommandEvent& evt);
 
 private:
     GLCanvas*     m_canvas   {nullptr};   // not owned
     wxSlider*     m_rotation {nullptr};
     wxCheckBox*   m_visible  {nullptr};
+    wxChoice*     m_instances {nullptr};
     wxStaticText* m_rotLabel {nullptr};
+    InputLog*     m_inputLog {nullptr};   // not owned
 };
\ No newline at end of file
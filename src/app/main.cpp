@@ -7,18 +7,189 @@
     #include <wx/wx.h>
 #endif
 #include <wx/image.h> // wxInitAllImageHandlers
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
 
+#include "AppOptions.h"
+#include "GLPlatform.h"
 #include "MainFrame.h"
+#include "render/GlTrace.h"
+#include "render/Profiler.h"
+
+namespace {
+const char* const kRenderThreadSwitch = "render-thread";
+const char* const kFrameModeOption    = "frame-mode";
+const char* const kFpsOption          = "fps";
+const char* const kVsyncOption        = "vsync";
+const char* const kSpinOption         = "spin";
+const char* const kProfileOption      = "profile";
+const char* const kTraceOption        = "trace";
+const char* const kTraceFramesOption  = "trace-frames";
+const char* const kRecordInputOption  = "record-input";
+const char* const kReplayInputOption  = "replay-input";
+const char* const kLatencyReportOption = "latency-report";
+const char* const kTextureCacheOption = "texture-cache";
+const char* const kProgramCacheOption = "program-cache";
+}
 
 class WxglApp final : public wxApp
 {
 public:
+    WxglApp();
+
+    bool Initialize(int& argc, wxChar** argv) override;
     bool OnInit() override;
     int  OnExit() override;
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+
+private:
+    AppOptions m_options;
 };
 
 wxIMPLEMENT_APP(WxglApp);
 
+WxglApp::WxglApp()
+{
+    // Set before the command line is parsed: the default cache folders live
+    // under wxStandardPaths' per-app directory.
+    SetAppName("wxgl_overlay_demo");
+    SetVendorName("wxgl");
+}
+
+bool WxglApp::Initialize(int& argc, wxChar** argv)
+{
+    // Xlib must be made thread-safe before wx opens the display, i.e. before
+    // the command line is parsed properly in OnInit(); peek at it here.
+    for (int i = 1; i < argc; ++i) {
+        if (wxString(argv[i]) == wxString("--") + kRenderThreadSwitch) {
+            if (!wxgl::PrepareThreadedGL())
+                wxLogWarning("XInitThreads failed; the render thread may be unstable.");
+            break;
+        }
+    }
+    return wxApp::Initialize(argc, argv);
+}
+
+void WxglApp::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    wxApp::OnInitCmdLine(parser);
+    parser.AddSwitch(wxEmptyString, kRenderThreadSwitch,
+                     "render on a dedicated thread that owns the GL context");
+    parser.AddOption(wxEmptyString, kFrameModeOption,
+                     "frame scheduling: continuous, on-demand (default) or animation");
+    parser.AddOption(wxEmptyString, kFpsOption,
+                     "target frame rate for continuous/animation mode (default 60)",
+                     wxCMD_LINE_VAL_DOUBLE);
+    parser.AddOption(wxEmptyString, kVsyncOption,
+                     "swap interval: on or off (default: driver setting)");
+    parser.AddOption(wxEmptyString, kSpinOption,
+                     "auto-rotation speed in degrees per second",
+                     wxCMD_LINE_VAL_DOUBLE);
+    parser.AddOption(wxEmptyString, kProfileOption,
+                     "record frame timings and write them to this .csv/.json file at exit");
+    parser.AddOption(wxEmptyString, kTraceOption,
+                     "record the GL calls of the first frames to this file (replay with wxgl_replay)");
+    parser.AddOption(wxEmptyString, kTraceFramesOption,
+                     "number of frames to record with --trace (default 300)",
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(wxEmptyString, kRecordInputOption,
+                     "record slider/checkbox/overlay-click input to this file at exit");
+    parser.AddOption(wxEmptyString, kReplayInputOption,
+                     "replay a recorded input file with its original timing, then quit");
+    parser.AddOption(wxEmptyString, kLatencyReportOption,
+                     "write per-input input->present latency percentiles to this .json file at exit");
+    parser.AddOption(wxEmptyString, kTextureCacheOption,
+                     "directory for cooked overlay icons, or 'off' (default: user data directory)");
+    parser.AddOption(wxEmptyString, kProgramCacheOption,
+                     "directory for linked shader program binaries, or 'off' (default: user data directory)");
+}
+
+bool WxglApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    m_options.render_thread = parser.Found(kRenderThreadSwitch);
+
+    wxString mode;
+    if (parser.Found(kFrameModeOption, &mode)) {
+        if (mode == "continuous") {
+            m_options.frame_mode = FrameScheduler::Mode::Continuous;
+        } else if (mode == "on-demand") {
+            m_options.frame_mode = FrameScheduler::Mode::OnDemand;
+        } else if (mode == "animation") {
+            m_options.frame_mode = FrameScheduler::Mode::AnimationOnly;
+        } else {
+            wxLogError("Unknown --%s value '%s'.", kFrameModeOption, mode);
+            return false;
+        }
+    }
+
+    double fps = 0.0;
+    if (parser.Found(kFpsOption, &fps))
+        m_options.target_fps = fps;
+
+    wxString vsync;
+    if (parser.Found(kVsyncOption, &vsync)) {
+        if (vsync == "on") {
+            m_options.swap_interval = 1;
+        } else if (vsync == "off") {
+            m_options.swap_interval = 0;
+        } else {
+            wxLogError("Unknown --%s value '%s'.", kVsyncOption, vsync);
+            return false;
+        }
+    }
+
+    double spin = 0.0;
+    if (parser.Found(kSpinOption, &spin))
+        m_options.spin_deg_per_sec = spin;
+
+    wxString profile;
+    if (parser.Found(kProfileOption, &profile))
+        m_options.profile_path = profile.ToStdString();
+
+    wxString trace;
+    if (parser.Found(kTraceOption, &trace))
+        m_options.trace_path = trace.ToStdString();
+
+    long traceFrames = 0;
+    if (parser.Found(kTraceFramesOption, &traceFrames)) {
+        if (traceFrames <= 0) {
+            wxLogError("--%s must be positive.", kTraceFramesOption);
+            return false;
+        }
+        m_options.trace_frames = static_cast<int>(traceFrames);
+    }
+
+    wxString input;
+    if (parser.Found(kRecordInputOption, &input))
+        m_options.record_input_path = input.ToStdString();
+    if (parser.Found(kReplayInputOption, &input))
+        m_options.replay_input_path = input.ToStdString();
+    if (parser.Found(kLatencyReportOption, &input))
+        m_options.latency_report_path = input.ToStdString();
+
+    const auto cacheDir = [&parser](const char* option, std::string& out) {
+        wxString cache;
+        if (!parser.Found(option, &cache)) {
+            wxFileName dir(wxStandardPaths::Get().GetUserLocalDataDir(), wxEmptyString);
+            dir.AppendDir(option);   // folder named like the option
+            cache = dir.GetPath();
+        }
+        if (cache != "off")
+            out = cache.ToStdString();
+    };
+    cacheDir(kTextureCacheOption, m_options.texture_cache_dir);
+    cacheDir(kProgramCacheOption, m_options.program_cache_dir);
+
+    if (!m_options.record_input_path.empty() && !m_options.replay_input_path.empty()) {
+        wxLogError("--%s and --%s cannot be combined.", kRecordInputOption, kReplayInputOption);
+        return false;
+    }
+
+    return wxApp::OnCmdLineParsed(parser);
+}
+
 bool WxglApp::OnInit()
 {
     if (!wxApp::OnInit())
@@ -27,14 +198,23 @@ bool WxglApp::OnInit()
     // Enable common image handlers (PNG, etc.) for any wx-side assets if used later.
     wxInitAllImageHandlers();
 
-    SetAppName("wxgl_overlay_demo");
-    SetVendorName("wxgl");
+#if WXGL_ENABLE_PROFILING
+    if (!m_options.profile_path.empty())
+        Profiler::SetEnabled(true);
+#else
+    if (!m_options.profile_path.empty())
+        wxLogWarning("Built without WXGL_ENABLE_PROFILING; --%s records nothing.", kProfileOption);
+#endif
+
+    // Armed before the canvas exists: Renderer::Initialize() attaches it.
+    if (!m_options.trace_path.empty() && !GlTrace::Start(m_options.trace_path, m_options.trace_frames))
+        wxLogWarning("GL trace disabled: %s", GlTrace::LastError());
 
     try
     {
         // Construct and show the main frame.
         // MainFrame is responsible for creating the GL canvas and side panel.
-        MainFrame* frame = new MainFrame(nullptr, wxID_ANY, "wxGL Overlay Demo");
+        MainFrame* frame = new MainFrame(nullptr, wxID_ANY, "wxGL Overlay Demo", m_options);
         frame->SetClientSize(1024, 640);
         frame->CentreOnScreen();
         frame->Show(true);
@@ -56,6 +236,18 @@ bool WxglApp::OnInit()
 
 int WxglApp::OnExit()
 {
-    // Place for any global teardown if needed later.
+    // The canvas (and any render thread) is gone: all samples are final.
+    if (!m_options.profile_path.empty() && !Profiler::Instance().Export(m_options.profile_path))
+        wxLogError("Cannot write frame timings to %s", m_options.profile_path);
+
+    if (!m_options.trace_path.empty()) {
+        const GlTrace::Stats t = GlTrace::Stop();
+        if (!GlTrace::LastError().empty())
+            wxLogError("GL trace %s: %s", m_options.trace_path, GlTrace::LastError());
+        else
+            wxLogVerbose("GL trace: %d frames, %llu calls written to %s", t.frames,
+                         static_cast<unsigned long long>(t.calls), m_options.trace_path);
+    }
+
     return wxApp::OnExit();
 }
\ No newline at end of file
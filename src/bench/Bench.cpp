@@ -0,0 +1,121 @@
+// src/bench/Bench.cpp
+#include "Bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "render/Util.h"
+
+namespace {
+// Value at a 1-based rank of sorted data, clamped to [1, n].
+double AtRank(const std::vector<double>& sorted, long rank)
+{
+    const long n = static_cast<long>(sorted.size());
+    rank = std::max(1L, std::min(rank, n));
+    return sorted[static_cast<std::size_t>(rank - 1)];
+}
+} // namespace
+
+std::int64_t Bench::NowNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Bench::SetInfo(const std::string& key, const std::string& value)
+{
+    for (auto& kv : m_info) {
+        if (kv.first == key) {
+            kv.second = value;
+            return;
+        }
+    }
+    m_info.emplace_back(key, value);
+}
+
+bool Bench::Selected(const std::string& name) const
+{
+    return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+bool Bench::Run(const std::string& name, int batch, const Body& body,
+                const Hook& afterSample, const Hook& beforeSample)
+{
+    if (!Selected(name))
+        return false;
+
+    Result r;
+    r.name  = name;
+    r.batch = std::max(1, batch);
+
+    const int total = std::max(0, m_options.warmup) + std::max(1, m_options.samples);
+    for (int s = 0; s < total; ++s) {
+        if (beforeSample)
+            beforeSample();
+        const std::int64_t start = NowNs();
+        for (int i = 0; i < r.batch; ++i)
+            body(i);
+        if (afterSample)
+            afterSample();
+        const std::int64_t end = NowNs();
+        if (s >= m_options.warmup)
+            r.samples_ns.push_back(static_cast<double>(end - start) / r.batch);
+    }
+
+    std::vector<double> sorted(r.samples_ns);
+    std::sort(sorted.begin(), sorted.end());
+    const long n = static_cast<long>(sorted.size());
+    r.median_ns = Util::Percentile(sorted, 0.5);
+    const double half = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+    r.ci_low_ns  = AtRank(sorted, static_cast<long>(std::floor(n / 2.0 - half)));
+    r.ci_high_ns = AtRank(sorted, static_cast<long>(std::ceil(n / 2.0 + half)) + 1);
+    r.min_ns     = sorted.front();
+    double sum = 0.0;
+    for (double v : sorted)
+        sum += v;
+    r.mean_ns = sum / static_cast<double>(n);
+
+    m_results.push_back(r);
+    std::printf("  %-34s %12.1f ns  [%.1f, %.1f]\n", r.name.c_str(), r.median_ns, r.ci_low_ns, r.ci_high_ns);
+    std::fflush(stdout);
+    return true;
+}
+
+void Bench::PrintTable() const
+{
+    std::printf("\n%-36s %14s %14s %14s %14s\n", "case", "median", "ci95 low", "ci95 high", "min");
+    for (const Result& r : m_results) {
+        std::printf("%-36s %11.3f us %11.3f us %11.3f us %11.3f us\n", r.name.c_str(),
+                    r.median_ns * 1e-3, r.ci_low_ns * 1e-3, r.ci_high_ns * 1e-3, r.min_ns * 1e-3);
+    }
+}
+
+bool Bench::WriteJson(const std::string& path) const
+{
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"warmup\": %d,\n  \"samples\": %d,\n  \"info\": {",
+                 m_options.warmup, m_options.samples);
+    for (std::size_t i = 0; i < m_info.size(); ++i) {
+        std::fprintf(f, "%s\n    \"%s\": \"%s\"", i ? "," : "",
+                     Util::JsonEscape(m_info[i].first).c_str(), Util::JsonEscape(m_info[i].second).c_str());
+    }
+    std::fprintf(f, "\n  },\n  \"results\": [");
+    for (std::size_t i = 0; i < m_results.size(); ++i) {
+        const Result& r = m_results[i];
+        std::fprintf(f, "%s\n    {\"name\": \"%s\", \"batch\": %d, \"median_ns\": %.1f, "
+                        "\"ci_low_ns\": %.1f, \"ci_high_ns\": %.1f, \"min_ns\": %.1f, \"mean_ns\": %.1f, "
+                        "\"samples_ns\": [",
+                     i ? "," : "", Util::JsonEscape(r.name).c_str(), r.batch, r.median_ns,
+                     r.ci_low_ns, r.ci_high_ns, r.min_ns, r.mean_ns);
+        for (std::size_t k = 0; k < r.samples_ns.size(); ++k)
+            std::fprintf(f, "%s%.1f", k ? ", " : "", r.samples_ns[k]);
+        std::fprintf(f, "]}");
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
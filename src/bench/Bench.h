@@ -0,0 +1,74 @@
+// src/bench/Bench.h
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Bench
+ * Minimal benchmark runner for wxgl_bench (no external framework).
+ *
+ * Each case runs 'warmup' discarded samples, then 'samples' measured ones.
+ * A sample times 'batch' calls of the body, so cheap operations rise well
+ * above timer resolution; results are reported per call.
+ *
+ * Reported per case (nanoseconds per call):
+ * - median (nearest rank, Util::Percentile) with a distribution-free 95%
+ *   confidence interval (order statistics around n/2 +- 1.96*sqrt(n)/2),
+ *   min, mean;
+ * - the raw per-sample values, so runs can be re-analysed offline.
+ *
+ * WriteJson() emits one document per run; compare two runs with any JSON
+ * tooling, e.g. by case name and median_ns / ci bounds.
+ */
+class Bench
+{
+public:
+    struct Options {
+        int warmup  {3};
+        int samples {21};
+        std::string filter;   // substring of case names to run; empty = all
+    };
+
+    struct Result {
+        std::string name;
+        int    batch {1};
+        double median_ns  {0.0};
+        double ci_low_ns  {0.0};
+        double ci_high_ns {0.0};
+        double min_ns     {0.0};
+        double mean_ns    {0.0};
+        std::vector<double> samples_ns;   // per call, measurement order
+    };
+
+    // Body receives the call index within the sample (0..batch-1).
+    using Body = std::function<void(int)>;
+    // Optional hooks around each sample (not timed), e.g. glFinish.
+    using Hook = std::function<void()>;
+
+    explicit Bench(const Options& options) : m_options(options) {}
+
+    // False when the filter excludes 'name'; check before costly case setup.
+    bool Selected(const std::string& name) const;
+
+    // Runs the case unless filtered out; returns false when skipped.
+    bool Run(const std::string& name, int batch, const Body& body,
+             const Hook& afterSample = Hook(), const Hook& beforeSample = Hook());
+
+    // Free-form run information written into the JSON header.
+    void SetInfo(const std::string& key, const std::string& value);
+
+    const std::vector<Result>& Results() const { return m_results; }
+
+    bool WriteJson(const std::string& path) const;
+    void PrintTable() const;
+
+    static std::int64_t NowNs();
+
+private:
+    Options m_options;
+    std::vector<std::pair<std::string, std::string>> m_info;
+    std::vector<Result> m_results;
+};
@@ -0,0 +1,923 @@
+// src/bench/main.cpp
+// wxgl_bench: repeatable micro- and macrobenchmarks of the render and
+// resource paths, run headless (EGL + offscreen FBO, e.g. Mesa llvmpipe).
+//
+//   wxgl_bench [--json=out.json] [--filter=substr] [--samples=N] [--warmup=N]
+//              [--sizes=640x360,1920x1080] [--label=text]
+//
+// Case names are stable ("render/1280x720", "shader/compile", ...) so JSON
+// files from different commits can be compared case by case. Streaming cases
+// also print their sustained upload rate in MB/s.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "Bench.h"
+#include "headless/HeadlessContext.h"
+#include "render/GlCaps.h"
+#include "render/GlState.h"
+#include "render/Mesh.h"
+#include "render/MeshOptimizer.h"
+#include "render/OffscreenTarget.h"
+#include "render/Renderer.h"
+#include "render/ProgramCache.h"
+#include "render/Shader.h"
+#include "render/ShaderBatch.h"
+#include "render/StreamingTexture.h"
+#include "render/Texture.h"
+#include "render/TextureCache.h"
+#include "render/UIOverlay.h"
+#include "render/VertexPack.h"
+
+#include "glad/glad.h"
+
+namespace {
+struct Size {
+    int w;
+    int h;
+};
+
+struct Options {
+    Bench::Options bench;
+    std::string json;
+    std::string label;
+    std::vector<Size> sizes { {640, 360}, {1280, 720}, {1920, 1080}, {3840, 2160} };
+};
+
+bool Value(const char* arg, const char* name, const char*& value)
+{
+    const std::size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=')
+        return false;
+    value = arg + n + 1;
+    return true;
+}
+
+bool ParseSizes(const char* v, std::vector<Size>& out)
+{
+    out.clear();
+    while (*v) {
+        Size s {0, 0};
+        int used = 0;
+        if (std::sscanf(v, "%dx%d%n", &s.w, &s.h, &used) != 2 || s.w <= 0 || s.h <= 0)
+            return false;
+        out.push_back(s);
+        v += used;
+        if (*v == ',')
+            ++v;
+    }
+    return !out.empty();
+}
+
+bool ParseArgs(int argc, char** argv, Options& o)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* v = nullptr;
+        if (Value(argv[i], "--json", v)) {
+            o.json = v;
+        } else if (Value(argv[i], "--filter", v)) {
+            o.bench.filter = v;
+        } else if (Value(argv[i], "--samples", v)) {
+            o.bench.samples = std::atoi(v);
+        } else if (Value(argv[i], "--warmup", v)) {
+            o.bench.warmup = std::atoi(v);
+        } else if (Value(argv[i], "--sizes", v)) {
+            if (!ParseSizes(v, o.sizes))
+                return false;
+        } else if (Value(argv[i], "--label", v)) {
+            o.label = v;
+        } else {
+            return false;
+        }
+    }
+    return o.bench.samples > 0 && o.bench.warmup >= 0;
+}
+
+std::string ResourceDir()
+{
+#ifdef APP_RESOURCE_DIR
+    return APP_RESOURCE_DIR;
+#else
+    return "resources";
+#endif
+}
+
+std::string GlString(unsigned name)
+{
+    const char* s = reinterpret_cast<const char*>(glGetString(name));
+    return s ? s : "?";
+}
+
+bool AnySelected(const Bench& bench, std::initializer_list<std::string> names)
+{
+    for (const std::string& name : names) {
+        if (bench.Selected(name))
+            return true;
+    }
+    return false;
+}
+
+// Scratch directory under $TMPDIR (or /tmp) for cache cases; removed with
+// its files on destruction, so runs leave nothing behind.
+class TempDir
+{
+public:
+    explicit TempDir(const char* prefix)
+    {
+        const char* base = std::getenv("TMPDIR");
+        const std::string pattern = std::string(base && *base ? base : "/tmp") + "/" + prefix + ".XXXXXX";
+        std::vector<char> path(pattern.begin(), pattern.end());
+        path.push_back('\0');
+        if (::mkdtemp(path.data()))
+            m_path = path.data();
+    }
+
+    ~TempDir()
+    {
+        if (m_path.empty())
+            return;
+        if (DIR* dir = ::opendir(m_path.c_str())) {
+            while (const dirent* e = ::readdir(dir)) {
+                const std::string name = e->d_name;
+                if (name != "." && name != "..")
+                    std::remove((m_path + "/" + name).c_str());
+            }
+            ::closedir(dir);
+        }
+        ::rmdir(m_path.c_str());
+    }
+
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    const std::string& Path() const { return m_path; }   // empty: not created
+
+private:
+    std::string m_path;
+};
+
+// Same shape as the instanced scene shader: non-trivial but GLSL 1.20.
+const char* const kBenchVS =
+    "attribute vec2 aPos;\n"
+    "attribute vec3 aColor;\n"
+    "attribute vec2 aOffset;\n"
+    "attribute vec2 aRotScale;\n"
+    "attribute vec4 aInstColor;\n"
+    "uniform mat4 uMVP;\n"
+    "varying vec3 vColor;\n"
+    "void main() {\n"
+    "  float c = cos(aRotScale.x) * aRotScale.y;\n"
+    "  float s = sin(aRotScale.x) * aRotScale.y;\n"
+    "  vec2 p = vec2(c * aPos.x - s * aPos.y, s * aPos.x + c * aPos.y) + aOffset;\n"
+    "  vColor = aColor * aInstColor.rgb;\n"
+    "  gl_Position = uMVP * vec4(p, 0.0, 1.0);\n"
+    "}\n";
+
+const char* const kBenchFS =
+    "varying vec3 vColor;\n"
+    "uniform sampler2D uTex;\n"
+    "void main() {\n"
+    "  gl_FragColor = vec4(vColor, 1.0) * texture2D(uTex, vColor.xy);\n"
+    "}\n";
+
+// Full-frame renders at each canvas size; every frame is a full redraw.
+void BenchRender(Bench& bench, const Options& opt, int instances)
+{
+    for (const Size& size : opt.sizes) {
+        char name[64];
+        std::snprintf(name, sizeof(name), instances ? "render/%dx%d/instances=%d" : "render/%dx%d",
+                      size.w, size.h, instances);
+        if (!bench.Selected(name))
+            continue;
+
+        Renderer renderer;
+        OffscreenTarget target;
+        if (!renderer.Initialize() || !target.Create(size.w, size.h)) {
+            std::fprintf(stderr, "  %s: skipped (renderer or framebuffer unavailable)\n", name);
+            continue;
+        }
+        target.Bind();
+        (void)renderer.LoadOverlayIcon(ResourceDir() + "/icons/toggle.png");
+        renderer.Resize(size.w, size.h, 1.0f);
+        renderer.SetInstanceCount(instances);
+
+        int frame = 0;
+        bench.Run(name, 1,
+                  [&](int) {
+                      renderer.SetRotation(static_cast<float>(frame++ % 360));
+                      renderer.Invalidate();
+                      renderer.Render();
+                      glFinish();
+                  });
+    }
+}
+
+void BenchResources(Bench& bench)
+{
+    // Objects below are created outside Renderer: give them a fresh cache.
+    GlState state;
+    GlState::MakeCurrent(&state);
+
+    // Each compile gets unique source text so no driver cache can serve it.
+    int serial = 0;
+    std::string vs, fs;
+    bench.Run("shader/compile", 1,
+              [&](int) {
+                  const std::string tag = "#version 120\n// bench " + std::to_string(serial++) + "\n";
+                  vs = tag + kBenchVS;
+                  fs = tag + kBenchFS;
+                  Shader shader;
+                  if (!shader.CompileFromSource(vs.c_str(), fs.c_str(), "bench"))
+                      std::fprintf(stderr, "%s", shader.LastLog().c_str());
+              });
+
+    // Startup-sized sets of distinct programs: one after another vs. all
+    // submitted before the first status query (ShaderBatch, incl. fallback).
+    const int kPrograms = 8;
+    std::vector<std::string> setVs(kPrograms), setFs(kPrograms);
+    const auto uniqueSet = [&] {
+        for (int p = 0; p < kPrograms; ++p) {
+            const std::string tag = "#version 120\n// bench " + std::to_string(serial++) + "\n";
+            setVs[p] = tag + kBenchVS;
+            setFs[p] = tag + kBenchFS;
+        }
+    };
+    bench.Run("shader/compile_serial/8", 1,
+              [&](int) {
+                  uniqueSet();
+                  Shader shaders[kPrograms];
+                  for (int p = 0; p < kPrograms; ++p)
+                      (void)shaders[p].CompileFromSource(setVs[p].c_str(), setFs[p].c_str(), "bench");
+              });
+    bench.Run("shader/compile_batch/8", 1,
+              [&](int) {
+                  uniqueSet();
+                  Shader shaders[kPrograms];
+                  ShaderBatch batch;
+                  (void)batch.Begin();
+                  for (int p = 0; p < kPrograms; ++p) {
+                      if (shaders[p].Submit(setVs[p].c_str(), setFs[p].c_str(), "bench"))
+                          batch.Add(&shaders[p]);
+                  }
+                  batch.Finish();
+              });
+
+    // The same program loaded as a driver binary (one store up front).
+    if (bench.Selected("shader/load_binary")) {
+        const TempDir programDir("wxgl_bench_program_cache");
+        ProgramCache programs(programDir.Path());
+        if (programDir.Path().empty()) {
+            std::fprintf(stderr, "  shader/load_binary: skipped (no temporary directory)\n");
+        } else if (programs.Supported()) {
+            // Own sources: shader/compile may have been filtered out.
+            const std::string tag = "#version 120\n// bench " + std::to_string(serial++) + "\n";
+            vs = tag + kBenchVS;
+            fs = tag + kBenchFS;
+            ProgramCache::MakeCurrent(&programs);
+            {
+                Shader warm;
+                (void)warm.CompileFromSource(vs.c_str(), fs.c_str(), "bench");
+            }
+            bench.Run("shader/load_binary", 1,
+                      [&](int) {
+                          Shader shader;
+                          if (!shader.CompileFromSource(vs.c_str(), fs.c_str(), "bench"))
+                              std::fprintf(stderr, "%s", shader.LastLog().c_str());
+                      });
+            ProgramCache::MakeCurrent(nullptr);
+        } else {
+            std::fprintf(stderr, "  shader/load_binary: skipped (no program binary support)\n");
+        }
+    }
+
+    const std::string png = ResourceDir() + "/icons/toggle.png";
+    bench.Run("texture/load_png", 16,
+              [&](int) {
+                  Texture tex;
+                  (void)tex.LoadFromFile(png, true);
+              },
+              [] { glFinish(); });
+
+    // One Cook() up front makes every sample a hit.
+    if (AnySelected(bench, { "texture/load_cooked", "texture/load_cooked/rgba4+mips",
+                             "texture/decode_png", "texture/decode_cooked" })) {
+        const TempDir cacheDir("wxgl_bench_texture_cache");
+        TextureCache cache(cacheDir.Path());
+        const TextureCache::Options cooked;
+        TextureCache::Options compact;
+        compact.format = TextureCache::Format::RGBA4;
+        compact.mips   = true;
+        if (!cacheDir.Path().empty() && cache.Cook(png, true, cooked) && cache.Cook(png, true, compact)) {
+            bench.Run("texture/load_cooked", 16,
+                      [&](int) {
+                          Texture tex;
+                          (void)cache.LoadTexture(png, true, cooked, tex);
+                      },
+                      [] { glFinish(); });
+            bench.Run("texture/load_cooked/rgba4+mips", 16,
+                      [&](int) {
+                          Texture tex;
+                          (void)cache.LoadTexture(png, true, compact, tex);
+                      },
+                      [] { glFinish(); });
+
+            // CPU side of the icon path (AsyncTextureLoader workers, atlas).
+            std::vector<unsigned char> rgba;
+            int w = 0, h = 0;
+            bench.Run("texture/decode_png", 16,
+                      [&](int) { (void)Texture::DecodeFile(png, true, rgba, w, h); });
+            bench.Run("texture/decode_cooked", 16,
+                      [&](int) {
+                          TextureCache::Pixels pixels;
+                          (void)cache.MapPixels(png, true, pixels);
+                      });
+        } else {
+            std::fprintf(stderr, "  texture/load_cooked: skipped (cannot cook %s)\n", png.c_str());
+        }
+    }
+
+    // Mesh creation and streaming updates at a few buffer sizes.
+    const Mesh::Attrib aPos { 0, 2, GL_FLOAT, GL_FALSE, 8, 0 };
+    for (std::size_t bytes : { std::size_t(64), std::size_t(64) << 10, std::size_t(4) << 20 }) {
+        const std::string suffix = "/" + std::to_string(bytes) + "B";
+        if (!AnySelected(bench, { "mesh/create" + suffix, "mesh/update" + suffix }))
+            continue;
+        std::vector<unsigned char> data(bytes, 0x5A);
+        const int batch = bytes >= (std::size_t(1) << 20) ? 4 : 64;
+
+        bench.Run("mesh/create" + suffix, batch,
+                  [&](int) {
+                      Mesh m;
+                      (void)m.Create(data.data(), data.size(), { aPos }, GL_STATIC_DRAW);
+                  },
+                  [] { glFinish(); });
+
+        if (!bench.Selected("mesh/update" + suffix))
+            continue;
+        Mesh mesh;
+        (void)mesh.Create(data.data(), data.size(), { aPos }, GL_DYNAMIC_DRAW);
+        bench.Run("mesh/update" + suffix, batch,
+                  [&](int i) {
+                      data[0] = static_cast<unsigned char>(i);
+                      (void)mesh.UpdateBuffer(data.data(), data.size(), GL_DYNAMIC_DRAW);
+                  },
+                  [] { glFinish(); });
+    }
+
+    GlState::MakeCurrent(nullptr);
+}
+
+// Imported-mesh stand-in: a 256x256-quad grid (131072 triangles) with
+// position/normal/UV vertices, as a shuffled triangle soup. Drawn as the soup
+// (glDrawArrays), welded + indexed in the shuffled order, and indexed in
+// vertex-cache order, into a small target so vertex work dominates.
+const char* const kMeshVS =
+    "#version 120\n"
+    "attribute vec3 aPos;\n"
+    "attribute vec3 aNormal;\n"
+    "attribute vec2 aUV;\n"
+    "uniform mat4 uMVP;\n"
+    "varying vec3 vColor;\n"
+    "void main() {\n"
+    "  float d = max(dot(normalize(aNormal), normalize(vec3(0.3, 0.5, 1.0))), 0.0);\n"
+    "  vColor = vec3(aUV, 0.5) * (0.2 + 0.8 * d);\n"
+    "  gl_Position = uMVP * vec4(aPos * 2.0 - 1.0, 1.0);\n"
+    "}\n";
+
+const char* const kMeshFS =
+    "#version 120\n"
+    "varying vec3 vColor;\n"
+    "void main() {\n"
+    "  gl_FragColor = vec4(vColor, 1.0);\n"
+    "}\n";
+
+struct MeshVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    float u, v;
+};
+
+std::vector<MeshVertex> GridSoup(int quads)
+{
+    const auto vertex = [quads](int i, int j) {
+        const float s = static_cast<float>(i) / static_cast<float>(quads);
+        const float t = static_cast<float>(j) / static_cast<float>(quads);
+        // Gentle bumps so normals differ per vertex.
+        const float nx = 0.2f * std::sin(s * 12.0f), ny = 0.2f * std::cos(t * 9.0f);
+        return MeshVertex{ s, t, 0.0f, nx, ny, 1.0f, s, t };
+    };
+    std::vector<std::array<MeshVertex, 3>> tris;
+    tris.reserve(static_cast<std::size_t>(quads) * quads * 2);
+    for (int j = 0; j < quads; ++j) {
+        for (int i = 0; i < quads; ++i) {
+            tris.push_back({ { vertex(i, j), vertex(i + 1, j),     vertex(i + 1, j + 1) } });
+            tris.push_back({ { vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1) } });
+        }
+    }
+    std::mt19937 rng(0x5EED);   // fixed: runs stay comparable
+    std::shuffle(tris.begin(), tris.end(), rng);
+
+    std::vector<MeshVertex> soup;
+    soup.reserve(tris.size() * 3);
+    for (const auto& t : tris)
+        soup.insert(soup.end(), t.begin(), t.end());
+    return soup;
+}
+
+void BenchMesh(Bench& bench)
+{
+    const int kQuads = 256;
+    const std::string tris = "/" + std::to_string(kQuads * kQuads * 2) + "tris";
+    const char* const kDrawCases[] = { "mesh/draw/soup", "mesh/draw/indexed", "mesh/draw/indexed+cache" };
+    const bool draws = AnySelected(bench, { kDrawCases[0], kDrawCases[1], kDrawCases[2] });
+    if (!draws && !AnySelected(bench, { "mesh/weld" + tris, "mesh/optimize_cache" + tris }))
+        return;
+
+    GlState state;
+    GlState::MakeCurrent(&state);
+
+    const std::vector<MeshVertex> soup = GridSoup(kQuads);
+    const std::size_t stride = sizeof(MeshVertex);
+
+    // Built once up front: the draw cases need them even when filtered alone.
+    std::vector<unsigned char> welded;
+    std::vector<std::uint32_t> shuffled;
+    const std::size_t unique = MeshOptimizer::Weld(soup.data(), soup.size(), stride, nullptr, 0,
+                                                   welded, shuffled);
+    std::vector<std::uint32_t> ordered = shuffled;
+    (void)MeshOptimizer::OptimizeVertexCache(ordered.data(), ordered.size(), unique);
+    std::vector<unsigned char> fetched = welded;
+    (void)MeshOptimizer::OptimizeVertexFetch(fetched.data(), unique, stride, ordered.data(), ordered.size());
+
+    std::vector<unsigned char> scratchVertices;
+    std::vector<std::uint32_t> scratchIndices;
+    bench.Run("mesh/weld" + tris, 1,
+              [&](int) { (void)MeshOptimizer::Weld(soup.data(), soup.size(), stride, nullptr, 0,
+                                                   scratchVertices, scratchIndices); });
+    bench.Run("mesh/optimize_cache" + tris, 1,
+              [&](int) {
+                  scratchIndices = shuffled;
+                  (void)MeshOptimizer::OptimizeVertexCache(scratchIndices.data(), scratchIndices.size(), unique);
+              });
+    if (!draws) {
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+
+    OffscreenTarget target;
+    Shader shader;
+    shader.BindAttrib("aPos", 0);
+    shader.BindAttrib("aNormal", 1);
+    shader.BindAttrib("aUV", 2);
+    if (!target.Create(256, 256) || !shader.CompileFromSource(kMeshVS, kMeshFS, "bench-mesh")) {
+        std::fprintf(stderr, "  mesh/draw: skipped (framebuffer or program unavailable)\n");
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+    target.Bind();
+    state.Viewport(0, 0, 256, 256);
+    shader.Use();
+    const float identity[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+    (void)shader.SetMat4(shader.FindUniform("uMVP"), identity);
+
+    const Mesh::Attrib aPos    { 0, 3, GL_FLOAT, GL_FALSE, static_cast<int>(stride), offsetof(MeshVertex, x) };
+    const Mesh::Attrib aNormal { 1, 3, GL_FLOAT, GL_FALSE, static_cast<int>(stride), offsetof(MeshVertex, nx) };
+    const Mesh::Attrib aUV     { 2, 2, GL_FLOAT, GL_FALSE, static_cast<int>(stride), offsetof(MeshVertex, u) };
+
+    struct Variant {
+        const char* name;
+        const void* vertices;
+        std::size_t vertex_count;
+        const std::vector<std::uint32_t>* indices;   // nullptr: soup
+    };
+    const Variant variants[] = {
+        { kDrawCases[0], soup.data(),    soup.size(), nullptr },
+        { kDrawCases[1], welded.data(),  unique,      &shuffled },
+        { kDrawCases[2], fetched.data(), unique,      &ordered },
+    };
+
+    // Measured VS invocations where the driver has ARB_pipeline_statistics_query.
+    const bool stats = GlCaps::HasExtension("GL_ARB_pipeline_statistics_query") &&
+                       glGenQueries && glGetQueryObjectui64v;
+    std::vector<unsigned char> reference, pixels;
+    const char* referenceName = nullptr;
+
+    for (const Variant& v : variants) {
+        if (!bench.Selected(v.name))
+            continue;
+        Mesh mesh;
+        if (!mesh.Create(v.vertices, v.vertex_count * stride, { aPos, aNormal, aUV }, GL_STATIC_DRAW) ||
+            (v.indices && !mesh.SetIndices(v.indices->data(), v.indices->size(), GL_STATIC_DRAW))) {
+            std::fprintf(stderr, "  %s: skipped (mesh unavailable)\n", v.name);
+            continue;
+        }
+        const int count = static_cast<int>(v.indices ? v.indices->size() : v.vertex_count);
+        const auto draw = [&] {
+            glClear(GL_COLOR_BUFFER_BIT);
+            mesh.Draw(GL_TRIANGLES, count);
+        };
+        bench.Run(v.name, 1, [&](int) { draw(); glFinish(); });
+
+        // Same triangles in any order cover the same pixels exactly once.
+        draw();
+        (void)target.ReadPixels(pixels);
+        const bool same = reference.empty() || pixels == reference;
+        if (reference.empty()) {
+            reference = pixels;
+            referenceName = v.name;
+        }
+
+        const std::size_t bytes = v.vertex_count * stride + mesh.IndexBytes();
+        const MeshOptimizer::CacheStats sim = v.indices
+            ? MeshOptimizer::AnalyzeVertexCache(v.indices->data(), v.indices->size(), v.vertex_count)
+            : MeshOptimizer::CacheStats{ v.vertex_count, v.vertex_count / 3, v.vertex_count, 3.0, 1.0 };
+        std::printf("  %s: %.2f MiB (%zu vertices, %s indices), ACMR %.3f, %zu VS invocations simulated",
+                    v.name, static_cast<double>(bytes) / (1024.0 * 1024.0), v.vertex_count,
+                    !mesh.Indexed() ? "no" : mesh.IndexType() == GL_UNSIGNED_SHORT ? "16-bit" : "32-bit",
+                    sim.acmr, sim.transforms);
+        if (stats) {
+            GLuint query = 0;
+            glGenQueries(1, &query);
+            glBeginQuery(0x82F0, query);   // GL_VERTEX_SHADER_INVOCATIONS_ARB
+            draw();
+            glEndQuery(0x82F0);
+            GLuint64 invocations = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &invocations);
+            glDeleteQueries(1, &query);
+            std::printf(", %llu measured", static_cast<unsigned long long>(invocations));
+        }
+        if (same)
+            std::printf("\n");
+        else
+            std::printf(" (IMAGE DIFFERS from %s)\n", referenceName);
+    }
+
+    OffscreenTarget::BindDefault();
+    GlState::MakeCurrent(nullptr);
+}
+
+// Vertex formats: the same 512x512-quad indexed grid (263k vertices, 524k
+// triangles) with position/color/UV vertices, uploaded as 36-byte float
+// vertices and as 16-byte quantized ones packed by VertexPack (half-float
+// position, RGBA8 color, 16-bit normalized UV). The shader is identical; the
+// attribute formats tell GL how to widen the data. vertex/stream/* uploads
+// the vertices again every frame (dynamic geometry). Also times the CPU pack.
+const char* const kPackVS =
+    "#version 120\n"
+    "attribute vec3 aPos;\n"
+    "attribute vec4 aColor;\n"
+    "attribute vec2 aUV;\n"
+    "uniform mat4 uMVP;\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "  vColor = aColor * vec4(aUV, 1.0, 1.0);\n"
+    "  gl_Position = uMVP * vec4(aPos * 2.0 - 1.0, 1.0);\n"
+    "}\n";
+
+const char* const kPackFS =
+    "#version 120\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "  gl_FragColor = vColor;\n"
+    "}\n";
+
+struct FloatVertex {
+    float x, y, z;
+    float r, g, b, a;
+    float u, v;
+};
+
+// Quantized layout: half x/y/z (+2 bytes padding), RGBA8, UV as UNorm16.
+const std::size_t kPackedStride   = 16;
+const std::size_t kPackedColorOfs = 8;
+const std::size_t kPackedUVOfs    = 12;
+
+void PackGrid(const std::vector<FloatVertex>& src, std::vector<unsigned char>& dst)
+{
+    using Format = VertexPack::Format;
+    const std::size_t n = src.size();
+    dst.assign(n * kPackedStride, 0);
+    const std::size_t s = sizeof(FloatVertex);
+    VertexPack::Pack(Format::Half,    &src[0].x, s, 3, dst.data(),                   kPackedStride, n);
+    VertexPack::Pack(Format::UNorm8,  &src[0].r, s, 4, dst.data() + kPackedColorOfs, kPackedStride, n);
+    VertexPack::Pack(Format::UNorm16, &src[0].u, s, 2, dst.data() + kPackedUVOfs,    kPackedStride, n);
+}
+
+// Per-value reference of PackGrid() (what a loop without VertexPack's bulk
+// converters would do).
+void PackGridScalar(const std::vector<FloatVertex>& src, std::vector<unsigned char>& dst)
+{
+    dst.assign(src.size() * kPackedStride, 0);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        const FloatVertex& v = src[i];
+        unsigned char* out = dst.data() + i * kPackedStride;
+        const std::uint16_t pos[3] = { VertexPack::ToHalf(v.x), VertexPack::ToHalf(v.y), VertexPack::ToHalf(v.z) };
+        const std::uint8_t color[4] = { VertexPack::ToUNorm8(v.r), VertexPack::ToUNorm8(v.g),
+                                        VertexPack::ToUNorm8(v.b), VertexPack::ToUNorm8(v.a) };
+        const std::uint16_t uv[2] = { VertexPack::ToUNorm16(v.u), VertexPack::ToUNorm16(v.v) };
+        std::memcpy(out, pos, sizeof(pos));
+        std::memcpy(out + kPackedColorOfs, color, sizeof(color));
+        std::memcpy(out + kPackedUVOfs, uv, sizeof(uv));
+    }
+}
+
+void BenchVertexFormats(Bench& bench)
+{
+    const int kQuads = 512;
+    const int side = kQuads + 1;
+    const std::string verts = "/" + std::to_string(side * side) + "verts";
+    const std::string packName = std::string(VertexPack::SimdEnabled() ? "vertex/pack/sse2" : "vertex/pack/bulk") + verts;
+    const bool draws = AnySelected(bench, { "vertex/draw/float" + verts, "vertex/stream/float" + verts,
+                                            "vertex/draw/quantized" + verts, "vertex/stream/quantized" + verts });
+    if (!draws && !AnySelected(bench, { packName, "vertex/pack/scalar" + verts }))
+        return;
+
+    GlState state;
+    GlState::MakeCurrent(&state);
+
+    std::vector<FloatVertex> vertices;
+    vertices.reserve(static_cast<std::size_t>(side) * side);
+    for (int j = 0; j < side; ++j) {
+        for (int i = 0; i < side; ++i) {
+            const float s = static_cast<float>(i) / static_cast<float>(kQuads);
+            const float t = static_cast<float>(j) / static_cast<float>(kQuads);
+            vertices.push_back(FloatVertex{ s, t, 0.0f,
+                                            0.5f + 0.5f * std::sin(s * 7.0f), 0.5f + 0.5f * std::cos(t * 5.0f),
+                                            s * t, 1.0f, s, t });
+        }
+    }
+    std::vector<std::uint32_t> indices;
+    indices.reserve(static_cast<std::size_t>(kQuads) * kQuads * 6);
+    for (int j = 0; j < kQuads; ++j) {
+        for (int i = 0; i < kQuads; ++i) {
+            const std::uint32_t v = static_cast<std::uint32_t>(j * side + i);
+            const std::uint32_t quad[6] = { v, v + 1, v + side + 1, v, v + side + 1, v + side };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+
+    std::vector<unsigned char> packed, scratch;
+    PackGrid(vertices, packed);
+    PackGridScalar(vertices, scratch);
+    if (scratch != packed)
+        std::fprintf(stderr, "  vertex/pack: bulk and per-value packing DIFFER\n");
+
+    bench.Run(packName, 1,
+              [&](int) { PackGrid(vertices, scratch); });
+    bench.Run("vertex/pack/scalar" + verts, 1,
+              [&](int) { PackGridScalar(vertices, scratch); });
+    if (!draws) {
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+
+    OffscreenTarget target;
+    Shader shader;
+    shader.BindAttrib("aPos", 0);
+    shader.BindAttrib("aColor", 1);
+    shader.BindAttrib("aUV", 2);
+    if (!target.Create(256, 256) || !shader.CompileFromSource(kPackVS, kPackFS, "bench-vertex-formats")) {
+        std::fprintf(stderr, "  vertex/draw: skipped (framebuffer or program unavailable)\n");
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+    if (!Mesh::HalfFloatSupported()) {
+        std::fprintf(stderr, "  vertex/draw: skipped (no half-float vertex attributes)\n");
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+    target.Bind();
+    state.Viewport(0, 0, 256, 256);
+    shader.Use();
+    const float identity[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+    (void)shader.SetMat4(shader.FindUniform("uMVP"), identity);
+
+    using Format = VertexPack::Format;
+    const int fs = static_cast<int>(sizeof(FloatVertex));
+    const int ps = static_cast<int>(kPackedStride);
+    struct Variant {
+        const char* name;
+        const char* stream;
+        const void* data;
+        std::size_t stride;
+        Mesh::Attrib pos, color, uv;
+    };
+    const Variant variants[] = {
+        { "vertex/draw/float", "vertex/stream/float", vertices.data(), sizeof(FloatVertex),
+            VertexPack::MakeAttrib(0, 3, Format::Float, fs, offsetof(FloatVertex, x)),
+            VertexPack::MakeAttrib(1, 4, Format::Float, fs, offsetof(FloatVertex, r)),
+            VertexPack::MakeAttrib(2, 2, Format::Float, fs, offsetof(FloatVertex, u)) },
+        { "vertex/draw/quantized", "vertex/stream/quantized", packed.data(), kPackedStride,
+            VertexPack::MakeAttrib(0, 3, Format::Half,    ps, 0),
+            VertexPack::MakeAttrib(1, 4, Format::UNorm8,  ps, kPackedColorOfs),
+            VertexPack::MakeAttrib(2, 2, Format::UNorm16, ps, kPackedUVOfs) },
+    };
+
+    std::vector<unsigned char> reference, pixels;
+    const int count = static_cast<int>(indices.size());
+    for (const Variant& v : variants) {
+        if (!AnySelected(bench, { v.name + verts, v.stream + verts }))
+            continue;
+        Mesh mesh;
+        if (!mesh.Create(v.data, vertices.size() * v.stride, { v.pos, v.color, v.uv }, GL_STATIC_DRAW) ||
+            !mesh.SetIndices(indices.data(), indices.size(), GL_STATIC_DRAW)) {
+            std::fprintf(stderr, "  %s: skipped (mesh unavailable)\n", v.name);
+            continue;
+        }
+        const auto draw = [&] {
+            glClear(GL_COLOR_BUFFER_BIT);
+            mesh.Draw(GL_TRIANGLES, count);
+        };
+        const std::size_t bytes = vertices.size() * v.stride;
+        bench.Run(v.name + verts, 1, [&](int) { draw(); glFinish(); });
+        bench.Run(v.stream + verts, 1,
+                  [&](int) { (void)mesh.UpdateBuffer(v.data, bytes, GL_STREAM_DRAW); draw(); glFinish(); });
+
+        // Quantization may move a color by a step; report the largest change.
+        draw();
+        (void)target.ReadPixels(pixels);
+        std::printf("  %s: %zu bytes/vertex, %.2f MiB vertices", v.name, v.stride,
+                    static_cast<double>(bytes) / (1024.0 * 1024.0));
+        if (reference.empty()) {
+            reference = pixels;
+            std::printf("\n");
+        } else {
+            int maxDiff = 0;
+            for (std::size_t i = 0; i < pixels.size() && i < reference.size(); ++i)
+                maxDiff = std::max(maxDiff, std::abs(int(pixels[i]) - int(reference[i])));
+            std::printf(", max channel diff vs %s %d\n", variants[0].name, maxDiff);
+        }
+    }
+
+    OffscreenTarget::BindDefault();
+    GlState::MakeCurrent(nullptr);
+}
+
+// Full-frame RGBA video-style streams: StreamingTexture (PBO ring) against
+// plain glTexSubImage2D from client memory. A sample ends with glFinish, so
+// the rate includes the GPU copy, not just the hand-off.
+const int kStreamFrames = 8;
+
+double StreamMBps(const Bench& bench, std::size_t frameBytes)
+{
+    return static_cast<double>(frameBytes) / (bench.Results().back().median_ns * 1e-9) / 1e6;
+}
+
+void StreamPbo(Bench& bench, const char* name, const Size& size, std::vector<unsigned char>& frame)
+{
+    StreamingTexture stream;
+    if (!stream.Create(size.w, size.h)) {
+        std::fprintf(stderr, "  %s: skipped (texture unavailable)\n", name);
+        return;
+    }
+    // A dropped update is retried (the producer only ever polls fences),
+    // for at most a second so a fence that never signals cannot hang us.
+    bool stalled = false;
+    bench.Run(name, kStreamFrames,
+              [&](int i) {
+                  frame[0] = static_cast<unsigned char>(i);
+                  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                  while (!stalled && !stream.Update(0, 0, size.w, size.h, frame.data()))
+                      stalled = std::chrono::steady_clock::now() > deadline;
+              },
+              [] { glFinish(); });
+    std::printf("  %s: %.0f MB/s sustained (%s, %llu dropped attempts)%s\n", name,
+                StreamMBps(bench, frame.size()),
+                stream.UsesPbo() ? "mapped PBO ring" : "orphaned PBO",
+                static_cast<unsigned long long>(stream.GetStats().dropped),
+                stalled ? " (STALLED: an update was dropped for over 1 s)" : "");
+}
+
+void StreamDirect(Bench& bench, const char* name, const Size& size, std::vector<unsigned char>& frame)
+{
+    Texture direct;
+    if (!direct.CreateFromPixels(size.w, size.h, frame.data())) {
+        std::fprintf(stderr, "  %s: skipped (texture unavailable)\n", name);
+        return;
+    }
+    bench.Run(name, kStreamFrames,
+              [&](int i) {
+                  frame[0] = static_cast<unsigned char>(i);
+                  (void)direct.UpdateRegion(0, 0, size.w, size.h, frame.data(), 0);
+              },
+              [] { glFinish(); });
+    std::printf("  %s: %.0f MB/s sustained\n", name, StreamMBps(bench, frame.size()));
+}
+
+void BenchStreaming(Bench& bench)
+{
+    GlState state;
+    GlState::MakeCurrent(&state);
+
+    const Size sizes[] = { { 1920, 1080 }, { 3840, 2160 } };
+    for (const Size& size : sizes) {
+        char pbo[64], direct[64];
+        std::snprintf(pbo, sizeof(pbo), "stream/%dx%d/pbo", size.w, size.h);
+        std::snprintf(direct, sizeof(direct), "stream/%dx%d/direct", size.w, size.h);
+        if (!AnySelected(bench, { pbo, direct }))
+            continue;
+
+        std::vector<unsigned char> frame(static_cast<std::size_t>(size.w) * static_cast<std::size_t>(size.h) * 4u, 0x80);
+        if (bench.Selected(pbo))
+            StreamPbo(bench, pbo, size, frame);
+        if (bench.Selected(direct))
+            StreamDirect(bench, direct, size, frame);
+    }
+
+    GlState::MakeCurrent(nullptr);
+}
+
+// CPU-only: button hit test over a grid covering the canvas.
+void BenchHitTest(Bench& bench)
+{
+    if (!bench.Selected("overlay/hittest"))
+        return;
+
+    GlState state;
+    GlState::MakeCurrent(&state);
+
+    UIOverlay overlay;
+    if (!overlay.Initialize()) {
+        std::fprintf(stderr, "  overlay/hittest: skipped (overlay init failed)\n");
+        GlState::MakeCurrent(nullptr);
+        return;
+    }
+    overlay.Resize(1280, 720, 1.0f);
+    for (int i = 0; i < 256; ++i) {
+        const UIOverlay::Item item { 8 + (i % 32) * 24, 8 + (i / 32) * 24, 16, 16, 0x40FF40FFu, -1 };
+        overlay.AddItem(item);
+    }
+
+    const int kGrid = 64;
+    volatile int hits = 0;
+    bench.Run("overlay/hittest", kGrid * kGrid,
+              [&](int i) {
+                  const int x = (i % kGrid) * 1280 / kGrid;
+                  const int y = (i / kGrid) * 720 / kGrid;
+                  hits = hits + (overlay.HitTest(x, y) ? 1 : 0);
+              });
+
+    GlState::MakeCurrent(nullptr);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s [--json=out.json] [--filter=substr] [--samples=N] [--warmup=N]\n"
+                     "          [--sizes=WxH,WxH,...] [--label=text]\n", argv[0]);
+        return 2;
+    }
+
+    HeadlessContext context;
+    if (!context.Create()) {
+        std::fprintf(stderr, "Headless GL context: %s\n", context.LastError().c_str());
+        return 1;
+    }
+    if (!gladLoadGL()) {
+        std::fprintf(stderr, "Cannot load OpenGL entry points.\n");
+        return 1;
+    }
+
+    Bench bench(opt.bench);
+    bench.SetInfo("context",     context.Description());
+    bench.SetInfo("gl_vendor",   GlString(0x1F00));   // GL_VENDOR
+    bench.SetInfo("gl_renderer", GlString(0x1F01));   // GL_RENDERER
+    bench.SetInfo("gl_version",  GlString(GL_VERSION));
+    if (!opt.label.empty())
+        bench.SetInfo("label", opt.label);
+    std::printf("%s | %s\n", GlString(0x1F01).c_str(), GlString(GL_VERSION).c_str());
+
+    BenchRender(bench, opt, 0);
+    BenchRender(bench, opt, 10000);
+    BenchResources(bench);
+    BenchMesh(bench);
+    BenchVertexFormats(bench);
+    BenchStreaming(bench);
+    BenchHitTest(bench);
+
+    bench.PrintTable();
+    if (!opt.json.empty()) {
+        if (!bench.WriteJson(opt.json)) {
+            std::fprintf(stderr, "Cannot write %s\n", opt.json.c_str());
+            return 1;
+        }
+        std::printf("Wrote %s\n", opt.json.c_str());
+    }
+    return 0;
+}
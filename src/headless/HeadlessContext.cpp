@@ -0,0 +1,263 @@
+// src/headless/HeadlessContext.cpp
+#include "HeadlessContext.h"
+
+#include "render/GlCaps.h"
+
+#if defined(__linux__) || (defined(__unix__) && !defined(__APPLE__))
+#  define WXGL_HAVE_DLOPEN 1
+#  include <dlfcn.h>
+#  include <cstdio>
+#else
+#  define WXGL_HAVE_DLOPEN 0
+#endif
+
+#if WXGL_HAVE_DLOPEN
+namespace {
+// EGL types and tokens, declared locally so no EGL headers are needed.
+using EGLDisplay = void*;
+using EGLConfig  = void*;
+using EGLSurface = void*;
+using EGLContext = void*;
+using EGLBoolean = unsigned int;
+using EGLenum    = unsigned int;
+using EGLint     = int;
+
+const EGLint  kEglNone              = 0x3038;
+const EGLint  kEglExtensions        = 0x3055;
+const EGLint  kEglSurfaceType       = 0x3033;
+const EGLint  kEglPbufferBit        = 0x0001;
+const EGLint  kEglRenderableType    = 0x3040;
+const EGLint  kEglOpenGLBit         = 0x0008;
+const EGLint  kEglRedSize           = 0x3024;
+const EGLint  kEglGreenSize         = 0x3023;
+const EGLint  kEglBlueSize          = 0x3022;
+const EGLint  kEglAlphaSize         = 0x3021;
+const EGLint  kEglWidth             = 0x3057;
+const EGLint  kEglHeight            = 0x3056;
+const EGLenum kEglOpenGLApi         = 0x30A2;
+const EGLenum kEglPlatformSurfaceless = 0x31DD;   // EGL_PLATFORM_SURFACELESS_MESA
+
+typedef void*       (*PFN_eglGetProcAddress)(const char*);
+typedef EGLDisplay  (*PFN_eglGetDisplay)(void*);
+typedef EGLDisplay  (*PFN_eglGetPlatformDisplayEXT)(EGLenum, void*, const EGLint*);
+typedef EGLBoolean  (*PFN_eglInitialize)(EGLDisplay, EGLint*, EGLint*);
+typedef EGLBoolean  (*PFN_eglTerminate)(EGLDisplay);
+typedef const char* (*PFN_eglQueryString)(EGLDisplay, EGLint);
+typedef EGLBoolean  (*PFN_eglBindAPI)(EGLenum);
+typedef EGLBoolean  (*PFN_eglChooseConfig)(EGLDisplay, const EGLint*, EGLConfig*, EGLint, EGLint*);
+typedef EGLContext  (*PFN_eglCreateContext)(EGLDisplay, EGLConfig, EGLContext, const EGLint*);
+typedef EGLBoolean  (*PFN_eglDestroyContext)(EGLDisplay, EGLContext);
+typedef EGLSurface  (*PFN_eglCreatePbufferSurface)(EGLDisplay, EGLConfig, const EGLint*);
+typedef EGLBoolean  (*PFN_eglDestroySurface)(EGLDisplay, EGLSurface);
+typedef EGLBoolean  (*PFN_eglMakeCurrent)(EGLDisplay, EGLSurface, EGLSurface, EGLContext);
+typedef EGLint      (*PFN_eglGetError)(void);
+} // namespace
+
+struct HeadlessContext::Egl {
+    void* lib {nullptr};
+
+    PFN_eglGetProcAddress       getProcAddress {nullptr};
+    PFN_eglGetDisplay           getDisplay {nullptr};
+    PFN_eglInitialize           initialize {nullptr};
+    PFN_eglTerminate            terminate {nullptr};
+    PFN_eglQueryString          queryString {nullptr};
+    PFN_eglBindAPI              bindApi {nullptr};
+    PFN_eglChooseConfig         chooseConfig {nullptr};
+    PFN_eglCreateContext        createContext {nullptr};
+    PFN_eglDestroyContext       destroyContext {nullptr};
+    PFN_eglCreatePbufferSurface createPbuffer {nullptr};
+    PFN_eglDestroySurface       destroySurface {nullptr};
+    PFN_eglMakeCurrent          makeCurrent {nullptr};
+    PFN_eglGetError             getError {nullptr};
+
+    EGLDisplay display {nullptr};
+    EGLContext context {nullptr};
+    EGLSurface surface {nullptr};   // pbuffer fallback only
+
+    template <typename T>
+    bool Load(T& fn, const char* name)
+    {
+        fn = reinterpret_cast<T>(dlsym(lib, name));
+        return fn != nullptr;
+    }
+
+    bool Open()
+    {
+        lib = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+        if (!lib)
+            lib = dlopen("libEGL.so", RTLD_NOW | RTLD_LOCAL);
+        if (!lib)
+            return false;
+        return Load(getProcAddress, "eglGetProcAddress") && Load(getDisplay, "eglGetDisplay") &&
+               Load(initialize, "eglInitialize") && Load(terminate, "eglTerminate") &&
+               Load(queryString, "eglQueryString") && Load(bindApi, "eglBindAPI") &&
+               Load(chooseConfig, "eglChooseConfig") && Load(createContext, "eglCreateContext") &&
+               Load(destroyContext, "eglDestroyContext") && Load(createPbuffer, "eglCreatePbufferSurface") &&
+               Load(destroySurface, "eglDestroySurface") && Load(makeCurrent, "eglMakeCurrent") &&
+               Load(getError, "eglGetError");
+    }
+
+    // Creates a context (and pbuffer if needed) on an initialized display.
+    bool CreateOn(EGLDisplay dpy, bool& usedPbuffer)
+    {
+        if (!bindApi(kEglOpenGLApi))
+            return false;
+
+        const EGLint configAttribs[] = {
+            kEglSurfaceType, kEglPbufferBit,
+            kEglRenderableType, kEglOpenGLBit,
+            kEglRedSize, 8, kEglGreenSize, 8, kEglBlueSize, 8, kEglAlphaSize, 8,
+            kEglNone
+        };
+        EGLConfig config = nullptr;
+        EGLint count = 0;
+        const bool haveConfig = chooseConfig(dpy, configAttribs, &config, 1, &count) && count > 0;
+
+        // Without a config only EGL_KHR_no_config_context can help.
+        const char* ext = queryString(dpy, kEglExtensions);
+        if (!haveConfig && !GlCaps::HasToken(ext, "EGL_KHR_no_config_context"))
+            return false;
+
+        const EGLint contextAttribs[] = { kEglNone };
+        EGLContext ctx = createContext(dpy, haveConfig ? config : nullptr, nullptr, contextAttribs);
+        if (!ctx)
+            return false;
+
+        EGLSurface surf = nullptr;
+        usedPbuffer = !GlCaps::HasToken(ext, "EGL_KHR_surfaceless_context");
+        if (usedPbuffer) {
+            const EGLint pbufferAttribs[] = { kEglWidth, 1, kEglHeight, 1, kEglNone };
+            surf = haveConfig ? createPbuffer(dpy, config, pbufferAttribs) : nullptr;
+            if (!surf) {
+                destroyContext(dpy, ctx);
+                return false;
+            }
+        }
+        if (!makeCurrent(dpy, surf, surf, ctx)) {
+            if (surf) destroySurface(dpy, surf);
+            destroyContext(dpy, ctx);
+            return false;
+        }
+        display = dpy;
+        context = ctx;
+        surface = surf;
+        return true;
+    }
+};
+
+HeadlessContext::HeadlessContext() = default;
+
+HeadlessContext::~HeadlessContext()
+{
+    Destroy();
+}
+
+bool HeadlessContext::fail(const std::string& what)
+{
+    m_error = what;
+    Destroy();
+    return false;
+}
+
+bool HeadlessContext::Create()
+{
+    Destroy();
+    m_error.clear();
+
+    m_egl.reset(new Egl());
+    if (!m_egl->Open())
+        return fail("libEGL.so.1 not found or incomplete");
+    Egl& egl = *m_egl;
+
+    // 1. Mesa's surfaceless platform: no X11/Wayland server required.
+    const char* clientExt = egl.queryString(nullptr, kEglExtensions);
+    const auto getPlatformDisplay = reinterpret_cast<PFN_eglGetPlatformDisplayEXT>(
+        egl.getProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay && GlCaps::HasToken(clientExt, "EGL_MESA_platform_surfaceless")) {
+        EGLDisplay dpy = getPlatformDisplay(kEglPlatformSurfaceless, nullptr, nullptr);
+        bool pbuffer = false;
+        if (dpy && egl.initialize(dpy, nullptr, nullptr)) {
+            if (egl.CreateOn(dpy, pbuffer)) {
+                m_description = pbuffer ? "EGL surfaceless (Mesa), pbuffer" : "EGL surfaceless (Mesa)";
+                return true;
+            }
+            egl.terminate(dpy);
+        }
+    }
+
+    // 2./3. Default display (may need a display server, depending on the driver).
+    EGLDisplay dpy = egl.getDisplay(nullptr);
+    if (!dpy || !egl.initialize(dpy, nullptr, nullptr))
+        return fail("no usable EGL display");
+    bool pbuffer = false;
+    if (!egl.CreateOn(dpy, pbuffer)) {
+        const EGLint err = egl.getError();
+        egl.terminate(dpy);
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "cannot create a desktop GL context (EGL error 0x%04X)",
+                      static_cast<unsigned>(err));
+        return fail(buf);
+    }
+    m_description = pbuffer ? "EGL pbuffer" : "EGL surfaceless";
+    return true;
+}
+
+void HeadlessContext::Destroy()
+{
+    if (!m_egl)
+        return;
+    Egl& egl = *m_egl;
+    if (egl.display) {
+        egl.makeCurrent(egl.display, nullptr, nullptr, nullptr);
+        if (egl.surface) egl.destroySurface(egl.display, egl.surface);
+        if (egl.context) egl.destroyContext(egl.display, egl.context);
+        egl.terminate(egl.display);
+    }
+    if (egl.lib)
+        dlclose(egl.lib);
+    m_egl.reset();
+    m_description.clear();
+}
+
+bool HeadlessContext::MakeCurrent()
+{
+    if (!Valid())
+        return false;
+    return m_egl->makeCurrent(m_egl->display, m_egl->surface, m_egl->surface, m_egl->context) != 0;
+}
+
+void HeadlessContext::ReleaseCurrent()
+{
+    if (Valid())
+        m_egl->makeCurrent(m_egl->display, nullptr, nullptr, nullptr);
+}
+
+bool HeadlessContext::Valid() const
+{
+    return m_egl && m_egl->context;
+}
+
+#else // !WXGL_HAVE_DLOPEN
+
+struct HeadlessContext::Egl {};
+
+HeadlessContext::HeadlessContext() = default;
+HeadlessContext::~HeadlessContext() = default;
+
+bool HeadlessContext::fail(const std::string& what)
+{
+    m_error = what;
+    return false;
+}
+
+bool HeadlessContext::Create()
+{
+    return fail("headless contexts are only implemented with EGL on Linux/Unix");
+}
+
+void HeadlessContext::Destroy() {}
+bool HeadlessContext::MakeCurrent() { return false; }
+void HeadlessContext::ReleaseCurrent() {}
+bool HeadlessContext::Valid() const { return false; }
+
+#endif
@@ -0,0 +1,54 @@
+// src/headless/HeadlessContext.h
+#pragma once
+
+#include <memory>
+#include <string>
+
+/**
+ * HeadlessContext
+ * Desktop OpenGL context without a window or wxWidgets, for running the
+ * Renderer in a plain process (CI, benchmarks, GPU-less hosts with Mesa
+ * llvmpipe). Pair it with an OffscreenTarget to have something to draw into.
+ *
+ * EGL is opened at runtime (libEGL.so.1), so building needs no EGL headers
+ * or libraries. Create() tries, in order:
+ *   1. EGL_MESA_platform_surfaceless display, context without surface
+ *   2. default EGL display, context without surface (EGL_KHR_surfaceless_context)
+ *   3. default EGL display, 1x1 pbuffer surface
+ * Linux/Unix only; elsewhere Create() fails with LastError() set.
+ *
+ * The context is current on the creating thread after Create(); gladLoadGL()
+ * (Renderer::Initialize) resolves GL entry points through libGL as usual.
+ */
+class HeadlessContext
+{
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Create and make current. Returns false with LastError() on failure.
+    bool Create();
+    void Destroy();
+
+    bool MakeCurrent();
+    void ReleaseCurrent();
+
+    bool Valid() const;
+
+    // e.g. "EGL surfaceless (Mesa)"; empty before Create().
+    const std::string& Description() const { return m_description; }
+    const std::string& LastError() const   { return m_error; }
+
+private:
+    struct Egl;   // runtime-loaded EGL entry points and handles
+
+    bool fail(const std::string& what);
+
+private:
+    std::unique_ptr<Egl> m_egl;
+    std::string m_description;
+    std::string m_error;
+};
@@ -0,0 +1,29 @@
+// src/headless/ImageFile.cpp
+#include "ImageFile.h"
+
+#include <cstdio>
+
+namespace wxgl {
+
+bool WritePpm(const std::string& path, int w, int h, const std::vector<unsigned char>& rgba)
+{
+    if (w <= 0 || h <= 0 || rgba.size() < static_cast<std::size_t>(w) * h * 4)
+        return false;
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    std::vector<unsigned char> rgb(static_cast<std::size_t>(w) * 3);
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* src = &rgba[static_cast<std::size_t>(y) * w * 4];
+        for (int x = 0; x < w; ++x) {
+            rgb[x * 3 + 0] = src[x * 4 + 0];
+            rgb[x * 3 + 1] = src[x * 4 + 1];
+            rgb[x * 3 + 2] = src[x * 4 + 2];
+        }
+        std::fwrite(rgb.data(), 1, rgb.size(), f);
+    }
+    return std::fclose(f) == 0;
+}
+
+} // namespace wxgl
@@ -0,0 +1,12 @@
+// src/headless/ImageFile.h
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace wxgl {
+
+// Binary PPM from tightly packed RGBA8 rows, top row first (alpha dropped).
+bool WritePpm(const std::string& path, int w, int h, const std::vector<unsigned char>& rgba);
+
+} // namespace wxgl
@@ -0,0 +1,822 @@
+// src/headless/TraceReplay.cpp
+#include "TraceReplay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "glad/glad.h"
+
+using gltrace::Op;
+
+// Issues a call when executing; optional entry points may be missing.
+#define WXGL_REPLAY(fn, ...)            \
+    do {                                \
+        if (!execute) break;            \
+        if (!(fn)) { ++m_skipped; break; } \
+        fn(__VA_ARGS__);                \
+        ++m_calls;                      \
+    } while (0)
+
+namespace {
+const GLenum kQueryResult          = 0x8866;   // GL_QUERY_RESULT
+const GLenum kQueryResultAvailable = 0x8867;   // GL_QUERY_RESULT_AVAILABLE
+
+const void* AsPointer(std::uint64_t offset)
+{
+    return reinterpret_cast<const void*>(static_cast<std::uintptr_t>(offset));
+}
+} // namespace
+
+// ---- Reader ----
+
+bool TraceReplay::Reader::Take(void* out, std::size_t n)
+{
+    if (bad || static_cast<std::size_t>(end - p) < n) {
+        bad = true;
+        std::memset(out, 0, n);
+        return false;
+    }
+    std::memcpy(out, p, n);
+    p += n;
+    return true;
+}
+
+std::uint8_t  TraceReplay::Reader::U8()  { std::uint8_t v;  Take(&v, 1); return v; }
+std::uint32_t TraceReplay::Reader::U32() { std::uint32_t v; Take(&v, 4); return v; }
+std::int32_t  TraceReplay::Reader::I32() { std::int32_t v;  Take(&v, 4); return v; }
+float         TraceReplay::Reader::F32() { float v;         Take(&v, 4); return v; }
+std::uint64_t TraceReplay::Reader::U64() { std::uint64_t v; Take(&v, 8); return v; }
+
+const void* TraceReplay::Reader::Blob(std::uint32_t& size)
+{
+    size = U32();
+    if (bad || static_cast<std::size_t>(end - p) < size) {
+        bad  = true;
+        size = 0;
+        return nullptr;
+    }
+    const void* data = size ? p : nullptr;
+    p += size;
+    return data;
+}
+
+std::string TraceReplay::Reader::Str()
+{
+    std::uint32_t n = 0;
+    const char* s = static_cast<const char*>(Blob(n));
+    return s ? std::string(s, n) : std::string();
+}
+
+// ---- Loading ----
+
+bool TraceReplay::fail(const std::string& what)
+{
+    m_error = what;
+    return false;
+}
+
+bool TraceReplay::Load(const std::string& path)
+{
+    m_data.clear();
+    m_info.clear();
+    m_frameCount = 0;
+    m_extentW = m_extentH = 0;
+    m_error.clear();
+
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return fail("cannot open " + path);
+    unsigned char chunk[1 << 16];
+    std::size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+        m_data.insert(m_data.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    Reader r;
+    r.p   = m_data.data();
+    r.end = m_data.data() + m_data.size();
+    char magic[sizeof(gltrace::kMagic)];
+    r.Take(magic, sizeof(magic));
+    const std::uint32_t version = r.U32();
+    const std::uint32_t order   = r.U32();
+    if (r.bad || std::memcmp(magic, gltrace::kMagic, sizeof(magic)) != 0)
+        return fail(path + " is not a GL trace");
+    if (order != gltrace::kByteOrder)
+        return fail("trace was written with a different byte order");
+    if (version != gltrace::kVersion)
+        return fail("unsupported trace version " + std::to_string(version));
+    m_bodyStart = static_cast<std::size_t>(r.p - m_data.data());
+
+    bool frameEnd = false;
+    while (step(r, false, frameEnd)) {
+        if (frameEnd)
+            ++m_frameCount;
+    }
+    if (!m_error.empty())
+        return false;
+
+    Begin(0);
+    return true;
+}
+
+void TraceReplay::Begin(unsigned defaultFbo)
+{
+    m_reader.p   = m_data.data() + m_bodyStart;
+    m_reader.end = m_data.data() + m_data.size();
+    m_reader.bad = false;
+
+    m_frame   = 0;
+    m_calls   = 0;
+    m_skipped = 0;
+    m_defaultFbo = defaultFbo;
+    for (NameMap* m : { &m_buffers, &m_vaos, &m_textures, &m_shaders, &m_programs,
+                        &m_queries, &m_fbos, &m_rbos, &m_attribs })
+        m->clear();
+    m_uniforms.clear();
+    for (const auto& kv : m_syncs) {
+        if (glDeleteSync)
+            glDeleteSync(static_cast<GLsync>(kv.second));
+    }
+    m_syncs.clear();
+    m_mapped.clear();
+    m_program = 0;
+    m_pack = gltrace::PixelStore();
+}
+
+bool TraceReplay::NextFrame()
+{
+    if (m_data.empty())
+        return false;
+    bool frameEnd = false;
+    while (step(m_reader, true, frameEnd)) {
+        if (frameEnd) {
+            ++m_frame;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---- Name translation ----
+
+unsigned TraceReplay::name(const NameMap& map, unsigned captured)
+{
+    if (captured == 0)
+        return 0;
+    const auto it = map.find(captured);
+    return it != map.end() ? it->second : 0;
+}
+
+int TraceReplay::uniform(int capturedLoc) const
+{
+    if (capturedLoc < 0)
+        return capturedLoc;
+    const std::uint64_t key = (static_cast<std::uint64_t>(m_program) << 32) | static_cast<std::uint32_t>(capturedLoc);
+    const auto it = m_uniforms.find(key);
+    return it != m_uniforms.end() ? it->second : -1;
+}
+
+unsigned TraceReplay::attrib(unsigned capturedIndex) const
+{
+    const auto it = m_attribs.find(capturedIndex);
+    return it != m_attribs.end() ? it->second : capturedIndex;
+}
+
+template <typename Fn>
+void TraceReplay::gen(Reader& r, bool execute, NameMap& map, Fn fn)
+{
+    const std::int32_t n = r.I32();
+    std::vector<GLuint> captured(static_cast<std::size_t>(std::max(0, n)));
+    for (GLuint& id : captured)
+        id = r.U32();
+    if (!execute || r.bad || captured.empty())
+        return;
+    if (!fn) {
+        ++m_skipped;
+        return;
+    }
+    std::vector<GLuint> fresh(captured.size(), 0);
+    fn(static_cast<GLsizei>(fresh.size()), fresh.data());
+    ++m_calls;
+    for (std::size_t i = 0; i < captured.size(); ++i)
+        map[captured[i]] = fresh[i];
+}
+
+template <typename Fn>
+void TraceReplay::del(Reader& r, bool execute, NameMap& map, Fn fn)
+{
+    const std::int32_t n = r.I32();
+    std::vector<GLuint> ids(static_cast<std::size_t>(std::max(0, n)));
+    for (GLuint& id : ids) {
+        const GLuint captured = r.U32();
+        id = name(map, captured);
+        if (execute)
+            map.erase(captured);
+    }
+    if (!execute || r.bad || ids.empty())
+        return;
+    if (!fn) {
+        ++m_skipped;
+        return;
+    }
+    fn(static_cast<GLsizei>(ids.size()), ids.data());
+    ++m_calls;
+}
+
+// ---- Records ----
+
+bool TraceReplay::step(Reader& r, bool execute, bool& frameEnd)
+{
+    frameEnd = false;
+    if (r.p >= r.end || r.bad)
+        return false;
+
+    const std::uint8_t code = r.U8();
+    if (code >= static_cast<std::uint8_t>(Op::Count))
+        return fail("unknown record " + std::to_string(code));
+
+    switch (static_cast<Op>(code)) {
+    case Op::FrameEnd:
+        frameEnd = true;
+        break;
+    case Op::Info: {
+        std::string key = r.Str();
+        std::string value = r.Str();
+        if (!execute)
+            m_info.emplace_back(std::move(key), std::move(value));
+        break;
+    }
+
+    case Op::Clear: {
+        const GLbitfield mask = r.U32();
+        WXGL_REPLAY(glClear, mask);
+        break;
+    }
+    case Op::ClearColor: {
+        const float cr = r.F32(), cg = r.F32(), cb = r.F32(), ca = r.F32();
+        WXGL_REPLAY(glClearColor, cr, cg, cb, ca);
+        break;
+    }
+    case Op::Viewport:
+    case Op::Scissor: {
+        const GLint x = r.I32(), y = r.I32();
+        const GLsizei w = r.I32(), h = r.I32();
+        if (static_cast<Op>(code) == Op::Viewport) {
+            if (!execute) {
+                m_extentW = std::max(m_extentW, x + w);
+                m_extentH = std::max(m_extentH, y + h);
+            }
+            WXGL_REPLAY(glViewport, x, y, w, h);
+        } else {
+            WXGL_REPLAY(glScissor, x, y, w, h);
+        }
+        break;
+    }
+    case Op::Enable: {
+        const GLenum cap = r.U32();
+        WXGL_REPLAY(glEnable, cap);
+        break;
+    }
+    case Op::Disable: {
+        const GLenum cap = r.U32();
+        WXGL_REPLAY(glDisable, cap);
+        break;
+    }
+    case Op::BlendFunc: {
+        const GLenum s = r.U32(), d = r.U32();
+        WXGL_REPLAY(glBlendFunc, s, d);
+        break;
+    }
+    case Op::GetError:
+        if (execute) {
+            (void)glGetError();
+            ++m_calls;
+        }
+        break;
+    case Op::GetString: {
+        const GLenum which = r.U32();
+        WXGL_REPLAY(glGetString, which);
+        break;
+    }
+
+    case Op::GenBuffers:    gen(r, execute, m_buffers, glGenBuffers); break;
+    case Op::DeleteBuffers: del(r, execute, m_buffers, glDeleteBuffers); break;
+    case Op::BindBuffer: {
+        const GLenum target = r.U32();
+        const GLuint id = name(m_buffers, r.U32());
+        WXGL_REPLAY(glBindBuffer, target, id);
+        break;
+    }
+    case Op::BufferData: {
+        const GLenum target = r.U32();
+        const std::uint64_t size = r.U64();
+        std::uint32_t n = 0;
+        const void* data = r.Blob(n);
+        const GLenum usage = r.U32();
+        WXGL_REPLAY(glBufferData, target, static_cast<GLsizeiptr>(size), data, usage);
+        break;
+    }
+    case Op::BufferSubData: {
+        const GLenum target = r.U32();
+        const std::uint64_t offset = r.U64();
+        std::uint32_t n = 0;
+        const void* data = r.Blob(n);
+        WXGL_REPLAY(glBufferSubData, target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(n), data);
+        break;
+    }
+
+    case Op::GenVertexArrays:    gen(r, execute, m_vaos, glGenVertexArrays); break;
+    case Op::DeleteVertexArrays: del(r, execute, m_vaos, glDeleteVertexArrays); break;
+    case Op::BindVertexArray: {
+        const GLuint id = name(m_vaos, r.U32());
+        WXGL_REPLAY(glBindVertexArray, id);
+        break;
+    }
+    case Op::VertexAttribPointer: {
+        const GLuint index = attrib(r.U32());
+        const GLint size = r.I32();
+        const GLenum type = r.U32();
+        const GLboolean norm = static_cast<GLboolean>(r.U32());
+        const GLsizei stride = r.I32();
+        const std::uint64_t offset = r.U64();
+        WXGL_REPLAY(glVertexAttribPointer, index, size, type, norm, stride, AsPointer(offset));
+        break;
+    }
+    case Op::EnableVertexAttribArray: {
+        const GLuint index = attrib(r.U32());
+        WXGL_REPLAY(glEnableVertexAttribArray, index);
+        break;
+    }
+    case Op::DisableVertexAttribArray: {
+        const GLuint index = attrib(r.U32());
+        WXGL_REPLAY(glDisableVertexAttribArray, index);
+        break;
+    }
+
+    case Op::CreateShader: {
+        const GLenum type = r.U32();
+        const GLuint captured = r.U32();
+        if (execute && !r.bad) {
+            m_shaders[captured] = glCreateShader(type);
+            ++m_calls;
+        }
+        break;
+    }
+    case Op::ShaderSource: {
+        const GLuint shader = name(m_shaders, r.U32());
+        const std::int32_t count = r.I32();
+        std::vector<const GLchar*> strings;
+        std::vector<GLint> lengths;
+        for (std::int32_t i = 0; i < count && !r.bad; ++i) {
+            std::uint32_t n = 0;
+            const void* s = r.Blob(n);
+            strings.push_back(s ? static_cast<const GLchar*>(s) : "");
+            lengths.push_back(static_cast<GLint>(n));
+        }
+        WXGL_REPLAY(glShaderSource, shader, static_cast<GLsizei>(strings.size()), strings.data(), lengths.data());
+        break;
+    }
+    case Op::CompileShader: {
+        const GLuint shader = name(m_shaders, r.U32());
+        WXGL_REPLAY(glCompileShader, shader);
+        break;
+    }
+    case Op::GetShaderiv: {
+        const GLuint shader = name(m_shaders, r.U32());
+        const GLenum pname = r.U32();
+        GLint value = 0;
+        WXGL_REPLAY(glGetShaderiv, shader, pname, &value);
+        break;
+    }
+    case Op::GetShaderInfoLog: {
+        const GLuint shader = name(m_shaders, r.U32());
+        const GLsizei maxLength = std::max(1, r.I32());
+        m_scratch.resize(static_cast<std::size_t>(maxLength));
+        WXGL_REPLAY(glGetShaderInfoLog, shader, maxLength, nullptr, reinterpret_cast<GLchar*>(m_scratch.data()));
+        break;
+    }
+    case Op::DeleteShader: {
+        const GLuint captured = r.U32();
+        const GLuint shader = name(m_shaders, captured);
+        WXGL_REPLAY(glDeleteShader, shader);
+        if (execute) m_shaders.erase(captured);
+        break;
+    }
+    case Op::CreateProgram: {
+        const GLuint captured = r.U32();
+        if (execute && !r.bad) {
+            m_programs[captured] = glCreateProgram();
+            ++m_calls;
+        }
+        break;
+    }
+    case Op::AttachShader: {
+        const GLuint program = name(m_programs, r.U32());
+        const GLuint shader = name(m_shaders, r.U32());
+        WXGL_REPLAY(glAttachShader, program, shader);
+        break;
+    }
+    case Op::LinkProgram: {
+        const GLuint program = name(m_programs, r.U32());
+        WXGL_REPLAY(glLinkProgram, program);
+        break;
+    }
+    case Op::GetProgramiv: {
+        const GLuint program = name(m_programs, r.U32());
+        const GLenum pname = r.U32();
+        GLint value = 0;
+        WXGL_REPLAY(glGetProgramiv, program, pname, &value);
+        break;
+    }
+    case Op::GetProgramInfoLog: {
+        const GLuint program = name(m_programs, r.U32());
+        const GLsizei maxLength = std::max(1, r.I32());
+        m_scratch.resize(static_cast<std::size_t>(maxLength));
+        WXGL_REPLAY(glGetProgramInfoLog, program, maxLength, nullptr, reinterpret_cast<GLchar*>(m_scratch.data()));
+        break;
+    }
+    case Op::UseProgram: {
+        const GLuint captured = r.U32();
+        if (execute) m_program = captured;
+        const GLuint program = name(m_programs, captured);
+        WXGL_REPLAY(glUseProgram, program);
+        break;
+    }
+    case Op::DeleteProgram: {
+        const GLuint captured = r.U32();
+        const GLuint program = name(m_programs, captured);
+        WXGL_REPLAY(glDeleteProgram, program);
+        if (execute) m_programs.erase(captured);
+        break;
+    }
+
+    case Op::BindAttribLocation: {
+        const GLuint program = name(m_programs, r.U32());
+        const GLuint index = r.U32();
+        const std::string attribName = r.Str();
+        if (r.bad)
+            break;
+        WXGL_REPLAY(glBindAttribLocation, program, index, attribName.c_str());
+        break;
+    }
+    case Op::MaxShaderCompilerThreadsKHR: {
+        const GLuint count = r.U32();
+        WXGL_REPLAY(glMaxShaderCompilerThreadsKHR, count);
+        break;
+    }
+    case Op::DrawElementsInstanced: {
+        const GLenum mode = r.U32();
+        const GLsizei count = r.I32();
+        const GLenum type = r.U32();
+        const std::uint64_t offset = r.U64();
+        const GLsizei instances = r.I32();
+        WXGL_REPLAY(glDrawElementsInstanced, mode, count, type, AsPointer(offset), instances);
+        break;
+    }
+    case Op::GetIntegerv:
+        // Read-only, and the result size depends on pname: not issued.
+        (void)r.U32();
+        break;
+    case Op::GetStringi: {
+        const GLenum which = r.U32();
+        const GLuint index = r.U32();
+        WXGL_REPLAY(glGetStringi, which, index);
+        break;
+    }
+
+    case Op::GetUniformLocation:
+    case Op::GetAttribLocation: {
+        const GLuint capturedProgram = r.U32();
+        const std::string uniformName = r.Str();
+        const GLint captured = r.I32();
+        if (!execute || r.bad)
+            break;
+        const GLuint program = name(m_programs, capturedProgram);
+        ++m_calls;
+        if (static_cast<Op>(code) == Op::GetUniformLocation) {
+            const GLint loc = glGetUniformLocation(program, uniformName.c_str());
+            if (captured >= 0)
+                m_uniforms[(static_cast<std::uint64_t>(capturedProgram) << 32) | static_cast<std::uint32_t>(captured)] = loc;
+        } else {
+            const GLint loc = glGetAttribLocation(program, uniformName.c_str());
+            if (captured >= 0 && loc >= 0)
+                m_attribs[static_cast<GLuint>(captured)] = static_cast<GLuint>(loc);
+        }
+        break;
+    }
+    case Op::Uniform1i: {
+        const GLint loc = uniform(r.I32());
+        const GLint v0 = r.I32();
+        WXGL_REPLAY(glUniform1i, loc, v0);
+        break;
+    }
+    case Op::UniformMatrix4fv: {
+        const GLint loc = uniform(r.I32());
+        const GLsizei count = r.I32();
+        const GLboolean transpose = static_cast<GLboolean>(r.U32());
+        std::uint32_t n = 0;
+        const GLfloat* value = static_cast<const GLfloat*>(r.Blob(n));
+        if (value && n >= static_cast<std::uint32_t>(count) * 16 * sizeof(GLfloat))
+            WXGL_REPLAY(glUniformMatrix4fv, loc, count, transpose, value);
+        break;
+    }
+    case Op::Uniform4f: {
+        const GLint loc = uniform(r.I32());
+        const float v0 = r.F32(), v1 = r.F32(), v2 = r.F32(), v3 = r.F32();
+        WXGL_REPLAY(glUniform4f, loc, v0, v1, v2, v3);
+        break;
+    }
+    case Op::Uniform1f: {
+        const GLint loc = uniform(r.I32());
+        const float v0 = r.F32();
+        WXGL_REPLAY(glUniform1f, loc, v0);
+        break;
+    }
+    case Op::Uniform2f: {
+        const GLint loc = uniform(r.I32());
+        const float v0 = r.F32(), v1 = r.F32();
+        WXGL_REPLAY(glUniform2f, loc, v0, v1);
+        break;
+    }
+    case Op::GetActiveUniform:
+    case Op::GetActiveAttrib: {
+        const GLuint program = name(m_programs, r.U32());
+        const GLuint index = r.U32();
+        const GLsizei bufSize = std::max(1, r.I32());
+        m_scratch.resize(static_cast<std::size_t>(bufSize));
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        GLchar* out = reinterpret_cast<GLchar*>(m_scratch.data());
+        if (static_cast<Op>(code) == Op::GetActiveUniform)
+            WXGL_REPLAY(glGetActiveUniform, program, index, bufSize, &length, &size, &type, out);
+        else
+            WXGL_REPLAY(glGetActiveAttrib, program, index, bufSize, &length, &size, &type, out);
+        break;
+    }
+
+    case Op::GenTextures:    gen(r, execute, m_textures, glGenTextures); break;
+    case Op::DeleteTextures: del(r, execute, m_textures, glDeleteTextures); break;
+    case Op::BindTexture: {
+        const GLenum target = r.U32();
+        const GLuint id = name(m_textures, r.U32());
+        WXGL_REPLAY(glBindTexture, target, id);
+        break;
+    }
+    case Op::TexImage2D:
+    case Op::TexSubImage2D: {
+        const bool full = static_cast<Op>(code) == Op::TexImage2D;
+        const GLenum target = r.U32();
+        const GLint level = r.I32();
+        const GLint a = r.I32();   // internalformat | xoffset
+        const GLint b = full ? 0 : r.I32();   // yoffset
+        const GLsizei w = r.I32(), h = r.I32();
+        const GLint border = full ? r.I32() : 0;
+        const GLenum format = r.U32(), type = r.U32();
+        const void* pixels = nullptr;
+        if (r.U8()) {
+            pixels = AsPointer(r.U64());
+        } else {
+            std::uint32_t n = 0;
+            pixels = r.Blob(n);
+        }
+        if (full)
+            WXGL_REPLAY(glTexImage2D, target, level, a, w, h, border, format, type, pixels);
+        else
+            WXGL_REPLAY(glTexSubImage2D, target, level, a, b, w, h, format, type, pixels);
+        break;
+    }
+    case Op::PixelStorei: {
+        const GLenum pname = r.U32();
+        const GLint param = r.I32();
+        if (execute) {
+            switch (pname) {
+            case 0x0D05: m_pack.alignment  = param; break;   // GL_PACK_ALIGNMENT
+            case 0x0D02: m_pack.rowLength  = param; break;   // GL_PACK_ROW_LENGTH
+            case 0x0D03: m_pack.skipRows   = param; break;   // GL_PACK_SKIP_ROWS
+            case 0x0D04: m_pack.skipPixels = param; break;   // GL_PACK_SKIP_PIXELS
+            default: break;
+            }
+        }
+        WXGL_REPLAY(glPixelStorei, pname, param);
+        break;
+    }
+    case Op::TexParameteri: {
+        const GLenum target = r.U32(), pname = r.U32();
+        const GLint param = r.I32();
+        WXGL_REPLAY(glTexParameteri, target, pname, param);
+        break;
+    }
+    case Op::ActiveTexture: {
+        const GLenum unit = r.U32();
+        WXGL_REPLAY(glActiveTexture, unit);
+        break;
+    }
+
+    case Op::DrawArrays: {
+        const GLenum mode = r.U32();
+        const GLint first = r.I32();
+        const GLsizei count = r.I32();
+        WXGL_REPLAY(glDrawArrays, mode, first, count);
+        break;
+    }
+    case Op::DrawElements: {
+        const GLenum mode = r.U32();
+        const GLsizei count = r.I32();
+        const GLenum type = r.U32();
+        const std::uint64_t offset = r.U64();
+        WXGL_REPLAY(glDrawElements, mode, count, type, AsPointer(offset));
+        break;
+    }
+    case Op::DrawArraysInstanced: {
+        const GLenum mode = r.U32();
+        const GLint first = r.I32();
+        const GLsizei count = r.I32(), instances = r.I32();
+        WXGL_REPLAY(glDrawArraysInstanced, mode, first, count, instances);
+        break;
+    }
+    case Op::VertexAttribDivisor: {
+        const GLuint index = attrib(r.U32());
+        const GLuint divisor = r.U32();
+        WXGL_REPLAY(glVertexAttribDivisor, index, divisor);
+        break;
+    }
+
+    case Op::GenQueries:    gen(r, execute, m_queries, glGenQueries); break;
+    case Op::DeleteQueries: del(r, execute, m_queries, glDeleteQueries); break;
+    case Op::BeginQuery: {
+        const GLenum target = r.U32();
+        const GLuint id = name(m_queries, r.U32());
+        WXGL_REPLAY(glBeginQuery, target, id);
+        break;
+    }
+    case Op::EndQuery: {
+        const GLenum target = r.U32();
+        WXGL_REPLAY(glEndQuery, target);
+        break;
+    }
+    case Op::GetQueryObjectiv:
+    case Op::GetQueryObjectui64v: {
+        const GLuint id = name(m_queries, r.U32());
+        const GLenum pname = r.U32();
+        if (!execute || !glGetQueryObjectiv)
+            break;
+        // The capture read results only once available; never block here.
+        GLint available = 1;
+        if (pname == kQueryResult) {
+            glGetQueryObjectiv(id, kQueryResultAvailable, &available);
+            if (!available) {
+                ++m_skipped;
+                break;
+            }
+        }
+        GLint value = 0;
+        GLuint64 value64 = 0;
+        if (static_cast<Op>(code) == Op::GetQueryObjectiv)
+            WXGL_REPLAY(glGetQueryObjectiv, id, pname, &value);
+        else
+            WXGL_REPLAY(glGetQueryObjectui64v, id, pname, &value64);
+        break;
+    }
+
+    case Op::ReadPixels: {
+        const GLint x = r.I32(), y = r.I32();
+        const GLsizei w = r.I32(), h = r.I32();
+        const GLenum format = r.U32(), type = r.U32();
+        const bool toBuffer = r.U8() != 0;
+        const std::uint64_t offset = r.U64();
+        void* dst = const_cast<void*>(AsPointer(offset));
+        if (execute && !toBuffer) {
+            m_scratch.resize(static_cast<std::size_t>(gltrace::ImageBytes(w, h, format, type, m_pack)));
+            dst = m_scratch.empty() ? nullptr : m_scratch.data();
+            if (!dst) {
+                ++m_skipped;
+                break;
+            }
+        }
+        WXGL_REPLAY(glReadPixels, x, y, w, h, format, type, dst);
+        break;
+    }
+    case Op::Finish:
+        if (execute) {
+            glFinish();
+            ++m_calls;
+        }
+        break;
+
+    case Op::GenFramebuffers:    gen(r, execute, m_fbos, glGenFramebuffers); break;
+    case Op::DeleteFramebuffers: del(r, execute, m_fbos, glDeleteFramebuffers); break;
+    case Op::BindFramebuffer: {
+        const GLenum target = r.U32();
+        const GLuint captured = r.U32();
+        const GLuint fbo = captured ? name(m_fbos, captured) : m_defaultFbo;
+        WXGL_REPLAY(glBindFramebuffer, target, fbo);
+        break;
+    }
+    case Op::CheckFramebufferStatus: {
+        const GLenum target = r.U32();
+        WXGL_REPLAY(glCheckFramebufferStatus, target);
+        break;
+    }
+    case Op::FramebufferRenderbuffer: {
+        const GLenum target = r.U32(), attachment = r.U32(), rbTarget = r.U32();
+        const GLuint rb = name(m_rbos, r.U32());
+        WXGL_REPLAY(glFramebufferRenderbuffer, target, attachment, rbTarget, rb);
+        break;
+    }
+    case Op::GenRenderbuffers:    gen(r, execute, m_rbos, glGenRenderbuffers); break;
+    case Op::DeleteRenderbuffers: del(r, execute, m_rbos, glDeleteRenderbuffers); break;
+    case Op::BindRenderbuffer: {
+        const GLenum target = r.U32();
+        const GLuint rb = name(m_rbos, r.U32());
+        WXGL_REPLAY(glBindRenderbuffer, target, rb);
+        break;
+    }
+    case Op::RenderbufferStorage: {
+        const GLenum target = r.U32(), internalformat = r.U32();
+        const GLsizei w = r.I32(), h = r.I32();
+        WXGL_REPLAY(glRenderbufferStorage, target, internalformat, w, h);
+        break;
+    }
+
+    case Op::MapBufferRange: {
+        const GLenum target = r.U32();
+        const std::uint64_t offset = r.U64(), length = r.U64();
+        const GLbitfield access = r.U32() & ~static_cast<GLbitfield>(GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!execute)
+            break;
+        if (!glMapBufferRange) {
+            ++m_skipped;
+            break;
+        }
+        m_mapped[target] = glMapBufferRange(target, static_cast<GLintptr>(offset),
+                                            static_cast<GLsizeiptr>(length), access);
+        ++m_calls;
+        break;
+    }
+    case Op::UnmapBuffer: {
+        const GLenum target = r.U32();
+        std::uint32_t n = 0;
+        const void* data = r.Blob(n);
+        if (!execute)
+            break;
+        const auto it = m_mapped.find(target);
+        if (!glUnmapBuffer || it == m_mapped.end() || !it->second) {
+            ++m_skipped;
+            break;
+        }
+        if (n)
+            std::memcpy(it->second, data, n);
+        m_mapped.erase(it);
+        glUnmapBuffer(target);
+        ++m_calls;
+        break;
+    }
+    case Op::FenceSync: {
+        const GLenum condition = r.U32();
+        const GLbitfield flags = r.U32();
+        const std::uint64_t captured = r.U64();
+        if (!execute)
+            break;
+        if (!glFenceSync) {
+            ++m_skipped;
+            break;
+        }
+        m_syncs[captured] = glFenceSync(condition, flags);
+        ++m_calls;
+        break;
+    }
+    case Op::ClientWaitSync: {
+        const std::uint64_t captured = r.U64();
+        const GLbitfield flags = r.U32();
+        const std::uint64_t timeout = r.U64();
+        const auto it = m_syncs.find(captured);
+        if (execute && it == m_syncs.end()) {
+            ++m_skipped;
+            break;
+        }
+        WXGL_REPLAY(glClientWaitSync, static_cast<GLsync>(it->second), flags, timeout);
+        break;
+    }
+    case Op::DeleteSync: {
+        const std::uint64_t captured = r.U64();
+        const auto it = m_syncs.find(captured);
+        if (execute && it == m_syncs.end()) {
+            ++m_skipped;
+            break;
+        }
+        WXGL_REPLAY(glDeleteSync, static_cast<GLsync>(it->second));
+        if (execute)
+            m_syncs.erase(it);
+        break;
+    }
+
+    case Op::Count:
+        break;
+    }
+
+    if (r.bad)
+        return fail("truncated record " + std::to_string(code));
+    return true;
+}
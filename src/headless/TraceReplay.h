@@ -0,0 +1,105 @@
+// src/headless/TraceReplay.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "render/GlTraceFormat.h"
+
+/**
+ * TraceReplay
+ * Plays a GlTrace capture back on the current GL context, frame by frame.
+ *
+ * - Load(path): read the whole trace into memory (no I/O while replaying),
+ *   check the header and pre-scan frames, info records and viewport extent.
+ * - Begin(fbo): reset name tables; the capture's window-system framebuffer
+ *   (name 0) is redirected to 'fbo', e.g. an OffscreenTarget.
+ * - NextFrame(): issue the calls up to the next frame marker.
+ *
+ * Object names, uniform locations and attribute locations are remapped to
+ * the ones the replaying driver hands out. Query results that are not yet
+ * available are not waited for (the capture never blocked on them either).
+ * Buffer mappings are replayed synchronized (GL_MAP_UNSYNCHRONIZED_BIT is
+ * dropped): the replay does not act on fence results, so it must not
+ * overwrite data the GPU still reads.
+ */
+class TraceReplay
+{
+public:
+    bool Load(const std::string& path);
+    void Begin(unsigned defaultFbo);
+
+    // False at the end of the trace or on a malformed record (see LastError()).
+    bool NextFrame();
+
+    int  FrameCount() const { return m_frameCount; }
+    int  FramesReplayed() const { return m_frame; }
+    std::uint64_t Calls() const { return m_calls; }
+    std::uint64_t Skipped() const { return m_skipped; }   // calls without a usable target
+
+    // Smallest framebuffer size covering every captured viewport.
+    int ExtentWidth()  const { return m_extentW; }
+    int ExtentHeight() const { return m_extentH; }
+
+    const std::vector<std::pair<std::string, std::string>>& Info() const { return m_info; }
+    const std::string& LastError() const { return m_error; }
+
+private:
+    using NameMap = std::unordered_map<unsigned, unsigned>;
+
+    struct Reader {
+        const unsigned char* p   {nullptr};
+        const unsigned char* end {nullptr};
+        bool bad {false};
+
+        bool Take(void* out, std::size_t n);
+        std::uint8_t  U8();
+        std::uint32_t U32();
+        std::int32_t  I32();
+        float         F32();
+        std::uint64_t U64();
+        const void*   Blob(std::uint32_t& size);   // nullptr for an empty blob
+        std::string   Str();
+    };
+
+    // Decodes one record; issues it when 'execute', else only scans it.
+    // Returns false at the end of data or on error; sets 'frameEnd'.
+    bool step(Reader& r, bool execute, bool& frameEnd);
+    bool fail(const std::string& what);
+
+    // glGen*/glDelete* records; 'fn' is the matching glad entry point.
+    template <typename Fn> void gen(Reader& r, bool execute, NameMap& map, Fn fn);
+    template <typename Fn> void del(Reader& r, bool execute, NameMap& map, Fn fn);
+    unsigned name(const NameMap& map, unsigned captured);
+    int uniform(int capturedLoc) const;
+    unsigned attrib(unsigned capturedIndex) const;
+
+private:
+    std::vector<unsigned char> m_data;
+    std::size_t m_bodyStart {0};
+    Reader m_reader;
+
+    std::vector<std::pair<std::string, std::string>> m_info;
+    int m_frameCount {0};
+    int m_extentW {0};
+    int m_extentH {0};
+
+    // Replay state
+    int m_frame {0};
+    std::uint64_t m_calls   {0};
+    std::uint64_t m_skipped {0};
+    unsigned m_defaultFbo {0};
+    NameMap m_buffers, m_vaos, m_textures, m_shaders, m_programs, m_queries, m_fbos, m_rbos;
+    std::unordered_map<std::uint64_t, int> m_uniforms;   // (program << 32 | location) -> location
+    std::unordered_map<std::uint64_t, void*> m_syncs;    // captured GLsync -> replay GLsync
+    std::unordered_map<unsigned, void*> m_mapped;        // target -> replay mapping
+    NameMap  m_attribs;                                  // captured index -> replay index
+    unsigned m_program {0};                              // captured name of the bound program
+    gltrace::PixelStore m_pack;
+    std::vector<unsigned char> m_scratch;
+
+    std::string m_error;
+};
@@ -0,0 +1,203 @@
+// src/headless/main.cpp
+// wxgl_offscreen: renders the demo scene without a window or wxWidgets and
+// reports per-frame cost. Usable on GPU-less hosts with Mesa llvmpipe.
+//
+//   wxgl_offscreen [--size=WxH] [--frames=N] [--instances=N] [--spin=DEG]
+//                  [--out=frame.ppm] [--profile=timings.json|.csv] [--trace=frames.wxtrace]
+//                  [--program-cache=DIR]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "headless/HeadlessContext.h"
+#include "headless/ImageFile.h"
+#include "render/GlTrace.h"
+#include "render/LatencyStats.h"
+#include "render/OffscreenTarget.h"
+#include "render/Profiler.h"
+#include "render/ProgramCache.h"
+#include "render/Renderer.h"
+#include "render/ShaderBatch.h"
+
+#include "glad/glad.h"
+
+namespace {
+struct Options {
+    int    width     {1024};
+    int    height    {640};
+    int    frames    {120};
+    int    instances {0};
+    double spin      {3.0};   // degrees per frame
+    std::string out;
+    std::string profile;
+    std::string trace;
+    std::string programCache;   // must exist
+};
+
+bool Value(const char* arg, const char* name, const char*& value)
+{
+    const std::size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=')
+        return false;
+    value = arg + n + 1;
+    return true;
+}
+
+bool ParseArgs(int argc, char** argv, Options& o)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* v = nullptr;
+        if (Value(argv[i], "--size", v)) {
+            if (std::sscanf(v, "%dx%d", &o.width, &o.height) != 2 || o.width <= 0 || o.height <= 0)
+                return false;
+        } else if (Value(argv[i], "--frames", v)) {
+            o.frames = std::atoi(v);
+        } else if (Value(argv[i], "--instances", v)) {
+            o.instances = std::atoi(v);
+        } else if (Value(argv[i], "--spin", v)) {
+            o.spin = std::atof(v);
+        } else if (Value(argv[i], "--out", v)) {
+            o.out = v;
+        } else if (Value(argv[i], "--profile", v)) {
+            o.profile = v;
+        } else if (Value(argv[i], "--trace", v)) {
+            o.trace = v;
+        } else if (Value(argv[i], "--program-cache", v)) {
+            o.programCache = v;
+        } else {
+            return false;
+        }
+    }
+    return o.frames > 0;
+}
+
+std::string ResourceDir()
+{
+#ifdef APP_RESOURCE_DIR
+    return APP_RESOURCE_DIR;
+#else
+    return "resources";
+#endif
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s [--size=WxH] [--frames=N] [--instances=N] [--spin=DEG]\n"
+                     "          [--out=frame.ppm] [--profile=timings.json|.csv] [--trace=frames.wxtrace]\n"
+                     "          [--program-cache=DIR]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    HeadlessContext context;
+    if (!context.Create()) {
+        std::fprintf(stderr, "Headless GL context: %s\n", context.LastError().c_str());
+        return 1;
+    }
+    std::printf("Context: %s\n", context.Description().c_str());
+
+    if (!opt.profile.empty())
+        Profiler::SetEnabled(true);
+    // Every frame of the run; the capture attaches in Renderer::Initialize().
+    if (!opt.trace.empty() && !GlTrace::Start(opt.trace, opt.frames)) {
+        std::fprintf(stderr, "Cannot trace to %s: %s\n", opt.trace.c_str(), GlTrace::LastError().c_str());
+        return 1;
+    }
+
+    int status = 0;
+    {
+        // Renderer and target hold GL objects: destroy them before the context.
+        Renderer renderer;
+        renderer.SetProgramCacheDir(opt.programCache);
+        const std::int64_t initStart = LatencyStats::NowNs();
+        if (!renderer.Initialize()) {
+            std::fprintf(stderr, "Renderer initialization failed.\n");
+            return 1;
+        }
+        const double initMs = (LatencyStats::NowNs() - initStart) / 1e6;
+        std::printf("Initialize: %.3f ms\n", initMs);
+        if (const ProgramCache* programs = renderer.GetProgramCache()) {
+            const ProgramCache::Stats& s = programs->GetStats();
+            std::printf("Program cache %s: %llu hits, %llu stored, %llu rejected%s\n",
+                        programs->Directory().c_str(), static_cast<unsigned long long>(s.hits),
+                        static_cast<unsigned long long>(s.stored), static_cast<unsigned long long>(s.rejected),
+                        programs->Supported() ? "" : " (bypassed)");
+        }
+
+        OffscreenTarget target;
+        if (!target.Create(opt.width, opt.height)) {
+            std::fprintf(stderr, "Cannot create a %dx%d framebuffer object.\n", opt.width, opt.height);
+            return 1;
+        }
+        target.Bind();
+
+        const std::string icons = ResourceDir() + "/icons";
+        (void)renderer.LoadOverlayIcon(icons + "/toggle.png");
+        renderer.SetGpuTiming(!opt.profile.empty());
+        renderer.Resize(opt.width, opt.height, 1.0f);
+        renderer.SetInstanceCount(opt.instances);
+        // The framebuffer keeps its contents: partial redraws are valid.
+        renderer.SetBufferAge(1);
+
+        LatencyStats frameMs;
+        int fallbackFrames = 0;
+        double programsMs = renderer.PendingPrograms() == 0 ? initMs : -1.0;
+        for (int i = 0; i < opt.frames; ++i) {
+            const std::int64_t start = LatencyStats::NowNs();
+            renderer.SetRotation(static_cast<float>(opt.spin * i));
+            renderer.Render();
+            glFinish();   // count the rasterization, not just the submission
+            frameMs.AddSince(start, LatencyStats::NowNs());
+            WXGL_PROFILE_FRAME();
+            if (renderer.PendingPrograms() != 0)
+                ++fallbackFrames;
+            else if (programsMs < 0.0)
+                programsMs = (LatencyStats::NowNs() - initStart) / 1e6;
+        }
+        if (const ShaderBatch* programs = renderer.GetShaderBatch()) {
+            std::printf("Programs: %d ready, %d failed, all linked %.3f ms after Initialize() started "
+                        "(%d fallback frames, %s)\n",
+                        programs->GetStats().ready, programs->GetStats().failed, programsMs, fallbackFrames,
+                        programs->Parallel() ? "KHR_parallel_shader_compile" : "serial");
+        }
+
+        const LatencyStats::Summary s = frameMs.Summarize();
+        std::printf("%dx%d, %d frames (last %zu): mean %.3f ms, p95 %.3f ms, max %.3f ms\n",
+                    opt.width, opt.height, opt.frames, s.count, s.mean, s.p95, s.max);
+
+        if (!opt.out.empty()) {
+            std::vector<unsigned char> rgba;
+            if (!target.ReadPixels(rgba) || !wxgl::WritePpm(opt.out, target.width(), target.height(), rgba)) {
+                std::fprintf(stderr, "Cannot write %s\n", opt.out.c_str());
+                status = 1;
+            } else {
+                std::printf("Wrote %s\n", opt.out.c_str());
+            }
+        }
+    }
+
+    if (!opt.trace.empty()) {
+        const GlTrace::Stats t = GlTrace::Stop();
+        if (!GlTrace::LastError().empty()) {
+            std::fprintf(stderr, "Trace %s: %s\n", opt.trace.c_str(), GlTrace::LastError().c_str());
+            status = 1;
+        }
+        std::printf("Trace: %d frames, %llu calls, %.1f MiB -> %s\n", t.frames,
+                    static_cast<unsigned long long>(t.calls), t.bytes / (1024.0 * 1024.0), opt.trace.c_str());
+        if (t.unsupported)
+            std::printf("Trace: %llu calls cannot be replayed exactly\n",
+                        static_cast<unsigned long long>(t.unsupported));
+    }
+    if (!opt.profile.empty() && !Profiler::Instance().Export(opt.profile)) {
+        std::fprintf(stderr, "Cannot write frame timings to %s\n", opt.profile.c_str());
+        status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,184 @@
+// src/headless/replay_main.cpp
+// wxgl_replay: plays a GL trace (GlTrace, e.g. wxgl_offscreen --trace or the
+// demo's --trace) back headless, as fast as possible, and reports the cost of
+// every frame. Lets a slow frame recorded elsewhere be reproduced offline.
+//
+//   wxgl_replay trace.wxtrace [--size=WxH] [--no-finish] [--csv=frames.csv]
+//                             [--out=last.ppm]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "headless/HeadlessContext.h"
+#include "headless/ImageFile.h"
+#include "headless/TraceReplay.h"
+#include "render/LatencyStats.h"
+#include "render/OffscreenTarget.h"
+#include "render/Util.h"
+
+#include "glad/glad.h"
+
+namespace {
+struct Options {
+    std::string trace;
+    int  width  {0};   // 0 = from the captured viewports
+    int  height {0};
+    bool finish {true};
+    std::string csv;
+    std::string out;
+};
+
+bool Value(const char* arg, const char* name, const char*& value)
+{
+    const std::size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=')
+        return false;
+    value = arg + n + 1;
+    return true;
+}
+
+bool ParseArgs(int argc, char** argv, Options& o)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* v = nullptr;
+        if (Value(argv[i], "--size", v)) {
+            if (std::sscanf(v, "%dx%d", &o.width, &o.height) != 2 || o.width <= 0 || o.height <= 0)
+                return false;
+        } else if (std::strcmp(argv[i], "--no-finish") == 0) {
+            o.finish = false;
+        } else if (Value(argv[i], "--csv", v)) {
+            o.csv = v;
+        } else if (Value(argv[i], "--out", v)) {
+            o.out = v;
+        } else if (argv[i][0] != '-' && o.trace.empty()) {
+            o.trace = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return !o.trace.empty();
+}
+
+// Whatever the trace rendered into last (its own FBO or the window stand-in).
+bool SaveCurrentFramebuffer(const std::string& path, int w, int h)
+{
+    std::vector<unsigned char> rgba(static_cast<std::size_t>(w) * h * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    const std::size_t row = static_cast<std::size_t>(w) * 4;
+    std::vector<unsigned char> flipped(rgba.size());
+    for (int y = 0; y < h; ++y)
+        std::memcpy(&flipped[static_cast<std::size_t>(y) * row],
+                    &rgba[static_cast<std::size_t>(h - 1 - y) * row], row);
+    return wxgl::WritePpm(path, w, h, flipped);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s trace.wxtrace [--size=WxH] [--no-finish] [--csv=frames.csv]\n"
+                     "          [--out=last.ppm]\n", argv[0]);
+        return 2;
+    }
+
+    TraceReplay trace;
+    if (!trace.Load(opt.trace)) {
+        std::fprintf(stderr, "%s\n", trace.LastError().c_str());
+        return 1;
+    }
+    for (const auto& kv : trace.Info())
+        std::printf("Captured %s: %s\n", kv.first.c_str(), kv.second.c_str());
+
+    HeadlessContext context;
+    if (!context.Create()) {
+        std::fprintf(stderr, "Headless GL context: %s\n", context.LastError().c_str());
+        return 1;
+    }
+    if (!gladLoadGL()) {
+        std::fprintf(stderr, "Cannot load OpenGL entry points.\n");
+        return 1;
+    }
+    std::printf("Replaying on %s | %s\n", reinterpret_cast<const char*>(glGetString(0x1F01)),
+                reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    const int w = opt.width  ? opt.width  : std::max(1, trace.ExtentWidth());
+    const int h = opt.height ? opt.height : std::max(1, trace.ExtentHeight());
+
+    int status = 0;
+    {
+        // Stands in for the window-system framebuffer of the capture.
+        OffscreenTarget target;
+        if (!target.Create(w, h)) {
+            std::fprintf(stderr, "Cannot create a %dx%d framebuffer object.\n", w, h);
+            return 1;
+        }
+        target.Bind();
+        trace.Begin(target.fbo());
+
+        std::vector<double> frameMs;
+        frameMs.reserve(static_cast<std::size_t>(trace.FrameCount()));
+        for (;;) {
+            const std::int64_t start = LatencyStats::NowNs();
+            if (!trace.NextFrame())
+                break;
+            if (opt.finish)
+                glFinish();   // count the rasterization, not just the submission
+            frameMs.push_back(static_cast<double>(LatencyStats::NowNs() - start) * 1e-6);
+        }
+        if (!trace.LastError().empty()) {
+            std::fprintf(stderr, "Replay stopped after frame %d: %s\n", trace.FramesReplayed(),
+                         trace.LastError().c_str());
+            status = 1;
+        }
+
+        std::printf("%dx%d, %d frames, %llu calls", w, h, trace.FramesReplayed(),
+                    static_cast<unsigned long long>(trace.Calls()));
+        if (trace.Skipped())
+            std::printf(" (%llu skipped)", static_cast<unsigned long long>(trace.Skipped()));
+        std::printf("\n");
+
+        if (!frameMs.empty()) {
+            // The first frame also creates every resource: report it apart.
+            std::printf("first frame (incl. setup): %.3f ms\n", frameMs.front());
+            std::vector<double> rest(frameMs.begin() + 1, frameMs.end());
+            if (!rest.empty()) {
+                std::sort(rest.begin(), rest.end());
+                double sum = 0.0;
+                for (double ms : rest)
+                    sum += ms;
+                std::printf("frames 2..%zu: mean %.3f ms, median %.3f ms, p95 %.3f ms, max %.3f ms\n",
+                            frameMs.size(), sum / static_cast<double>(rest.size()), Util::Percentile(rest, 0.5),
+                            Util::Percentile(rest, 0.95), rest.back());
+            }
+        }
+
+        if (!opt.csv.empty()) {
+            std::FILE* f = std::fopen(opt.csv.c_str(), "w");
+            if (f) {
+                std::fprintf(f, "frame,ms\n");
+                for (std::size_t i = 0; i < frameMs.size(); ++i)
+                    std::fprintf(f, "%zu,%.4f\n", i + 1, frameMs[i]);
+            }
+            if (!f || std::fclose(f) != 0) {
+                std::fprintf(stderr, "Cannot write %s\n", opt.csv.c_str());
+                status = 1;
+            }
+        }
+
+        if (!opt.out.empty()) {
+            if (SaveCurrentFramebuffer(opt.out, w, h)) {
+                std::printf("Wrote %s\n", opt.out.c_str());
+            } else {
+                std::fprintf(stderr, "Cannot write %s\n", opt.out.c_str());
+                status = 1;
+            }
+        }
+    }
+    return status;
+}
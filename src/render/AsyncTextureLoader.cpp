@@ -0,0 +1,171 @@
+// src/render/AsyncTextureLoader.cpp
+#include "AsyncTextureLoader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "LatencyStats.h"
+#include "Profiler.h"
+#include "Texture.h"
+
+const int AsyncTextureLoader::kMaxWorkers;
+
+AsyncTextureLoader::AsyncTextureLoader(int workers)
+{
+    if (workers <= 0)
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    m_workerCount = std::max(1, std::min(workers, kMaxWorkers));
+}
+
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_jobs.clear();
+    }
+    m_cv.notify_all();
+    for (std::thread& t : m_workers)
+        t.join();
+}
+
+AsyncTextureLoader::Ticket AsyncTextureLoader::Request(const std::string& path, bool flipY,
+                                                       Completion done)
+{
+    Ticket ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ticket = m_nextTicket++;
+
+        Job job;
+        job.ticket = ticket;
+        job.path   = path;
+        job.flipY  = flipY;
+        job.cache  = m_cache;
+        job.done   = std::move(done);
+        m_jobs.push_back(std::move(job));
+        ++m_stats.requested;
+
+        if (m_workers.empty())
+            startWorkers();
+    }
+    m_cv.notify_one();
+    return ticket;
+}
+
+void AsyncTextureLoader::SetReadyCallback(std::function<void()> notify)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_notify = std::move(notify);
+}
+
+void AsyncTextureLoader::SetCache(TextureCache* cache)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache = cache;
+}
+
+bool AsyncTextureLoader::HasReady() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_ready.empty();
+}
+
+std::size_t AsyncTextureLoader::Outstanding() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_decoding + m_ready.size();
+}
+
+AsyncTextureLoader::Stats AsyncTextureLoader::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void AsyncTextureLoader::startWorkers()
+{
+    for (int i = 0; i < m_workerCount; ++i)
+        m_workers.emplace_back(&AsyncTextureLoader::work, this);
+}
+
+void AsyncTextureLoader::work()
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_stop)
+                return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            ++m_decoding;
+        }
+
+        Result r;
+        r.image.ticket = job.ticket;
+        r.image.path   = job.path;
+        r.done         = std::move(job.done);
+        const std::int64_t start = LatencyStats::NowNs();
+        {
+            WXGL_PROFILE_SCOPE("AsyncTextureLoader::decode");
+            if (job.cache) {
+                r.image.ok     = job.cache->MapPixels(job.path, job.flipY, r.image.mapped);
+                r.image.width  = r.image.mapped.width();
+                r.image.height = r.image.mapped.height();
+            } else {
+                r.image.ok = Texture::DecodeFile(job.path, job.flipY, r.image.rgba, r.image.width, r.image.height);
+            }
+        }
+        r.image.decode_ms = static_cast<double>(LatencyStats::NowNs() - start) * 1e-6;
+
+        std::function<void()> notify;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_decoding;
+            m_stats.decode_ms += r.image.decode_ms;
+            if (m_stop)
+                return;
+            m_ready.push_back(std::move(r));
+            notify = m_notify;
+        }
+        if (notify)
+            notify();
+    }
+}
+
+int AsyncTextureLoader::Pump(double budgetMs)
+{
+    const std::int64_t start  = LatencyStats::NowNs();
+    const std::int64_t budget = static_cast<std::int64_t>(std::max(0.0, budgetMs) * 1e6);
+
+    int delivered = 0;
+    for (;;) {
+        Result r;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_ready.empty())
+                break;
+            r = std::move(m_ready.front());
+            m_ready.pop_front();
+        }
+
+        const std::int64_t t0 = LatencyStats::NowNs();
+        if (r.done)
+            r.done(r.image);
+        const std::int64_t t1 = LatencyStats::NowNs();
+        ++delivered;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.delivered;
+            if (!r.image.ok)
+                ++m_stats.failed;
+            m_stats.deliver_ms += static_cast<double>(t1 - t0) * 1e-6;
+        }
+
+        if (t1 - start >= budget)
+            break;
+    }
+    return delivered;
+}
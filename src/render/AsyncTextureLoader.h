@@ -0,0 +1,118 @@
+// src/render/AsyncTextureLoader.h
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TextureCache.h"
+
+/**
+ * AsyncTextureLoader
+ * Decodes image files (Texture::DecodeFile) on a small pool of worker
+ * threads and hands the pixels back on the GL thread. No GL calls here.
+ *
+ * - Request(path, flipY, done) returns a ticket at once; decoding happens
+ *   on a worker. Workers start with the first request, so a loader that is
+ *   never used costs no threads.
+ * - Pump(budgetMs), on the GL thread, runs the completions of finished
+ *   decodes (that is where callers upload) until the budget is used up; at
+ *   least one completion runs per call so loading always makes progress.
+ *   What is left waits for the next Pump(); HasReady() tells the host that
+ *   another frame is worth rendering.
+ * - SetReadyCallback(fn): 'fn' runs on a worker whenever a decode finishes,
+ *   e.g. to wake an idle GL thread. It must not block.
+ * - SetCache(cache): later requests read cooked pixels from a TextureCache
+ *   (cooking on a miss) instead of decoding, handed over in place from the
+ *   entry's mapping; the cache must outlive the loader.
+ *
+ * Destruction drops queued work and joins the workers; completions that
+ * did not run yet are discarded without being called.
+ */
+class AsyncTextureLoader
+{
+public:
+    using Ticket = std::uint64_t;
+
+    struct Image {
+        Ticket      ticket {0};
+        std::string path;
+        bool        ok {false};
+        int         width  {0};
+        int         height {0};
+        std::vector<unsigned char> rgba;   // decoded, tightly packed RGBA8
+        TextureCache::Pixels mapped;       // or: served by the cache, rgba empty
+        double      decode_ms {0.0};
+
+        const unsigned char* pixels() const { return mapped.data() ? mapped.data() : rgba.data(); }
+    };
+
+    // Runs inside Pump() on the GL thread; may take the pixels.
+    using Completion = std::function<void(Image&)>;
+
+    struct Stats {
+        std::uint64_t requested {0};
+        std::uint64_t delivered {0};
+        std::uint64_t failed    {0};
+        double decode_ms  {0.0};    // worker time, all decodes
+        double deliver_ms {0.0};    // GL-thread time spent in completions
+    };
+
+    // workers <= 0: hardware threads - 1, clamped to [1, kMaxWorkers].
+    explicit AsyncTextureLoader(int workers = 0);
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    static const int kMaxWorkers = 4;
+
+    // Any thread.
+    Ticket Request(const std::string& path, bool flipY, Completion done);
+    void   SetReadyCallback(std::function<void()> notify);
+    void   SetCache(TextureCache* cache);
+    bool   HasReady() const;
+    std::size_t Outstanding() const;   // requested, completion not run yet
+    Stats  GetStats() const;
+
+    // GL thread. Returns the number of completions run.
+    int Pump(double budgetMs);
+
+private:
+    struct Job {
+        Ticket      ticket {0};
+        std::string path;
+        bool        flipY {false};
+        TextureCache* cache {nullptr};
+        Completion  done;
+    };
+
+    struct Result {
+        Image      image;
+        Completion done;
+    };
+
+    void startWorkers();   // m_mutex held
+    void work();
+
+private:
+    int m_workerCount {1};
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job>         m_jobs;
+    std::deque<Result>      m_ready;
+    std::size_t             m_decoding {0};
+    bool                    m_stop {false};
+    Ticket                  m_nextTicket {1};
+    std::function<void()>   m_notify;
+    TextureCache*           m_cache {nullptr};
+    Stats                   m_stats;
+};
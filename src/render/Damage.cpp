@@ -0,0 +1,104 @@
+// src/render/Damage.cpp
+#include "Damage.h"
+
+#include <algorithm>
+
+namespace {
+bool TouchOrOverlap(const DamageRect& a, const DamageRect& b)
+{
+    return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+           a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+DamageRect Union(const DamageRect& a, const DamageRect& b)
+{
+    const int x0 = std::min(a.x, b.x);
+    const int y0 = std::min(a.y, b.y);
+    const int x1 = std::max(a.x + a.w, b.x + b.w);
+    const int y1 = std::max(a.y + a.h, b.y + b.h);
+    return DamageRect{ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Above this fraction of the target, one full pass is cheaper than scissoring.
+const double kFullThreshold = 0.75;
+} // namespace
+
+void DamageRegion::Clear()
+{
+    m_rects.clear();
+    m_full = false;
+}
+
+void DamageRegion::Add(const DamageRect& r)
+{
+    if (m_full || r.Empty())
+        return;
+
+    DamageRect cur = r;
+    // Absorb every rectangle the growing one touches, then insert it.
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (std::size_t i = 0; i < m_rects.size(); ++i) {
+            if (TouchOrOverlap(cur, m_rects[i])) {
+                cur = Union(cur, m_rects[i]);
+                m_rects[i] = m_rects.back();
+                m_rects.pop_back();
+                merged = true;
+                break;
+            }
+        }
+    }
+    m_rects.push_back(cur);
+
+    if (static_cast<int>(m_rects.size()) > kMaxRects)
+        collapse();
+}
+
+void DamageRegion::Add(const DamageRegion& other)
+{
+    if (other.m_full) {
+        SetFull();
+        return;
+    }
+    for (const DamageRect& r : other.m_rects)
+        Add(r);
+}
+
+void DamageRegion::ClipTo(int width, int height)
+{
+    if (m_full)
+        return;
+
+    std::vector<DamageRect> clipped;
+    clipped.reserve(m_rects.size());
+    for (const DamageRect& r : m_rects) {
+        const int x0 = std::max(r.x, 0);
+        const int y0 = std::max(r.y, 0);
+        const int x1 = std::min(r.x + r.w, width);
+        const int y1 = std::min(r.y + r.h, height);
+        if (x1 > x0 && y1 > y0)
+            clipped.push_back(DamageRect{ x0, y0, x1 - x0, y1 - y0 });
+    }
+    m_rects.swap(clipped);
+
+    const long long total = static_cast<long long>(width) * height;
+    if (total > 0 && Area() >= static_cast<long long>(kFullThreshold * static_cast<double>(total)))
+        SetFull();
+}
+
+long long DamageRegion::Area() const
+{
+    long long a = 0;
+    for (const DamageRect& r : m_rects)
+        a += r.Area();   // disjoint after merging
+    return a;
+}
+
+void DamageRegion::collapse()
+{
+    DamageRect box = m_rects.front();
+    for (const DamageRect& r : m_rects)
+        box = Union(box, r);
+    m_rects.assign(1, box);
+}
@@ -0,0 +1,56 @@
+// src/render/Damage.h
+#pragma once
+
+#include <vector>
+
+/**
+ * DamageRect
+ * Pixel rectangle in device pixels, top-left origin (same space as the
+ * overlay layout and canvas mouse events).
+ */
+struct DamageRect
+{
+    int x {0}, y {0}, w {0}, h {0};
+
+    bool Empty() const { return w <= 0 || h <= 0; }
+    long long Area() const { return Empty() ? 0 : static_cast<long long>(w) * h; }
+};
+
+/**
+ * DamageRegion
+ * A small set of dirty rectangles for one frame.
+ *
+ * - Add() merges a rectangle into any rectangle it overlaps or touches;
+ *   merging repeats until the set is disjoint.
+ * - When more than kMaxRects remain, everything collapses into the bounding
+ *   box (a few larger scissored passes beat many tiny ones).
+ * - SetFull() marks the whole target dirty; Full() regions ignore Add().
+ *
+ * No GL calls; Renderer turns the rectangles into glScissor passes.
+ */
+class DamageRegion
+{
+public:
+    static const int kMaxRects = 4;
+
+    void Clear();
+    void SetFull() { m_full = true; m_rects.clear(); }
+    void Add(const DamageRect& r);
+    void Add(const DamageRegion& other);
+
+    // Clip every rectangle to [0, width) x [0, height); promotes to Full()
+    // when the remaining area covers most of the target anyway.
+    void ClipTo(int width, int height);
+
+    bool Full() const  { return m_full; }
+    bool Empty() const { return !m_full && m_rects.empty(); }
+    const std::vector<DamageRect>& Rects() const { return m_rects; }
+    long long Area() const;
+
+private:
+    void collapse();
+
+private:
+    std::vector<DamageRect> m_rects;
+    bool m_full {false};
+};
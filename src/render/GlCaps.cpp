@@ -0,0 +1,91 @@
+// src/render/GlCaps.cpp
+#include "GlCaps.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "glad/glad.h"
+
+#include "GlState.h"
+
+bool GlCaps::HasVersion(int major, int minor)
+{
+    return GlState::Current().Caps().Version(major, minor);
+}
+
+bool GlCaps::HasExtension(const char* name)
+{
+    return GlState::Current().Caps().Extension(name);
+}
+
+bool GlCaps::HasToken(const char* list, const char* token)
+{
+    if (!list || !token || !*token)
+        return false;
+    const std::size_t n = std::strlen(token);
+    for (const char* p = list; (p = std::strstr(p, token)) != nullptr; p += n) {
+        const bool startOk = (p == list) || (p[-1] == ' ');
+        const bool endOk   = (p[n] == '\0') || (p[n] == ' ');
+        if (startOk && endOk)
+            return true;
+    }
+    return false;
+}
+
+bool GlCaps::Version(int major, int minor) const
+{
+    if (!load())
+        return false;
+    return m_major > major || (m_major == major && m_minor >= minor);
+}
+
+bool GlCaps::Extension(const char* name) const
+{
+    if (!name || !load())
+        return false;
+    return std::binary_search(m_extensions.begin(), m_extensions.end(), std::string(name));
+}
+
+void GlCaps::Reset()
+{
+    m_loaded = false;
+    m_major = m_minor = 0;
+    m_extensions.clear();
+}
+
+bool GlCaps::load() const
+{
+    if (m_loaded)
+        return true;
+    if (!glGetString)
+        return false;   // entry points not loaded yet: ask again later
+    const char* ver = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!ver)
+        return false;   // no current context
+    if (std::sscanf(ver, "%d.%d", &m_major, &m_minor) != 2)
+        m_major = m_minor = 0;   // also "OpenGL ES ..."
+
+    m_extensions.clear();
+    if (m_major >= 3 && glGetStringi) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* e = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (e)
+                m_extensions.emplace_back(e);
+        }
+    } else if (const char* list = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS))) {
+        for (const char* p = list; *p;) {
+            const char* end = std::strchr(p, ' ');
+            if (!end)
+                end = p + std::strlen(p);
+            if (end > p)
+                m_extensions.emplace_back(p, end);
+            p = *end ? end + 1 : end;
+        }
+    }
+    std::sort(m_extensions.begin(), m_extensions.end());
+    m_loaded = true;
+    return true;
+}
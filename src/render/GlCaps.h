@@ -0,0 +1,49 @@
+// src/render/GlCaps.h
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * GlCaps
+ * Version and extension checks for the current context. Render classes use
+ * these instead of testing entry points: the loader resolves every name on
+ * GLX, so a non-null pointer says nothing about driver support.
+ *
+ * - HasVersion()/HasExtension() answer from a snapshot owned by
+ *   GlState::Current() (one per context, or the per-thread fallback), taken on
+ *   the first query; later queries do not call GL.
+ * - Extensions are enumerated with glGetStringi on GL 3.0+ (GL_EXTENSIONS via
+ *   glGetString is an error in core profiles), else split from the legacy
+ *   string. Names match whole tokens only.
+ * - The version comes from GL_VERSION; OpenGL ES strings report 0.0.
+ * - HasToken() is the same whole-token match for any space separated list
+ *   (EGL/GLX extension strings).
+ *
+ * Notes:
+ * - The first query needs a current context and loaded entry points.
+ * - Reset() drops the snapshot (e.g. after the context was recreated).
+ */
+class GlCaps
+{
+public:
+    // Current context.
+    static bool HasVersion(int major, int minor);
+    static bool HasExtension(const char* name);
+
+    // Whole-token search in a space separated list; null-safe.
+    static bool HasToken(const char* list, const char* token);
+
+    bool Version(int major, int minor) const;
+    bool Extension(const char* name) const;
+    void Reset();
+
+private:
+    bool load() const;
+
+private:
+    mutable bool m_loaded {false};
+    mutable int  m_major {0};
+    mutable int  m_minor {0};
+    mutable std::vector<std::string> m_extensions;   // sorted
+};
@@ -0,0 +1,292 @@
+// src/render/GlState.cpp
+#include "GlState.h"
+
+#include "glad/glad.h"
+
+namespace {
+thread_local GlState* t_current = nullptr;
+} // namespace
+
+GlState::GlState()
+{
+    Invalidate();
+}
+
+GlState& GlState::Current()
+{
+    if (t_current)
+        return *t_current;
+    static thread_local GlState fallback;
+    return fallback;
+}
+
+void GlState::MakeCurrent(GlState* state)
+{
+    t_current = state;
+}
+
+void GlState::Invalidate()
+{
+    m_program    = kUnknown;
+    m_buffers[0] = kUnknown;
+    m_buffers[1] = kUnknown;
+    m_vao        = kUnknown;
+    m_activeUnit = -1;
+    for (int i = 0; i < kMaxTextureUnits; ++i) m_textures[i] = kUnknown;
+    for (int i = 0; i < kCapCount; ++i) m_caps[i] = -1;
+    m_blendSrc = m_blendDst = kUnknown;
+    m_viewportKnown   = false;
+    m_scissorKnown    = false;
+    m_unpackAlignment = -1;
+    m_unpackRowLength = -1;
+    m_attribEnabled = 0;
+    m_attribKnown   = 0;
+    for (int i = 0; i < kMaxAttribs; ++i) m_divisors[i] = kUnknown;
+}
+
+int GlState::capIndex(unsigned cap)
+{
+    switch (cap) {
+        case GL_BLEND:        return kCapBlend;
+        case GL_DEPTH_TEST:   return kCapDepth;
+        case GL_CULL_FACE:    return kCapCull;
+        case GL_SCISSOR_TEST: return kCapScissor;
+        default:              return -1;
+    }
+}
+
+int GlState::bufferIndex(unsigned target)
+{
+    switch (target) {
+        case GL_ARRAY_BUFFER:         return 0;
+        case GL_ELEMENT_ARRAY_BUFFER: return 1;
+        default:                      return -1;
+    }
+}
+
+void GlState::UseProgram(unsigned program)
+{
+    if (m_program == program) { filter(); return; }
+    issue();
+    m_program = program;
+    glUseProgram(program);
+}
+
+void GlState::BindBuffer(unsigned target, unsigned buffer)
+{
+    const int idx = bufferIndex(target);
+    if (idx >= 0) {
+        if (m_buffers[idx] == buffer) { filter(); return; }
+        m_buffers[idx] = buffer;
+    }
+    issue();
+    glBindBuffer(target, buffer);
+}
+
+void GlState::BindVertexArray(unsigned vao)
+{
+    if (m_vao == vao) { filter(); return; }
+    issue();
+    m_vao = vao;
+    // The element buffer binding is part of VAO state.
+    m_buffers[1] = kUnknown;
+    glBindVertexArray(vao);
+}
+
+void GlState::ActiveTexture(int unit)
+{
+    if (m_activeUnit == unit) { filter(); return; }
+    issue();
+    m_activeUnit = unit;
+    glActiveTexture(GL_TEXTURE0 + static_cast<unsigned>(unit));
+}
+
+void GlState::BindTexture(unsigned target, unsigned texture)
+{
+    const int unit = m_activeUnit;
+    if (target == GL_TEXTURE_2D && unit >= 0 && unit < kMaxTextureUnits) {
+        if (m_textures[unit] == texture) { filter(); return; }
+        m_textures[unit] = texture;
+    } else if (target == GL_TEXTURE_2D && unit < 0) {
+        // Active unit unknown: nothing can be cached reliably.
+        for (int i = 0; i < kMaxTextureUnits; ++i) m_textures[i] = kUnknown;
+    }
+    issue();
+    glBindTexture(target, texture);
+}
+
+void GlState::BindTextureUnit(int unit, unsigned target, unsigned texture)
+{
+    if (target == GL_TEXTURE_2D && unit >= 0 && unit < kMaxTextureUnits &&
+        m_textures[unit] == texture) {
+        filter();
+        return;
+    }
+    ActiveTexture(unit);
+    BindTexture(target, texture);
+}
+
+void GlState::Enable(unsigned cap)
+{
+    const int idx = capIndex(cap);
+    if (idx >= 0) {
+        if (m_caps[idx] == 1) { filter(); return; }
+        m_caps[idx] = 1;
+    }
+    issue();
+    glEnable(cap);
+}
+
+void GlState::Disable(unsigned cap)
+{
+    const int idx = capIndex(cap);
+    if (idx >= 0) {
+        if (m_caps[idx] == 0) { filter(); return; }
+        m_caps[idx] = 0;
+    }
+    issue();
+    glDisable(cap);
+}
+
+void GlState::BlendFunc(unsigned src, unsigned dst)
+{
+    if (m_blendSrc == src && m_blendDst == dst) { filter(); return; }
+    issue();
+    m_blendSrc = src;
+    m_blendDst = dst;
+    glBlendFunc(src, dst);
+}
+
+void GlState::Viewport(int x, int y, int w, int h)
+{
+    if (m_viewportKnown && m_viewport[0] == x && m_viewport[1] == y &&
+        m_viewport[2] == w && m_viewport[3] == h) {
+        filter();
+        return;
+    }
+    issue();
+    m_viewport[0] = x; m_viewport[1] = y; m_viewport[2] = w; m_viewport[3] = h;
+    m_viewportKnown = true;
+    glViewport(x, y, w, h);
+}
+
+void GlState::Scissor(int x, int y, int w, int h)
+{
+    if (m_scissorKnown && m_scissor[0] == x && m_scissor[1] == y &&
+        m_scissor[2] == w && m_scissor[3] == h) {
+        filter();
+        return;
+    }
+    issue();
+    m_scissor[0] = x; m_scissor[1] = y; m_scissor[2] = w; m_scissor[3] = h;
+    m_scissorKnown = true;
+    glScissor(x, y, w, h);
+}
+
+void GlState::PixelStore(unsigned pname, int value)
+{
+    int* slot = nullptr;
+    if (pname == GL_UNPACK_ALIGNMENT)  slot = &m_unpackAlignment;
+    if (pname == GL_UNPACK_ROW_LENGTH) slot = &m_unpackRowLength;
+    if (slot) {
+        if (*slot == value) { filter(); return; }
+        *slot = value;
+    }
+    issue();
+    glPixelStorei(pname, value);
+}
+
+void GlState::EnableVertexAttribArray(unsigned index)
+{
+    const bool cached = (m_vao == 0 && index < static_cast<unsigned>(kMaxAttribs));
+    if (cached) {
+        const std::uint32_t bit = 1u << index;
+        if ((m_attribKnown & bit) && (m_attribEnabled & bit)) { filter(); return; }
+        m_attribKnown   |= bit;
+        m_attribEnabled |= bit;
+    }
+    issue();
+    glEnableVertexAttribArray(index);
+}
+
+void GlState::DisableVertexAttribArray(unsigned index)
+{
+    const bool cached = (m_vao == 0 && index < static_cast<unsigned>(kMaxAttribs));
+    if (cached) {
+        const std::uint32_t bit = 1u << index;
+        if ((m_attribKnown & bit) && !(m_attribEnabled & bit)) { filter(); return; }
+        m_attribKnown   |= bit;
+        m_attribEnabled &= ~bit;
+    }
+    issue();
+    glDisableVertexAttribArray(index);
+}
+
+void GlState::VertexAttribDivisor(unsigned index, unsigned divisor)
+{
+    if (!glad_glVertexAttribDivisor)
+        return;
+    const bool cached = (m_vao == 0 && index < static_cast<unsigned>(kMaxAttribs));
+    if (cached) {
+        if (m_divisors[index] == divisor) { filter(); return; }
+        m_divisors[index] = divisor;
+    }
+    issue();
+    glVertexAttribDivisor(index, divisor);
+}
+
+void GlState::SetAttribArrays(std::uint32_t mask)
+{
+    if (m_vao != 0) {
+        // Not tracked: just enable what is needed.
+        for (unsigned i = 0; i < static_cast<unsigned>(kMaxAttribs); ++i) {
+            if (mask & (1u << i)) EnableVertexAttribArray(i);
+        }
+        return;
+    }
+
+    const std::uint32_t all = (1u << kMaxAttribs) - 1u;
+    mask &= all;
+    // Bits whose state is unknown or differs from the wanted one.
+    const std::uint32_t change = (~m_attribKnown | (m_attribEnabled ^ mask)) & all;
+    if (!change) { filter(); return; }
+    for (unsigned i = 0; i < static_cast<unsigned>(kMaxAttribs); ++i) {
+        const std::uint32_t bit = 1u << i;
+        if (!(change & bit)) continue;
+        issue();
+        if (mask & bit) glEnableVertexAttribArray(i);
+        else            glDisableVertexAttribArray(i);
+    }
+    m_attribKnown   = all;
+    m_attribEnabled = mask;
+}
+
+void GlState::OnBufferDeleted(unsigned buffer)
+{
+    // GL reverts deleted bindings of the current context to 0.
+    for (unsigned& b : m_buffers) {
+        if (b == buffer) b = 0;
+    }
+}
+
+void GlState::OnTextureDeleted(unsigned texture)
+{
+    for (unsigned& t : m_textures) {
+        if (t == texture) t = 0;
+    }
+}
+
+void GlState::OnProgramDeleted(unsigned program)
+{
+    // A deleted program stays current until replaced; force the next Use.
+    if (m_program == program) m_program = kUnknown;
+}
+
+void GlState::OnVertexArrayDeleted(unsigned vao)
+{
+    // Deleting the bound VAO reverts to the default one (state still tracked).
+    if (m_vao == vao) {
+        m_vao = 0;
+        m_buffers[1] = kUnknown;
+    }
+}
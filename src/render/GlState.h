@@ -0,0 +1,134 @@
+// src/render/GlState.h
+#pragma once
+
+#include <cstdint>
+
+#include "GlCaps.h"
+
+/**
+ * GlState
+ * Shadow copy of the GL state the render classes touch, sitting between them
+ * and the glad function pointers. Each setter compares against the cached
+ * value and only calls GL when the state actually changes.
+ *
+ * Tracked:
+ * - current program, GL_ARRAY_BUFFER / GL_ELEMENT_ARRAY_BUFFER, VAO
+ * - active texture unit and the GL_TEXTURE_2D binding of each unit
+ * - enable bits for GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST
+ * - blend func, viewport, scissor box, unpack alignment/row length
+ * - vertex attrib array enables and divisors of the default VAO (0) only;
+ *   named VAOs store their own attribute state, so calls made while one is
+ *   bound (VAO setup) go straight to GL.
+ *
+ * Everything starts "unknown" (first call always reaches GL). Call
+ * Invalidate() after code outside this tracker changed GL state.
+ *
+ * Ownership / threading:
+ * - One GlState per GL context. Renderer owns one and makes it current for the
+ *   calling thread (MakeCurrent); render classes use GlState::Current().
+ * - Without a current instance, Current() returns a per-thread fallback, so
+ *   standalone use of Mesh/Texture/Shader keeps working.
+ *
+ * Notes:
+ * - Deleting a bound object must be reported (OnBufferDeleted, ...), because
+ *   GL silently rebinds 0 in that case.
+ * - Counters: 'issued' GL calls vs. 'filtered' redundant ones.
+ * - Caps() holds the context's version/extension snapshot (GlCaps); it
+ *   survives Invalidate().
+ */
+class GlState
+{
+public:
+    struct Counters {
+        std::uint64_t issued   {0};
+        std::uint64_t filtered {0};
+    };
+
+    static const int kMaxTextureUnits = 16;
+    static const int kMaxAttribs      = 16;
+
+    GlState();
+
+    GlState(const GlState&) = delete;
+    GlState& operator=(const GlState&) = delete;
+
+    // Tracker of the calling thread's current context.
+    static GlState& Current();
+    static void MakeCurrent(GlState* state);   // nullptr = per-thread fallback
+
+    // Forget everything; the next call of each kind reaches GL.
+    void Invalidate();
+
+    // Objects
+    void UseProgram(unsigned program);
+    void BindBuffer(unsigned target, unsigned buffer);
+    void BindVertexArray(unsigned vao);
+    void BindTexture(unsigned target, unsigned texture);        // on the active unit
+    void BindTextureUnit(int unit, unsigned target, unsigned texture);
+    void ActiveTexture(int unit);                                // 0-based unit index
+
+    // Fixed-function state
+    void Enable(unsigned cap);
+    void Disable(unsigned cap);
+    void SetEnabled(unsigned cap, bool on) { on ? Enable(cap) : Disable(cap); }
+    void BlendFunc(unsigned src, unsigned dst);
+    void Viewport(int x, int y, int w, int h);
+    void Scissor(int x, int y, int w, int h);
+    void PixelStore(unsigned pname, int value);
+
+    // Vertex attribute arrays (cached for the default VAO only)
+    void EnableVertexAttribArray(unsigned index);
+    void DisableVertexAttribArray(unsigned index);
+    void VertexAttribDivisor(unsigned index, unsigned divisor);
+    // Enable exactly the arrays in 'mask' (bit i = attribute i), disabling the rest.
+    void SetAttribArrays(std::uint32_t mask);
+
+    // Deletion notifications (drop cached bindings of deleted objects)
+    void OnBufferDeleted(unsigned buffer);
+    void OnTextureDeleted(unsigned texture);
+    void OnProgramDeleted(unsigned program);
+    void OnVertexArrayDeleted(unsigned vao);
+
+    // Queries
+    unsigned Program() const          { return m_program; }
+    unsigned VertexArray() const      { return m_vao; }
+    const Counters& Stats() const     { return m_counters; }
+    GlCaps& Caps()                    { return m_glCaps; }
+    void ResetStats()                 { m_counters = Counters{}; }
+
+private:
+    enum Cap { kCapBlend, kCapDepth, kCapCull, kCapScissor, kCapCount };
+
+    static int capIndex(unsigned cap);
+    static int bufferIndex(unsigned target);
+
+    void issue()  { ++m_counters.issued; }
+    void filter() { ++m_counters.filtered; }
+
+private:
+    static const unsigned kUnknown = 0xFFFFFFFFu;
+
+    unsigned m_program {kUnknown};
+    unsigned m_buffers[2] {kUnknown, kUnknown};   // array, element
+    unsigned m_vao {kUnknown};
+    int      m_activeUnit {-1};
+    unsigned m_textures[kMaxTextureUnits];
+
+    signed char m_caps[kCapCount];                // -1 unknown, 0 off, 1 on
+    unsigned m_blendSrc {kUnknown};
+    unsigned m_blendDst {kUnknown};
+    int      m_viewport[4];
+    bool     m_viewportKnown {false};
+    int      m_scissor[4];
+    bool     m_scissorKnown {false};
+    int      m_unpackAlignment {-1};
+    int      m_unpackRowLength {-1};
+
+    // Default-VAO attribute arrays
+    std::uint32_t m_attribEnabled {0};
+    std::uint32_t m_attribKnown   {0};             // bit set = enable state known
+    unsigned      m_divisors[kMaxAttribs];         // kUnknown until first set
+
+    Counters m_counters;
+    GlCaps   m_glCaps;
+};
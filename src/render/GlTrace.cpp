@@ -0,0 +1,607 @@
+// src/render/GlTrace.cpp
+#include "GlTrace.h"
+#include "GlTraceFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "glad/glad.h"
+
+using gltrace::Op;
+
+namespace {
+const std::size_t kFlushBytes = 1u << 20;
+
+// The driver entry points saved by Attach(); the wrappers call through them.
+struct RealGl {
+#define WXGL_TRACE_REAL(name) decltype(glad_gl##name) name;
+    WXGL_TRACE_FUNCS(WXGL_TRACE_REAL)
+#undef WXGL_TRACE_REAL
+};
+
+struct Capture {
+    std::FILE* file {nullptr};
+    std::vector<unsigned char> buf;
+    bool attached {false};
+    bool failed   {false};
+    int  frameLimit {0};
+    GlTrace::Stats stats;
+    std::string error;
+
+    // State the recorder needs to size payloads and classify pointers.
+    gltrace::PixelStore unpack;
+    gltrace::PixelStore pack;
+    GLuint arrayBuffer  {0};
+    GLuint unpackBuffer {0};
+    GLuint packBuffer   {0};
+
+    // Open glMapBufferRange mappings; written bytes are recorded at unmap.
+    struct Mapping {
+        GLenum target {0};
+        const unsigned char* data {nullptr};
+        std::uint64_t length {0};
+        bool write {false};
+    };
+    std::vector<Mapping> mappings;
+};
+
+RealGl  s_real {};
+Capture s_cap;
+
+// ---- Writer ----
+
+void Flush()
+{
+    if (s_cap.buf.empty() || !s_cap.file)
+        return;
+    if (std::fwrite(s_cap.buf.data(), 1, s_cap.buf.size(), s_cap.file) != s_cap.buf.size()) {
+        s_cap.error  = "write error";
+        s_cap.failed = true;
+    }
+    s_cap.buf.clear();
+}
+
+void Put(const void* p, std::size_t n)
+{
+    const unsigned char* b = static_cast<const unsigned char*>(p);
+    s_cap.buf.insert(s_cap.buf.end(), b, b + n);
+    s_cap.stats.bytes += n;
+}
+
+void Begin(Op op)
+{
+    const std::uint8_t b = static_cast<std::uint8_t>(op);
+    Put(&b, 1);
+    if (op != Op::FrameEnd && op != Op::Info)
+        ++s_cap.stats.calls;
+}
+
+void End()
+{
+    if (s_cap.buf.size() >= kFlushBytes)
+        Flush();
+}
+
+void U8(std::uint8_t v)   { Put(&v, 1); }
+void U32(std::uint32_t v) { Put(&v, 4); }
+void I32(std::int32_t v)  { Put(&v, 4); }
+void F32(float v)         { Put(&v, 4); }
+void U64(std::uint64_t v) { Put(&v, 8); }
+
+void Blob(const void* p, std::uint64_t n)
+{
+    if (!p || n > 0xFFFFFFFFull) {
+        if (p)
+            ++s_cap.stats.unsupported;
+        n = 0;
+    }
+    U32(static_cast<std::uint32_t>(n));
+    if (n)
+        Put(p, static_cast<std::size_t>(n));
+}
+
+void Str(const char* s)
+{
+    Blob(s, s ? std::strlen(s) : 0);
+}
+
+void Names(GLsizei n, const GLuint* names)
+{
+    I32(n);
+    for (GLsizei i = 0; i < n && names; ++i)
+        U32(names[i]);
+}
+
+void Offset(const void* p)
+{
+    U64(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p)));
+}
+
+// Image data: a buffer offset while a pixel buffer is bound, else the bytes.
+void Pixels(GLuint boundBuffer, const void* p, int w, int h, GLenum format, GLenum type,
+            const gltrace::PixelStore& ps)
+{
+    U8(boundBuffer ? 1 : 0);
+    if (boundBuffer) {
+        Offset(p);
+        return;
+    }
+    const std::uint64_t bytes = p ? gltrace::ImageBytes(w, h, format, type, ps) : 0;
+    if (p && bytes == 0)
+        ++s_cap.stats.unsupported;
+    Blob(p, bytes);
+}
+
+void Forget(GLsizei n, const GLuint* names)
+{
+    for (GLsizei i = 0; i < n && names; ++i) {
+        if (names[i] == s_cap.arrayBuffer)  s_cap.arrayBuffer  = 0;
+        if (names[i] == s_cap.unpackBuffer) s_cap.unpackBuffer = 0;
+        if (names[i] == s_cap.packBuffer)   s_cap.packBuffer   = 0;
+    }
+}
+
+// ---- Wrappers: call the driver first, so outputs can be recorded ----
+
+void APIENTRY t_Clear(GLbitfield mask)
+{ s_real.Clear(mask); Begin(Op::Clear); U32(mask); End(); }
+
+void APIENTRY t_ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{ s_real.ClearColor(r, g, b, a); Begin(Op::ClearColor); F32(r); F32(g); F32(b); F32(a); End(); }
+
+void APIENTRY t_Viewport(GLint x, GLint y, GLsizei w, GLsizei h)
+{ s_real.Viewport(x, y, w, h); Begin(Op::Viewport); I32(x); I32(y); I32(w); I32(h); End(); }
+
+void APIENTRY t_Scissor(GLint x, GLint y, GLsizei w, GLsizei h)
+{ s_real.Scissor(x, y, w, h); Begin(Op::Scissor); I32(x); I32(y); I32(w); I32(h); End(); }
+
+void APIENTRY t_Enable(GLenum cap)
+{ s_real.Enable(cap); Begin(Op::Enable); U32(cap); End(); }
+
+void APIENTRY t_Disable(GLenum cap)
+{ s_real.Disable(cap); Begin(Op::Disable); U32(cap); End(); }
+
+void APIENTRY t_BlendFunc(GLenum s, GLenum d)
+{ s_real.BlendFunc(s, d); Begin(Op::BlendFunc); U32(s); U32(d); End(); }
+
+GLenum APIENTRY t_GetError(void)
+{ const GLenum e = s_real.GetError(); Begin(Op::GetError); End(); return e; }
+
+const GLubyte* APIENTRY t_GetString(GLenum name)
+{ const GLubyte* s = s_real.GetString(name); Begin(Op::GetString); U32(name); End(); return s; }
+
+void APIENTRY t_GenBuffers(GLsizei n, GLuint* out)
+{ s_real.GenBuffers(n, out); Begin(Op::GenBuffers); Names(n, out); End(); }
+
+void APIENTRY t_BindBuffer(GLenum target, GLuint buffer)
+{
+    s_real.BindBuffer(target, buffer);
+    if (target == 0x8892)      s_cap.arrayBuffer  = buffer;   // GL_ARRAY_BUFFER
+    else if (target == 0x88EC) s_cap.unpackBuffer = buffer;   // GL_PIXEL_UNPACK_BUFFER
+    else if (target == 0x88EB) s_cap.packBuffer   = buffer;   // GL_PIXEL_PACK_BUFFER
+    Begin(Op::BindBuffer); U32(target); U32(buffer); End();
+}
+
+void APIENTRY t_BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    s_real.BufferData(target, size, data, usage);
+    Begin(Op::BufferData); U32(target); U64(static_cast<std::uint64_t>(size));
+    Blob(data, data ? static_cast<std::uint64_t>(size) : 0); U32(usage); End();
+}
+
+void APIENTRY t_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    s_real.BufferSubData(target, offset, size, data);
+    Begin(Op::BufferSubData); U32(target); U64(static_cast<std::uint64_t>(offset));
+    Blob(data, static_cast<std::uint64_t>(size)); End();
+}
+
+void APIENTRY t_DeleteBuffers(GLsizei n, const GLuint* names)
+{ s_real.DeleteBuffers(n, names); Forget(n, names); Begin(Op::DeleteBuffers); Names(n, names); End(); }
+
+void APIENTRY t_GenVertexArrays(GLsizei n, GLuint* out)
+{ s_real.GenVertexArrays(n, out); Begin(Op::GenVertexArrays); Names(n, out); End(); }
+
+void APIENTRY t_BindVertexArray(GLuint vao)
+{ s_real.BindVertexArray(vao); Begin(Op::BindVertexArray); U32(vao); End(); }
+
+void APIENTRY t_DeleteVertexArrays(GLsizei n, const GLuint* names)
+{ s_real.DeleteVertexArrays(n, names); Begin(Op::DeleteVertexArrays); Names(n, names); End(); }
+
+void APIENTRY t_VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                    GLsizei stride, const void* pointer)
+{
+    s_real.VertexAttribPointer(index, size, type, normalized, stride, pointer);
+    if (!s_cap.arrayBuffer)
+        ++s_cap.stats.unsupported;   // client-side array
+    Begin(Op::VertexAttribPointer); U32(index); I32(size); U32(type); U32(normalized);
+    I32(stride); Offset(pointer); End();
+}
+
+void APIENTRY t_EnableVertexAttribArray(GLuint index)
+{ s_real.EnableVertexAttribArray(index); Begin(Op::EnableVertexAttribArray); U32(index); End(); }
+
+void APIENTRY t_DisableVertexAttribArray(GLuint index)
+{ s_real.DisableVertexAttribArray(index); Begin(Op::DisableVertexAttribArray); U32(index); End(); }
+
+GLuint APIENTRY t_CreateShader(GLenum type)
+{ const GLuint id = s_real.CreateShader(type); Begin(Op::CreateShader); U32(type); U32(id); End(); return id; }
+
+void APIENTRY t_ShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+{
+    s_real.ShaderSource(shader, count, strings, lengths);
+    Begin(Op::ShaderSource); U32(shader); I32(count);
+    for (GLsizei i = 0; i < count; ++i) {
+        const char* s = strings ? strings[i] : nullptr;
+        Blob(s, (lengths && lengths[i] >= 0) ? static_cast<std::uint64_t>(lengths[i])
+                                              : (s ? std::strlen(s) : 0));
+    }
+    End();
+}
+
+void APIENTRY t_CompileShader(GLuint shader)
+{ s_real.CompileShader(shader); Begin(Op::CompileShader); U32(shader); End(); }
+
+void APIENTRY t_GetShaderiv(GLuint shader, GLenum pname, GLint* param)
+{ s_real.GetShaderiv(shader, pname, param); Begin(Op::GetShaderiv); U32(shader); U32(pname); End(); }
+
+void APIENTRY t_GetShaderInfoLog(GLuint shader, GLsizei maxLength, GLsizei* length, GLchar* log)
+{ s_real.GetShaderInfoLog(shader, maxLength, length, log); Begin(Op::GetShaderInfoLog); U32(shader); I32(maxLength); End(); }
+
+void APIENTRY t_DeleteShader(GLuint shader)
+{ s_real.DeleteShader(shader); Begin(Op::DeleteShader); U32(shader); End(); }
+
+GLuint APIENTRY t_CreateProgram(void)
+{ const GLuint id = s_real.CreateProgram(); Begin(Op::CreateProgram); U32(id); End(); return id; }
+
+void APIENTRY t_AttachShader(GLuint program, GLuint shader)
+{ s_real.AttachShader(program, shader); Begin(Op::AttachShader); U32(program); U32(shader); End(); }
+
+void APIENTRY t_LinkProgram(GLuint program)
+{ s_real.LinkProgram(program); Begin(Op::LinkProgram); U32(program); End(); }
+
+void APIENTRY t_GetProgramiv(GLuint program, GLenum pname, GLint* param)
+{ s_real.GetProgramiv(program, pname, param); Begin(Op::GetProgramiv); U32(program); U32(pname); End(); }
+
+void APIENTRY t_GetProgramInfoLog(GLuint program, GLsizei maxLength, GLsizei* length, GLchar* log)
+{ s_real.GetProgramInfoLog(program, maxLength, length, log); Begin(Op::GetProgramInfoLog); U32(program); I32(maxLength); End(); }
+
+void APIENTRY t_UseProgram(GLuint program)
+{ s_real.UseProgram(program); Begin(Op::UseProgram); U32(program); End(); }
+
+void APIENTRY t_DeleteProgram(GLuint program)
+{ s_real.DeleteProgram(program); Begin(Op::DeleteProgram); U32(program); End(); }
+
+GLint APIENTRY t_GetUniformLocation(GLuint program, const GLchar* name)
+{
+    const GLint loc = s_real.GetUniformLocation(program, name);
+    Begin(Op::GetUniformLocation); U32(program); Str(name); I32(loc); End();
+    return loc;
+}
+
+void APIENTRY t_Uniform1i(GLint loc, GLint v0)
+{ s_real.Uniform1i(loc, v0); Begin(Op::Uniform1i); I32(loc); I32(v0); End(); }
+
+void APIENTRY t_UniformMatrix4fv(GLint loc, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    s_real.UniformMatrix4fv(loc, count, transpose, value);
+    Begin(Op::UniformMatrix4fv); I32(loc); I32(count); U32(transpose);
+    Blob(value, count > 0 ? static_cast<std::uint64_t>(count) * 16 * sizeof(GLfloat) : 0); End();
+}
+
+void APIENTRY t_Uniform4f(GLint loc, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{ s_real.Uniform4f(loc, v0, v1, v2, v3); Begin(Op::Uniform4f); I32(loc); F32(v0); F32(v1); F32(v2); F32(v3); End(); }
+
+void APIENTRY t_Uniform1f(GLint loc, GLfloat v0)
+{ s_real.Uniform1f(loc, v0); Begin(Op::Uniform1f); I32(loc); F32(v0); End(); }
+
+void APIENTRY t_Uniform2f(GLint loc, GLfloat v0, GLfloat v1)
+{ s_real.Uniform2f(loc, v0, v1); Begin(Op::Uniform2f); I32(loc); F32(v0); F32(v1); End(); }
+
+void APIENTRY t_GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length,
+                                 GLint* size, GLenum* type, GLchar* name)
+{
+    s_real.GetActiveUniform(program, index, bufSize, length, size, type, name);
+    Begin(Op::GetActiveUniform); U32(program); U32(index); I32(bufSize); End();
+}
+
+void APIENTRY t_GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length,
+                                GLint* size, GLenum* type, GLchar* name)
+{
+    s_real.GetActiveAttrib(program, index, bufSize, length, size, type, name);
+    Begin(Op::GetActiveAttrib); U32(program); U32(index); I32(bufSize); End();
+}
+
+GLint APIENTRY t_GetAttribLocation(GLuint program, const GLchar* name)
+{
+    const GLint loc = s_real.GetAttribLocation(program, name);
+    Begin(Op::GetAttribLocation); U32(program); Str(name); I32(loc); End();
+    return loc;
+}
+
+void APIENTRY t_GenTextures(GLsizei n, GLuint* out)
+{ s_real.GenTextures(n, out); Begin(Op::GenTextures); Names(n, out); End(); }
+
+void APIENTRY t_BindTexture(GLenum target, GLuint texture)
+{ s_real.BindTexture(target, texture); Begin(Op::BindTexture); U32(target); U32(texture); End(); }
+
+void APIENTRY t_TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei w, GLsizei h,
+                           GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    s_real.TexImage2D(target, level, internalformat, w, h, border, format, type, pixels);
+    Begin(Op::TexImage2D); U32(target); I32(level); I32(internalformat); I32(w); I32(h); I32(border);
+    U32(format); U32(type); Pixels(s_cap.unpackBuffer, pixels, w, h, format, type, s_cap.unpack); End();
+}
+
+void APIENTRY t_TexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei w, GLsizei h,
+                              GLenum format, GLenum type, const void* pixels)
+{
+    s_real.TexSubImage2D(target, level, x, y, w, h, format, type, pixels);
+    Begin(Op::TexSubImage2D); U32(target); I32(level); I32(x); I32(y); I32(w); I32(h);
+    U32(format); U32(type); Pixels(s_cap.unpackBuffer, pixels, w, h, format, type, s_cap.unpack); End();
+}
+
+void APIENTRY t_PixelStorei(GLenum pname, GLint param)
+{
+    s_real.PixelStorei(pname, param);
+    switch (pname) {
+    case 0x0CF5: s_cap.unpack.alignment  = param; break;   // GL_UNPACK_ALIGNMENT
+    case 0x0CF2: s_cap.unpack.rowLength  = param; break;   // GL_UNPACK_ROW_LENGTH
+    case 0x0CF3: s_cap.unpack.skipRows   = param; break;   // GL_UNPACK_SKIP_ROWS
+    case 0x0CF4: s_cap.unpack.skipPixels = param; break;   // GL_UNPACK_SKIP_PIXELS
+    case 0x0D05: s_cap.pack.alignment    = param; break;   // GL_PACK_ALIGNMENT
+    case 0x0D02: s_cap.pack.rowLength    = param; break;   // GL_PACK_ROW_LENGTH
+    case 0x0D03: s_cap.pack.skipRows     = param; break;   // GL_PACK_SKIP_ROWS
+    case 0x0D04: s_cap.pack.skipPixels   = param; break;   // GL_PACK_SKIP_PIXELS
+    default: break;
+    }
+    Begin(Op::PixelStorei); U32(pname); I32(param); End();
+}
+
+void APIENTRY t_TexParameteri(GLenum target, GLenum pname, GLint param)
+{ s_real.TexParameteri(target, pname, param); Begin(Op::TexParameteri); U32(target); U32(pname); I32(param); End(); }
+
+void APIENTRY t_DeleteTextures(GLsizei n, const GLuint* names)
+{ s_real.DeleteTextures(n, names); Begin(Op::DeleteTextures); Names(n, names); End(); }
+
+void APIENTRY t_ActiveTexture(GLenum unit)
+{ s_real.ActiveTexture(unit); Begin(Op::ActiveTexture); U32(unit); End(); }
+
+void APIENTRY t_DrawArrays(GLenum mode, GLint first, GLsizei count)
+{ s_real.DrawArrays(mode, first, count); Begin(Op::DrawArrays); U32(mode); I32(first); I32(count); End(); }
+
+void APIENTRY t_DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{ s_real.DrawElements(mode, count, type, indices); Begin(Op::DrawElements); U32(mode); I32(count); U32(type); Offset(indices); End(); }
+
+void APIENTRY t_DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    s_real.DrawArraysInstanced(mode, first, count, instances);
+    Begin(Op::DrawArraysInstanced); U32(mode); I32(first); I32(count); I32(instances); End();
+}
+
+void APIENTRY t_VertexAttribDivisor(GLuint index, GLuint divisor)
+{ s_real.VertexAttribDivisor(index, divisor); Begin(Op::VertexAttribDivisor); U32(index); U32(divisor); End(); }
+
+void APIENTRY t_GenQueries(GLsizei n, GLuint* out)
+{ s_real.GenQueries(n, out); Begin(Op::GenQueries); Names(n, out); End(); }
+
+void APIENTRY t_DeleteQueries(GLsizei n, const GLuint* names)
+{ s_real.DeleteQueries(n, names); Begin(Op::DeleteQueries); Names(n, names); End(); }
+
+void APIENTRY t_BeginQuery(GLenum target, GLuint id)
+{ s_real.BeginQuery(target, id); Begin(Op::BeginQuery); U32(target); U32(id); End(); }
+
+void APIENTRY t_EndQuery(GLenum target)
+{ s_real.EndQuery(target); Begin(Op::EndQuery); U32(target); End(); }
+
+void APIENTRY t_GetQueryObjectiv(GLuint id, GLenum pname, GLint* params)
+{ s_real.GetQueryObjectiv(id, pname, params); Begin(Op::GetQueryObjectiv); U32(id); U32(pname); End(); }
+
+void APIENTRY t_GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params)
+{ s_real.GetQueryObjectui64v(id, pname, params); Begin(Op::GetQueryObjectui64v); U32(id); U32(pname); End(); }
+
+void APIENTRY t_ReadPixels(GLint x, GLint y, GLsizei w, GLsizei h, GLenum format, GLenum type, void* pixels)
+{
+    s_real.ReadPixels(x, y, w, h, format, type, pixels);
+    // Only the destination kind matters for the replay; the bytes are not kept.
+    Begin(Op::ReadPixels); I32(x); I32(y); I32(w); I32(h); U32(format); U32(type);
+    U8(s_cap.packBuffer ? 1 : 0); Offset(s_cap.packBuffer ? pixels : nullptr); End();
+}
+
+void APIENTRY t_Finish(void)
+{ s_real.Finish(); Begin(Op::Finish); End(); }
+
+void APIENTRY t_GenFramebuffers(GLsizei n, GLuint* out)
+{ s_real.GenFramebuffers(n, out); Begin(Op::GenFramebuffers); Names(n, out); End(); }
+
+void APIENTRY t_DeleteFramebuffers(GLsizei n, const GLuint* names)
+{ s_real.DeleteFramebuffers(n, names); Begin(Op::DeleteFramebuffers); Names(n, names); End(); }
+
+void APIENTRY t_BindFramebuffer(GLenum target, GLuint fbo)
+{ s_real.BindFramebuffer(target, fbo); Begin(Op::BindFramebuffer); U32(target); U32(fbo); End(); }
+
+GLenum APIENTRY t_CheckFramebufferStatus(GLenum target)
+{ const GLenum s = s_real.CheckFramebufferStatus(target); Begin(Op::CheckFramebufferStatus); U32(target); End(); return s; }
+
+void APIENTRY t_FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum rbTarget, GLuint rb)
+{
+    s_real.FramebufferRenderbuffer(target, attachment, rbTarget, rb);
+    Begin(Op::FramebufferRenderbuffer); U32(target); U32(attachment); U32(rbTarget); U32(rb); End();
+}
+
+void APIENTRY t_GenRenderbuffers(GLsizei n, GLuint* out)
+{ s_real.GenRenderbuffers(n, out); Begin(Op::GenRenderbuffers); Names(n, out); End(); }
+
+void APIENTRY t_DeleteRenderbuffers(GLsizei n, const GLuint* names)
+{ s_real.DeleteRenderbuffers(n, names); Begin(Op::DeleteRenderbuffers); Names(n, names); End(); }
+
+void APIENTRY t_BindRenderbuffer(GLenum target, GLuint rb)
+{ s_real.BindRenderbuffer(target, rb); Begin(Op::BindRenderbuffer); U32(target); U32(rb); End(); }
+
+void APIENTRY t_RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei w, GLsizei h)
+{
+    s_real.RenderbufferStorage(target, internalformat, w, h);
+    Begin(Op::RenderbufferStorage); U32(target); U32(internalformat); I32(w); I32(h); End();
+}
+
+void* APIENTRY t_MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    void* p = s_real.MapBufferRange(target, offset, length, access);
+    Begin(Op::MapBufferRange); U32(target); U64(static_cast<std::uint64_t>(offset));
+    U64(static_cast<std::uint64_t>(length)); U32(access); End();
+    if (p) {
+        Capture::Mapping m;
+        m.target = target;
+        m.data   = static_cast<const unsigned char*>(p);
+        m.length = static_cast<std::uint64_t>(length);
+        m.write  = (access & GL_MAP_WRITE_BIT) != 0;
+        s_cap.mappings.push_back(m);
+    }
+    return p;
+}
+
+GLboolean APIENTRY t_UnmapBuffer(GLenum target)
+{
+    // Recorded before the driver call: the mapped bytes are gone afterwards.
+    const auto it = std::find_if(s_cap.mappings.begin(), s_cap.mappings.end(),
+                                 [target](const Capture::Mapping& m) { return m.target == target; });
+    const bool found = it != s_cap.mappings.end();
+    Begin(Op::UnmapBuffer); U32(target);
+    Blob(found && it->write ? it->data : nullptr, found ? it->length : 0); End();
+    if (found)
+        s_cap.mappings.erase(it);
+    return s_real.UnmapBuffer(target);
+}
+
+GLsync APIENTRY t_FenceSync(GLenum condition, GLbitfield flags)
+{
+    GLsync s = s_real.FenceSync(condition, flags);
+    Begin(Op::FenceSync); U32(condition); U32(flags); Offset(s); End();
+    return s;
+}
+
+GLenum APIENTRY t_ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    const GLenum r = s_real.ClientWaitSync(sync, flags, timeout);
+    Begin(Op::ClientWaitSync); Offset(sync); U32(flags); U64(timeout); End();
+    return r;
+}
+
+void APIENTRY t_DeleteSync(GLsync sync)
+{ s_real.DeleteSync(sync); Begin(Op::DeleteSync); Offset(sync); End(); }
+
+void APIENTRY t_BindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{ s_real.BindAttribLocation(program, index, name); Begin(Op::BindAttribLocation); U32(program); U32(index); Str(name); End(); }
+
+void APIENTRY t_MaxShaderCompilerThreadsKHR(GLuint count)
+{ s_real.MaxShaderCompilerThreadsKHR(count); Begin(Op::MaxShaderCompilerThreadsKHR); U32(count); End(); }
+
+void APIENTRY t_DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+{
+    s_real.DrawElementsInstanced(mode, count, type, indices, instances);
+    Begin(Op::DrawElementsInstanced); U32(mode); I32(count); U32(type); Offset(indices); I32(instances); End();
+}
+
+void APIENTRY t_GetIntegerv(GLenum pname, GLint* data)
+{ s_real.GetIntegerv(pname, data); Begin(Op::GetIntegerv); U32(pname); End(); }
+
+const GLubyte* APIENTRY t_GetStringi(GLenum name, GLuint index)
+{ const GLubyte* s = s_real.GetStringi(name, index); Begin(Op::GetStringi); U32(name); U32(index); End(); return s; }
+
+void Info(const char* key, const char* value)
+{
+    Begin(Op::Info); Str(key); Str(value ? value : ""); End();
+}
+} // namespace
+
+bool GlTrace::Start(const std::string& path, int frames)
+{
+    Stop();
+    s_cap = Capture();
+    if (glad_glClear) {
+        s_cap.error = "capture must start before the GL entry points are loaded";
+        return false;
+    }
+    s_cap.file = std::fopen(path.c_str(), "wb");
+    if (!s_cap.file) {
+        s_cap.error = "cannot open " + path;
+        return false;
+    }
+    s_cap.frameLimit = frames;
+
+    Put(gltrace::kMagic, sizeof(gltrace::kMagic));
+    U32(gltrace::kVersion);
+    U32(gltrace::kByteOrder);
+    Flush();
+    return true;
+}
+
+void GlTrace::Attach()
+{
+    if (!s_cap.file)
+        return;
+
+    // A later gladLoadGL() put the driver pointers back: save and wrap again.
+#define WXGL_TRACE_WRAP(name)                               \
+    if (glad_gl##name != &t_##name)                         \
+        s_real.name = glad_gl##name;                        \
+    glad_gl##name = s_real.name ? &t_##name : nullptr;
+    WXGL_TRACE_FUNCS(WXGL_TRACE_WRAP)
+#undef WXGL_TRACE_WRAP
+
+    if (!s_cap.attached) {
+        s_cap.attached = true;
+        Info("gl_vendor",   reinterpret_cast<const char*>(s_real.GetString(0x1F00)));
+        Info("gl_renderer", reinterpret_cast<const char*>(s_real.GetString(0x1F01)));
+        Info("gl_version",  reinterpret_cast<const char*>(s_real.GetString(0x1F02)));
+    }
+}
+
+void GlTrace::FrameEnd()
+{
+    if (!s_cap.attached)
+        return;
+    Begin(Op::FrameEnd);
+    ++s_cap.stats.frames;
+    Flush();
+    if (s_cap.failed || (s_cap.frameLimit > 0 && s_cap.stats.frames >= s_cap.frameLimit))
+        Stop();
+}
+
+GlTrace::Stats GlTrace::Stop()
+{
+    if (s_cap.attached) {
+#define WXGL_TRACE_UNWRAP(name)                             \
+        if (glad_gl##name == &t_##name)                     \
+            glad_gl##name = s_real.name;
+        WXGL_TRACE_FUNCS(WXGL_TRACE_UNWRAP)
+#undef WXGL_TRACE_UNWRAP
+        s_cap.attached = false;
+    }
+    if (s_cap.file) {
+        Flush();
+        if (std::fclose(s_cap.file) != 0 && s_cap.error.empty())
+            s_cap.error = "write error";
+        s_cap.file = nullptr;
+    }
+    s_cap.buf.clear();
+    s_cap.buf.shrink_to_fit();
+    return s_cap.stats;
+}
+
+bool GlTrace::Active()
+{
+    return s_cap.file != nullptr;
+}
+
+GlTrace::Stats GlTrace::GetStats()
+{
+    return s_cap.stats;
+}
+
+const std::string& GlTrace::LastError()
+{
+    return s_cap.error;
+}
@@ -0,0 +1,54 @@
+// src/render/GlTrace.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * GlTrace
+ * Records every GL call the renderer issues, with arguments and payloads
+ * (buffer data, texture pixels, shader sources), to a compact binary file
+ * that wxgl_replay plays back headless. Layout: GlTraceFormat.h.
+ *
+ * Capture works by swapping the glad function pointers for recording
+ * wrappers, so it costs nothing unless started:
+ *   GlTrace::Start("frames.wxtrace", 300);   // before Renderer::Initialize()
+ *   ...                                      // Initialize() calls Attach()
+ *   Renderer::Render() marks each frame; after 300 frames the pointers are
+ *   restored and the file is closed. Stop() ends the capture early.
+ *
+ * Notes:
+ * - The trace must start with the context: objects created before Attach()
+ *   are unknown to the replay. Start() after the first gladLoadGL() fails.
+ * - Calls must come from the thread that owns the GL context (one context).
+ * - Vertex attribute and index pointers are recorded as buffer offsets;
+ *   client-side arrays (unused by this renderer) are counted as unsupported.
+ * - Program binaries are driver specific and not traced: ProgramCache steps
+ *   aside while Active(), so programs are recorded as sources and links.
+ */
+class GlTrace
+{
+public:
+    struct Stats {
+        std::uint64_t calls {0};
+        std::uint64_t bytes {0};         // file size so far
+        int           frames {0};
+        std::uint64_t unsupported {0};   // calls the replay cannot reproduce exactly
+    };
+
+    // Opens the file and arms the capture for 'frames' frames (<= 0: until Stop()).
+    static bool Start(const std::string& path, int frames);
+
+    // Wraps the glad pointers; call after every gladLoadGL(). No-op unless armed.
+    static void Attach();
+
+    // Frame boundary; stops the capture once the frame budget is used up.
+    static void FrameEnd();
+
+    // Restores the glad pointers and closes the file. Safe to call when idle.
+    static Stats Stop();
+
+    static bool Active();
+    static Stats GetStats();
+    static const std::string& LastError();
+};
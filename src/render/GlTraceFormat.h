@@ -0,0 +1,121 @@
+// src/render/GlTraceFormat.h
+#pragma once
+
+// Binary layout shared by GlTrace (capture) and TraceReplay (wxgl_replay).
+//
+// File:    "WXGLTRC\0"  u32 version  u32 byte-order mark (0x01020304)
+//          then records until end of file.
+// Record:  u8 opcode, then the call's arguments in declaration order, in the
+//          writer's byte order (readers reject a foreign byte-order mark):
+//            enums, bitfields, names, GLint/GLsizei -> 4 bytes
+//            GLfloat                                -> 4 bytes
+//            GLsizeiptr/GLintptr, buffer offsets    -> 8 bytes
+//            payloads / strings                     -> u32 length + bytes
+//          Object names are the capture-side names; return values of
+//          glCreate*/glGet*Location and generated names follow the arguments.
+//          Sync objects are recorded as their capture-side handle (8 bytes).
+//          glUnmapBuffer carries the bytes written through the mapping.
+//
+// Opcodes for GL functions are their position in WXGL_TRACE_FUNCS; append
+// new functions at the end (and bump kVersion if a record layout changes)
+// so older traces stay readable.
+
+#include <cstdint>
+
+namespace gltrace {
+
+const char          kMagic[8]  = { 'W', 'X', 'G', 'L', 'T', 'R', 'C', '\0' };
+const std::uint32_t kVersion   = 1;
+const std::uint32_t kByteOrder = 0x01020304u;
+
+// Every glad entry point, without the "gl" prefix.
+#define WXGL_TRACE_FUNCS(X) \
+    X(Clear) X(ClearColor) X(Viewport) X(Scissor) X(Enable) X(Disable) X(BlendFunc) \
+    X(GetError) X(GetString) \
+    X(GenBuffers) X(BindBuffer) X(BufferData) X(BufferSubData) X(DeleteBuffers) \
+    X(GenVertexArrays) X(BindVertexArray) X(DeleteVertexArrays) \
+    X(VertexAttribPointer) X(EnableVertexAttribArray) X(DisableVertexAttribArray) \
+    X(CreateShader) X(ShaderSource) X(CompileShader) X(GetShaderiv) X(GetShaderInfoLog) \
+    X(DeleteShader) X(CreateProgram) X(AttachShader) X(LinkProgram) X(GetProgramiv) \
+    X(GetProgramInfoLog) X(UseProgram) X(DeleteProgram) \
+    X(GetUniformLocation) X(Uniform1i) X(UniformMatrix4fv) X(Uniform4f) X(Uniform1f) \
+    X(Uniform2f) X(GetActiveUniform) X(GetActiveAttrib) X(GetAttribLocation) \
+    X(GenTextures) X(BindTexture) X(TexImage2D) X(TexSubImage2D) X(PixelStorei) \
+    X(TexParameteri) X(DeleteTextures) X(ActiveTexture) \
+    X(DrawArrays) X(DrawElements) X(DrawArraysInstanced) X(VertexAttribDivisor) \
+    X(GenQueries) X(DeleteQueries) X(BeginQuery) X(EndQuery) X(GetQueryObjectiv) \
+    X(GetQueryObjectui64v) \
+    X(ReadPixels) X(Finish) \
+    X(GenFramebuffers) X(DeleteFramebuffers) X(BindFramebuffer) X(CheckFramebufferStatus) \
+    X(FramebufferRenderbuffer) X(GenRenderbuffers) X(DeleteRenderbuffers) \
+    X(BindRenderbuffer) X(RenderbufferStorage) \
+    X(MapBufferRange) X(UnmapBuffer) X(FenceSync) X(ClientWaitSync) X(DeleteSync) \
+    X(BindAttribLocation) X(MaxShaderCompilerThreadsKHR) X(DrawElementsInstanced) \
+    X(GetIntegerv) X(GetStringi)
+
+enum class Op : std::uint8_t {
+    FrameEnd = 0,   // no arguments; one per Renderer::Render()
+    Info     = 1,   // string key, string value (capture host, GL strings)
+#define WXGL_TRACE_OP(name) name,
+    WXGL_TRACE_FUNCS(WXGL_TRACE_OP)
+#undef WXGL_TRACE_OP
+    Count
+};
+
+// Pixel-store state that decides how many bytes an image call reads/writes.
+struct PixelStore {
+    int alignment  {4};
+    int rowLength  {0};
+    int skipRows   {0};
+    int skipPixels {0};
+};
+
+// Bytes addressed by a w x h image transfer from its data pointer, or 0 when
+// the format/type pair is not one this renderer uses.
+inline std::uint64_t ImageBytes(int w, int h, unsigned format, unsigned type, const PixelStore& ps)
+{
+    if (w <= 0 || h <= 0)
+        return 0;
+
+    int components = 0;
+    switch (format) {
+    case 0x1902: /* GL_DEPTH_COMPONENT */
+    case 0x1903: /* GL_RED */
+    case 0x1906: /* GL_ALPHA */
+    case 0x1909: /* GL_LUMINANCE */       components = 1; break;
+    case 0x8227: /* GL_RG */
+    case 0x190A: /* GL_LUMINANCE_ALPHA */ components = 2; break;
+    case 0x1907: /* GL_RGB */
+    case 0x80E0: /* GL_BGR */             components = 3; break;
+    case 0x1908: /* GL_RGBA */
+    case 0x80E1: /* GL_BGRA */            components = 4; break;
+    default: return 0;
+    }
+
+    int pixel = 0;
+    switch (type) {
+    case 0x1400: /* GL_BYTE */
+    case 0x1401: /* GL_UNSIGNED_BYTE */   pixel = components;     break;
+    case 0x1402: /* GL_SHORT */
+    case 0x1403: /* GL_UNSIGNED_SHORT */
+    case 0x140B: /* GL_HALF_FLOAT */      pixel = components * 2; break;
+    case 0x1404: /* GL_INT */
+    case 0x1405: /* GL_UNSIGNED_INT */
+    case 0x1406: /* GL_FLOAT */           pixel = components * 4; break;
+    case 0x8363: /* GL_UNSIGNED_SHORT_5_6_5 */
+    case 0x8033: /* GL_UNSIGNED_SHORT_4_4_4_4 */
+    case 0x8034: /* GL_UNSIGNED_SHORT_5_5_5_1 */ pixel = 2; break;
+    case 0x8035: /* GL_UNSIGNED_INT_8_8_8_8 */
+    case 0x8367: /* GL_UNSIGNED_INT_8_8_8_8_REV */
+    case 0x8368: /* GL_UNSIGNED_INT_2_10_10_10_REV */ pixel = 4; break;
+    default: return 0;
+    }
+
+    const std::uint64_t rowPixels = static_cast<std::uint64_t>(ps.rowLength > 0 ? ps.rowLength : w);
+    const std::uint64_t align     = static_cast<std::uint64_t>(ps.alignment > 0 ? ps.alignment : 1);
+    const std::uint64_t rowBytes  = (rowPixels * pixel + align - 1) / align * align;
+    return (static_cast<std::uint64_t>(ps.skipRows) + h - 1) * rowBytes +
+           (static_cast<std::uint64_t>(ps.skipPixels) + w) * pixel;
+}
+
+} // namespace gltrace
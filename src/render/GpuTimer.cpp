@@ -0,0 +1,146 @@
+// src/render/GpuTimer.cpp
+#include "GpuTimer.h"
+
+#include "glad/glad.h"
+
+#include "GlCaps.h"
+#include "Profiler.h"
+
+bool GpuTimer::Initialize()
+{
+    const bool entryPoints = glad_glGenQueries && glad_glDeleteQueries &&
+                             glad_glBeginQuery && glad_glEndQuery &&
+                             glad_glGetQueryObjectiv && glad_glGetQueryObjectui64v;
+    m_supported = entryPoints &&
+                  (GlCaps::HasVersion(3, 3) || GlCaps::HasExtension("GL_ARB_timer_query") ||
+                   GlCaps::HasExtension("GL_EXT_timer_query"));
+    return m_supported;
+}
+
+void GpuTimer::Shutdown()
+{
+    if (m_open)
+        End();
+    for (Slot& s : m_slots) {
+        if (!s.queries.empty() && glad_glDeleteQueries)
+            glDeleteQueries(static_cast<GLsizei>(s.queries.size()), s.queries.data());
+        s = Slot();
+    }
+    m_current = nullptr;
+}
+
+int GpuTimer::AddZone(const char* name)
+{
+    if (static_cast<int>(m_zones.size()) >= kMaxZones)
+        return -1;
+    Zone z;
+    z.name      = name;
+    z.profileId = Profiler::Instance().Register(("GPU " + z.name).c_str());
+    m_zones.push_back(z);
+    return static_cast<int>(m_zones.size()) - 1;
+}
+
+void GpuTimer::BeginFrame()
+{
+    ++m_frame;
+    m_current = nullptr;
+    if (!m_supported)
+        return;
+
+    collect();
+    if (!m_enabled)
+        return;
+
+    Slot& slot = m_slots[m_frame % kFramesInFlight];
+    if (slot.pending) {
+        ++m_skipped;   // GPU is more than kFramesInFlight frames behind
+        return;
+    }
+    slot.used    = 0;
+    slot.frame   = m_frame;
+    slot.startNs = Profiler::NowNs();
+    m_current  = &slot;
+}
+
+void GpuTimer::Begin(int zone)
+{
+    if (!m_current || m_open || zone < 0 || zone >= ZoneCount())
+        return;
+
+    Slot& s = *m_current;
+    if (s.used == static_cast<int>(s.queries.size())) {
+        GLuint q = 0;
+        glGenQueries(1, &q);
+        if (q == 0)
+            return;
+        s.queries.push_back(q);
+        s.zones.push_back(zone);
+    }
+    s.zones[s.used] = zone;
+    glBeginQuery(GL_TIME_ELAPSED, s.queries[s.used]);
+    m_open = true;
+}
+
+void GpuTimer::End()
+{
+    if (!m_open)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    ++m_current->used;
+    m_open = false;
+}
+
+void GpuTimer::EndFrame()
+{
+    if (m_open)
+        End();
+    if (m_current && m_current->used > 0)
+        m_current->pending = true;
+    m_current = nullptr;
+}
+
+void GpuTimer::collect()
+{
+    for (Slot& s : m_slots) {
+        if (s.pending)
+            collectSlot(s);
+    }
+}
+
+void GpuTimer::collectSlot(Slot& slot)
+{
+    for (int i = 0; i < slot.used; ++i) {
+        GLint available = 0;
+        glGetQueryObjectiv(slot.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+    }
+
+    const std::int64_t bound = Profiler::NowNs() - slot.startNs;
+    Result r;
+    r.frame = slot.frame;
+    r.valid = true;
+    for (int i = 0; i < slot.used; ++i) {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &ns);
+        r.ns[slot.zones[i]] += static_cast<std::int64_t>(ns);
+        r.zones |= 1u << slot.zones[i];
+    }
+    slot.pending = false;
+
+    for (int z = 0; z < ZoneCount(); ++z) {
+        if (r.ns[z] > bound) {
+            ++m_discarded;
+            return;
+        }
+    }
+
+    if (Profiler::Enabled()) {
+        for (int z = 0; z < ZoneCount(); ++z) {
+            if (r.zones & (1u << z))
+                Profiler::Instance().Record(m_zones[z].profileId, r.ns[z]);
+        }
+    }
+    if (r.frame > m_latest.frame)
+        m_latest = r;
+}
@@ -0,0 +1,106 @@
+// src/render/GpuTimer.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * GpuTimer
+ * GPU-side duration of render passes from GL_TIME_ELAPSED queries
+ * (GL 3.3, ARB_timer_query or EXT_timer_query). No wxWidgets.
+ *
+ * Usage per frame (current context required for every call):
+ *   BeginFrame();
+ *   Begin(zone); ...GL work...; End();    // any number of times
+ *   EndFrame();
+ *
+ * - A zone may be bracketed several times per frame (e.g. once per damage
+ *   rectangle); its intervals add up. Brackets must not nest: only one
+ *   TIME_ELAPSED query can be active.
+ * - Each frame's queries live in one of kFramesInFlight slots. BeginFrame()
+ *   collects slots whose results are available (GL_QUERY_RESULT_AVAILABLE)
+ *   and never waits; a slot still pending when its turn comes round again
+ *   leaves that frame untimed (Skipped()) instead of stalling.
+ * - A frame whose intervals exceed the wall-clock time since its
+ *   BeginFrame() is dropped as bogus (Discarded()); llvmpipe reports such
+ *   a value for the first query of a fresh context.
+ * - Collected zone times are recorded into the Profiler as "GPU <zone>",
+ *   next to the CPU scopes, while Profiler::Enabled().
+ */
+class GpuTimer
+{
+public:
+    static const int kFramesInFlight = 4;
+    static const int kMaxZones       = 8;
+
+    struct Result {
+        std::uint64_t frame {0};          // BeginFrame() count of the sample
+        std::int64_t  ns[kMaxZones] {};   // per zone, 0 when not bracketed
+        unsigned      zones {0};          // bit z set: zone z was bracketed
+        bool valid {false};
+    };
+
+    GpuTimer() = default;
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // Checks driver support; false (and all calls no-ops) when unavailable.
+    bool Initialize();
+    // Deletes the query objects; the creating context must be current.
+    void Shutdown();
+
+    bool Supported() const { return m_supported; }
+
+    // Recording switch; pending results are still collected while off.
+    void SetEnabled(bool on) { m_enabled = on; }
+    bool Enabled() const { return m_enabled && m_supported; }
+
+    // Returns the zone index, or -1 when kMaxZones are in use.
+    int AddZone(const char* name);
+    const std::string& ZoneName(int zone) const { return m_zones[zone].name; }
+    int ZoneCount() const { return static_cast<int>(m_zones.size()); }
+
+    void BeginFrame();
+    void Begin(int zone);
+    void End();
+    void EndFrame();
+
+    // Most recent frame whose queries completed.
+    const Result& Latest() const { return m_latest; }
+    std::uint64_t Frame() const { return m_frame; }
+    std::uint64_t Skipped() const { return m_skipped; }
+    std::uint64_t Discarded() const { return m_discarded; }
+
+private:
+    struct Zone {
+        std::string   name;
+        std::uint16_t profileId {0};
+    };
+
+    struct Slot {
+        std::vector<unsigned> queries;   // grown on demand, reused
+        std::vector<int>      zones;     // zone of queries[i]
+        int           used {0};
+        std::uint64_t frame {0};
+        std::int64_t  startNs {0};       // CPU time at BeginFrame()
+        bool          pending {false};
+    };
+
+    void collect();                  // harvest available slots
+    void collectSlot(Slot& slot);    // no-op while results are outstanding
+
+private:
+    bool m_supported {false};
+    bool m_enabled   {false};
+
+    std::vector<Zone> m_zones;
+    Slot m_slots[kFramesInFlight];
+    Slot* m_current {nullptr};       // slot being recorded, null = untimed frame
+    bool  m_open {false};            // a query is active
+
+    std::uint64_t m_frame   {0};
+    std::uint64_t m_skipped {0};
+    std::uint64_t m_discarded {0};
+    Result        m_latest;
+};
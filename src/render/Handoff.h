@@ -0,0 +1,171 @@
+// src/render/Handoff.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Lock-free handoff primitives between exactly one producer thread and one
+ * consumer thread (e.g. UI thread -> render thread). Header-only, no GL.
+ *
+ * TripleBuffer<T>
+ *   "Latest value wins" mailbox for snapshots. The writer never blocks and
+ *   never sees the reader's slot; the reader gets the most recent published
+ *   value and skips intermediate ones.
+ *
+ * SpscRing<T, N>
+ *   Bounded FIFO for discrete events that must not be coalesced (clicks).
+ *   N must be a power of two; TryPush fails when full.
+ *
+ * MpscRing<T, N>
+ *   Bounded FIFO with any number of producer threads and one consumer
+ *   (per-cell sequence numbers). Producers never block or allocate; TryPush
+ *   fails when full. Used for profiler samples from UI and render thread.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer: slot to fill, then Publish().
+    T& Back() { return m_slots[m_back]; }
+
+    void Publish()
+    {
+        const std::uint8_t prev =
+            m_middle.exchange(static_cast<std::uint8_t>(m_back | kFresh), std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+    }
+
+    void Publish(const T& value)
+    {
+        Back() = value;
+        Publish();
+    }
+
+    // Consumer: swaps in the latest published value; false if none since the
+    // last call (Front() then still holds the previous one).
+    bool Update()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & kFresh) == 0)
+            return false;
+        const std::uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & kIndexMask;
+        return true;
+    }
+
+    const T& Front() const { return m_slots[m_front]; }
+
+private:
+    static const std::uint8_t kIndexMask = 0x3;
+    static const std::uint8_t kFresh     = 0x4;
+
+    T m_slots[3] {};
+    std::uint8_t m_back  {0};                // producer only
+    std::uint8_t m_front {1};                // consumer only
+    std::atomic<std::uint8_t> m_middle {2};  // index | kFresh
+};
+
+template <typename T, std::size_t N>
+class SpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer
+    bool TryPush(const T& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == N)
+            return false;
+        m_items[head & (N - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer
+    bool TryPop(T& out)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+        out = m_items[tail & (N - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T m_items[N] {};
+    // Separate cache lines: the two counters are written by different threads.
+    alignas(64) std::atomic<std::size_t> m_head {0};
+    alignas(64) std::atomic<std::size_t> m_tail {0};
+};
+
+template <typename T, std::size_t N>
+class MpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two");
+
+public:
+    MpscRing()
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any thread.
+    bool TryPush(const T& value)
+    {
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & (N - 1)];
+            const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (dif == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;   // full: the consumer has not freed this cell yet
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer.
+    bool TryPop(T& out)
+    {
+        Cell& cell = m_cells[m_tail & (N - 1)];
+        const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+        if (seq != m_tail + 1)
+            return false;   // empty, or the producer is still writing
+        out = cell.value;
+        cell.seq.store(m_tail + N, std::memory_order_release);
+        ++m_tail;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq {0};
+        T value {};
+    };
+
+    Cell m_cells[N];
+    alignas(64) std::atomic<std::size_t> m_head {0};
+    alignas(64) std::size_t m_tail {0};   // consumer only
+};
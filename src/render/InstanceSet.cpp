@@ -0,0 +1,195 @@
+// src/render/InstanceSet.cpp
+#include "InstanceSet.h"
+
+#include <cmath>
+
+#include "glad/glad.h"
+#include "GlState.h"
+
+namespace {
+// Small deterministic PRNG (xorshift32); good enough for scene generation.
+struct XorShift32 {
+    std::uint32_t s;
+    explicit XorShift32(std::uint32_t seed) : s(seed ? seed : 0x9E3779B9u) {}
+    std::uint32_t next() {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+    // Uniform float in [0, 1)
+    float unit() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+};
+} // namespace
+
+InstanceSet::~InstanceSet()
+{
+    Reset();
+}
+
+void InstanceSet::Resize(std::size_t count)
+{
+    const std::size_t old = m_count;
+    m_count = count;
+
+    m_offset.resize(count * 2, 0.0f);
+    m_rotScale.resize(count * 2, 0.0f);
+    m_color.resize(count * 4, 255);
+    m_visible.resize(count, 255);
+
+    // Default scale for newly added instances is 1.
+    for (std::size_t i = old; i < count; ++i) {
+        m_rotScale[i * 2 + 1] = 1.0f;
+    }
+    m_dirty = kAll;
+    ++m_version;
+}
+
+void InstanceSet::SetOffset(std::size_t i, float x, float y)
+{
+    if (i >= m_count) return;
+    m_offset[i * 2 + 0] = x;
+    m_offset[i * 2 + 1] = y;
+    m_dirty |= kOffset;
+    ++m_version;
+}
+
+void InstanceSet::SetRotationScale(std::size_t i, float radians, float scale)
+{
+    if (i >= m_count) return;
+    m_rotScale[i * 2 + 0] = radians;
+    m_rotScale[i * 2 + 1] = scale;
+    m_dirty |= kRotScale;
+    ++m_version;
+}
+
+void InstanceSet::SetColor(std::size_t i, std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a)
+{
+    if (i >= m_count) return;
+    std::uint8_t* c = &m_color[i * 4];
+    c[0] = r; c[1] = g; c[2] = b; c[3] = a;
+    m_dirty |= kColor;
+    ++m_version;
+}
+
+void InstanceSet::SetVisible(std::size_t i, bool visible)
+{
+    if (i >= m_count) return;
+    m_visible[i] = visible ? 255 : 0;
+    m_dirty |= kVisible;
+    ++m_version;
+}
+
+void InstanceSet::GenerateStress(std::size_t count, unsigned seed)
+{
+    Resize(count);
+    if (count == 0) return;
+
+    // Square-ish grid; cell size in NDC so that the grid covers [-1, 1].
+    const std::size_t cols = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const std::size_t rows = (count + cols - 1) / cols;
+    const float cellW = 2.0f / static_cast<float>(cols);
+    const float cellH = 2.0f / static_cast<float>(rows);
+    // The base triangle spans ~1.1 NDC units; shrink it to about one cell.
+    const float baseScale = 0.9f * std::fmin(cellW, cellH);
+    const float twoPi = 6.28318530717958647692f;
+
+    XorShift32 rng(seed);
+    float*        off = m_offset.data();
+    float*        rs  = m_rotScale.data();
+    std::uint8_t* col = m_color.data();
+    std::uint8_t* vis = m_visible.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t cx = i % cols;
+        const std::size_t cy = i / cols;
+        const float jx = (rng.unit() - 0.5f) * 0.25f * cellW;
+        const float jy = (rng.unit() - 0.5f) * 0.25f * cellH;
+
+        off[i * 2 + 0] = -1.0f + (static_cast<float>(cx) + 0.5f) * cellW + jx;
+        off[i * 2 + 1] = -1.0f + (static_cast<float>(cy) + 0.5f) * cellH + jy;
+        rs[i * 2 + 0]  = rng.unit() * twoPi;
+        rs[i * 2 + 1]  = baseScale * (0.6f + 0.4f * rng.unit());
+
+        const std::uint32_t c = rng.next();
+        col[i * 4 + 0] = static_cast<std::uint8_t>(128 + ((c >>  0) & 0x7F));
+        col[i * 4 + 1] = static_cast<std::uint8_t>(128 + ((c >>  8) & 0x7F));
+        col[i * 4 + 2] = static_cast<std::uint8_t>(128 + ((c >> 16) & 0x7F));
+        col[i * 4 + 3] = 255;
+
+        vis[i] = (i % 16 == 15) ? 0 : 255;
+    }
+    m_dirty = kAll;
+    ++m_version;
+}
+
+std::size_t InstanceSet::StreamOffset(Stream s) const
+{
+    // Stream ranges are laid out back to back for the current GL capacity.
+    const std::size_t n = m_gpuCount;
+    switch (s) {
+        case kOffset:   return 0;
+        case kRotScale: return n * sizeof(float) * 2;
+        case kColor:    return n * sizeof(float) * 4;
+        case kVisible:  return n * (sizeof(float) * 4 + 4);
+        default:        return 0;
+    }
+}
+
+bool InstanceSet::Upload()
+{
+    if (!m_vbo) {
+        glGenBuffers(1, &m_vbo);
+        if (!m_vbo) return false;
+        m_gpuCount = 0;
+    }
+
+    GlState::Current().BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    if (m_gpuCount != m_count) {
+        // Layout depends on the count: re-allocate and send every stream.
+        m_gpuCount = m_count;
+        glBufferData(GL_ARRAY_BUFFER,
+                     static_cast<GLsizeiptr>(m_count * kBytesPerInstance),
+                     nullptr, GL_DYNAMIC_DRAW);
+        m_dirty = kAll;
+    }
+
+    if (m_count > 0) {
+        if (m_dirty & kOffset) {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(StreamOffset(kOffset)),
+                            static_cast<GLsizeiptr>(m_offset.size() * sizeof(float)), m_offset.data());
+        }
+        if (m_dirty & kRotScale) {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(StreamOffset(kRotScale)),
+                            static_cast<GLsizeiptr>(m_rotScale.size() * sizeof(float)), m_rotScale.data());
+        }
+        if (m_dirty & kColor) {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(StreamOffset(kColor)),
+                            static_cast<GLsizeiptr>(m_color.size()), m_color.data());
+        }
+        if (m_dirty & kVisible) {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(StreamOffset(kVisible)),
+                            static_cast<GLsizeiptr>(m_visible.size()), m_visible.data());
+        }
+    }
+    m_dirty = 0;
+    return true;
+}
+
+void InstanceSet::Reset()
+{
+    if (m_vbo) {
+        GlState::Current().OnBufferDeleted(m_vbo);
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+    m_gpuCount = 0;
+    m_count = 0;
+    m_offset.clear();
+    m_rotScale.clear();
+    m_color.clear();
+    m_visible.clear();
+    m_dirty = kAll;
+    ++m_version;
+}
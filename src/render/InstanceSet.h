@@ -0,0 +1,99 @@
+// src/render/InstanceSet.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * InstanceSet
+ * Per-instance data for instanced drawing (Scene stress mode), stored in
+ * structure-of-arrays layout on the CPU and inside one GL buffer:
+ *
+ *   [ offset.xy  * N ][ rotScale.xy * N ][ color.rgba8 * N ][ visible.u8 * N ]
+ *
+ * - offset:   translation in NDC (2 floats)
+ * - rotScale: rotation in radians + uniform scale (2 floats)
+ * - color:    RGBA8 tint, uploaded as normalized bytes
+ * - visible:  0/255, uploaded as a normalized byte
+ *
+ * Each stream is tracked separately; Upload() re-sends only the streams that
+ * were modified since the last upload. Setters are CPU-only and cheap; bulk
+ * writers can use the raw stream pointers and call MarkDirty().
+ * Version() increments on every modification, so owners can tell whether a
+ * new frame is needed without comparing data.
+ *
+ * Notes:
+ * - Upload()/Reset() require a current GL context.
+ * - Copy is disabled; the object owns its GL buffer.
+ */
+class InstanceSet
+{
+public:
+    enum Stream : unsigned {
+        kOffset   = 1u << 0,
+        kRotScale = 1u << 1,
+        kColor    = 1u << 2,
+        kVisible  = 1u << 3,
+        kAll      = kOffset | kRotScale | kColor | kVisible
+    };
+
+    InstanceSet() = default;
+    ~InstanceSet();
+
+    InstanceSet(const InstanceSet&) = delete;
+    InstanceSet& operator=(const InstanceSet&) = delete;
+
+    // Resize CPU storage. New instances are visible, white, unit scale.
+    void Resize(std::size_t count);
+    std::size_t Count() const { return m_count; }
+
+    // Per-instance setters (CPU side; mark the stream dirty).
+    void SetOffset(std::size_t i, float x, float y);
+    void SetRotationScale(std::size_t i, float radians, float scale);
+    void SetColor(std::size_t i, std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a);
+    void SetVisible(std::size_t i, bool visible);
+
+    // Raw stream access for bulk updates; call MarkDirty() afterwards.
+    float*        OffsetData()   { return m_offset.data(); }
+    float*        RotScaleData() { return m_rotScale.data(); }
+    std::uint8_t* ColorData()    { return m_color.data(); }
+    std::uint8_t* VisibleData()  { return m_visible.data(); }
+    void MarkDirty(unsigned streams) { m_dirty |= streams; ++m_version; }
+
+    // Modification counter (CPU side).
+    unsigned Version() const { return m_version; }
+
+    // Fill with 'count' instances on a jittered grid covering NDC [-1, 1],
+    // with pseudo-random rotation/color (deterministic for a given seed).
+    // Every 16th instance is hidden to exercise the visibility stream.
+    void GenerateStress(std::size_t count, unsigned seed);
+
+    // Send dirty streams to the GL buffer (re-allocates when the count grew).
+    bool Upload();
+
+    // Release the GL buffer and clear CPU storage.
+    void Reset();
+
+    // GL buffer and byte offset of each stream inside it (valid after Upload()).
+    unsigned vbo() const { return m_vbo; }
+    std::size_t StreamOffset(Stream s) const;
+
+    // Bytes per instance across all streams.
+    static constexpr std::size_t kBytesPerInstance =
+        sizeof(float) * 2 + sizeof(float) * 2 + 4 + 1;
+
+private:
+    std::size_t m_count {0};
+
+    // CPU streams (structure-of-arrays)
+    std::vector<float>        m_offset;    // 2 * N
+    std::vector<float>        m_rotScale;  // 2 * N
+    std::vector<std::uint8_t> m_color;     // 4 * N
+    std::vector<std::uint8_t> m_visible;   // 1 * N
+
+    unsigned    m_dirty {kAll};
+    unsigned    m_version {0};
+    unsigned    m_vbo {0};
+    std::size_t m_gpuCount {0};            // instance capacity of the GL buffer
+};
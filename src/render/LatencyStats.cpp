@@ -0,0 +1,59 @@
+// src/render/LatencyStats.cpp
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Util.h"
+
+std::int64_t LatencyStats::NowNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void LatencyStats::AddSince(std::int64_t startNs, std::int64_t endNs)
+{
+    Add(static_cast<double>(endNs - startNs) * 1e-6);
+}
+
+void LatencyStats::Add(double ms)
+{
+    if (m_samples.size() < kWindow) {
+        m_samples.push_back(ms);
+    } else {
+        m_samples[m_next] = ms;
+    }
+    m_next = (m_next + 1) % kWindow;
+    m_last = ms;
+    ++m_total;
+}
+
+void LatencyStats::Clear()
+{
+    m_samples.clear();
+    m_next  = 0;
+    m_total = 0;
+    m_last  = 0.0;
+}
+
+LatencyStats::Summary LatencyStats::Summarize() const
+{
+    Summary s;
+    s.count = m_samples.size();
+    if (s.count == 0)
+        return s;
+
+    std::vector<double> sorted(m_samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (double v : sorted)
+        sum += v;
+
+    s.last = m_last;
+    s.mean = sum / static_cast<double>(s.count);
+    s.p95  = Util::Percentile(sorted, 0.95);
+    s.max  = sorted.back();
+    return s;
+}
@@ -0,0 +1,44 @@
+// src/render/LatencyStats.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * LatencyStats
+ * Rolling window of latency samples in milliseconds (e.g. input event ->
+ * present). Keeps the last kWindow samples; summary values are computed on
+ * request, so Add() stays O(1) on the frame path.
+ *
+ * Timestamps are steady_clock nanoseconds (NowNs), so they can be passed
+ * between threads as plain integers; 0 means "no timestamp".
+ */
+class LatencyStats
+{
+public:
+    static const std::size_t kWindow = 240;   // ~4 s at 60 Hz
+
+    struct Summary {
+        std::size_t count {0};   // samples in the window
+        double last {0.0};
+        double mean {0.0};
+        double p95  {0.0};
+        double max  {0.0};
+    };
+
+    static std::int64_t NowNs();
+
+    void Add(double ms);
+    void AddSince(std::int64_t startNs, std::int64_t endNs);
+    void Clear();
+
+    std::size_t Total() const { return m_total; }   // samples ever added
+    Summary Summarize() const;
+
+private:
+    std::vector<double> m_samples;   // ring, up to kWindow
+    std::size_t m_next  {0};
+    std::size_t m_total {0};
+    double      m_last  {0.0};
+};
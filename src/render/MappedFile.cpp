@@ -0,0 +1,184 @@
+// src/render/MappedFile.cpp
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstdio>
+#include <utility>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#  include <sys/stat.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+std::atomic<unsigned> s_tempCounter {0};
+
+unsigned long ProcessId()
+{
+#if defined(_WIN32)
+    return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    return static_cast<unsigned long>(::getpid());
+#endif
+}
+} // namespace
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        swap(other);
+    }
+    return *this;
+}
+
+void MappedFile::swap(MappedFile& rhs) noexcept
+{
+    std::swap(m_data, rhs.m_data);
+    std::swap(m_size, rhs.m_size);
+#if defined(_WIN32)
+    std::swap(m_mapping, rhs.m_mapping);
+#endif
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);   // the mapping keeps the file open
+    if (!mapping)
+        return false;
+
+    void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!p) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_data    = p;
+    m_size    = static_cast<std::size_t>(size.QuadPart);
+    m_mapping = mapping;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    m_data    = nullptr;
+    m_mapping = nullptr;
+    m_size    = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file referenced
+    if (p == MAP_FAILED)
+        return false;
+
+    m_data = p;
+    m_size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        ::munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+bool MappedFile::WriteAtomic(const std::string& path, const void* data, std::size_t size)
+{
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), ".%lu.%u.tmp", ProcessId(), s_tempCounter.fetch_add(1));
+    const std::string tmp = path + suffix;
+
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f)
+        return false;
+    const bool written = std::fwrite(data, 1, size, f) == size;
+    const bool closed  = std::fclose(f) == 0;
+#if defined(_WIN32)
+    // rename() refuses to replace an existing file there.
+    const bool moved = written && closed &&
+                       MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool moved = written && closed && std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+    if (!moved) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Stamp(const std::string& path, std::uint64_t& size, std::int64_t& mtime)
+{
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (::_stat64(path.c_str(), &st) != 0)
+        return false;
+    mtime = static_cast<std::int64_t>(st.st_mtime) * 1000000000;
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0)
+        return false;
+#  if defined(__APPLE__)
+    mtime = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#  elif defined(__linux__)
+    mtime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#  else
+    mtime = static_cast<std::int64_t>(st.st_mtime) * 1000000000;
+#  endif
+#endif
+    size = static_cast<std::uint64_t>(st.st_size);
+    return true;
+}
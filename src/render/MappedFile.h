@@ -0,0 +1,60 @@
+// src/render/MappedFile.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * MappedFile
+ * Read-only memory mapping of a whole file (mmap / MapViewOfFile), so cooked
+ * resources can be handed to GL without copying them into heap buffers.
+ *
+ * - Open(path) maps the file; data()/size() stay valid until Close(), the
+ *   next Open() or destruction. Empty files fail to open.
+ * - Pages are faulted in by the first access, so opening is cheap.
+ * - WriteAtomic() is the matching writer for cache entries: the file appears
+ *   complete or not at all, even with several processes sharing a directory.
+ * - Stamp() reads size and modification time, to tell whether a source file
+ *   changed without reading it.
+ *
+ * Copy is disabled; move is supported.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    // Write 'size' bytes to a temporary name unique to this process and call
+    // (pid + counter), then rename over 'path' (replacing it). False if any
+    // step failed; the temporary is removed.
+    static bool WriteAtomic(const std::string& path, const void* data, std::size_t size);
+
+    // Size in bytes and modification time (ns since the epoch; whole seconds
+    // outside Linux and macOS) of 'path'.
+    static bool Stamp(const std::string& path, std::uint64_t& size, std::int64_t& mtime);
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(m_data); }
+    std::size_t size() const { return m_size; }
+    bool valid() const { return m_data != nullptr; }
+
+private:
+    void swap(MappedFile& rhs) noexcept;
+
+private:
+    void*       m_data {nullptr};
+    std::size_t m_size {0};
+#if defined(_WIN32)
+    void*       m_mapping {nullptr};   // HANDLE of the file mapping object
+#endif
+};
@@ -1,8 +1,12 @@
 // src/render/Mesh.cpp
 #include "Mesh.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 #include "glad/glad.h"
+#include "GlCaps.h"
+#include "GlState.h"
 
 Mesh::~Mesh()
 {
@@ -27,7 +31,12 @@ void Mesh::moveSwap(Mesh& rhs) noexcept
 {
     std::swap(m_vbo, rhs.m_vbo);
     std::swap(m_vao, rhs.m_vao);
+    std::swap(m_ebo, rhs.m_ebo);
+    std::swap(m_indexCount, rhs.m_indexCount);
+    std::swap(m_indexType, rhs.m_indexType);
     m_attribs.swap(rhs.m_attribs);
+    std::swap(m_instVbo, rhs.m_instVbo);
+    m_instAttribs.swap(rhs.m_instAttribs);
 }
 
 bool Mesh::Create(const void* data,
@@ -42,7 +51,7 @@ bool Mesh::Create(const void* data,
     glGenBuffers(1, &vbo);
     if (!vbo) return false;
 
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    GlState::Current().BindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
 
     m_vbo = vbo;
@@ -52,24 +61,118 @@ bool Mesh::Create(const void* data,
     if (!setupVAO()) {
         // Fallback path: nothing else to do here; attributes will be set at draw time.
     }
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     return true;
 }
 
 bool Mesh::UpdateBuffer(const void* data, std::size_t size, unsigned usage)
 {
     if (!m_vbo) return false;
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    GlState::Current().BindBuffer(GL_ARRAY_BUFFER, m_vbo);
     glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
 
     if (m_vao) {
         // VAO already knows attribute layout; nothing else to do.
     }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     return true;
 }
 
+bool Mesh::AttachInstanceBuffer(unsigned vbo, std::initializer_list<Attrib> attribs)
+{
+    if (!m_vbo) return false;
+
+    m_instVbo = vbo;
+    if (vbo) {
+        m_instAttribs.assign(attribs.begin(), attribs.end());
+    } else {
+        m_instAttribs.clear();
+    }
+
+    // The VAO captures buffer bindings, so rebuild it with the new streams.
+    if (m_vao) {
+        GlState::Current().OnVertexArrayDeleted(m_vao);
+        glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+        setupVAO();
+    }
+    return true;
+}
+
+bool Mesh::HalfFloatSupported()
+{
+    return GlCaps::HasVersion(3, 0) || GlCaps::HasExtension("GL_ARB_half_float_vertex");
+}
+
+bool Mesh::SetIndices(const std::uint32_t* indices, std::size_t count, unsigned usage)
+{
+    if (!m_vbo) return false;
+
+    GlState& gl = GlState::Current();
+    // The element binding is VAO state: bind ours (or 0) before touching it.
+    gl.BindVertexArray(m_vao);
+
+    if (count == 0 || !indices) {
+        if (m_ebo) {
+            gl.OnBufferDeleted(m_ebo);
+            glDeleteBuffers(1, &m_ebo);
+            m_ebo = 0;
+        }
+        m_indexCount = 0;
+        m_indexType  = 0;
+        return true;
+    }
+
+    if (!m_ebo) {
+        GLuint ebo = 0;
+        glGenBuffers(1, &ebo);
+        if (!ebo) return false;
+        m_ebo = ebo;
+    }
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+    // 16-bit indices halve the buffer and its fetch bandwidth.
+    const std::uint32_t maxIndex = *std::max_element(indices, indices + count);
+    if (maxIndex <= 0xFFFFu) {
+        std::vector<std::uint16_t> shorts(indices, indices + count);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(std::uint16_t)),
+                     shorts.data(), usage);
+        m_indexType = GL_UNSIGNED_SHORT;
+    } else {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(std::uint32_t)),
+                     indices, usage);
+        m_indexType = GL_UNSIGNED_INT;
+    }
+    m_indexCount = count;
+    return true;
+}
+
+std::size_t Mesh::IndexBytes() const
+{
+    return m_indexCount * (m_indexType == GL_UNSIGNED_SHORT ? 2u : 4u);
+}
+
+bool Mesh::InstancingSupported()
+{
+    // Non-null pointers prove nothing on GLX; ask the context.
+    const bool driver = GlCaps::HasVersion(3, 3) ||
+                        (GlCaps::HasExtension("GL_ARB_instanced_arrays") &&
+                         GlCaps::HasExtension("GL_ARB_draw_instanced"));
+    return driver && glad_glDrawArraysInstanced && glad_glVertexAttribDivisor;
+}
+
+void Mesh::bindAttribs(unsigned vbo, const std::vector<Attrib>& attribs)
+{
+    GlState& gl = GlState::Current();
+    gl.BindBuffer(GL_ARRAY_BUFFER, vbo);
+    for (const auto& a : attribs) {
+        gl.EnableVertexAttribArray(a.index);
+        glVertexAttribPointer(a.index, a.size, a.type,
+                              a.normalized, a.stride,
+                              reinterpret_cast<const void*>(a.offset));
+        // Always set: on the default VAO a previous mesh may have left a divisor.
+        gl.VertexAttribDivisor(a.index, a.divisor);
+    }
+}
+
 bool Mesh::setupVAO()
 {
     // VAO is not always available on very old GL. We check function pointers.
@@ -80,20 +183,16 @@ bool Mesh::setupVAO()
     glGenVertexArrays(1, &vao);
     if (!vao) return false;
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-
-    // Define attribute arrays once into the VAO state object
-    for (const auto& a : m_attribs) {
-        glEnableVertexAttribArray(a.index);
-        glVertexAttribPointer(a.index, a.size, a.type,
-                              a.normalized, a.stride,
-                              reinterpret_cast<const void*>(a.offset));
+    // Define attribute arrays once into the VAO state object. The VAO stays
+    // bound; every later user binds what it needs through GlState.
+    GlState::Current().BindVertexArray(vao);
+    bindAttribs(m_vbo, m_attribs);
+    if (m_instVbo) {
+        bindAttribs(m_instVbo, m_instAttribs);
+    }
+    if (m_ebo) {
+        GlState::Current().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
     }
-
-    // Unbind to keep state clean
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
 
     m_vao = vao;
     return true;
@@ -101,48 +200,89 @@ bool Mesh::setupVAO()
 
 void Mesh::enableAttributes() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    for (const auto& a : m_attribs) {
-        glEnableVertexAttribArray(a.index);
-        glVertexAttribPointer(a.index, a.size, a.type,
-                              a.normalized, a.stride,
-                              reinterpret_cast<const void*>(a.offset));
+    // Default VAO: enable exactly this mesh's arrays (stale ones from a
+    // previous mesh are disabled), then point them at our buffers.
+    std::uint32_t mask = 0;
+    for (const auto& a : m_attribs)     mask |= 1u << a.index;
+    for (const auto& a : m_instAttribs) mask |= 1u << a.index;
+
+    GlState& gl = GlState::Current();
+    gl.BindVertexArray(0);
+    gl.SetAttribArrays(mask);
+    bindAttribs(m_vbo, m_attribs);
+    if (m_instVbo) {
+        bindAttribs(m_instVbo, m_instAttribs);
+    }
+    if (m_ebo) {
+        gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
     }
 }
 
-void Mesh::disableAttributes() const
+const void* Mesh::indexOffset(int first) const
 {
-    for (const auto& a : m_attribs) {
-        glDisableVertexAttribArray(a.index);
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    const std::size_t size = (m_indexType == GL_UNSIGNED_SHORT) ? 2u : 4u;
+    return reinterpret_cast<const void*>(static_cast<std::size_t>(first) * size);
 }
 
 void Mesh::Draw(unsigned mode, int count) const
 {
-    if (!m_vbo || count <= 0) return;
+    DrawRange(mode, 0, count);
+}
+
+void Mesh::DrawRange(unsigned mode, int first, int count) const
+{
+    if (!m_vbo || count <= 0 || first < 0) return;
 
     if (m_vao) {
-        glBindVertexArray(m_vao);
-        glDrawArrays(mode, 0, count);
-        glBindVertexArray(0);
+        GlState::Current().BindVertexArray(m_vao);
     } else {
         // Fallback: bind attributes every draw
         enableAttributes();
-        glDrawArrays(mode, 0, count);
-        disableAttributes();
+    }
+    if (m_ebo) {
+        glDrawElements(mode, count, m_indexType, indexOffset(first));
+    } else {
+        glDrawArrays(mode, first, count);
+    }
+}
+
+void Mesh::DrawInstanced(unsigned mode, int count, int instances) const
+{
+    if (!m_vbo || count <= 0 || instances <= 0 || !InstancingSupported()) return;
+    if (m_ebo && !glDrawElementsInstanced) return;
+
+    if (m_vao) {
+        GlState::Current().BindVertexArray(m_vao);
+    } else {
+        enableAttributes();
+    }
+    if (m_ebo) {
+        glDrawElementsInstanced(mode, count, m_indexType, indexOffset(0), instances);
+    } else {
+        glDrawArraysInstanced(mode, 0, count, instances);
     }
 }
 
 void Mesh::Reset()
 {
     if (m_vao) {
+        GlState::Current().OnVertexArrayDeleted(m_vao);
         glDeleteVertexArrays(1, &m_vao);
         m_vao = 0;
     }
     if (m_vbo) {
+        GlState::Current().OnBufferDeleted(m_vbo);
         glDeleteBuffers(1, &m_vbo);
         m_vbo = 0;
     }
+    if (m_ebo) {
+        GlState::Current().OnBufferDeleted(m_ebo);
+        glDeleteBuffers(1, &m_ebo);
+        m_ebo = 0;
+    }
+    m_indexCount = 0;
+    m_indexType  = 0;
     m_attribs.clear();
+    m_instVbo = 0;
+    m_instAttribs.clear();
 }
\ No newline at end of file
@@ -4,10 +4,13 @@
 #include <initializer_list>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 
 /**
  * Mesh
- * Minimal RAII wrapper for a non-indexed triangle mesh (VBO + optional VAO).
+ * Minimal RAII wrapper for a triangle mesh (VBO + optional index buffer +
+ * optional VAO). Optionally sources per-instance attributes from a second,
+ * external buffer.
  *
  * Goals:
  * - Keep the demo code clean when setting up interleaved vertex data.
@@ -20,6 +23,16 @@
  *   Mesh m;
  *   m.Create(vertexData, sizeof(vertexData), {aPos, aColor});
  *   m.Draw(GL_TRIANGLES, 3);
+ *
+ * Indexed meshes: SetIndices() adds an element buffer (16-bit when every
+ * index fits, else 32-bit); from then on Draw/DrawRange/DrawInstanced use
+ * glDrawElements* and their first/count address indices, not vertices.
+ * Build indices for imported geometry with MeshOptimizer (weld + vertex
+ * cache order).
+ *
+ * Attributes may use compact types (GL_HALF_FLOAT, normalized
+ * GL_UNSIGNED_BYTE/SHORT); VertexPack converts float data and builds the
+ * matching Attrib.
  */
 class Mesh
 {
@@ -31,6 +44,7 @@ public:
         unsigned char normalized; // GL_TRUE/GL_FALSE
         int      stride;  // byte stride of a single vertex
         std::size_t offset; // byte offset within the vertex
+        unsigned divisor {0}; // 0 = per-vertex, N = advance every N instances
     };
 
     Mesh() = default;
@@ -61,12 +75,48 @@ public:
     bool UpdateBuffer(const void* data, std::size_t size, unsigned usage);
 
     /**
-     * Draw the mesh as non-indexed primitives.
+     * Source additional (typically per-instance) attributes from a buffer
+     * owned by the caller, e.g. InstanceSet. Attributes should set a non-zero
+     * divisor. The buffer id must stay valid while attached; pass 0 to detach.
+     * @return true on success
+     */
+    bool AttachInstanceBuffer(unsigned vbo, std::initializer_list<Attrib> attribs);
+
+    /**
+     * Upload a triangle index buffer; stored as GL_UNSIGNED_SHORT when the
+     * largest index is below 65536, else GL_UNSIGNED_INT. Replaces previous
+     * indices; count == 0 removes them (non-indexed again).
+     * @return true on success
+     */
+    bool SetIndices(const std::uint32_t* indices, std::size_t count, unsigned usage);
+
+    /**
+     * Draw the mesh.
      * @param mode  GL primitive (e.g., GL_TRIANGLES)
-     * @param count number of vertices to draw
+     * @param count number of vertices (indices when indexed) to draw
      */
     void Draw(unsigned mode, int count) const;
 
+    /**
+     * Draw a sub-range of the vertex (or index) buffer.
+     * @param first first vertex (first index when indexed)
+     */
+    void DrawRange(unsigned mode, int first, int count) const;
+
+    /**
+     * Draw 'instances' copies of the mesh in a single call.
+     * Requires InstancingSupported() (and glDrawElementsInstanced when
+     * indexed); no-op otherwise.
+     */
+    void DrawInstanced(unsigned mode, int count, int instances) const;
+
+    // GL 3.3, or ARB_instanced_arrays + ARB_draw_instanced (and the loader
+    // found glDrawArraysInstanced + glVertexAttribDivisor).
+    static bool InstancingSupported();
+
+    // GL_HALF_FLOAT attributes: GL 3.0 or ARB_half_float_vertex.
+    static bool HalfFloatSupported();
+
     /**
      * Release GL resources.
      */
@@ -75,15 +125,26 @@ public:
     // Accessors
     unsigned vbo() const { return m_vbo; }
     unsigned vao() const { return m_vao; } // might be 0 if not supported
+    unsigned ebo() const { return m_ebo; } // 0 if not indexed
+    bool Indexed() const { return m_ebo != 0; }
+    std::size_t IndexCount() const { return m_indexCount; }
+    unsigned IndexType() const { return m_indexType; }   // GL_UNSIGNED_SHORT/INT
+    std::size_t IndexBytes() const;
 
 private:
     void moveSwap(Mesh& rhs) noexcept;
     bool setupVAO();                    // tries to create VAO if available
     void enableAttributes() const;      // fallback path (no VAO)
-    void disableAttributes() const;     // fallback path (no VAO)
+    static void bindAttribs(unsigned vbo, const std::vector<Attrib>& attribs);
+    const void* indexOffset(int first) const;   // byte offset into the index buffer
 
 private:
     unsigned m_vbo {0};
     unsigned m_vao {0};                 // 0 => not used/available
+    unsigned m_ebo {0};                 // 0 => non-indexed
+    std::size_t m_indexCount {0};
+    unsigned m_indexType {0};
     std::vector<Attrib> m_attribs;      // cached for fallback attribute binding
+    unsigned m_instVbo {0};             // not owned (see AttachInstanceBuffer)
+    std::vector<Attrib> m_instAttribs;  // attributes sourced from m_instVbo
 };
\ No newline at end of file
@@ -0,0 +1,295 @@
+// src/render/MeshOptimizer.cpp
+#include "MeshOptimizer.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Util.h"
+
+const unsigned MeshOptimizer::kDefaultCacheSize;
+
+namespace {
+const std::uint32_t kNone = 0xFFFFFFFFu;
+
+// Forsyth's scoring constants ("Linear-Speed Vertex Cache Optimisation").
+const int   kScoreCacheSize    = 32;   // modelled LRU cache
+const float kCacheDecayPower   = 1.5f;
+const float kLastTriScore      = 0.75f;
+const float kValenceBoostScale = 2.0f;
+const float kValenceBoostPower = 0.5f;
+
+// Score terms are tabulated: std::pow per rescored vertex dominated the pass.
+const std::uint32_t kValenceTable = 32;
+
+struct ScoreTables {
+    float cache[kScoreCacheSize];
+    float valence[kValenceTable];
+
+    ScoreTables()
+    {
+        for (int i = 0; i < kScoreCacheSize; ++i) {
+            if (i < 3) {
+                // Used by the last triangle: a fixed score so the next triangle
+                // does not simply repeat the same edge in a strip.
+                cache[i] = kLastTriScore;
+            } else {
+                const float scale = 1.0f / static_cast<float>(kScoreCacheSize - 3);
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scale, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (std::uint32_t v = 1; v < kValenceTable; ++v)
+            valence[v] = kValenceBoostScale * std::pow(static_cast<float>(v), -kValenceBoostPower);
+    }
+};
+
+float VertexScore(const ScoreTables& tables, int cache_pos, std::uint32_t live_tris)
+{
+    if (live_tris == 0)
+        return -1.0f;   // nothing left to draw with it
+
+    const float cached = (cache_pos >= 0) ? tables.cache[cache_pos] : 0.0f;
+    // Finish vertices with few triangles left, so they can leave the cache.
+    const float boost = (live_tris < kValenceTable)
+        ? tables.valence[live_tris]
+        : kValenceBoostScale * std::pow(static_cast<float>(live_tris), -kValenceBoostPower);
+    return cached + boost;
+}
+} // namespace
+
+std::size_t MeshOptimizer::Weld(const void* vertices, std::size_t vertex_count, std::size_t stride,
+                                const std::uint32_t* indices, std::size_t index_count,
+                                std::vector<unsigned char>& out_vertices,
+                                std::vector<std::uint32_t>& out_indices)
+{
+    out_vertices.clear();
+    out_indices.clear();
+    if (!vertices || stride == 0)
+        return 0;
+    if (!indices)
+        index_count = vertex_count;
+
+    // Open addressing over unique vertices; at most half full.
+    std::size_t buckets = 16;
+    while (buckets < vertex_count * 2)
+        buckets *= 2;
+    std::vector<std::uint32_t> table(buckets, kNone);
+    std::vector<std::uint32_t> remap(vertex_count, kNone);
+
+    const unsigned char* src = static_cast<const unsigned char*>(vertices);
+    std::size_t unique = 0;
+    out_vertices.reserve(vertex_count * stride);
+    out_indices.reserve(index_count);
+
+    const std::size_t tri_count = index_count / 3;
+    for (std::size_t t = 0; t < tri_count; ++t) {
+        std::uint32_t tri[3];
+        bool valid = true;
+        for (std::size_t k = 0; k < 3; ++k) {
+            tri[k] = indices ? indices[t * 3 + k] : static_cast<std::uint32_t>(t * 3 + k);
+            valid = valid && tri[k] < vertex_count;
+        }
+        // Dropped whole: skipping just the bad index would shift the corners
+        // of every later triangle.
+        if (!valid)
+            continue;
+
+        for (const std::uint32_t v : tri) {
+            if (remap[v] == kNone) {
+                const unsigned char* bytes = src + v * stride;
+                std::size_t slot = Util::Fnv1a32(bytes, stride) & (buckets - 1);
+                while (table[slot] != kNone &&
+                       std::memcmp(out_vertices.data() + table[slot] * stride, bytes, stride) != 0) {
+                    slot = (slot + 1) & (buckets - 1);
+                }
+                if (table[slot] == kNone) {
+                    table[slot] = static_cast<std::uint32_t>(unique++);
+                    out_vertices.insert(out_vertices.end(), bytes, bytes + stride);
+                }
+                remap[v] = table[slot];
+            }
+            out_indices.push_back(remap[v]);
+        }
+    }
+    return unique;
+}
+
+bool MeshOptimizer::OptimizeVertexCache(std::uint32_t* indices, std::size_t index_count,
+                                        std::size_t vertex_count)
+{
+    const std::size_t tri_count = index_count / 3;
+    if (!indices || tri_count == 0)
+        return true;
+    for (std::size_t i = 0; i < tri_count * 3; ++i) {
+        if (indices[i] >= vertex_count)
+            return false;
+    }
+
+    // Triangles of each vertex (CSR); the first 'live[v]' entries of a
+    // vertex's range are the triangles not emitted yet.
+    std::vector<std::uint32_t> live(vertex_count, 0);
+    for (std::size_t i = 0; i < tri_count * 3; ++i)
+        ++live[indices[i]];
+    std::vector<std::uint32_t> first(vertex_count + 1, 0);
+    for (std::size_t v = 0; v < vertex_count; ++v)
+        first[v + 1] = first[v] + live[v];
+    std::vector<std::uint32_t> adjacency(tri_count * 3);
+    {
+        std::vector<std::uint32_t> fill(first.begin(), first.end() - 1);
+        for (std::size_t t = 0; t < tri_count; ++t) {
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+        }
+    }
+
+    static const ScoreTables tables;
+    std::vector<int>   cache_pos(vertex_count, -1);
+    std::vector<float> vertex_score(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v)
+        vertex_score[v] = VertexScore(tables, -1, live[v]);
+
+    std::vector<float> tri_score(tri_count);
+    std::vector<char>  emitted(tri_count, 0);
+    std::size_t best = 0;
+    for (std::size_t t = 0; t < tri_count; ++t) {
+        const std::uint32_t* tri = indices + t * 3;
+        tri_score[t] = vertex_score[tri[0]] + vertex_score[tri[1]] + vertex_score[tri[2]];
+        if (tri_score[t] > tri_score[best])
+            best = t;
+    }
+
+    std::vector<std::uint32_t> order;
+    order.reserve(tri_count * 3);
+    std::uint32_t cache[kScoreCacheSize + 3];
+    std::uint32_t next_cache[kScoreCacheSize + 3];
+    int cache_count = 0;
+    std::size_t cursor = 0;   // dead-end restarts scan forward from here
+
+    while (order.size() < tri_count * 3) {
+        if (best == kNone) {
+            // No cached vertex has triangles left: continue in input order.
+            while (emitted[cursor])
+                ++cursor;
+            best = cursor;
+        }
+
+        const std::uint32_t* tri = indices + best * 3;
+        order.insert(order.end(), tri, tri + 3);
+        emitted[best] = 1;
+
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t v = tri[k];
+            std::uint32_t* adj = adjacency.data() + first[v];
+            for (std::uint32_t j = 0; j < live[v]; ++j) {
+                if (adj[j] == best) {
+                    adj[j] = adj[live[v] - 1];
+                    adj[live[v] - 1] = static_cast<std::uint32_t>(best);
+                    --live[v];
+                    break;
+                }
+            }
+        }
+
+        // LRU: the triangle's vertices move to the front.
+        int next_count = 0;
+        for (int k = 0; k < 3; ++k) {
+            bool dup = false;
+            for (int j = 0; j < next_count; ++j)
+                dup = dup || next_cache[j] == tri[k];
+            if (!dup)
+                next_cache[next_count++] = tri[k];
+        }
+        for (int i = 0; i < cache_count; ++i) {
+            const std::uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                next_cache[next_count++] = v;
+        }
+
+        // Rescore everything that moved, including vertices pushed out.
+        for (int i = 0; i < next_count; ++i) {
+            const std::uint32_t v = next_cache[i];
+            cache_pos[v] = (i < kScoreCacheSize) ? i : -1;
+            const float score = VertexScore(tables, cache_pos[v], live[v]);
+            const float delta = score - vertex_score[v];
+            vertex_score[v] = score;
+            const std::uint32_t* adj = adjacency.data() + first[v];
+            for (std::uint32_t j = 0; j < live[v]; ++j)
+                tri_score[adj[j]] += delta;
+        }
+
+        best = kNone;
+        float best_score = -1.0f;
+        cache_count = next_count < kScoreCacheSize ? next_count : kScoreCacheSize;
+        for (int i = 0; i < cache_count; ++i) {
+            const std::uint32_t v = next_cache[i];
+            cache[i] = v;
+            const std::uint32_t* adj = adjacency.data() + first[v];
+            for (std::uint32_t j = 0; j < live[v]; ++j) {
+                if (tri_score[adj[j]] > best_score) {
+                    best_score = tri_score[adj[j]];
+                    best = adj[j];
+                }
+            }
+        }
+    }
+
+    std::memcpy(indices, order.data(), order.size() * sizeof(std::uint32_t));
+    return true;
+}
+
+std::size_t MeshOptimizer::OptimizeVertexFetch(void* vertices, std::size_t vertex_count, std::size_t stride,
+                                               std::uint32_t* indices, std::size_t index_count)
+{
+    std::vector<std::uint32_t> remap(vertex_count, kNone);
+    std::uint32_t next = 0;
+    for (std::size_t i = 0; i < index_count; ++i) {
+        const std::uint32_t v = indices[i];
+        if (v >= vertex_count)
+            continue;
+        if (remap[v] == kNone)
+            remap[v] = next++;
+        indices[i] = remap[v];
+    }
+
+    unsigned char* data = static_cast<unsigned char*>(vertices);
+    std::vector<unsigned char> reordered(static_cast<std::size_t>(next) * stride);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        if (remap[v] != kNone)
+            std::memcpy(reordered.data() + remap[v] * stride, data + v * stride, stride);
+    }
+    if (!reordered.empty())
+        std::memcpy(data, reordered.data(), reordered.size());
+    return next;
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::uint32_t* indices,
+                                                            std::size_t index_count,
+                                                            std::size_t vertex_count,
+                                                            unsigned cache_size)
+{
+    CacheStats stats;
+    if (cache_size == 0)
+        cache_size = 1;
+
+    // FIFO via insertion stamps: a vertex is cached while fewer than
+    // 'cache_size' other vertices were inserted after it.
+    std::vector<std::size_t> stamp(vertex_count, 0);
+    std::size_t clock = static_cast<std::size_t>(cache_size) + 1;
+    for (std::size_t i = 0; i < index_count; ++i) {
+        const std::uint32_t v = indices[i];
+        if (v >= vertex_count)
+            continue;
+        if (stamp[v] == 0)
+            ++stats.vertices;
+        if (clock - stamp[v] > cache_size)
+            stamp[v] = clock++;
+    }
+
+    stats.transforms = clock - cache_size - 1;
+    stats.triangles  = index_count / 3;
+    if (stats.triangles)
+        stats.acmr = static_cast<double>(stats.transforms) / static_cast<double>(stats.triangles);
+    if (stats.vertices)
+        stats.atvr = static_cast<double>(stats.transforms) / static_cast<double>(stats.vertices);
+    return stats;
+}
@@ -0,0 +1,68 @@
+// src/render/MeshOptimizer.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * MeshOptimizer
+ * CPU passes that turn imported triangle data into compact indexed meshes
+ * (Mesh::SetIndices) that are cheap to draw. Triangle lists only.
+ *
+ * Typical order for an imported triangle soup:
+ *   Weld()                -> unique vertices + index buffer
+ *   OptimizeVertexCache() -> triangle order for the post-transform cache
+ *   OptimizeVertexFetch() -> vertex order = first use, unused ones dropped
+ *
+ * - Weld() merges vertices whose bytes are identical (no epsilon: attributes
+ *   that differ by rounding stay separate). It accepts a triangle soup
+ *   (indices == nullptr) or an indexed mesh with duplicated vertices.
+ *   Triangles with an out-of-range index, and a trailing partial triangle,
+ *   are left out of the output.
+ * - OptimizeVertexCache() is Forsyth's linear-speed algorithm: triangles are
+ *   emitted greedily by a score favouring vertices recently used (cache
+ *   position) and vertices with few triangles left (valence), so each vertex
+ *   tends to be shaded once instead of once per triangle.
+ * - AnalyzeVertexCache() simulates a FIFO cache of 'cache_size' entries and
+ *   reports vertex shader invocations, ACMR (per triangle; 3 = no reuse,
+ *   ~0.5 for regular grids) and ATVR (per referenced vertex; 1 = optimal).
+ *
+ * Index values must be < vertex_count. No GL calls; any thread.
+ */
+class MeshOptimizer
+{
+public:
+    struct CacheStats {
+        std::size_t transforms {0};   // vertex shader invocations
+        std::size_t triangles  {0};
+        std::size_t vertices   {0};   // distinct vertices referenced
+        double      acmr {0.0};       // transforms / triangles
+        double      atvr {0.0};       // transforms / vertices
+    };
+
+    // Entries of the simulated post-transform cache (typical of GPUs).
+    static const unsigned kDefaultCacheSize = 16;
+
+    MeshOptimizer() = delete;
+
+    // Returns the unique vertex count; out_vertices holds that many
+    // 'stride'-byte vertices in first-occurrence order.
+    static std::size_t Weld(const void* vertices, std::size_t vertex_count, std::size_t stride,
+                            const std::uint32_t* indices, std::size_t index_count,
+                            std::vector<unsigned char>& out_vertices,
+                            std::vector<std::uint32_t>& out_indices);
+
+    // Reorder triangles in place; false (indices untouched) on out-of-range indices.
+    static bool OptimizeVertexCache(std::uint32_t* indices, std::size_t index_count,
+                                    std::size_t vertex_count);
+
+    // Reorder vertices by first use and rewrite the indices to match.
+    // Returns the referenced vertex count (the buffer's new length).
+    static std::size_t OptimizeVertexFetch(void* vertices, std::size_t vertex_count, std::size_t stride,
+                                           std::uint32_t* indices, std::size_t index_count);
+
+    static CacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t index_count,
+                                         std::size_t vertex_count,
+                                         unsigned cache_size = kDefaultCacheSize);
+};
@@ -0,0 +1,116 @@
+// src/render/OffscreenTarget.cpp
+#include "OffscreenTarget.h"
+
+#include <cstring>
+#include <utility>
+
+#include "glad/glad.h"
+
+OffscreenTarget::~OffscreenTarget()
+{
+    Reset();
+}
+
+OffscreenTarget::OffscreenTarget(OffscreenTarget&& other) noexcept
+{
+    swap(other);
+}
+
+OffscreenTarget& OffscreenTarget::operator=(OffscreenTarget&& other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        swap(other);
+    }
+    return *this;
+}
+
+void OffscreenTarget::swap(OffscreenTarget& rhs) noexcept
+{
+    std::swap(m_fbo,   rhs.m_fbo);
+    std::swap(m_color, rhs.m_color);
+    std::swap(m_w,     rhs.m_w);
+    std::swap(m_h,     rhs.m_h);
+}
+
+bool OffscreenTarget::Supported()
+{
+    return glad_glGenFramebuffers && glad_glDeleteFramebuffers && glad_glBindFramebuffer &&
+           glad_glCheckFramebufferStatus && glad_glFramebufferRenderbuffer &&
+           glad_glGenRenderbuffers && glad_glDeleteRenderbuffers &&
+           glad_glBindRenderbuffer && glad_glRenderbufferStorage;
+}
+
+bool OffscreenTarget::Create(int width, int height)
+{
+    Reset();
+    if (width <= 0 || height <= 0 || !Supported())
+        return false;
+
+    glGenRenderbuffers(1, &m_color);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_color);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    if (!complete) {
+        Reset();
+        return false;
+    }
+    m_w = width;
+    m_h = height;
+    return true;
+}
+
+void OffscreenTarget::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+}
+
+void OffscreenTarget::BindDefault()
+{
+    if (glad_glBindFramebuffer)
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool OffscreenTarget::ReadPixels(std::vector<unsigned char>& rgba) const
+{
+    if (!m_fbo)
+        return false;
+
+    Bind();
+    const std::size_t row = static_cast<std::size_t>(m_w) * 4;
+    rgba.resize(row * static_cast<std::size_t>(m_h));
+    // RGBA8 rows are 4-byte aligned, matching the default GL_PACK_ALIGNMENT.
+    glReadPixels(0, 0, m_w, m_h, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+    // GL returns the bottom row first.
+    std::vector<unsigned char> tmp(row);
+    for (int y = 0; y < m_h / 2; ++y) {
+        unsigned char* a = &rgba[static_cast<std::size_t>(y) * row];
+        unsigned char* b = &rgba[static_cast<std::size_t>(m_h - 1 - y) * row];
+        std::memcpy(tmp.data(), a, row);
+        std::memcpy(a, b, row);
+        std::memcpy(b, tmp.data(), row);
+    }
+    return true;
+}
+
+void OffscreenTarget::Reset()
+{
+    if (m_fbo) {
+        // Unbind first so later draws do not hit a deleted framebuffer.
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &m_fbo);
+        m_fbo = 0;
+    }
+    if (m_color) {
+        glDeleteRenderbuffers(1, &m_color);
+        m_color = 0;
+    }
+    m_w = m_h = 0;
+}
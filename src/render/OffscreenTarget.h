@@ -0,0 +1,64 @@
+// src/render/OffscreenTarget.h
+#pragma once
+
+#include <vector>
+
+/**
+ * OffscreenTarget
+ * Framebuffer object with an RGBA8 color renderbuffer, for rendering without
+ * a window (headless runs, benchmarks, tests).
+ * - Create(w, h): allocate; false when FBOs are unsupported or incomplete
+ * - Bind(): make it the draw/read framebuffer; Renderer then draws into it
+ * - ReadPixels(rgba): copy the image back to memory, top row first
+ *
+ * Notes:
+ * - Requires a current GL context (after gladLoadGL, e.g. Renderer::Initialize)
+ *   when creating, reading or destroying.
+ * - The contents persist between frames, so the host may report buffer age 1
+ *   to the Renderer for partial redraws.
+ * - Copy is disabled; move is supported.
+ */
+class OffscreenTarget
+{
+public:
+    OffscreenTarget() = default;
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    OffscreenTarget(OffscreenTarget&& other) noexcept;
+    OffscreenTarget& operator=(OffscreenTarget&& other) noexcept;
+
+    // (Re)allocate at the given size in pixels. Returns true on success.
+    bool Create(int width, int height);
+
+    // Bind as draw + read framebuffer / restore the window-system framebuffer.
+    void Bind() const;
+    static void BindDefault();
+
+    // Wait for rendering and copy the color buffer as tightly packed RGBA8,
+    // rows top to bottom (w*h*4 bytes). Binds the target.
+    bool ReadPixels(std::vector<unsigned char>& rgba) const;
+
+    // Release the GL objects, if any.
+    void Reset();
+
+    // Accessors
+    unsigned fbo() const { return m_fbo; }
+    int width()  const { return m_w; }
+    int height() const { return m_h; }
+    bool valid() const { return m_fbo != 0; }
+
+    // True when the loaded GL exposes framebuffer objects.
+    static bool Supported();
+
+private:
+    void swap(OffscreenTarget& rhs) noexcept;
+
+private:
+    unsigned m_fbo   {0};
+    unsigned m_color {0};   // renderbuffer
+    int      m_w     {0};
+    int      m_h     {0};
+};
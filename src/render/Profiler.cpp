@@ -0,0 +1,180 @@
+// src/render/Profiler.cpp
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Util.h"
+
+std::atomic<bool> Profiler::s_enabled {false};
+
+namespace {
+int BucketOf(std::int64_t ns)
+{
+    int k = 0;
+    for (std::uint64_t v = static_cast<std::uint64_t>(std::max<std::int64_t>(ns, 1)); v > 1; v >>= 1)
+        ++k;
+    return std::min(k, Profiler::kBuckets - 1);
+}
+
+double Us(double ns) { return ns * 1e-3; }
+
+bool EndsWith(const std::string& s, const char* suffix)
+{
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+} // namespace
+
+Profiler& Profiler::Instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+std::uint16_t Profiler::Register(const char* name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < m_scopes.size(); ++i) {
+        if (m_scopes[i].name == name)
+            return static_cast<std::uint16_t>(i);
+    }
+    if (static_cast<int>(m_scopes.size()) >= kMaxScopes)
+        return static_cast<std::uint16_t>(kMaxScopes - 1);   // shares the last slot
+
+    Scope s;
+    s.name = name;
+    s.window.reserve(kWindow);
+    m_scopes.push_back(s);
+    return static_cast<std::uint16_t>(m_scopes.size() - 1);
+}
+
+void Profiler::EndFrame()
+{
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drainLocked();
+}
+
+void Profiler::drainLocked()
+{
+    Sample s;
+    while (m_ring.TryPop(s)) {
+        if (s.id >= m_scopes.size())
+            continue;
+        Scope& sc = m_scopes[s.id];
+        if (sc.count == 0) {
+            sc.min = s.ns;
+            sc.max = s.ns;
+        } else {
+            sc.min = std::min(sc.min, s.ns);
+            sc.max = std::max(sc.max, s.ns);
+        }
+        ++sc.count;
+        sc.sum += s.ns;
+        ++sc.histogram[BucketOf(s.ns)];
+
+        if (sc.window.size() < kWindow) {
+            sc.window.push_back(s.ns);
+        } else {
+            sc.window[sc.next] = s.ns;
+        }
+        sc.next = (sc.next + 1) % kWindow;
+    }
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drainLocked();
+    for (Scope& sc : m_scopes) {
+        const std::string name = sc.name;
+        sc = Scope();
+        sc.name = name;
+        sc.window.reserve(kWindow);
+    }
+    m_frames.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+std::vector<Profiler::ScopeStats> Profiler::Snapshot()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drainLocked();
+
+    std::vector<ScopeStats> out;
+    out.reserve(m_scopes.size());
+    for (const Scope& sc : m_scopes) {
+        ScopeStats st;
+        st.name  = sc.name;
+        st.count = sc.count;
+        st.histogram.assign(sc.histogram, sc.histogram + kBuckets);
+        if (sc.count > 0) {
+            std::vector<double> w(sc.window.begin(), sc.window.end());
+            std::sort(w.begin(), w.end());
+            st.mean_us = Us(static_cast<double>(sc.sum) / static_cast<double>(sc.count));
+            st.min_us  = Us(static_cast<double>(sc.min));
+            st.max_us  = Us(static_cast<double>(sc.max));
+            st.p50_us  = Us(Util::Percentile(w, 0.50));
+            st.p95_us  = Us(Util::Percentile(w, 0.95));
+            st.p99_us  = Us(Util::Percentile(w, 0.99));
+        }
+        out.push_back(st);
+    }
+    return out;
+}
+
+bool Profiler::ExportCsv(const std::string& path)
+{
+    const std::vector<ScopeStats> stats = Snapshot();
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "scope,count,mean_us,min_us,p50_us,p95_us,p99_us,max_us\n");
+    for (const ScopeStats& s : stats) {
+        std::fprintf(f, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                     s.name.c_str(), static_cast<unsigned long long>(s.count),
+                     s.mean_us, s.min_us, s.p50_us, s.p95_us, s.p99_us, s.max_us);
+    }
+    return std::fclose(f) == 0;
+}
+
+bool Profiler::ExportJson(const std::string& path)
+{
+    const std::vector<ScopeStats> stats = Snapshot();
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "{\n  \"frames\": %llu,\n  \"dropped\": %llu,\n  \"scopes\": [",
+                 static_cast<unsigned long long>(Frames()),
+                 static_cast<unsigned long long>(Dropped()));
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const ScopeStats& s = stats[i];
+        std::fprintf(f, "%s\n    {\"name\": \"%s\", \"count\": %llu, \"mean_us\": %.3f, \"min_us\": %.3f, "
+                        "\"p50_us\": %.3f, \"p95_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, "
+                        "\"histogram_ns\": [",
+                     i ? "," : "", Util::JsonEscape(s.name).c_str(), static_cast<unsigned long long>(s.count),
+                     s.mean_us, s.min_us, s.p50_us, s.p95_us, s.p99_us, s.max_us);
+        // Non-empty buckets only, as [upper bound ns, count].
+        bool first = true;
+        for (int k = 0; k < kBuckets; ++k) {
+            if (s.histogram[k] == 0)
+                continue;
+            std::fprintf(f, "%s[%llu, %llu]", first ? "" : ", ",
+                         static_cast<unsigned long long>(1ull << (k + 1)),
+                         static_cast<unsigned long long>(s.histogram[k]));
+            first = false;
+        }
+        std::fprintf(f, "]}");
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+bool Profiler::Export(const std::string& path)
+{
+    return EndsWith(path, ".csv") ? ExportCsv(path) : ExportJson(path);
+}
@@ -0,0 +1,166 @@
+// src/render/Profiler.h
+#pragma once
+
+// CPU frame-timing scopes (header + small .cpp, no wxWidgets).
+// Usage:
+//   void Renderer::Render() {
+//       WXGL_PROFILE_SCOPE("Renderer::Render");
+//       ...
+//   }
+//   WXGL_PROFILE_FRAME();   // once per presented frame: folds samples into stats
+//
+// Compile in with:
+//   -D WXGL_ENABLE_PROFILING=ON   (CMake option, default ON)
+// Compiled out, the macros expand to nothing and no profiler code runs.
+// Compiled in, scopes record only while Profiler::SetEnabled(true) (the app
+// does so for --profile); otherwise a scope costs one relaxed atomic load.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Handoff.h"
+
+#ifndef WXGL_ENABLE_PROFILING
+#  define WXGL_ENABLE_PROFILING 0
+#endif
+
+/**
+ * Profiler
+ * Process-wide collector of scope durations.
+ *
+ * - Scopes push {id, duration} into a fixed-size lock-free MPSC ring; UI and
+ *   render thread may record concurrently. A full ring drops the sample and
+ *   counts it (Dropped()); nothing ever blocks or allocates on that path.
+ * - EndFrame() drains the ring into per-scope statistics: count/mean/min/
+ *   max, a rolling window of the last kWindow samples for p50/p95/p99
+ *   (Util::Percentile), and a cumulative power-of-two histogram.
+ * - ExportCsv / ExportJson write a snapshot; Export() picks by extension.
+ */
+class Profiler
+{
+public:
+    static const int         kMaxScopes  = 64;
+    static const std::size_t kWindow     = 1024;   // samples per scope for percentiles
+    static const int         kBuckets    = 40;     // [2^k, 2^(k+1)) ns, k < 40 (~18 min)
+    static const std::size_t kRingSize   = 8192;
+
+    struct ScopeStats {
+        std::string   name;
+        std::uint64_t count {0};
+        double mean_us {0.0};
+        double min_us  {0.0};
+        double p50_us  {0.0};
+        double p95_us  {0.0};
+        double p99_us  {0.0};
+        double max_us  {0.0};
+        std::vector<std::uint64_t> histogram;   // kBuckets counts
+    };
+
+    static Profiler& Instance();
+
+    static bool Enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool on) { s_enabled.store(on, std::memory_order_relaxed); }
+
+    static std::int64_t NowNs()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Returns a stable id for a scope name (same name, same id).
+    std::uint16_t Register(const char* name);
+
+    void Record(std::uint16_t id, std::int64_t durationNs)
+    {
+        Sample s;
+        s.id = id;
+        s.ns = durationNs;
+        if (!m_ring.TryPush(s))
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void EndFrame();
+    void Reset();
+
+    std::uint64_t Frames() const  { return m_frames.load(std::memory_order_relaxed); }
+    std::uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    std::vector<ScopeStats> Snapshot();
+
+    bool ExportCsv(const std::string& path);
+    bool ExportJson(const std::string& path);
+    bool Export(const std::string& path);   // ".csv" -> CSV, otherwise JSON
+
+private:
+    struct Sample {
+        std::uint16_t id {0};
+        std::int64_t  ns {0};
+    };
+
+    struct Scope {
+        std::string name;
+        std::uint64_t count {0};
+        std::int64_t  sum {0};
+        std::int64_t  min {0};
+        std::int64_t  max {0};
+        std::vector<std::int64_t> window;   // ring of the last kWindow samples
+        std::size_t   next {0};
+        std::uint64_t histogram[kBuckets] {};
+    };
+
+    Profiler() = default;
+    void drainLocked();
+
+private:
+    static std::atomic<bool> s_enabled;
+
+    MpscRing<Sample, kRingSize> m_ring;
+    std::atomic<std::uint64_t>  m_dropped {0};
+    std::atomic<std::uint64_t>  m_frames  {0};
+
+    std::mutex         m_mutex;     // scopes table, drain, snapshot
+    std::vector<Scope> m_scopes;
+};
+
+/**
+ * ProfileScope
+ * RAII timer behind WXGL_PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(std::uint16_t id)
+        : m_id(id), m_start(Profiler::Enabled() ? Profiler::NowNs() : 0) {}
+
+    ~ProfileScope()
+    {
+        if (m_start != 0)
+            Profiler::Instance().Record(m_id, Profiler::NowNs() - m_start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    std::uint16_t m_id;
+    std::int64_t  m_start;
+};
+
+#define WXGL_PROFILE_CONCAT_(a, b) a##b
+#define WXGL_PROFILE_CONCAT(a, b)  WXGL_PROFILE_CONCAT_(a, b)
+
+#if WXGL_ENABLE_PROFILING
+    #define WXGL_PROFILE_SCOPE(name)                                                   \
+        static const std::uint16_t WXGL_PROFILE_CONCAT(wxglProfId_, __LINE__) =      \
+            ::Profiler::Instance().Register(name);                                     \
+        ::ProfileScope WXGL_PROFILE_CONCAT(wxglProfScope_, __LINE__)(                  \
+            WXGL_PROFILE_CONCAT(wxglProfId_, __LINE__))
+    #define WXGL_PROFILE_FRAME() ::Profiler::Instance().EndFrame()
+#else
+    #define WXGL_PROFILE_SCOPE(name) ((void)0)
+    #define WXGL_PROFILE_FRAME()     ((void)0)
+#endif
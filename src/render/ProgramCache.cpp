@@ -0,0 +1,166 @@
+// src/render/ProgramCache.cpp
+#include "ProgramCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "glad/glad.h"
+#include "GlCaps.h"
+#include "GlTrace.h"
+#include "MappedFile.h"
+#include "Util.h"
+
+namespace {
+const char          kMagic[4] = { 'W', 'X', 'P', 'B' };
+const std::uint32_t kVersion  = 1;
+
+struct FileHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint32_t format;     // binaryFormat from glGetProgramBinary
+    std::uint32_t size;       // payload bytes
+    std::uint64_t checksum;   // FNV-1a of the payload
+};
+
+static_assert(sizeof(FileHeader) == 32, "program cache header layout");
+
+thread_local ProgramCache* t_current = nullptr;
+
+// Hashes the string including its terminator, so ("ab","c") != ("a","bc").
+std::uint64_t HashString(const char* s, std::uint64_t h)
+{
+    return s ? Util::Fnv1a(s, std::strlen(s) + 1, h) : Util::Fnv1a("", 1, h);
+}
+
+std::uint64_t KeyOf(const std::string& path)
+{
+    // <dir>/<16 hex>.wxprog
+    const std::size_t dot = path.rfind('.');
+    const std::size_t start = (dot != std::string::npos && dot >= 16) ? dot - 16 : 0;
+    return std::strtoull(path.substr(start, 16).c_str(), nullptr, 16);
+}
+} // namespace
+
+ProgramCache::ProgramCache(const std::string& dir)
+    : m_dir(dir)
+{
+    while (m_dir.size() > 1 && (m_dir.back() == '/' || m_dir.back() == '\\'))
+        m_dir.pop_back();
+}
+
+ProgramCache* ProgramCache::Current()
+{
+    return t_current;
+}
+
+void ProgramCache::MakeCurrent(ProgramCache* cache)
+{
+    t_current = cache;
+}
+
+bool ProgramCache::Supported() const
+{
+    if (m_driverSupport < 0) {
+        GLint formats = 0;
+        const bool api = (GlCaps::HasVersion(4, 1) || GlCaps::HasExtension("GL_ARB_get_program_binary")) &&
+                         glGetProgramBinary && glProgramBinary && glProgramParameteri;
+        if (api)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        m_driverSupport = (api && formats > 0) ? 1 : 0;
+    }
+    return m_driverSupport == 1 && !GlTrace::Active();
+}
+
+std::string ProgramCache::entryPath(const char* vs_src, const char* fs_src)
+{
+    if (!m_driverKnown) {
+        std::uint64_t h = Util::Fnv1a(&kVersion, sizeof(kVersion));
+        for (GLenum name : { GLenum(GL_VENDOR), GLenum(GL_RENDERER), GLenum(GL_VERSION),
+                             GLenum(GL_SHADING_LANGUAGE_VERSION) })
+            h = HashString(reinterpret_cast<const char*>(glGetString(name)), h);
+        m_driverHash  = h;
+        m_driverKnown = true;
+    }
+    const std::uint64_t key = HashString(fs_src, HashString(vs_src, m_driverHash));
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.wxprog", static_cast<unsigned long long>(key));
+    return m_dir + name;
+}
+
+unsigned ProgramCache::Load(const char* vs_src, const char* fs_src)
+{
+    if (!Supported())
+        return 0;
+
+    const std::string path = entryPath(vs_src, fs_src);
+    MappedFile file;
+    FileHeader hdr;
+    const bool valid = file.Open(path) && file.size() >= sizeof(hdr) &&
+                       (std::memcpy(&hdr, file.data(), sizeof(hdr)), true) &&
+                       std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) == 0 &&
+                       hdr.version == kVersion && hdr.key == KeyOf(path) &&
+                       hdr.size == file.size() - sizeof(hdr) &&
+                       hdr.checksum == Util::Fnv1a(file.data() + sizeof(hdr), hdr.size);
+    if (!valid) {
+        ++m_stats.misses;
+        return 0;
+    }
+
+    const GLuint prog = glCreateProgram();
+    if (!prog) {
+        ++m_stats.misses;
+        return 0;
+    }
+    glProgramBinary(prog, hdr.format, file.data() + sizeof(hdr), static_cast<GLsizei>(hdr.size));
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (ok != GL_TRUE) {
+        // Stale for this driver: drop it so the recompiled program replaces it.
+        glDeleteProgram(prog);
+        file.Close();
+        std::remove(path.c_str());
+        ++m_stats.rejected;
+        return 0;
+    }
+    ++m_stats.hits;
+    return prog;
+}
+
+bool ProgramCache::Store(const char* vs_src, const char* fs_src, unsigned program)
+{
+    if (!program || !Supported())
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;   // no binary formats on this driver
+
+    std::vector<unsigned char> data(sizeof(FileHeader) + static_cast<std::size_t>(length));
+    GLsizei written = 0;
+    GLenum  format  = 0;
+    glGetProgramBinary(program, length, &written, &format, data.data() + sizeof(FileHeader));
+    if (written <= 0)
+        return false;
+    data.resize(sizeof(FileHeader) + static_cast<std::size_t>(written));
+
+    const std::string path = entryPath(vs_src, fs_src);
+    FileHeader hdr {};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version  = kVersion;
+    hdr.key      = KeyOf(path);
+    hdr.format   = format;
+    hdr.size     = static_cast<std::uint32_t>(written);
+    hdr.checksum = Util::Fnv1a(data.data() + sizeof(hdr), hdr.size);
+    std::memcpy(data.data(), &hdr, sizeof(hdr));
+
+    // Readers never map a partial entry.
+    if (!MappedFile::WriteAtomic(path, data.data(), data.size()))
+        return false;
+    ++m_stats.stored;
+    return true;
+}
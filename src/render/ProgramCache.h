@@ -0,0 +1,71 @@
+// src/render/ProgramCache.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * ProgramCache
+ * On-disk store of linked GL program binaries (GL 4.1 / ARB_get_program_binary),
+ * so later runs skip GLSL compilation and linking.
+ *
+ * - Shader::CompileFromSource() asks the calling thread's current cache
+ *   (MakeCurrent) first and stores every program it had to link itself.
+ * - Entries are keyed by a 64-bit FNV-1a hash of both sources and the
+ *   GL_VENDOR / GL_RENDERER / GL_VERSION / GLSL version strings, and stored
+ *   as <dir>/<16 hex digits>.wxprog (header with binary format, size and a
+ *   payload checksum, then the driver blob). The file name is the index: a
+ *   lookup is one open() of a known path.
+ * - A driver update changes the version string and therefore the key. A blob
+ *   the driver still rejects (glProgramBinary leaves the program unlinked)
+ *   is deleted and the caller compiles from source, which stores a new one.
+ * - Without GL 4.1 / ARB_get_program_binary, on drivers offering no binary
+ *   format (GL_NUM_PROGRAM_BINARY_FORMATS == 0), or while a GlTrace capture
+ *   runs (a trace must replay on other drivers), Load() always misses and
+ *   Store() does nothing.
+ *
+ * Threading: one cache per GL context; use it on that context's thread.
+ */
+class ProgramCache
+{
+public:
+    struct Stats {
+        std::uint64_t hits     {0};
+        std::uint64_t misses   {0};
+        std::uint64_t rejected {0};   // blobs the driver refused
+        std::uint64_t stored   {0};
+    };
+
+    // 'dir' must exist; entries are created on demand.
+    explicit ProgramCache(const std::string& dir);
+
+    ProgramCache(const ProgramCache&) = delete;
+    ProgramCache& operator=(const ProgramCache&) = delete;
+
+    // Cache of the calling thread (nullptr = none).
+    static ProgramCache* Current();
+    static void MakeCurrent(ProgramCache* cache);
+
+    // True when the context can save and load program binaries (the driver
+    // part is checked once).
+    bool Supported() const;
+
+    // A linked program object created from the cached binary, or 0.
+    unsigned Load(const char* vs_src, const char* fs_src);
+
+    // Save 'program' (linked, GL_PROGRAM_BINARY_RETRIEVABLE_HINT set).
+    bool Store(const char* vs_src, const char* fs_src, unsigned program);
+
+    const std::string& Directory() const { return m_dir; }
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    std::string entryPath(const char* vs_src, const char* fs_src);
+
+private:
+    std::string   m_dir;
+    std::uint64_t m_driverHash {0};   // vendor/renderer/version, on first use
+    bool          m_driverKnown {false};
+    mutable signed char m_driverSupport {-1};   // -1 unknown, else 0/1
+    Stats         m_stats;
+};
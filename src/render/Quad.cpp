@@ -1,25 +1,28 @@
 // src/render/Quad.cpp
 #include "Quad.h"
 
+#include <cstdint>
+
 #include "glad/glad.h"
 
 bool Quad::CreatePosUV(unsigned posIndex, unsigned uvIndex)
 {
-    // Interleaved: [pos01.x, pos01.y, uv.x, uv.y] for 4 vertices
-    const float verts[] = {
-        // x    y    u    v
-         0.0f, 0.0f, 0.0f, 0.0f, // top-left
-         1.0f, 0.0f, 1.0f, 0.0f, // top-right
-         1.0f, 1.0f, 1.0f, 1.0f, // bottom-right
-         0.0f, 1.0f, 0.0f, 1.0f, // bottom-left
+    // Interleaved: [pos01.x, pos01.y, uv.x, uv.y] for 4 vertices,
+    // normalized unsigned shorts (0xFFFF reads as 1.0)
+    const std::uint16_t verts[] = {
+        // x       y       u       v
+        0x0000, 0x0000, 0x0000, 0x0000, // top-left
+        0xFFFF, 0x0000, 0xFFFF, 0x0000, // top-right
+        0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, // bottom-right
+        0x0000, 0xFFFF, 0x0000, 0xFFFF, // bottom-left
     };
 
-    const int stride = static_cast<int>(sizeof(float) * 4);
+    const int stride = static_cast<int>(sizeof(std::uint16_t) * 4);
     const Mesh::Attrib aPos {
-        posIndex, /*size*/2, GL_FLOAT, GL_FALSE, stride, /*offset*/0
+        posIndex, /*size*/2, GL_UNSIGNED_SHORT, GL_TRUE, stride, /*offset*/0
     };
     const Mesh::Attrib aUV  {
-        uvIndex,  /*size*/2, GL_FLOAT, GL_FALSE, stride, /*offset*/sizeof(float)*2
+        uvIndex,  /*size*/2, GL_UNSIGNED_SHORT, GL_TRUE, stride, /*offset*/sizeof(std::uint16_t)*2
     };
 
     const bool ok = m_mesh.Create(
@@ -6,13 +6,14 @@
 /**
  * Quad
  * A tiny helper that provides a reusable unit quad mesh in 0..1 space
- * with interleaved attributes. Intended for screen-space/UI rendering,
+ * with interleaved attributes (8 bytes per vertex). Intended for screen-space/UI rendering,
  * but can be used anywhere a unit quad is handy.
  *
  * - CreatePosUV(posIndex, uvIndex):
  *     Builds a 4-vertex quad with attributes:
- *       aPos01 (2 floats) at 'posIndex'  — position in 0..1 range
- *       aUV    (2 floats) at 'uvIndex'   — texture coordinates (0..1)
+ *       aPos01 (2 x normalized u16) at 'posIndex'  — position in 0..1 range
+ *       aUV    (2 x normalized u16) at 'uvIndex'   — texture coordinates (0..1)
+ *   Both read as floats in the shader; 0 and 1 are exact.
  *   The caller's shader must use the same attribute locations.
  *
  * - Draw():
@@ -0,0 +1,232 @@
+// src/render/RenderQueue.cpp
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "glad/glad.h"
+#include "GlState.h"
+#include "Mesh.h"
+#include "Profiler.h"
+#include "Shader.h"
+
+void RenderQueue::Clear()
+{
+    m_commands.clear();
+    m_uniforms.clear();
+    m_values.clear();
+    m_order.clear();
+    m_sorted = true;
+}
+
+void RenderQueue::SetLayerOrdered(std::uint8_t layer, bool ordered)
+{
+    const std::uint8_t bit = static_cast<std::uint8_t>(1u << (layer & 7));
+    if (ordered) m_ordered[layer >> 3] |= bit;
+    else         m_ordered[layer >> 3] &= static_cast<std::uint8_t>(~bit);
+}
+
+std::uint64_t RenderQueue::MakeKey(std::uint8_t layer, unsigned program,
+                                   unsigned texture, unsigned buffer)
+{
+    // GL names are small integers; 16 bits each only affects grouping if they
+    // ever wrap, never correctness.
+    return (static_cast<std::uint64_t>(layer)              << 56) |
+           (static_cast<std::uint64_t>(program & 0xFFFFu)  << 40) |
+           (static_cast<std::uint64_t>(texture & 0xFFFFu)  << 24) |
+           (static_cast<std::uint64_t>(buffer  & 0xFFFFu)  <<  8);
+}
+
+std::size_t RenderQueue::Push(std::uint8_t layer, Shader* shader, const Mesh* mesh,
+                              unsigned texture, Blend blend,
+                              unsigned mode, int first, int count, int instances)
+{
+    const bool ordered = (m_ordered[layer >> 3] >> (layer & 7)) & 1u;
+    const std::uint64_t key = ordered
+        ? (static_cast<std::uint64_t>(layer) << 56)
+        : MakeKey(layer, shader ? shader->Program() : 0u, texture, mesh ? mesh->vbo() : 0u);
+
+    DrawCommand cmd;
+    cmd.key          = key;
+    cmd.shader       = shader;
+    cmd.mesh         = mesh;
+    cmd.texture      = texture;
+    cmd.mode         = mode;
+    cmd.first        = first;
+    cmd.count        = count;
+    cmd.instances    = instances;
+    cmd.uniformFirst = static_cast<std::uint32_t>(m_uniforms.size());
+    cmd.uniformCount = 0;
+    cmd.blend        = blend;
+
+    if (!m_commands.empty() && key < m_commands.back().key)
+        m_sorted = false;
+    m_commands.push_back(cmd);
+    m_order.push_back(SortItem{ key, static_cast<std::uint32_t>(m_commands.size() - 1) });
+    return m_commands.size() - 1;
+}
+
+float* RenderQueue::addUniform(int slot, UniformKind kind, int n)
+{
+    if (m_commands.empty() || slot < 0)
+        return nullptr;
+
+    const std::uint32_t offset = static_cast<std::uint32_t>(m_values.size());
+    m_values.resize(m_values.size() + static_cast<std::size_t>(n));
+    m_uniforms.push_back(UniformRecord{ slot, offset, kind });
+    ++m_commands.back().uniformCount;
+    return &m_values[offset];
+}
+
+void RenderQueue::UniformInt(int slot, int v)
+{
+    // Stored bit-exact in the float arena.
+    static_assert(sizeof(int) == sizeof(float), "int uniforms share the float arena");
+    if (float* dst = addUniform(slot, UniformKind::Int, 1))
+        std::memcpy(dst, &v, sizeof(int));
+}
+
+void RenderQueue::UniformFloat(int slot, float v)
+{
+    if (float* dst = addUniform(slot, UniformKind::Float, 1))
+        dst[0] = v;
+}
+
+void RenderQueue::UniformVec4(int slot, float x, float y, float z, float w)
+{
+    if (float* dst = addUniform(slot, UniformKind::Vec4, 4)) {
+        dst[0] = x; dst[1] = y; dst[2] = z; dst[3] = w;
+    }
+}
+
+void RenderQueue::UniformMat4(int slot, const float m[16])
+{
+    if (float* dst = addUniform(slot, UniformKind::Mat4, 16))
+        std::memcpy(dst, m, 16 * sizeof(float));
+}
+
+void RenderQueue::Sort()
+{
+    WXGL_PROFILE_SCOPE("RenderQueue::Sort");
+    if (m_sorted || m_order.size() < 2) {
+        m_sorted = true;
+        return;
+    }
+
+    // LSD radix sort, 8 bits per pass. Passes where every key shares the
+    // same byte are skipped (common: low byte, high program/texture bits).
+    const std::size_t n = m_order.size();
+    m_scratch.resize(n);
+    SortItem* src = m_order.data();
+    SortItem* dst = m_scratch.data();
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        std::size_t counts[256] = {};
+        for (std::size_t i = 0; i < n; ++i)
+            ++counts[(src[i].key >> shift) & 0xFF];
+        if (counts[(src[0].key >> shift) & 0xFF] == n)
+            continue;
+
+        std::size_t sum = 0;
+        for (std::size_t& c : counts) {
+            const std::size_t t = c;
+            c = sum;
+            sum += t;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+            dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != m_order.data())
+        m_order.swap(m_scratch);
+    m_sorted = true;
+}
+
+void RenderQueue::Execute()
+{
+    ExecuteLayers(0, 255);
+}
+
+void RenderQueue::ExecuteLayers(std::uint8_t firstLayer, std::uint8_t lastLayer)
+{
+    Sort();
+    WXGL_PROFILE_SCOPE("RenderQueue::Execute");
+
+    // The layer is the top key byte: each layer is one contiguous run.
+    const auto layerOf = [](const SortItem& it) { return static_cast<unsigned>(it.key >> 56); };
+    const auto begin = std::partition_point(m_order.begin(), m_order.end(),
+        [&](const SortItem& it) { return layerOf(it) < firstLayer; });
+    const auto end = std::partition_point(begin, m_order.end(),
+        [&](const SortItem& it) { return layerOf(it) <= lastLayer; });
+
+    m_stats = Stats{};
+    m_stats.commands = static_cast<int>(end - begin);
+
+    GlState& gl = GlState::Current();
+    const Shader* lastShader  = nullptr;
+    unsigned      lastTexture = 0;
+
+    for (auto it = begin; it != end; ++it) {
+        const DrawCommand& cmd = m_commands[it->index];
+        if (!cmd.shader || !cmd.mesh)
+            continue;
+
+        if (cmd.shader != lastShader) {
+            cmd.shader->Use();
+            lastShader = cmd.shader;
+            ++m_stats.programs;
+        }
+        for (std::uint32_t u = 0; u < cmd.uniformCount; ++u) {
+            const UniformRecord& rec = m_uniforms[cmd.uniformFirst + u];
+            const float* v = &m_values[rec.offset];
+            switch (rec.kind) {
+                case UniformKind::Int: {
+                    int i = 0;
+                    std::memcpy(&i, v, sizeof(int));
+                    cmd.shader->SetInt(rec.slot, i);
+                    break;
+                }
+                case UniformKind::Float: cmd.shader->SetFloat(rec.slot, v[0]); break;
+                case UniformKind::Vec4:  cmd.shader->SetVec4(rec.slot, v[0], v[1], v[2], v[3]); break;
+                case UniformKind::Mat4:  cmd.shader->SetMat4(rec.slot, v); break;
+            }
+        }
+        if (cmd.texture && cmd.texture != lastTexture) {
+            gl.BindTextureUnit(0, GL_TEXTURE_2D, cmd.texture);
+            lastTexture = cmd.texture;
+            ++m_stats.textures;
+        }
+        ApplyBlend(cmd.blend);
+
+        if (cmd.instances > 0) {
+            cmd.mesh->DrawInstanced(cmd.mode, cmd.count, cmd.instances);
+        } else {
+            cmd.mesh->DrawRange(cmd.mode, cmd.first, cmd.count);
+        }
+        ++m_stats.draw_calls;
+    }
+}
+
+void RenderQueue::ApplyBlend(Blend b)
+{
+    GlState& gl = GlState::Current();
+    switch (b) {
+        case Blend::Alpha:
+            gl.Enable(GL_BLEND);
+            gl.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case Blend::Premultiplied:
+            gl.Enable(GL_BLEND);
+            gl.BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case Blend::Additive:
+            gl.Enable(GL_BLEND);
+            gl.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+            break;
+        case Blend::Opaque:
+            gl.Disable(GL_BLEND);
+            break;
+    }
+}
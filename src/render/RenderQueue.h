@@ -0,0 +1,136 @@
+// src/render/RenderQueue.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+class Shader;
+
+/**
+ * RenderQueue
+ * Per-frame list of compact draw packets. Subsystems record commands instead
+ * of drawing; Renderer sorts them once and executes them in key order.
+ *
+ * Sort key (64 bit, most significant first):
+ *   [63..56] layer  [55..40] program  [39..24] texture  [23..8] buffer  [7..0] 0
+ * Layers marked as ordered (e.g. the alpha-blended overlay) use only the
+ * layer byte, so their commands keep submission order; the radix sort is
+ * stable (LSD, 8 bits per pass, constant-byte passes skipped).
+ *
+ * Uniform values are copied into a per-queue arena at record time and applied
+ * through the Shader's slot setters (which skip unchanged values) at Execute().
+ *
+ * The recorded list stays valid until Clear(): Execute() may be called again
+ * to replay it unchanged.
+ *
+ * Notes:
+ * - Shader/Mesh pointers are not owned and must outlive the recorded list.
+ * - Execute() requires a current GL context and routes state via GlState.
+ */
+class RenderQueue
+{
+public:
+    enum class Blend : unsigned char {
+        Alpha,          // src*a + dst*(1-a)   (straight alpha, the default)
+        Premultiplied,  // src   + dst*(1-a)
+        Additive,       // src*a + dst
+        Opaque          // blending disabled
+    };
+
+    // Well-known layers (draw order).
+    enum Layer : std::uint8_t {
+        kLayerScene   = 16,
+        kLayerOverlay = 128
+    };
+
+    struct DrawCommand {
+        std::uint64_t key;
+        Shader*       shader;
+        const Mesh*   mesh;
+        unsigned      texture;        // GL_TEXTURE_2D on unit 0 (0 = leave as is)
+        unsigned      mode;           // GL primitive
+        int           first;          // vertices, or indices for indexed meshes
+        int           count;
+        int           instances;      // 0 = non-instanced
+        std::uint32_t uniformFirst;   // into the uniform record arena
+        std::uint16_t uniformCount;
+        Blend         blend;
+    };
+
+    struct Stats {
+        int commands   {0};
+        int draw_calls {0};
+        int programs   {0};   // program switches during Execute()
+        int textures   {0};   // texture switches during Execute()
+    };
+
+    RenderQueue() = default;
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Drop all commands (capacity is kept).
+    void Clear();
+
+    // Commands of an ordered layer sort by submission order only.
+    void SetLayerOrdered(std::uint8_t layer, bool ordered);
+
+    // Begin a command; uniforms added afterwards belong to it. Returns its index.
+    std::size_t Push(std::uint8_t layer, Shader* shader, const Mesh* mesh,
+                     unsigned texture, Blend blend,
+                     unsigned mode, int first, int count, int instances = 0);
+
+    // Per-command uniforms (slots from Shader::FindUniform).
+    void UniformInt(int slot, int v);
+    void UniformFloat(int slot, float v);
+    void UniformVec4(int slot, float x, float y, float z, float w);
+    void UniformMat4(int slot, const float m[16]);
+
+    // Sort by key (no-op when already sorted since the last Push).
+    void Sort();
+
+    // Issue all commands in sorted order.
+    void Execute();
+
+    // Issue only the commands of layers [firstLayer, lastLayer], e.g. to
+    // time the scene and overlay passes separately. Stats cover this call.
+    void ExecuteLayers(std::uint8_t firstLayer, std::uint8_t lastLayer);
+
+    std::size_t Size() const { return m_commands.size(); }
+    bool Empty() const { return m_commands.empty(); }
+    const Stats& LastStats() const { return m_stats; }
+
+    // Set blend enable/func through GlState.
+    static void ApplyBlend(Blend b);
+
+    static std::uint64_t MakeKey(std::uint8_t layer, unsigned program,
+                                 unsigned texture, unsigned buffer);
+
+private:
+    enum class UniformKind : unsigned char { Int, Float, Vec4, Mat4 };
+
+    struct UniformRecord {
+        int           slot;
+        std::uint32_t offset;     // into m_values
+        UniformKind   kind;
+    };
+
+    struct SortItem {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    float* addUniform(int slot, UniformKind kind, int n);
+
+private:
+    std::vector<DrawCommand>   m_commands;
+    std::vector<UniformRecord> m_uniforms;
+    std::vector<float>         m_values;
+    std::vector<SortItem>      m_order;
+    std::vector<SortItem>      m_scratch;
+    std::uint8_t               m_ordered[256 / 8] {};   // bitset of ordered layers
+    bool                       m_sorted {true};
+    Stats                      m_stats;
+};
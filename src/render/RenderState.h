@@ -1,6 +1,8 @@
 // src/render/RenderState.h
 #pragma once
 
+#include <cstdint>
+
 /**
  * RenderState
  * A simple POD-like struct holding the adjustable parameters of the scene.
@@ -11,10 +13,44 @@
  * - rotation_deg: rotation angle in degrees around the Z axis (2D scene).
  * - scale:        uniform scale factor (>0).
  * - object_visible: whether the main scene object is drawn.
+ * - instance_count: 0 draws the single demo triangle; N > 0 switches Scene to
+ *                   the instanced stress scene with N triangles.
+ * - version:      incremented by Renderer whenever any field actually changes;
+ *                 compare versions instead of fields to detect dirty state.
  */
 struct RenderState
 {
     float rotation_deg {0.0f};
     float scale        {1.0f};
     bool  object_visible {true};
-};
\ No newline at end of file
+    int   instance_count {0};
+
+    std::uint32_t version {0};
+};
+
+/**
+ * RenderStateDelta
+ * Parameter changes collected between two frames. Each setter overwrites the
+ * pending value of its field, so any number of UI events collapses into at
+ * most one assignment per field; Renderer::Apply() consumes it once per frame.
+ */
+struct RenderStateDelta
+{
+    enum Field : unsigned {
+        kRotation  = 1u << 0,
+        kScale     = 1u << 1,
+        kVisible   = 1u << 2,
+        kInstances = 1u << 3
+    };
+
+    unsigned    mask {0};   // Field bits set since the last Clear()
+    RenderState values;     // only fields named in 'mask' are meaningful
+
+    void SetRotation(float deg)    { values.rotation_deg   = deg; mask |= kRotation; }
+    void SetScale(float s)         { values.scale          = s;   mask |= kScale; }
+    void SetObjectVisible(bool v)  { values.object_visible = v;   mask |= kVisible; }
+    void SetInstanceCount(int n)   { values.instance_count = n;   mask |= kInstances; }
+
+    bool Empty() const { return mask == 0; }
+    void Clear()       { mask = 0; }
+};
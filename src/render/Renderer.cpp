@@ -4,22 +4,59 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #include "glad/glad.h"
 
+#include "AsyncTextureLoader.h"
+#include "GlState.h"
+#include "ProgramCache.h"
+#include "GlTrace.h"
+#include "GpuTimer.h"
+#include "Profiler.h"
+#include "RenderQueue.h"
 #include "Scene.h"
+#include "ShaderBatch.h"
+#include "TextureCache.h"
 #include "UIOverlay.h"
 
 namespace {
+// GpuTimer zones, added in this order in Initialize().
+enum GpuZone { kGpuClear, kGpuScene, kGpuOverlay };
+
+double NsToMs(std::int64_t ns) { return static_cast<double>(ns) * 1e-6; }
+
 // Simple clamp helper for C++14
 template <typename T>
 T clamp(T v, T lo, T hi) {
     return (v < lo) ? lo : (v > hi) ? hi : v;
 }
+
+// Assign and bump the state version only on an actual change.
+template <typename T>
+void assignState(RenderState& state, T& field, T value) {
+    if (field != value) {
+        field = value;
+        ++state.version;
+    }
+}
 } // namespace
 
 Renderer::Renderer()  = default;
-Renderer::~Renderer() = default;
+
+Renderer::~Renderer()
+{
+    // Subsystems release GL objects through our tracker; drop it afterwards.
+    if (m_gl) GlState::MakeCurrent(m_gl.get());
+    if (m_gpuTimer) m_gpuTimer->Shutdown();
+    m_loader.reset();
+    m_queue.reset();
+    m_overlay.reset();
+    m_scene.reset();
+    m_shaders.reset();
+    if (m_gl) GlState::MakeCurrent(nullptr);
+    if (ProgramCache::Current() == m_programs.get()) ProgramCache::MakeCurrent(nullptr);
+}
 
 bool Renderer::Initialize()
 {
@@ -30,23 +67,53 @@ bool Renderer::Initialize()
     if (!gladLoadGL()) {
         return false;
     }
+    // Loading reset the entry points; re-wrap them if a trace is recording.
+    GlTrace::Attach();
     const char* ver = reinterpret_cast<const char*>(glGetString(0x1F02)); // GL_VERSION
     const char* shv = reinterpret_cast<const char*>(glGetString(0x8B8C)); // GLSL
     std::cout << "OpenGL: " << (ver ? ver : "?")
           << " | GLSL: " << (shv ? shv : "?") << std::endl;
 
+    // Fresh tracker: the context may have been touched before we got it.
+    m_gl.reset(new GlState());
+    GlState::MakeCurrent(m_gl.get());
+    m_gl->ActiveTexture(0);
+    // Scene / overlay programs below come from the binary cache when possible.
+    ProgramCache::MakeCurrent(m_programs.get());
+
     ApplyDefaultGLState();
 
+    // Programs compile concurrently; subsystems draw with the batch's
+    // fallback program until theirs are linked (polled in Render()).
+    m_shaders.reset(new ShaderBatch());
+    if (!m_shaders->Begin()) {
+        return false;
+    }
+
     // Create subsystems
     m_scene.reset(new Scene());
-    m_overlay.reset(new UIOverlay());
+    // Icons may have been requested before Initialize(); pending async loads
+    // hold on to that overlay, so keep it rather than replacing it.
+    overlay();
+    m_queue.reset(new RenderQueue());
+    // Overlay quads are alpha blended: keep their submission order.
+    m_queue->SetLayerOrdered(RenderQueue::kLayerOverlay, true);
+
+    m_gpuTimer.reset(new GpuTimer());
+    if (m_gpuTimer->Initialize()) {
+        m_gpuTimer->AddZone("clear");
+        m_gpuTimer->AddZone("scene");
+        m_gpuTimer->AddZone("overlay");
+    }
+    m_gpuTimer->SetEnabled(m_gpuTiming);
 
-    if (!m_scene->Initialize()) {
+    if (!m_scene->Initialize(m_shaders.get())) {
         return false;
     }
-    if (!m_overlay->Initialize()) {
+    if (!m_overlay->Initialize(m_shaders.get())) {
         return false;
     }
+    m_shaders->Poll();
 
     // Propagate initial sizes if Resize was called earlier with defaults.
     m_scene->Resize(m_width, m_height, m_dpi);
@@ -59,32 +126,237 @@ bool Renderer::Initialize()
 void Renderer::ApplyDefaultGLState()
 {
     // 2D: no depth, enable alpha blending for textured UI
-    glDisable(0x0B71 /* GL_DEPTH_TEST */);
-    glDisable(0x0B44 /* GL_CULL_FACE */);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_gl->Disable(GL_DEPTH_TEST);
+    m_gl->Disable(GL_CULL_FACE);
+    m_gl->Enable(GL_BLEND);
+    m_gl->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     // A neutral dark background
     glClearColor(0.10f, 0.12f, 0.15f, 1.0f);
 }
 
 void Renderer::Resize(int width_px, int height_px, float dpi_scale)
 {
-    m_width  = std::max(1, width_px);
-    m_height = std::max(1, height_px);
-    m_dpi    = (dpi_scale > 0.0f) ? dpi_scale : 1.0f;
+    const int   w   = std::max(1, width_px);
+    const int   h   = std::max(1, height_px);
+    const float dpi = (dpi_scale > 0.0f) ? dpi_scale : 1.0f;
+    // The canvas re-applies its size on every paint; only real changes count.
+    const bool changed = (w != m_width || h != m_height || dpi != m_dpi);
+    if (changed)
+        m_frameDirty = true;
 
-    glViewport(0, 0, m_width, m_height);
+    m_width  = w;
+    m_height = h;
+    m_dpi    = dpi;
 
+    if (m_gl) {
+        GlState::MakeCurrent(m_gl.get());
+        m_gl->Viewport(0, 0, m_width, m_height);
+    } else {
+        glViewport(0, 0, m_width, m_height);
+    }
+
+    if (!changed)
+        return;
     if (m_scene)   m_scene->Resize(m_width, m_height, m_dpi);
     if (m_overlay) m_overlay->Resize(m_width, m_height, m_dpi);
 }
 
 void Renderer::Render()
 {
+    WXGL_PROFILE_SCOPE("Renderer::Render");
+    if (m_gl) {
+        GlState::MakeCurrent(m_gl.get());
+        ProgramCache::MakeCurrent(m_programs.get());
+        m_gl->ResetStats();
+    }
+
+    if (!m_queue) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        GlTrace::FrameEnd();
+        return;
+    }
+
+    // A program that just linked replaces its fallback: record and draw anew.
+    if (m_shaders && m_shaders->Pending() != 0 && m_shaders->Poll() > 0) {
+        m_recorded   = false;
+        m_frameDirty = true;
+    }
+
+    if (m_scene) m_scene->Prepare(m_state);
+
+    // Finished icon decodes are packed and uploaded here, within budget.
+    if (m_loader) {
+        WXGL_PROFILE_SCOPE("Renderer::TextureUploads");
+        m_loader->Pump(m_uploadBudgetMs);
+    }
+
+    const unsigned overlayVersion = m_overlay ? m_overlay->Version() : 0u;
+    const bool replay = m_recorded &&
+                        m_recordedState   == m_state.version &&
+                        m_recordedOverlay == overlayVersion;
+    if (!replay) {
+        m_queue->Clear();
+        if (m_scene)   m_scene->Submit(*m_queue, RenderQueue::kLayerScene, m_state);
+        if (m_overlay) m_overlay->Submit(*m_queue, RenderQueue::kLayerOverlay);
+        m_recordedState   = m_state.version;
+        m_recordedOverlay = overlayVersion;
+        m_recorded        = true;
+    }
+
+    const DamageRegion repaint = computeRepaint();
+    int drawCalls = 0;
+    m_gpuTimer->BeginFrame();
+    if (repaint.Full()) {
+        m_gl->Disable(GL_SCISSOR_TEST);
+        clearPass();
+        drawCalls = drawPasses();
+    } else if (!repaint.Empty()) {
+        // One scissored clear + replay per rectangle; everything outside is
+        // still valid in the back buffer (buffer age).
+        m_gl->Enable(GL_SCISSOR_TEST);
+        for (const DamageRect& r : repaint.Rects()) {
+            m_gl->Scissor(r.x, m_height - (r.y + r.h), r.w, r.h);
+            clearPass();
+            drawCalls += drawPasses();
+        }
+        m_gl->Disable(GL_SCISSOR_TEST);
+    }
+    m_gpuTimer->EndFrame();
+
+    m_presented    = currentVersions();
+    m_frameDirty   = false;
+
+    m_stats = FrameStats{};
+    m_stats.draw_calls = drawCalls;
+    m_stats.commands   = static_cast<int>(m_queue->Size());
+    m_stats.replayed   = replay;
+    m_stats.full_redraw    = repaint.Full();
+    m_stats.damage_rects   = repaint.Full() ? 0 : static_cast<int>(repaint.Rects().size());
+    m_stats.repaint_pixels = repaint.Full() ? static_cast<long long>(m_width) * m_height
+                                            : repaint.Area();
+    if (m_overlay) {
+        m_stats.overlay_sprites = m_overlay->LastStats().sprites;
+        m_stats.overlay_batches = m_overlay->LastStats().draw_calls;
+    }
+    if (m_gl) {
+        m_stats.gl_calls_issued   = static_cast<int>(m_gl->Stats().issued);
+        m_stats.gl_calls_filtered = static_cast<int>(m_gl->Stats().filtered);
+    }
+    fillGpuStats();
+    GlTrace::FrameEnd();
+}
+
+void Renderer::clearPass()
+{
+    m_gpuTimer->Begin(kGpuClear);
     glClear(GL_COLOR_BUFFER_BIT);
+    m_gpuTimer->End();
+}
+
+int Renderer::drawPasses()
+{
+    int drawCalls = 0;
+
+    m_gpuTimer->Begin(kGpuScene);
+    m_queue->ExecuteLayers(0, RenderQueue::kLayerOverlay - 1);
+    drawCalls += m_queue->LastStats().draw_calls;
+    m_gpuTimer->End();
+
+    m_gpuTimer->Begin(kGpuOverlay);
+    m_queue->ExecuteLayers(RenderQueue::kLayerOverlay, 255);
+    drawCalls += m_queue->LastStats().draw_calls;
+    m_gpuTimer->End();
+
+    return drawCalls;
+}
+
+void Renderer::fillGpuStats()
+{
+    const GpuTimer::Result& r = m_gpuTimer->Latest();
+    if (!m_gpuTimer->Enabled() || !r.valid)
+        return;
+    const auto ms = [&r](int zone) { return (r.zones & (1u << zone)) ? NsToMs(r.ns[zone]) : -1.0; };
+    m_stats.gpu_clear_ms   = ms(kGpuClear);
+    m_stats.gpu_scene_ms   = ms(kGpuScene);
+    m_stats.gpu_overlay_ms = ms(kGpuOverlay);
+    m_stats.gpu_lag_frames = static_cast<int>(m_gpuTimer->Frame() - r.frame);
+}
+
+DamageRegion Renderer::computeRepaint()
+{
+    // What changed since the previous frame. Always collect so the
+    // subsystems' pending damage does not accumulate.
+    DamageRegion frame;
+    if (m_scene)   m_scene->CollectDamage(m_state, frame);
+    if (m_overlay) m_overlay->CollectDamage(frame);
+    if (m_frameDirty)
+        frame.SetFull();
+    frame.ClipTo(m_width, m_height);
+
+    // A back buffer that is 'age' frames old misses this frame's damage plus
+    // that of the age-1 frames presented since it was last drawn.
+    DamageRegion repaint = frame;
+    const int age = m_bufferAge;
+    if (age <= 0 || age - 1 > m_historyCount) {
+        repaint.SetFull();
+    } else {
+        for (int i = 0; i < age - 1; ++i)
+            repaint.Add(m_history[i]);
+        repaint.ClipTo(m_width, m_height);
+    }
+
+    // Shift history (most recent first).
+    for (int i = kDamageHistory - 1; i > 0; --i)
+        m_history[i] = m_history[i - 1];
+    m_history[0] = frame;
+    if (m_historyCount < kDamageHistory)
+        ++m_historyCount;
+    return repaint;
+}
+
+void Renderer::SetBufferAge(int age)
+{
+    m_bufferAge = age > 0 ? age : 0;
+}
+
+void Renderer::SetGpuTiming(bool on)
+{
+    m_gpuTiming = on;
+    if (m_gpuTimer)
+        m_gpuTimer->SetEnabled(on);
+}
+
+bool Renderer::GpuTimingSupported() const
+{
+    return m_gpuTimer && m_gpuTimer->Supported();
+}
 
-    if (m_scene)   m_scene->Render(m_state);
-    if (m_overlay) m_overlay->Render();
+Renderer::Versions Renderer::currentVersions() const
+{
+    Versions v;
+    v.state   = m_state.version;
+    v.overlay = m_overlay ? m_overlay->Version() : 0u;
+    v.content = m_scene ? m_scene->ContentVersion() : 0u;
+    return v;
+}
+
+bool Renderer::NeedsRender() const
+{
+    if (!m_initialized || m_frameDirty)
+        return true;
+    if (m_loader && m_loader->HasReady())
+        return true;
+    if (m_shaders && m_shaders->Pending() != 0)
+        return true;
+    const Versions v = currentVersions();
+    return v.state   != m_presented.state ||
+           v.overlay != m_presented.overlay ||
+           v.content != m_presented.content;
+}
+
+void Renderer::Invalidate()
+{
+    m_frameDirty = true;
 }
 
 void Renderer::SetRotation(float deg)
@@ -94,32 +366,127 @@ void Renderer::SetRotation(float deg)
         // Keep within [0, 360)
         float d = std::fmod(deg, 360.0f);
         if (d < 0.0f) d += 360.0f;
-        m_state.rotation_deg = d;
+        assignState(m_state, m_state.rotation_deg, d);
     }
 }
 
 void Renderer::SetScale(float s)
 {
     if (std::isfinite(s)) {
-        m_state.scale = clamp(s, 0.1f, 8.0f);
+        assignState(m_state, m_state.scale, clamp(s, 0.1f, 8.0f));
     }
 }
 
 void Renderer::SetObjectVisible(bool v)
 {
-    m_state.object_visible = v;
+    assignState(m_state, m_state.object_visible, v);
+}
+
+void Renderer::SetInstanceCount(int n)
+{
+    // Upper bound keeps the per-instance buffer within a few tens of MB.
+    assignState(m_state, m_state.instance_count, clamp(n, 0, 4 * 1024 * 1024));
+}
+
+void Renderer::Apply(const RenderStateDelta& delta)
+{
+    const RenderState& v = delta.values;
+    if (delta.mask & RenderStateDelta::kRotation)  SetRotation(v.rotation_deg);
+    if (delta.mask & RenderStateDelta::kScale)     SetScale(v.scale);
+    if (delta.mask & RenderStateDelta::kVisible)   SetObjectVisible(v.object_visible);
+    if (delta.mask & RenderStateDelta::kInstances) SetInstanceCount(v.instance_count);
 }
 
 bool Renderer::LoadOverlayIcon(const std::string& png_path)
 {
-    if (!m_overlay)
-        m_overlay.reset(new UIOverlay());
+    UIOverlay& overlay = this->overlay();
     if (!m_initialized) {
         // The icon upload requires GL; caller ensures Initialize() first.
         // We still allow storing the path and lazy-loading inside UIOverlay if desired,
         // but here we just forward and return the immediate result.
     }
-    return m_overlay->LoadIcon(png_path);
+    return overlay.LoadIcon(png_path);
+}
+
+int Renderer::LoadOverlayIconSet(const std::vector<std::string>& png_paths)
+{
+    int packed = 0;
+    for (int h : overlay().AddIcons(png_paths)) {
+        if (h >= 0) ++packed;
+    }
+    return packed;
+}
+
+void Renderer::LoadOverlayIconAsync(const std::string& png_path, const IconLoaded& done)
+{
+    overlay().LoadIconAsync(loader(), png_path, done);
+}
+
+void Renderer::LoadOverlayIconSetAsync(const std::vector<std::string>& png_paths, const IconLoaded& done)
+{
+    overlay().AddIconsAsync(loader(), png_paths, done);
+}
+
+void Renderer::SetTextureUploadBudget(double ms)
+{
+    m_uploadBudgetMs = std::max(0.0, ms);
+}
+
+void Renderer::SetTextureReadyCallback(std::function<void()> notify)
+{
+    loader().SetReadyCallback(std::move(notify));
+}
+
+std::size_t Renderer::PendingTextureLoads() const
+{
+    return m_loader ? m_loader->Outstanding() : 0;
+}
+
+bool Renderer::SetTextureCacheDir(const std::string& dir)
+{
+    // Queued decodes hold the current cache.
+    if (PendingTextureLoads() != 0)
+        return false;
+
+    m_texCache.reset(dir.empty() ? nullptr : new TextureCache(dir));
+    if (m_overlay)
+        m_overlay->SetTextureCache(m_texCache.get());
+    if (m_loader)
+        m_loader->SetCache(m_texCache.get());
+    return true;
+}
+
+std::size_t Renderer::PendingPrograms() const
+{
+    return m_shaders ? m_shaders->Pending() : 0;
+}
+
+bool Renderer::SetProgramCacheDir(const std::string& dir)
+{
+    // The driver strings in the key are read once, from this context.
+    if (m_initialized)
+        return false;
+
+    m_programs.reset(dir.empty() ? nullptr : new ProgramCache(dir));
+    return true;
+}
+
+UIOverlay& Renderer::overlay()
+{
+    if (!m_overlay) {
+        m_overlay.reset(new UIOverlay());
+        m_overlay->SetTextureCache(m_texCache.get());
+    }
+    return *m_overlay;
+}
+
+AsyncTextureLoader& Renderer::loader()
+{
+    if (!m_loader) {
+        m_loader.reset(new AsyncTextureLoader());
+        m_loader->SetCache(m_texCache.get());
+    }
+    return *m_loader;
 }
 
 bool Renderer::HitTestOverlay(int x_px, int y_px, float /*dpi_scale*/) const
@@ -1,12 +1,23 @@
 // src/render/Renderer.h
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "Damage.h"
 #include "RenderState.h"
 
 // Forward declarations to keep rendering core decoupled at interface level.
+class AsyncTextureLoader;
+class TextureCache;
+class GlState;
+class ProgramCache;
+class ShaderBatch;
+class GpuTimer;
+class RenderQueue;
 class Scene;
 class UIOverlay;
 
@@ -17,18 +28,80 @@ class UIOverlay;
  * Lifecycle:
  *   - Initialize()    : load GL functions, set GL state, create subcomponents
  *   - Resize(w,h,dpi) : update viewport and subcomponents
- *   - Render()        : draw scene + overlay
+ *   - Render()        : record scene + overlay into a RenderQueue, sort, execute
+ *
+ * Recording is skipped when neither the RenderState nor the overlay changed
+ * since the last frame; the sorted command list is then replayed as-is.
+ *
+ * Dirty tracking:
+ *   NeedsRender() compares the RenderState, overlay and scene content
+ *   versions against those of the last rendered frame (plus size changes and
+ *   Invalidate()), so the host can skip frames where nothing changed.
+ *
+ * Partial redraw:
+ *   Scene and overlay report dirty pixel rectangles; the renderer merges
+ *   them and clears/redraws only those under glScissor. This needs the host
+ *   to report the back buffer's age (SetBufferAge, from GLX/EGL buffer-age or
+ *   1 for preserved swaps); with age 0 (unknown) every frame is full.
+ *
+ * GPU timing:
+ *   SetGpuTiming(true) brackets the clear, scene and overlay passes with
+ *   GL_TIME_ELAPSED queries (GpuTimer). Results are read back a few frames
+ *   late without stalling and show up in FrameStats and, while profiling,
+ *   in the Profiler as "GPU clear" / "GPU scene" / "GPU overlay".
+ *
+ * GL state goes through a per-context GlState cache, made current for the
+ * calling thread in Initialize()/Resize()/Render().
+ * SetProgramCacheDir() likewise makes a ProgramCache current, so shaders
+ * linked once are loaded as driver binaries on later runs.
+ *
+ * Shader programs are submitted together in Initialize() and complete in the
+ * background (ShaderBatch, KHR_parallel_shader_compile): until a program is
+ * linked its draws use a flat fallback program, and NeedsRender() stays true
+ * while PendingPrograms() is not 0.
+ *
+ * GL tracing:
+ *   Initialize() attaches an armed GlTrace capture and each Render() ends one
+ *   trace frame (wxgl_replay times them per frame).
  *
  * UI -> Render state:
- *   SetRotation / SetScale / SetObjectVisible
+ *   SetRotation / SetScale / SetObjectVisible / SetInstanceCount, or a
+ *   RenderStateDelta collected between frames via Apply()
  *
  * Overlay:
- *   LoadOverlayIcon() : load PNG into GL texture for the overlay button
+ *   LoadOverlayIcon() : pack the overlay button PNG into the icon atlas
+ *   LoadOverlayIconSet(): pack many PNGs (e.g. resources/icons) in one go
  *   HitTestOverlay()  : pixel-space hit test for the overlay button
+ *   The *Async variants return at once: PNGs decode on AsyncTextureLoader
+ *   worker threads, the button shows a placeholder, and Render() packs and
+ *   uploads finished icons within SetTextureUploadBudget() per frame before
+ *   reporting them through the callback. NeedsRender() stays true while
+ *   decoded icons wait; SetTextureReadyCallback() wakes an idle host.
+ *   SetTextureCacheDir() routes both paths through a TextureCache, so PNGs
+ *   are decoded once and later runs load the cooked pixels instead.
  */
 class Renderer final
 {
 public:
+    // Per-frame counters of the last Render() call.
+    struct FrameStats {
+        int draw_calls      {0};  // all draw calls issued (scene + overlay)
+        int commands        {0};  // render queue size
+        bool replayed   {false};  // queue reused without re-recording
+        int overlay_sprites {0};  // quads submitted to the overlay sprite batch
+        int overlay_batches {0};  // overlay draw calls after batching
+        int gl_calls_issued   {0};  // state calls that reached GL (GlState)
+        int gl_calls_filtered {0};  // redundant state calls dropped by GlState
+        bool full_redraw    {true};   // false = scissored partial redraw
+        int  damage_rects   {0};      // scissor passes (0 when full)
+        long long repaint_pixels {0}; // pixels cleared and redrawn
+        // Latest completed GPU pass times (ms), -1 = not timed / no result yet.
+        double gpu_clear_ms   {-1.0};
+        double gpu_scene_ms   {-1.0};
+        double gpu_overlay_ms {-1.0};
+        int    gpu_lag_frames {0};    // frames between that sample and this one
+    };
+
     Renderer();
     ~Renderer();
 
@@ -41,18 +114,80 @@ public:
     // Draw frame (scene first, then overlay).
     void Render();
 
+    // True when something changed since the last Render().
+    bool NeedsRender() const;
+
+    // Force the next NeedsRender() to return true and the next frame to be a
+    // full redraw (e.g. lost window contents).
+    void Invalidate();
+
+    // Age of the back buffer the next Render() draws into: 0 = unknown or
+    // undefined (full redraw), 1 = previous frame, N = N frames ago.
+    void SetBufferAge(int age);
+
+    // Time render passes on the GPU (no-op where timer queries are missing).
+    void SetGpuTiming(bool on);
+    bool GpuTimingSupported() const;
+
     // UI-controlled parameters
     void SetRotation(float deg);
     void SetScale(float s);
     void SetObjectVisible(bool v);
+    void SetInstanceCount(int n);   // 0 = single triangle, N = instanced stress scene
+
+    // Apply the fields of a coalesced delta through the setters above.
+    void Apply(const RenderStateDelta& delta);
 
     // Overlay interaction
     bool LoadOverlayIcon(const std::string& png_path);
+    int  LoadOverlayIconSet(const std::vector<std::string>& png_paths); // returns #packed
     bool HitTestOverlay(int x_px, int y_px, float dpi_scale) const;
 
+    // Asynchronous overlay icons; 'done' runs on the GL thread inside Render().
+    // May be requested before Initialize(), which keeps the same overlay.
+    using IconLoaded = std::function<void(const std::string& path, bool ok)>;
+    void LoadOverlayIconAsync(const std::string& png_path, const IconLoaded& done = IconLoaded());
+    void LoadOverlayIconSetAsync(const std::vector<std::string>& png_paths,
+                                 const IconLoaded& done = IconLoaded());
+    void SetTextureUploadBudget(double ms);   // per Render(), default 2 ms
+    // Runs on a decode thread when an image is ready; must not block.
+    void SetTextureReadyCallback(std::function<void()> notify);
+    std::size_t PendingTextureLoads() const;
+    // Cook icons into 'dir' (must exist) and load them from there; "" = off.
+    // Fails while async icon loads are pending.
+    bool SetTextureCacheDir(const std::string& dir);
+    const TextureCache* GetTextureCache() const { return m_texCache.get(); }
+    // Keep linked shader programs in 'dir' (must exist) so later runs skip
+    // GLSL compilation; "" = off. Call before Initialize().
+    bool SetProgramCacheDir(const std::string& dir);
+    const ProgramCache* GetProgramCache() const { return m_programs.get(); }
+    // Programs still compiling (drawn with the fallback meanwhile).
+    std::size_t PendingPrograms() const;
+    const ShaderBatch* GetShaderBatch() const { return m_shaders.get(); }
+
+    // Direct access for adding overlay items (nullptr until Initialize() or
+    // the first icon request).
+    UIOverlay* Overlay() { return m_overlay.get(); }
+
+    // Statistics
+    const FrameStats& LastFrameStats() const { return m_stats; }
+
 private:
+    struct Versions {
+        std::uint32_t state   {0};
+        unsigned      overlay {0};
+        unsigned      content {0};
+    };
+
     // Helpers
     void ApplyDefaultGLState();
+    Versions currentVersions() const;
+    DamageRegion computeRepaint();   // region to redraw this frame
+    void clearPass();
+    int  drawPasses();               // scene + overlay, returns draw calls
+    void fillGpuStats();
+    UIOverlay& overlay();              // created on first use
+    AsyncTextureLoader& loader();      // created on first use
 
 private:
     // Backing state shared with Scene
@@ -63,9 +198,49 @@ private:
     int   m_height {1};
     float m_dpi    {1.0f};
 
+    // GL state cache of this context; declared first so it outlives the
+    // subsystems that report deletions to it.
+    std::unique_ptr<GlState>   m_gl;
+
+    // Startup programs and the fallback; outlives the subsystems' shaders.
+    std::unique_ptr<ShaderBatch> m_shaders;
+
     // Subsystems
     std::unique_ptr<Scene>     m_scene;
     std::unique_ptr<UIOverlay> m_overlay;
 
+    // Program binaries for every Shader compiled on this context.
+    std::unique_ptr<ProgramCache> m_programs;
+
+    // Cooked icon cache; used by the overlay atlas and the loader threads.
+    std::unique_ptr<TextureCache> m_texCache;
+
+    // Decode threads for async icons (created on first use); its pending
+    // completions refer to the overlay, so it is destroyed first.
+    std::unique_ptr<AsyncTextureLoader> m_loader;
+    double m_uploadBudgetMs {2.0};
+
+    // Recorded frame and what it was recorded from
+    std::unique_ptr<RenderQueue> m_queue;
+
+    // GPU pass timing (zones: clear, scene, overlay)
+    std::unique_ptr<GpuTimer> m_gpuTimer;
+    bool m_gpuTiming {false};
+    std::uint32_t m_recordedState   {0};
+    unsigned      m_recordedOverlay {0};
+    bool          m_recorded {false};
+
+    // Versions of the last rendered frame
+    Versions m_presented;
+    bool     m_frameDirty {true};
+
+    // Damage of the last presented frames (index 0 = most recent)
+    static const int kDamageHistory = 4;
+    DamageRegion m_history[kDamageHistory];
+    int m_historyCount {0};
+    int m_bufferAge {0};
+
+    FrameStats m_stats;
+
     bool m_initialized {false};
 };
\ No newline at end of file
@@ -1,170 +1,344 @@
 // src/render/Scene.cpp
 #include "Scene.h"
 
+#include <algorithm>
 #include <cmath>
-#include <new>
+#include <iostream>
 
 #include "glad/glad.h"
+#include "Profiler.h"
 #include "Shader.h"
+#include "ShaderBatch.h"
+#include "ShaderVariants.h"
+#include "VertexPack.h"
 
-// Vertex: 2D position + RGB color
+// Source vertex: 2D position + RGB color. Uploaded packed (CreateTriangle).
 struct VertexPC {
     float x, y;
     float r, g, b;
 };
 
-Scene::Scene() = default;
+namespace {
+// A simple isosceles triangle centered at the origin (NDC space)
+const VertexPC kTriangle[3] = {
+    { -0.5f, -0.5f,  0.95f, 0.4f, 0.3f },
+    {  0.5f, -0.5f,  0.3f,  0.8f, 0.4f },
+    {  0.0f,  0.6f,  0.2f,  0.5f, 0.95f }
+};
+
+// Fixed seed so stress runs are comparable between launches.
+const unsigned kStressSeed = 0x5EED1234u;
+
+// Attribute locations, bound before linking so meshes can be built while the
+// programs are still compiling. aPos matches the ShaderBatch fallback.
+const unsigned kLocPos       = 0;
+const unsigned kLocColor     = 1;
+const unsigned kLocOffset    = 2;
+const unsigned kLocRotScale  = 3;
+const unsigned kLocInstColor = 4;
+const unsigned kLocVisible   = 5;
+
+// Flat color of the triangle while its program is pending.
+const float kFallbackColor[4] = { 0.5f, 0.5f, 0.55f, 1.0f };
+
+// Uniform slots of a variant, in SetUniforms() order.
+const int kUniformMvp = 0;
+
+// Plain triangle and, with INSTANCED, the stress field. The per-instance
+// transform is applied before the global uMVP so the slider still
+// rotates/scales the whole field.
+const char* kSceneVS =
+    "VS_IN vec2 aPos;\n"
+    "VS_IN vec3 aColor;\n"
+    "#ifdef INSTANCED\n"
+    "VS_IN vec2 aOffset;\n"
+    "VS_IN vec2 aRotScale; // radians, scale\n"
+    "VS_IN vec4 aInstColor;\n"
+    "VS_IN float aVisible;\n"
+    "#endif\n"
+    "uniform mat4 uMVP;\n"
+    "VS_OUT vec3 vColor;\n"
+    "void main() {\n"
+    "#ifdef INSTANCED\n"
+    "  float c = cos(aRotScale.x) * aRotScale.y;\n"
+    "  float s = sin(aRotScale.x) * aRotScale.y;\n"
+    "  vec2 p = vec2(c * aPos.x - s * aPos.y, s * aPos.x + c * aPos.y) + aOffset;\n"
+    "  vColor = aColor * aInstColor.rgb;\n"
+    "  // Hidden instances are moved outside the clip volume (clipped, no fragments).\n"
+    "  gl_Position = (aVisible > 0.5) ? uMVP * vec4(p, 0.0, 1.0) : vec4(2.0, 2.0, 2.0, 1.0);\n"
+    "#else\n"
+    "  vColor = aColor;\n"
+    "  gl_Position = uMVP * vec4(aPos, 0.0, 1.0);\n"
+    "#endif\n"
+    "}\n";
 
-Scene::~Scene()
+const char* kSceneFS =
+    "FS_IN vec3 vColor;\n"
+    "void main() {\n"
+    "  FRAG_COLOR = vec4(vColor, 1.0);\n"
+    "}\n";
+
+// Build a 2D rotation+scale matrix (column-major for GLSL)
+void BuildMVP(const RenderState& state, float out[16])
 {
-    if (m_vbo) {
-        glDeleteBuffers(1, &m_vbo);
-        m_vbo = 0;
-    }
-    delete m_shader;
-    m_shader = nullptr;
+    const float s = (state.scale > 0.f) ? state.scale : 1.f;
+    const float rad = state.rotation_deg * 3.14159265358979323846f / 180.0f;
+    const float c = std::cos(rad) * s;
+    const float sn = std::sin(rad) * s;
+
+    const float mvp[16] = {
+        c,   sn,  0.f, 0.f,
+       -sn,  c,   0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f
+    };
+    for (int i = 0; i < 16; ++i) out[i] = mvp[i];
 }
+} // namespace
+
+Scene::Scene()
+    : m_shaders("scene", { { Feature::Instanced, "INSTANCED" } })
+{
+}
+
+Scene::~Scene() = default;
 
-bool Scene::Initialize()
+bool Scene::Initialize(ShaderBatch* programs)
 {
     if (m_ready)
         return true;
 
-    if (!BuildGeometry())
-        return false;
+    m_programs = programs;
+    m_glsl330  = ShaderVariants::Glsl330Supported();
     if (!BuildShader())
         return false;
+    if (!BuildGeometry())
+        return false;
+
+    // Instancing is optional: the demo triangle still works without it.
+    if (!BuildInstanced()) {
+        std::cout << "Scene: instanced stress mode unavailable." << std::endl;
+    }
 
+    ResolveShaders();
     m_ready = true;
     return true;
 }
 
+void Scene::ResolveShaders()
+{
+    if (m_instancing && m_shaders.Failed(Key(true))) {
+        // Reported by the batch; the demo triangle still works without it.
+        m_instancing = false;
+        std::cout << "Scene: instanced stress mode unavailable." << std::endl;
+    }
+}
+
 void Scene::Resize(int width_px, int height_px, float dpi_scale)
 {
     m_width  = (width_px  > 0) ? width_px  : 1;
     m_height = (height_px > 0) ? height_px : 1;
     m_dpi    = (dpi_scale > 0.f) ? dpi_scale : 1.f;
 
-    (void)m_width; (void)m_height; (void)m_dpi; // reserved for future use
+    (void)m_dpi; // reserved for future use
+    // Size is used for damage bounds; a resize repaints everything anyway.
+    m_damageValid = false;
 }
 
-void Scene::Render(const RenderState& state)
+void Scene::Prepare(const RenderState& state)
 {
-    if (!m_ready || !m_shader)
-        return;
+    WXGL_PROFILE_SCOPE("Scene::Prepare");
+    ResolveShaders();
+    if (m_ready && m_instancing && state.instance_count > 0) {
+        // Regenerates on count changes; otherwise uploads dirty streams only.
+        m_instancesOk = SyncInstances(state.instance_count);
+    }
+}
 
-    if (!state.object_visible)
+void Scene::Submit(RenderQueue& queue, std::uint8_t layer, const RenderState& state)
+{
+    WXGL_PROFILE_SCOPE("Scene::Submit");
+    m_drawCalls = 0;
+    if (!m_ready)
         return;
 
-    // Activate program
-    m_shader->Use();
-    const unsigned int prog = m_shader->Program();
-    if (!prog)
+    if (!state.object_visible)
         return;
 
-    // Build a 2D rotation+scale matrix (column-major for GLSL)
-    const float s = (state.scale > 0.f) ? state.scale : 1.f;
-    const float rad = state.rotation_deg * 3.14159265358979323846f / 180.0f;
-    const float c = std::cos(rad) * s;
-    const float sn = std::sin(rad) * s;
+    float mvp[16];
+    BuildMVP(state, mvp);
 
-    const float mvp[16] = {
-        c,   sn,  0.f, 0.f,
-       -sn,  c,   0.f, 0.f,
-        0.f, 0.f, 1.f, 0.f,
-        0.f, 0.f, 0.f, 1.f
-    };
-
-    const int locMvp = glGetUniformLocation(prog, "uMVP");
-    if (locMvp >= 0 && glad_glUniformMatrix4fv) {
-        glUniformMatrix4fv(locMvp, 1, GL_FALSE, mvp);
+    // The plain triangle stands in until the instanced program is linked.
+    if (state.instance_count > 0 && m_instancing) {
+        const ShaderVariants::Program prog = m_shaders.Get(Key(true));
+        if (prog.shader) {
+            SubmitInstanced(queue, layer, prog, mvp);
+            return;
+        }
     }
 
-    // Bind VBO and set vertex attributes by queried locations
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-
-    const int locPos   = glGetAttribLocation(prog, "aPos");
-    const int locColor = glGetAttribLocation(prog, "aColor");
-    if (locPos < 0 || locColor < 0) {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    const ShaderVariants::Program prog = m_shaders.Get(Key(false));
+    if (prog.shader) {
+        queue.Push(layer, prog.shader, &m_mesh, 0, RenderQueue::Blend::Alpha, GL_TRIANGLES, 0, 3);
+        queue.UniformMat4(prog.slots[kUniformMvp], mvp);
+    } else if (Shader* fallback = m_programs ? m_programs->Fallback() : nullptr) {
+        queue.Push(layer, fallback, &m_mesh, 0, RenderQueue::Blend::Alpha, GL_TRIANGLES, 0, 3);
+        queue.UniformMat4(m_programs->FallbackMatrix(), mvp);
+        queue.UniformVec4(m_programs->FallbackColor(),
+                          kFallbackColor[0], kFallbackColor[1], kFallbackColor[2], kFallbackColor[3]);
+    } else {
         return;
     }
+    m_drawCalls = 1;
+}
 
-    const GLsizei stride = static_cast<GLsizei>(sizeof(VertexPC));
-    const GLvoid* posPtr = reinterpret_cast<const GLvoid*>(offsetof(VertexPC, x));
-    const GLvoid* colPtr = reinterpret_cast<const GLvoid*>(offsetof(VertexPC, r));
+void Scene::SubmitInstanced(RenderQueue& queue, std::uint8_t layer,
+                            const ShaderVariants::Program& prog, const float mvp[16])
+{
+    if (!m_instancesOk || m_instances.Count() == 0)
+        return;
 
-    if (locPos >= 0 && glad_glEnableVertexAttribArray && glad_glVertexAttribPointer) {
-        glEnableVertexAttribArray(static_cast<GLuint>(locPos));
-        glVertexAttribPointer(static_cast<GLuint>(locPos), 2, GL_FLOAT, GL_FALSE, stride, posPtr);
-    }
-    if (locColor >= 0 && glad_glEnableVertexAttribArray && glad_glVertexAttribPointer) {
-        glEnableVertexAttribArray(static_cast<GLuint>(locColor));
-        glVertexAttribPointer(static_cast<GLuint>(locColor), 3, GL_FLOAT, GL_FALSE, stride, colPtr);
+    // One draw call for the whole set; hidden instances collapse in the VS.
+    queue.Push(layer, prog.shader, &m_instMesh, 0, RenderQueue::Blend::Alpha, GL_TRIANGLES, 0, 3,
+               static_cast<int>(m_instances.Count()));
+    queue.UniformMat4(prog.slots[kUniformMvp], mvp);
+    m_drawCalls = 1;
+}
+
+DamageRect Scene::Bounds(const RenderState& state) const
+{
+    if (!state.object_visible)
+        return DamageRect{};
+
+    float mvp[16];
+    BuildMVP(state, mvp);
+
+    // NDC -> device pixels (top-left origin), padded for rasterization/rounding.
+    float x0 = 1e30f, y0 = 1e30f, x1 = -1e30f, y1 = -1e30f;
+    for (const VertexPC& v : kTriangle) {
+        const float nx = mvp[0] * v.x + mvp[4] * v.y;
+        const float ny = mvp[1] * v.x + mvp[5] * v.y;
+        const float px = (nx * 0.5f + 0.5f) * static_cast<float>(m_width);
+        const float py = (0.5f - ny * 0.5f) * static_cast<float>(m_height);
+        x0 = std::min(x0, px); x1 = std::max(x1, px);
+        y0 = std::min(y0, py); y1 = std::max(y1, py);
     }
+    const int pad = 2;
+    const int ix0 = static_cast<int>(std::floor(x0)) - pad;
+    const int iy0 = static_cast<int>(std::floor(y0)) - pad;
+    const int ix1 = static_cast<int>(std::ceil(x1))  + pad;
+    const int iy1 = static_cast<int>(std::ceil(y1))  + pad;
+    return DamageRect{ ix0, iy0, ix1 - ix0, iy1 - iy0 };
+}
 
-    if (glad_glDrawArrays) {
-        glDrawArrays(GL_TRIANGLES, 0, 3);
+void Scene::CollectDamage(const RenderState& state, DamageRegion& out)
+{
+    const unsigned content = m_instances.Version();
+    if (!m_damageValid) {
+        out.SetFull();
+    } else if (state.version != m_damageState.version || content != m_damageContent) {
+        if (DrawsInstanced(state) || DrawsInstanced(m_damageState)) {
+            // The field covers the whole viewport.
+            out.SetFull();
+        } else {
+            out.Add(Bounds(m_damageState));
+            out.Add(Bounds(state));
+        }
     }
+    m_damageState   = state;
+    m_damageContent = content;
+    m_damageValid   = true;
+}
 
-    if (locColor >= 0 && glad_glDisableVertexAttribArray) {
-        glDisableVertexAttribArray(static_cast<GLuint>(locColor));
+bool Scene::SyncInstances(int count)
+{
+    const std::size_t want = static_cast<std::size_t>(count > 0 ? count : 0);
+    if (want != m_instances.Count()) {
+        m_instances.GenerateStress(want, kStressSeed);
     }
-    if (locPos >= 0 && glad_glDisableVertexAttribArray) {
-        glDisableVertexAttribArray(static_cast<GLuint>(locPos));
+    if (!m_instances.Upload())
+        return false;
+
+    // Stream offsets follow the buffer's capacity, which can also change
+    // through Instances(); re-point the mesh whenever the layout moved.
+    const unsigned    vbo    = m_instances.vbo();
+    const std::size_t layout = m_instances.StreamOffset(InstanceSet::kVisible);
+    if (vbo != m_attachedVbo || layout != m_attachedLayout) {
+        const Mesh::Attrib aOffset   { kLocOffset,    2, GL_FLOAT,         GL_FALSE, 0,
+                                       m_instances.StreamOffset(InstanceSet::kOffset),   1 };
+        const Mesh::Attrib aRotScale { kLocRotScale,  2, GL_FLOAT,         GL_FALSE, 0,
+                                       m_instances.StreamOffset(InstanceSet::kRotScale), 1 };
+        const Mesh::Attrib aColor    { kLocInstColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  0,
+                                       m_instances.StreamOffset(InstanceSet::kColor),    1 };
+        const Mesh::Attrib aVisible  { kLocVisible,   1, GL_UNSIGNED_BYTE, GL_TRUE,  0,
+                                       m_instances.StreamOffset(InstanceSet::kVisible),  1 };
+        m_instMesh.AttachInstanceBuffer(vbo, { aOffset, aRotScale, aColor, aVisible });
+        m_attachedVbo    = vbo;
+        m_attachedLayout = layout;
     }
+    return true;
+}
+
+bool Scene::BuildInstanced()
+{
+    if (!Mesh::InstancingSupported())
+        return false;
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Submitted now so a batch compiles it with the other startup programs.
+    m_shaders.Get(Key(true));
+    if (m_shaders.Failed(Key(true)))
+        return false;
+
+    if (!CreateTriangle(m_instMesh))
+        return false;
+    m_attachedVbo = 0;   // fresh mesh: attach the instance streams again
+
+    m_instancing = true;
+    return true;
 }
 
 bool Scene::BuildGeometry()
 {
-    // A simple isosceles triangle centered at the origin (NDC space)
-    const VertexPC verts[3] = {
-        { -0.5f, -0.5f,  0.95f, 0.4f, 0.3f },
-        {  0.5f, -0.5f,  0.3f,  0.8f, 0.4f },
-        {  0.0f,  0.6f,  0.2f,  0.5f, 0.95f }
-    };
+    return CreateTriangle(m_mesh);
+}
 
-    glGenBuffers(1, &m_vbo);
-    if (!m_vbo)
-        return false;
+bool Scene::CreateTriangle(Mesh& mesh) const
+{
+    // 8 bytes per vertex instead of 20: half-float position (float where the
+    // driver lacks half attributes) and an RGB8 color in a 4-byte slot.
+    using Format = VertexPack::Format;
+    const Format posFormat = Mesh::HalfFloatSupported() ? Format::Half : Format::Float;
+    const std::size_t posBytes = 2 * VertexPack::ComponentBytes(posFormat);
+    const std::size_t stride = posBytes + 4;
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    unsigned char data[3 * (2 * sizeof(float) + 4)] = {};
+    VertexPack::Pack(posFormat, &kTriangle[0].x, sizeof(VertexPC), 2, data, stride, 3);
+    VertexPack::Pack(Format::UNorm8, &kTriangle[0].r, sizeof(VertexPC), 3, data + posBytes, stride, 3);
 
-    return (glGetError() == 0);
+    const int s = static_cast<int>(stride);
+    const Mesh::Attrib aPos   = VertexPack::MakeAttrib(kLocPos,   2, posFormat,      s, 0);
+    const Mesh::Attrib aColor = VertexPack::MakeAttrib(kLocColor, 3, Format::UNorm8, s, posBytes);
+    return mesh.Create(data, 3 * stride, { aPos, aColor }, GL_STATIC_DRAW);
 }
 
 bool Scene::BuildShader()
 {
-    static const char* kVS =
-        "#version 120\n"
-        "attribute vec2 aPos;\n"
-        "attribute vec3 aColor;\n"
-        "uniform mat4 uMVP;\n"
-        "varying vec3 vColor;\n"
-        "void main() {\n"
-        "  vColor = aColor;\n"
-        "  gl_Position = uMVP * vec4(aPos, 0.0, 1.0);\n"
-        "}\n";
-
-    static const char* kFS =
-        "#version 120\n"
-        "varying vec3 vColor;\n"
-        "void main() {\n"
-        "  gl_FragColor = vec4(vColor, 1.0);\n"
-        "}\n";
-
-    m_shader = new (std::nothrow) Shader();
-    if (!m_shader)
-        return false;
+    m_shaders.SetSources(kSceneVS, kSceneFS);
+    m_shaders.BindAttrib("aPos",       kLocPos);
+    m_shaders.BindAttrib("aColor",     kLocColor);
+    m_shaders.BindAttrib("aOffset",    kLocOffset);
+    m_shaders.BindAttrib("aRotScale",  kLocRotScale);
+    m_shaders.BindAttrib("aInstColor", kLocInstColor);
+    m_shaders.BindAttrib("aVisible",   kLocVisible);
+    m_shaders.SetUniforms({ "uMVP" });
+    m_shaders.SetBatch(m_programs);
 
-    if (!m_shader->CompileFromSource(kVS, kFS, nullptr)) {
-        delete m_shader;
-        m_shader = nullptr;
-        return false;
-    }
-    return true;
-}
\ No newline at end of file
+    // Without a batch this compiles now; with one it only has to submit.
+    m_shaders.Get(Key(false));
+    return !m_shaders.Failed(Key(false));
+}
+
+Scene::ShaderKey Scene::Key(bool instanced) const
+{
+    return ShaderKey().With(Feature::Instanced, instanced).Glsl330(m_glsl330);
+}
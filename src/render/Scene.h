@@ -5,13 +5,29 @@
 
 #include <cstddef>
 
-class Shader;
+#include "Damage.h"
+#include "InstanceSet.h"
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include "ShaderVariants.h"
+
+class ShaderBatch;
 
 /**
  * Scene
  * A minimal 2D demo scene rendering a single colored triangle in NDC.
  * - Applies rotation (degrees) and uniform scale from RenderState.
  * - Skips drawing when object_visible == false.
+ * - When RenderState::instance_count > 0 and the driver supports instancing,
+ *   draws that many independently transformed triangles (stress scene) with
+ *   one instanced draw call; per-instance data lives in an InstanceSet.
+ * - Draws are recorded into a RenderQueue (Submit); Prepare() runs every
+ *   frame, including frames that replay an earlier recording.
+ * - Initialize(programs) does not wait for its programs to link: the
+ *   triangle is drawn flat with the ShaderBatch fallback until the scene
+ *   program is ready, and the instanced field starts once its program is.
+ * - The plain and instanced programs are variants of one source
+ *   (Feature::Instanced), built with "#version 330 core" when available.
  *
  * No dependency on wxWidgets. Uses raw OpenGL via the loader.
  */
@@ -22,25 +38,79 @@ public:
     ~Scene();
 
     // Initialize GL resources (VBO, shader). Requires a current GL context.
-    bool Initialize();
+    // With 'programs' the shaders complete through that batch.
+    bool Initialize(ShaderBatch* programs = nullptr);
 
-    // Viewport/DPI are kept for possible future use (e.g., pixel-space UI).
+    // Viewport size maps damage bounds to pixels; DPI is kept for future use.
     void Resize(int width_px, int height_px, float dpi_scale);
 
-    // Render the scene according to the provided state.
-    void Render(const RenderState& state);
+    // Per-frame resource sync (instance uploads). Call before Submit/replay.
+    void Prepare(const RenderState& state);
+
+    // Record the scene's draw commands for 'state' into 'layer'.
+    void Submit(RenderQueue& queue, std::uint8_t layer, const RenderState& state);
+
+    // Instanced stress mode availability (false on drivers without instancing).
+    bool InstancingAvailable() const { return m_instancing; }
+
+    // Per-instance data (mutable for callers animating individual instances).
+    InstanceSet& Instances() { return m_instances; }
+
+    // Pixels that changed since the previous call (device pixels, top-left
+    // origin): the old and new triangle bounds, or everything for the
+    // instanced field. The first call reports the full viewport.
+    void CollectDamage(const RenderState& state, DamageRegion& out);
+
+    // Changes whenever scene content changed outside RenderState (instances).
+    unsigned ContentVersion() const { return m_instances.Version(); }
+
+    // Draw commands recorded by the last Submit() (0 or 1).
+    int LastDrawCalls() const { return m_drawCalls; }
 
 private:
+    // Shader features; each combination in use is its own program.
+    enum class Feature : std::uint32_t {
+        Instanced = 1u << 0,   // per-instance offset, rotation/scale, color, visibility
+    };
+    using ShaderKey = VariantKey<Feature>;
+
     bool BuildGeometry();
+    bool CreateTriangle(Mesh& mesh) const;   // packed demo triangle
     bool BuildShader();
+    bool BuildInstanced();                 // instanced program + mesh (optional)
+    void ResolveShaders();                 // drops instancing if its program failed
+    ShaderKey Key(bool instanced) const;
+    bool SyncInstances(int count);         // regenerate/upload when count changes
+    void SubmitInstanced(RenderQueue& queue, std::uint8_t layer,
+                         const ShaderVariants::Program& prog, const float mvp[16]);
+    DamageRect Bounds(const RenderState& state) const;   // screen bounds, empty if hidden
+    bool DrawsInstanced(const RenderState& state) const {
+        return state.instance_count > 0 && m_instancing;
+    }
 
 private:
-    unsigned int m_vbo {0};     // GL buffer for vertex data
-    Shader*      m_shader {nullptr}; // owned; created during Initialize()
+    Mesh         m_mesh;        // demo triangle (VBO + VAO)
+    ShaderVariantSet<Feature> m_shaders;    // plain + instanced programs
+    bool         m_glsl330  {false};
+    ShaderBatch* m_programs {nullptr};   // not owned; async compiles + fallback
+
+    // Instanced stress path
+    Mesh         m_instMesh;              // base triangle + attached instance streams
+    InstanceSet  m_instances;
+    bool         m_instancing      {false};   // mesh built, program not failed
+    bool         m_instancesOk     {false};   // last Prepare() synced the set
+    unsigned     m_attachedVbo     {0};       // instance buffer the mesh points at
+    std::size_t  m_attachedLayout  {0};       // its last stream offset when attached
 
     int   m_width  {1};
     int   m_height {1};
     float m_dpi    {1.0f};
 
+    // State of the last CollectDamage() call
+    RenderState m_damageState;
+    unsigned    m_damageContent {0};
+    bool        m_damageValid {false};
+
+    int   m_drawCalls {0};
     bool  m_ready  {false};
 };
\ No newline at end of file
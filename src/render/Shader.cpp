@@ -1,10 +1,32 @@
 // src/render/Shader.cpp
 #include "Shader.h"
 
+#include <cstring>
 #include <vector>
-#include <sstream>
 
 #include "glad/glad.h"
+#include "GlCaps.h"
+#include "GlState.h"
+#include "ProgramCache.h"
+#include "Util.h"
+
+namespace {
+std::uint32_t HashName(const char* s)
+{
+    return Util::Fnv1a32(s, std::strlen(s));
+}
+
+int FindVariable(const std::vector<Shader::Variable>& table, const char* name)
+{
+    if (!name) return -1;
+    const std::uint32_t h = HashName(name);
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        if (table[i].hash == h && table[i].name == name)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+} // namespace
 
 Shader::~Shader()
 {
@@ -13,31 +35,72 @@ Shader::~Shader()
 
 void Shader::Reset()
 {
+    releaseProgram();
+    m_status = Status::Empty;
+    m_lastLog.clear();
+    m_uniforms.clear();
+    m_attribs.clear();
+    m_cache.clear();
+}
+
+void Shader::releaseProgram()
+{
+    if (m_vs) glDeleteShader(m_vs);
+    if (m_fs) glDeleteShader(m_fs);
+    m_vs = m_fs = 0;
     if (m_prog) {
+        GlState::Current().OnProgramDeleted(m_prog);
         glDeleteProgram(m_prog);
         m_prog = 0;
     }
-    m_lastLog.clear();
+    m_programCache = nullptr;
+    m_sources[0].clear();
+    m_sources[1].clear();
 }
 
-bool Shader::compile(GLuint& outShader, unsigned type, const char* src, std::string& log)
+bool Shader::ParallelCompileSupported()
 {
-    outShader = 0;
-    if (!src) {
-        log += "Empty shader source provided.\n";
-        return false;
+    return GlCaps::HasExtension("GL_KHR_parallel_shader_compile") ||
+           GlCaps::HasExtension("GL_ARB_parallel_shader_compile");
+}
+
+void Shader::BindAttrib(const char* name, unsigned location)
+{
+    if (!name) return;
+    for (Binding& b : m_bindings) {
+        if (b.name == name) {
+            b.location = location;
+            return;
+        }
     }
+    m_bindings.push_back(Binding{ name, location });
+}
 
-    GLuint sh = glCreateShader(type);
-    if (!sh) {
-        log += "glCreateShader failed.\n";
-        return false;
+bool Shader::bindingsMatch() const
+{
+    // Inactive attributes (-1) are fine; an active one must sit where asked.
+    for (const Binding& b : m_bindings) {
+        const int loc = AttribLocation(b.name.c_str());
+        if (loc >= 0 && loc != static_cast<int>(b.location))
+            return false;
     }
+    return true;
+}
+
+GLuint Shader::submitStage(unsigned type, const char* src)
+{
+    GLuint sh = glCreateShader(type);
+    if (!sh)
+        return 0;
 
     const GLchar* sources[1] = { src };
     glShaderSource(sh, 1, sources, nullptr);
-    glCompileShader(sh);
+    glCompileShader(sh);   // status is read in complete()
+    return sh;
+}
 
+bool Shader::compiled(GLuint sh, std::string& log)
+{
     GLint ok = GL_FALSE;
     glGetShaderiv(sh, GL_COMPILE_STATUS, &ok);
 
@@ -49,41 +112,25 @@ bool Shader::compile(GLuint& outShader, unsigned type, const char* src, std::str
         GLsizei written = 0;
         glGetShaderInfoLog(sh, logLen, &written, buf.data());
         log.append(buf.data(), buf.data() + (written > 0 ? written : 0));
-        if (log.back() != '\n') log.push_back('\n');
+        if (!log.empty() && log.back() != '\n') log.push_back('\n');
     }
-
-    if (!ok) {
-        glDeleteShader(sh);
-        return false;
-    }
-
-    outShader = sh;
-    return true;
+    return ok == GL_TRUE;
 }
 
-bool Shader::link(GLuint prog, GLuint vs, GLuint fs, std::string& log)
+bool Shader::linked(std::string& log)
 {
-    glAttachShader(prog, vs);
-    glAttachShader(prog, fs);
-    glLinkProgram(prog);
-
     GLint ok = GL_FALSE;
-    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    glGetProgramiv(m_prog, GL_LINK_STATUS, &ok);
 
     GLint logLen = 0;
-    glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &logLen);
+    glGetProgramiv(m_prog, GL_INFO_LOG_LENGTH, &logLen);
     if (logLen > 1) {
         std::vector<GLchar> buf(static_cast<size_t>(logLen), 0);
         GLsizei written = 0;
-        glGetProgramInfoLog(prog, logLen, &written, buf.data());
+        glGetProgramInfoLog(m_prog, logLen, &written, buf.data());
         log.append(buf.data(), buf.data() + (written > 0 ? written : 0));
-        if (log.back() != '\n') log.push_back('\n');
+        if (!log.empty() && log.back() != '\n') log.push_back('\n');
     }
-
-    // Detach & delete shaders regardless of success (no longer needed after link)
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
     return ok == GL_TRUE;
 }
 
@@ -91,54 +138,248 @@ bool Shader::CompileFromSource(const char* vs_src,
                                const char* fs_src,
                                const char* debugName)
 {
-    Reset();
-
-    std::ostringstream ctx;
-    if (debugName && *debugName)
-        ctx << "[" << debugName << "] ";
+    return Submit(vs_src, fs_src, debugName) && Finish();
+}
 
-    GLuint vs = 0, fs = 0;
-    std::string log;
+bool Shader::Submit(const char* vs_src, const char* fs_src, const char* debugName)
+{
+    Reset();
+    m_debugName = (debugName && *debugName) ? std::string("[") + debugName + "] " : std::string();
 
-    if (!compile(vs, GL_VERTEX_SHADER, vs_src, log)) {
-        m_lastLog = ctx.str() + "Vertex shader compilation failed:\n" + log;
+    if (!vs_src || !fs_src) {
+        m_lastLog = m_debugName + "Empty shader source provided.\n";
+        m_status  = Status::Failed;
         return false;
     }
 
-    if (!compile(fs, GL_FRAGMENT_SHADER, fs_src, log)) {
-        if (vs) glDeleteShader(vs);
-        m_lastLog = ctx.str() + "Fragment shader compilation failed:\n" + log;
-        return false;
+    ProgramCache* cache = ProgramCache::Current();
+    if (cache && cache->Supported()) {
+        if (GLuint cached = cache->Load(vs_src, fs_src)) {
+            m_prog = cached;
+            reflect();
+            if (bindingsMatch()) {
+                m_status = Status::Ready;
+                return true;
+            }
+            Reset();   // linked with other attribute locations: rebuild
+        }
+    } else {
+        cache = nullptr;
     }
 
-    GLuint prog = glCreateProgram();
-    if (!prog) {
-        glDeleteShader(vs);
-        glDeleteShader(fs);
-        m_lastLog = ctx.str() + "glCreateProgram failed.\n";
+    // Nothing below waits for the compiler: statuses are read in complete().
+    m_vs   = submitStage(GL_VERTEX_SHADER, vs_src);
+    m_fs   = submitStage(GL_FRAGMENT_SHADER, fs_src);
+    m_prog = (m_vs && m_fs) ? glCreateProgram() : 0;
+    if (!m_prog) {
+        releaseProgram();
+        m_lastLog = m_debugName + "glCreateShader/glCreateProgram failed.\n";
+        m_status  = Status::Failed;
         return false;
     }
-
-    std::string linkLog;
-    const bool linked = link(prog, vs, fs, linkLog);
-    if (!linked) {
-        glDeleteProgram(prog);
-        m_lastLog = ctx.str() + "Program link failed:\n" + linkLog;
-        return false;
+    if (cache) {
+        glProgramParameteri(m_prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        m_programCache = cache;
+        m_sources[0]   = vs_src;
+        m_sources[1]   = fs_src;
     }
+    glAttachShader(m_prog, m_vs);
+    glAttachShader(m_prog, m_fs);
+    for (const Binding& b : m_bindings)
+        glBindAttribLocation(m_prog, b.location, b.name.c_str());
+    glLinkProgram(m_prog);
 
-    m_prog = prog;
-    if (!linkLog.empty()) {
-        m_lastLog = ctx.str() + linkLog;
-    } else {
-        m_lastLog.clear();
+    m_parallel = ParallelCompileSupported();
+    m_status   = Status::Pending;
+    return true;
+}
+
+bool Shader::Poll()
+{
+    if (m_status != Status::Pending)
+        return true;
+    if (m_parallel) {
+        GLint done = GL_FALSE;
+        glGetProgramiv(m_prog, GL_COMPLETION_STATUS_KHR, &done);
+        if (done != GL_TRUE)
+            return false;
     }
+    complete();
     return true;
 }
 
+bool Shader::Finish()
+{
+    if (m_status == Status::Pending)
+        complete();
+    return m_status == Status::Ready;
+}
+
+void Shader::complete()
+{
+    std::string vsLog, fsLog, linkLog;
+    const bool vsOk = compiled(m_vs, vsLog);
+    const bool fsOk = compiled(m_fs, fsLog);
+    const bool ok   = vsOk && fsOk && linked(linkLog);
+
+    // Stages are no longer needed once the program is linked (or failed).
+    glDeleteShader(m_vs);
+    glDeleteShader(m_fs);
+    m_vs = m_fs = 0;
+
+    if (!ok) {
+        if (!vsOk)
+            m_lastLog = m_debugName + "Vertex shader compilation failed:\n" + vsLog;
+        else if (!fsOk)
+            m_lastLog = m_debugName + "Fragment shader compilation failed:\n" + fsLog;
+        else
+            m_lastLog = m_debugName + "Program link failed:\n" + linkLog;
+        releaseProgram();
+        m_status = Status::Failed;
+        return;
+    }
+
+    reflect();
+    if (m_programCache)
+        m_programCache->Store(m_sources[0].c_str(), m_sources[1].c_str(), m_prog);
+    m_programCache = nullptr;
+    m_sources[0].clear();
+    m_sources[1].clear();
+
+    m_lastLog = linkLog.empty() ? std::string() : m_debugName + linkLog;
+    m_status  = Status::Ready;
+}
+
 void Shader::Use() const
 {
-    if (m_prog) {
-        glUseProgram(m_prog);
+    if (m_status == Status::Ready) {
+        GlState::Current().UseProgram(m_prog);
     }
+}
+
+void Shader::reflect()
+{
+    m_uniforms.clear();
+    m_attribs.clear();
+    m_cache.clear();
+    if (!m_prog)
+        return;
+
+    // One pass over the linked program; everything after this is table lookups.
+    const auto enumerate = [this](GLenum countPname, GLenum maxLenPname, bool uniforms,
+                                  std::vector<Variable>& out) {
+        GLint count = 0, maxLen = 0;
+        glGetProgramiv(m_prog, countPname, &count);
+        glGetProgramiv(m_prog, maxLenPname, &maxLen);
+        std::vector<GLchar> name(static_cast<std::size_t>(maxLen > 0 ? maxLen : 1) + 1, 0);
+
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei len = 0;
+            GLint   size = 0;
+            GLenum  type = 0;
+            if (uniforms) {
+                glGetActiveUniform(m_prog, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                                   &len, &size, &type, name.data());
+            } else {
+                glGetActiveAttrib(m_prog, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                                  &len, &size, &type, name.data());
+            }
+            if (len <= 0)
+                continue;
+
+            Variable v;
+            v.name.assign(name.data(), static_cast<std::size_t>(len));
+            // Skip built-ins (gl_VertexID etc.); they have no location.
+            if (v.name.compare(0, 3, "gl_") == 0)
+                continue;
+            const std::size_t bracket = v.name.find('[');
+            if (bracket != std::string::npos)
+                v.name.erase(bracket);
+            v.hash = HashName(v.name.c_str());
+            v.location = uniforms ? glGetUniformLocation(m_prog, v.name.c_str())
+                                  : glGetAttribLocation(m_prog, v.name.c_str());
+            v.type = type;
+            v.size = size;
+            out.push_back(v);
+        }
+    };
+
+    enumerate(GL_ACTIVE_UNIFORMS,   GL_ACTIVE_UNIFORM_MAX_LENGTH,   true,  m_uniforms);
+    enumerate(GL_ACTIVE_ATTRIBUTES, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, false, m_attribs);
+
+    m_cache.assign(m_uniforms.size(), Cached{ {0.f}, false });
+}
+
+int Shader::FindUniform(const char* name) const
+{
+    return FindVariable(m_uniforms, name);
+}
+
+int Shader::AttribLocation(const char* name) const
+{
+    const int i = FindVariable(m_attribs, name);
+    return (i >= 0) ? m_attribs[static_cast<std::size_t>(i)].location : -1;
+}
+
+bool Shader::unchanged(int slot, const float* v, int n)
+{
+    Cached& c = m_cache[static_cast<std::size_t>(slot)];
+    const std::size_t bytes = sizeof(float) * static_cast<std::size_t>(n);
+    if (c.valid && std::memcmp(c.v, v, bytes) == 0) {
+        ++m_stats.skipped;
+        return true;
+    }
+    std::memcpy(c.v, v, bytes);
+    c.valid = true;
+    ++m_stats.uploads;
+    return false;
+}
+
+bool Shader::SetInt(int slot, int v)
+{
+    if (slot < 0 || slot >= static_cast<int>(m_uniforms.size()))
+        return false;
+    float bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    if (!unchanged(slot, &bits, 1))
+        glUniform1i(m_uniforms[static_cast<std::size_t>(slot)].location, v);
+    return true;
+}
+
+bool Shader::SetFloat(int slot, float v)
+{
+    if (slot < 0 || slot >= static_cast<int>(m_uniforms.size()))
+        return false;
+    if (!unchanged(slot, &v, 1))
+        glUniform1f(m_uniforms[static_cast<std::size_t>(slot)].location, v);
+    return true;
+}
+
+bool Shader::SetVec2(int slot, float x, float y)
+{
+    if (slot < 0 || slot >= static_cast<int>(m_uniforms.size()))
+        return false;
+    const float v[2] = { x, y };
+    if (!unchanged(slot, v, 2))
+        glUniform2f(m_uniforms[static_cast<std::size_t>(slot)].location, x, y);
+    return true;
+}
+
+bool Shader::SetVec4(int slot, float x, float y, float z, float w)
+{
+    if (slot < 0 || slot >= static_cast<int>(m_uniforms.size()))
+        return false;
+    const float v[4] = { x, y, z, w };
+    if (!unchanged(slot, v, 4))
+        glUniform4f(m_uniforms[static_cast<std::size_t>(slot)].location, x, y, z, w);
+    return true;
+}
+
+bool Shader::SetMat4(int slot, const float m[16])
+{
+    if (slot < 0 || slot >= static_cast<int>(m_uniforms.size()) || !m)
+        return false;
+    if (!unchanged(slot, m, 16))
+        glUniformMatrix4fv(m_uniforms[static_cast<std::size_t>(slot)].location, 1, GL_FALSE, m);
+    return true;
 }
\ No newline at end of file
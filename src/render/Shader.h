@@ -1,51 +1,153 @@
 // src/render/Shader.h
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "glad/glad.h"
 
+class ProgramCache;
+
 /**
  * Shader
  * Minimal GLSL shader helper for OpenGL 2.1-era pipelines.
  * - CompileFromSource(vs, fs, debugName): compiles, links and owns a program object.
+ *   With a current ProgramCache the linked binary is loaded from / saved to disk.
+ * - Submit(vs, fs, debugName) does the same without waiting for the driver;
+ *   Poll() completes it once the link is done (GL_COMPLETION_STATUS_KHR with
+ *   KHR_parallel_shader_compile, otherwise it waits), Finish() always waits.
+ *   Submitting several programs before polling any lets the driver compile
+ *   them concurrently (see ShaderBatch).
+ * - BindAttrib(name, location) fixes attribute locations before linking, so
+ *   vertex layouts can be set up while the program is still pending.
  * - Use(): glUseProgram(program).
  * - Program(): returns GL program handle (0 if not ready).
  * - LastLog(): returns last compile/link info log (for diagnostics).
  *
+ * Reflection:
+ * - After a successful link, all active uniforms and attributes are enumerated
+ *   once (GL_ACTIVE_UNIFORMS / GL_ACTIVE_ATTRIBUTES) into a compact table.
+ * - FindUniform(name) returns a slot (index into that table, -1 if inactive);
+ *   AttribLocation(name) returns the attribute location. Both only search the
+ *   table, never the driver; resolve them once at init time.
+ * - SetInt/SetFloat/SetVec2/SetVec4/SetMat4(slot, ...) upload through the
+ *   cached location and skip the GL call when the value is unchanged.
+ *
  * Notes:
  * - Requires a current GL context.
+ * - Setters write to this program: it must be the current one (Use()).
  * - On failure, LastLog() contains the error messages.
  */
 class Shader
 {
 public:
+    struct Variable {
+        std::string   name;      // array uniforms are stored without "[0]"
+        std::uint32_t hash;      // FNV-1a of name (fast reject during lookup)
+        int           location;  // GL location
+        unsigned      type;      // e.g. GL_FLOAT_MAT4
+        int           size;      // array size (1 for scalars)
+    };
+
+    struct Stats {
+        unsigned long long uploads {0};   // glUniform* calls issued
+        unsigned long long skipped {0};   // setter calls filtered as redundant
+    };
+
     Shader() = default;
     ~Shader();
 
     Shader(const Shader&) = delete;
     Shader& operator=(const Shader&) = delete;
 
+    enum class Status { Empty, Pending, Ready, Failed };
+
     // Compile and link from in-memory source strings.
     // debugName is optional (can be nullptr) and used only for log context.
     bool CompileFromSource(const char* vs_src,
                            const char* fs_src,
                            const char* debugName);
 
+    // Attribute location for the next link; kept across Reset().
+    void BindAttrib(const char* name, unsigned location);
+
+    // Start compile + link and return at once. False only when no GL objects
+    // could be created; compile/link errors show up as Status::Failed.
+    bool Submit(const char* vs_src, const char* fs_src, const char* debugName);
+    // Complete a pending program if the driver is done; true once not Pending.
+    bool Poll();
+    // Complete a pending program, waiting for the driver; true if Ready.
+    bool Finish();
+
+    Status GetStatus() const { return m_status; }
+    bool Ready() const { return m_status == Status::Ready; }
+
+    // KHR/ARB_parallel_shader_compile on the current context.
+    static bool ParallelCompileSupported();
+
     // Activate the program (no-op if not compiled).
     void Use() const;
 
     // Release the GL program.
     void Reset();
 
+    // Reflection lookups (table only; no GL calls).
+    int FindUniform(const char* name) const;      // slot or -1
+    int AttribLocation(const char* name) const;   // location or -1
+    const std::vector<Variable>& Uniforms()   const { return m_uniforms; }
+    const std::vector<Variable>& Attributes() const { return m_attribs; }
+
+    // Typed setters by slot; return false for invalid slots.
+    bool SetInt(int slot, int v);
+    bool SetFloat(int slot, float v);
+    bool SetVec2(int slot, float x, float y);
+    bool SetVec4(int slot, float x, float y, float z, float w);
+    bool SetMat4(int slot, const float m[16]);
+
     // Accessors
-    unsigned Program() const { return m_prog; }
+    unsigned Program() const { return m_status == Status::Ready ? m_prog : 0u; }
     const std::string& LastLog() const { return m_lastLog; }
+    const Stats& UniformStats() const { return m_stats; }
 
 private:
-    bool compile(GLuint& outShader, unsigned type, const char* src, std::string& log);
-    bool link(GLuint prog, GLuint vs, GLuint fs, std::string& log);
+    GLuint submitStage(unsigned type, const char* src);
+    bool compiled(GLuint shader, std::string& log);   // status + info log
+    bool linked(std::string& log);
+    void complete();                                  // Pending -> Ready/Failed
+    void releaseProgram();
+    bool bindingsMatch() const;                       // reflected vs. BindAttrib()
+    void reflect();
+    // Compare-and-store the cached value; true if the upload can be skipped.
+    bool unchanged(int slot, const float* v, int n);
 
 private:
+    // Last uploaded value per uniform slot (up to a mat4).
+    struct Cached {
+        float v[16];
+        bool  valid;
+    };
+
+    struct Binding {
+        std::string name;
+        unsigned    location;
+    };
+
     unsigned     m_prog {0};
+    Status       m_status {Status::Empty};
     std::string  m_lastLog;
-};
\ No newline at end of file
+    std::string  m_debugName;
+
+    // While Pending: stage objects, completion polling, sources to cache.
+    unsigned      m_vs {0};
+    unsigned      m_fs {0};
+    bool          m_parallel {false};
+    ProgramCache* m_programCache {nullptr};
+    std::string   m_sources[2];
+
+    std::vector<Binding>  m_bindings;
+
+    std::vector<Variable> m_uniforms;
+    std::vector<Variable> m_attribs;
+    std::vector<Cached>   m_cache;     // parallel to m_uniforms
+    Stats                 m_stats;
+};
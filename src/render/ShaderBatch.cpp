@@ -0,0 +1,101 @@
+// src/render/ShaderBatch.cpp
+#include "ShaderBatch.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "glad/glad.h"
+
+namespace {
+const char* kFallbackVS =
+    "#version 120\n"
+    "attribute vec2 aPos;\n"
+    "uniform mat4 uMatrix;\n"
+    "void main() {\n"
+    "  gl_Position = uMatrix * vec4(aPos, 0.0, 1.0);\n"
+    "}\n";
+
+const char* kFallbackFS =
+    "#version 120\n"
+    "uniform vec4 uColor;\n"
+    "void main() {\n"
+    "  gl_FragColor = uColor;\n"
+    "}\n";
+
+// All driver threads: startup is the only time programs are built.
+const GLuint kAllCompilerThreads = 0xFFFFFFFFu;
+} // namespace
+
+bool ShaderBatch::Begin()
+{
+    m_parallel = Shader::ParallelCompileSupported();
+    if (m_parallel && glMaxShaderCompilerThreadsKHR)
+        glMaxShaderCompilerThreadsKHR(kAllCompilerThreads);
+
+    m_fallback.BindAttrib("aPos", 0);
+    if (!m_fallback.Submit(kFallbackVS, kFallbackFS, "fallback"))
+        return false;
+    Add(&m_fallback);
+    return true;
+}
+
+void ShaderBatch::Add(Shader* shader)
+{
+    if (!shader)
+        return;
+    ++m_stats.submitted;
+    if (shader->GetStatus() == Shader::Status::Pending)
+        m_pending.push_back(shader);
+    else
+        finished(shader);   // e.g. loaded from the ProgramCache
+}
+
+int ShaderBatch::Poll()
+{
+    int done = 0;
+    for (std::size_t i = 0; i < m_pending.size();) {
+        Shader* shader = m_pending[i];
+        if (!shader->Poll()) {
+            ++i;
+            continue;
+        }
+        m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(i));
+        finished(shader);
+        ++done;
+    }
+    return done;
+}
+
+void ShaderBatch::Finish()
+{
+    for (Shader* shader : m_pending) {
+        shader->Finish();
+        finished(shader);
+    }
+    m_pending.clear();
+}
+
+Shader* ShaderBatch::Fallback()
+{
+    const auto it = std::find(m_pending.begin(), m_pending.end(), &m_fallback);
+    if (it != m_pending.end()) {
+        m_pending.erase(it);
+        m_fallback.Finish();
+        finished(&m_fallback);
+    }
+    return m_fallback.Ready() ? &m_fallback : nullptr;
+}
+
+void ShaderBatch::finished(Shader* shader)
+{
+    if (shader->Ready()) {
+        ++m_stats.ready;
+        if (shader == &m_fallback) {
+            m_uMatrix = m_fallback.FindUniform("uMatrix");
+            m_uColor  = m_fallback.FindUniform("uColor");
+        }
+    } else {
+        ++m_stats.failed;
+        std::cout << shader->LastLog();
+    }
+}
@@ -0,0 +1,74 @@
+// src/render/ShaderBatch.h
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Shader.h"
+
+/**
+ * ShaderBatch
+ * Startup compilation of many programs at once instead of one after another.
+ *
+ * Checking GL_COMPILE_STATUS / GL_LINK_STATUS right after each link makes
+ * the driver finish that program before the next one is even submitted. A
+ * batch instead collects programs that were Submit()ted and completes them
+ * later:
+ * - Begin() raises the driver's compiler thread count
+ *   (glMaxShaderCompilerThreadsKHR) and submits the fallback program.
+ * - Add(shader) registers a submitted Shader. Poll() completes the programs
+ *   whose link finished without waiting (GL_COMPLETION_STATUS_KHR); without
+ *   KHR/ARB_parallel_shader_compile it waits for them, which still lets a
+ *   threaded driver overlap the compiles submitted before.
+ * - Fallback(): a tiny program (attribute 0 = vec2 position, uniforms
+ *   uMatrix and uColor) that subsystems draw flat placeholders with until
+ *   their own program is Ready(). Its first use waits for it.
+ *
+ * Shaders are not owned and must outlive their Poll()/Finish() calls.
+ * Failed programs are reported on stdout with their log.
+ */
+class ShaderBatch
+{
+public:
+    struct Stats {
+        int submitted {0};
+        int ready     {0};
+        int failed    {0};
+    };
+
+    ShaderBatch() = default;
+
+    ShaderBatch(const ShaderBatch&) = delete;
+    ShaderBatch& operator=(const ShaderBatch&) = delete;
+
+    // Requires a current GL context; false if the fallback cannot be created.
+    bool Begin();
+
+    // Register a Submit()ted shader (finished ones are counted at once).
+    void Add(Shader* shader);
+
+    // Complete finished programs; returns how many completed in this call.
+    int Poll();
+    // Complete everything, waiting for the driver.
+    void Finish();
+
+    std::size_t Pending() const { return m_pending.size(); }
+    bool Parallel() const { return m_parallel; }
+    const Stats& GetStats() const { return m_stats; }
+
+    // Ready fallback program and its uniform slots (nullptr if it failed).
+    Shader* Fallback();
+    int FallbackMatrix() const { return m_uMatrix; }
+    int FallbackColor() const  { return m_uColor; }
+
+private:
+    void finished(Shader* shader);
+
+private:
+    std::vector<Shader*> m_pending;
+    Shader m_fallback;
+    int    m_uMatrix {-1};
+    int    m_uColor  {-1};
+    bool   m_parallel {false};
+    Stats  m_stats;
+};
@@ -0,0 +1,149 @@
+// src/render/ShaderVariants.cpp
+#include "ShaderVariants.h"
+
+#include <cstdio>
+#include <iostream>
+
+#include "glad/glad.h"
+#include "Shader.h"
+#include "ShaderBatch.h"
+
+const std::uint32_t ShaderVariants::kGlsl330;
+
+struct ShaderVariants::Variant {
+    std::uint32_t    key {0};
+    Shader           shader;
+    std::vector<int> slots;
+    bool             resolved {false};   // slots looked up after the link
+};
+
+ShaderVariants::ShaderVariants(const char* name)
+    : m_name(name ? name : "")
+{
+}
+
+ShaderVariants::~ShaderVariants() = default;
+
+void ShaderVariants::SetSources(const char* vs_body, const char* fs_body)
+{
+    m_vs = vs_body;
+    m_fs = fs_body;
+}
+
+void ShaderVariants::AddDefine(std::uint32_t bit, const char* name)
+{
+    if (bit != 0 && (bit & kGlsl330) == 0 && name)
+        m_defines.push_back(Define{ bit, name });
+}
+
+void ShaderVariants::BindAttrib(const char* name, unsigned location)
+{
+    m_bindings.push_back(Binding{ name, location });
+}
+
+void ShaderVariants::SetUniforms(std::initializer_list<const char*> names)
+{
+    m_uniforms.assign(names.begin(), names.end());
+}
+
+void ShaderVariants::Reset()
+{
+    m_variants.clear();
+    m_last = nullptr;
+}
+
+bool ShaderVariants::Glsl330Supported()
+{
+    const char* ver = reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION));
+    int major = 0, minor = 0;
+    if (!ver || std::sscanf(ver, "%d.%d", &major, &minor) != 2)
+        return false;   // also rejects "OpenGL ES GLSL ES ..."
+    return major > 3 || (major == 3 && minor >= 30);
+}
+
+ShaderVariants::Program ShaderVariants::Get(std::uint32_t key)
+{
+    Variant* v = find(key);
+    if (!v && !(v = create(key)))
+        return Program{};
+    m_last = v;
+
+    if (!v->shader.Ready())
+        return Program{};
+    if (!v->resolved) {
+        v->slots.resize(m_uniforms.size());
+        for (std::size_t i = 0; i < m_uniforms.size(); ++i)
+            v->slots[i] = v->shader.FindUniform(m_uniforms[i]);
+        v->resolved = true;
+    }
+    return Program{ &v->shader, v->slots.data() };
+}
+
+bool ShaderVariants::Failed(std::uint32_t key) const
+{
+    const Variant* v = find(key);
+    return v && v->shader.GetStatus() == Shader::Status::Failed;
+}
+
+ShaderVariants::Variant* ShaderVariants::find(std::uint32_t key) const
+{
+    if (m_last && m_last->key == key)
+        return m_last;
+    for (const auto& v : m_variants) {
+        if (v->key == key)
+            return v.get();
+    }
+    return nullptr;
+}
+
+ShaderVariants::Variant* ShaderVariants::create(std::uint32_t key)
+{
+    if (!m_vs || !m_fs)
+        return nullptr;
+
+    std::unique_ptr<Variant> v(new Variant());
+    v->key = key;
+    for (const Binding& b : m_bindings)
+        v->shader.BindAttrib(b.name, b.location);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s#%08x", m_name.c_str(), static_cast<unsigned>(key));
+    const std::string vs = preamble(key, true) + m_vs;
+    const std::string fs = preamble(key, false) + m_fs;
+    // A failed variant stays in the table so it is not rebuilt every frame.
+    if (v->shader.Submit(vs.c_str(), fs.c_str(), name)) {
+        if (m_batch)
+            m_batch->Add(&v->shader);
+        else if (!v->shader.Finish())
+            std::cout << v->shader.LastLog();
+    } else {
+        std::cout << v->shader.LastLog();
+    }
+
+    m_variants.push_back(std::move(v));
+    return m_variants.back().get();
+}
+
+std::string ShaderVariants::preamble(std::uint32_t key, bool vertex) const
+{
+    std::string s;
+    if (key & kGlsl330) {
+        s = "#version 330 core\n"
+            "#define TEXTURE_2D texture\n";
+        s += vertex ? "#define VS_IN in\n#define VS_OUT out\n"
+                    : "#define FS_IN in\nout vec4 wxFragColor;\n#define FRAG_COLOR wxFragColor\n";
+    } else {
+        s = "#version 120\n"
+            "#define TEXTURE_2D texture2D\n";
+        s += vertex ? "#define VS_IN attribute\n#define VS_OUT varying\n"
+                    : "#define FS_IN varying\n#define FRAG_COLOR gl_FragColor\n";
+    }
+    for (const Define& d : m_defines) {
+        if (key & d.bit) {
+            s += "#define ";
+            s += d.name;
+            s += " 1\n";
+        }
+    }
+    return s;
+}
@@ -0,0 +1,177 @@
+// src/render/ShaderVariants.h
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Shader;
+class ShaderBatch;
+
+/**
+ * ShaderVariants
+ * One GLSL source pair specialized into a separate program per feature
+ * combination, so draws pick the most specialized program instead of
+ * branching on uniforms in the shader.
+ *
+ * - Feature bits map to "#define NAME 1" lines of a preamble that follows
+ *   the #version header; the sources test them with #ifdef.
+ * - kGlsl330 selects a "#version 330 core" header instead of "#version 120".
+ *   The preamble defines VS_IN, VS_OUT, FS_IN, TEXTURE_2D and FRAG_COLOR so
+ *   one body compiles under both.
+ * - Get(key) compiles a variant on first use and caches it by its bitmask;
+ *   later lookups scan a handful of entries and return the uniform slots
+ *   resolved for that variant (parallel to the names given to SetUniforms).
+ * - With SetBatch() a first use submits the program and returns nothing
+ *   until it has linked (draw a fallback meanwhile); without it the first
+ *   Get() compiles synchronously.
+ *
+ * Use ShaderVariantSet<Feature> for type-safe keys; this class is the
+ * untyped implementation. Requires a current GL context.
+ */
+class ShaderVariants
+{
+public:
+    // Header selection; feature bits must stay below it.
+    static const std::uint32_t kGlsl330 = 1u << 31;
+
+    struct Program {
+        Shader*    shader {nullptr};   // nullptr: pending or failed
+        const int* slots  {nullptr};   // uniform slots, SetUniforms() order
+    };
+
+    explicit ShaderVariants(const char* name);
+    ~ShaderVariants();
+
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    // Sources without #version; they must outlive this object (literals).
+    void SetSources(const char* vs_body, const char* fs_body);
+    void AddDefine(std::uint32_t bit, const char* name);
+    void BindAttrib(const char* name, unsigned location);
+    void SetUniforms(std::initializer_list<const char*> names);
+    void SetBatch(ShaderBatch* batch) { m_batch = batch; }
+
+    Program Get(std::uint32_t key);
+    // True once the variant for key was created and failed to build.
+    bool Failed(std::uint32_t key) const;
+
+    // Variants created so far (pending, ready or failed).
+    std::size_t Count() const { return m_variants.size(); }
+    void Reset();
+
+    // True when the context compiles "#version 330 core" shaders.
+    static bool Glsl330Supported();
+
+private:
+    struct Variant;
+    struct Define {
+        std::uint32_t bit;
+        const char*   name;
+    };
+    struct Binding {
+        const char* name;
+        unsigned    location;
+    };
+
+    Variant* find(std::uint32_t key) const;
+    Variant* create(std::uint32_t key);
+    std::string preamble(std::uint32_t key, bool vertex) const;
+
+private:
+    std::string m_name;
+    const char* m_vs {nullptr};
+    const char* m_fs {nullptr};
+    std::vector<Define>      m_defines;
+    std::vector<Binding>     m_bindings;
+    std::vector<const char*> m_uniforms;
+    ShaderBatch* m_batch {nullptr};
+
+    std::vector<std::unique_ptr<Variant>> m_variants;
+    Variant* m_last {nullptr};   // most recent lookup
+};
+
+/**
+ * VariantKey<Feature>
+ * Bitmask of one shader family's features. Keys of different families do
+ * not mix, and keys known at compile time are constant expressions:
+ *   constexpr auto kKey = VariantKey<SpriteFeature>::Of<SpriteFeature::Tint>();
+ */
+template <typename Feature>
+class VariantKey
+{
+public:
+    constexpr VariantKey() = default;
+    constexpr VariantKey(Feature f) : m_bits(static_cast<std::uint32_t>(f)) {}
+
+    template <Feature... Fs>
+    static constexpr VariantKey Of() { return VariantKey(Combine({ static_cast<std::uint32_t>(Fs)... })); }
+
+    constexpr VariantKey operator|(VariantKey rhs) const { return VariantKey(m_bits | rhs.m_bits); }
+    constexpr VariantKey With(Feature f, bool on) const
+    {
+        return on ? VariantKey(m_bits | static_cast<std::uint32_t>(f)) : *this;
+    }
+    constexpr VariantKey Glsl330(bool on) const
+    {
+        return on ? VariantKey(m_bits | ShaderVariants::kGlsl330) : VariantKey(m_bits & ~ShaderVariants::kGlsl330);
+    }
+    constexpr bool Has(Feature f) const { return (m_bits & static_cast<std::uint32_t>(f)) != 0; }
+    constexpr std::uint32_t Bits() const { return m_bits; }
+
+    constexpr bool operator==(VariantKey rhs) const { return m_bits == rhs.m_bits; }
+    constexpr bool operator!=(VariantKey rhs) const { return m_bits != rhs.m_bits; }
+
+private:
+    explicit constexpr VariantKey(std::uint32_t bits) : m_bits(bits) {}
+
+    static constexpr std::uint32_t Combine(std::initializer_list<std::uint32_t> bits)
+    {
+        std::uint32_t r = 0;
+        for (std::uint32_t b : bits) r |= b;
+        return r;
+    }
+
+    std::uint32_t m_bits {0};
+};
+
+/**
+ * ShaderVariantSet<Feature>
+ * ShaderVariants taking VariantKey<Feature>; the define table is typed too.
+ */
+template <typename Feature>
+class ShaderVariantSet
+{
+public:
+    using Key     = VariantKey<Feature>;
+    using Program = ShaderVariants::Program;
+
+    struct Define {
+        Feature     feature;
+        const char* name;
+    };
+
+    ShaderVariantSet(const char* name, std::initializer_list<Define> defines)
+        : m_impl(name)
+    {
+        for (const Define& d : defines)
+            m_impl.AddDefine(static_cast<std::uint32_t>(d.feature), d.name);
+    }
+
+    void SetSources(const char* vs_body, const char* fs_body) { m_impl.SetSources(vs_body, fs_body); }
+    void BindAttrib(const char* name, unsigned location) { m_impl.BindAttrib(name, location); }
+    void SetUniforms(std::initializer_list<const char*> names) { m_impl.SetUniforms(names); }
+    void SetBatch(ShaderBatch* batch) { m_impl.SetBatch(batch); }
+
+    Program Get(Key key) { return m_impl.Get(key.Bits()); }
+    bool Failed(Key key) const { return m_impl.Failed(key.Bits()); }
+
+    std::size_t Count() const { return m_impl.Count(); }
+    void Reset() { m_impl.Reset(); }
+
+private:
+    ShaderVariants m_impl;
+};
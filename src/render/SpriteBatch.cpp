@@ -0,0 +1,243 @@
+// src/render/SpriteBatch.cpp
+#include "SpriteBatch.h"
+
+#include <cstddef>
+
+#include "glad/glad.h"
+#include "GlState.h"
+#include "Shader.h"
+#include "ShaderBatch.h"
+#include "VertexPack.h"
+
+namespace {
+// Quads are emitted as two triangles (6 vertices) so any number of them can
+// share one glDrawArrays(GL_TRIANGLES) call.
+const int kVertsPerQuad = 6;
+
+// Initial stream capacity in vertices (grows by doubling).
+const std::size_t kInitialCapacity = 256 * kVertsPerQuad;
+
+// Attribute locations, bound before linking (position matches the fallback).
+const unsigned kLocPos  = 0;
+const unsigned kLocUV   = 1;
+const unsigned kLocTint = 2;
+
+// Placeholder color while the program is pending (RGBA).
+const float kFallbackTint[4] = { 0.6f, 0.6f, 0.6f, 0.5f };
+
+// Uniform slots of a variant, in SetUniforms() order.
+const int kUniformOrtho = 0;
+const int kUniformTex   = 1;
+
+const std::uint32_t kWhite = 0xFFFFFFFFu;
+
+const char* kSpriteVS =
+    "VS_IN vec2 aPosPx; // pixels (top-left origin)\n"
+    "VS_IN vec2 aUV;\n"
+    "uniform mat4 uOrtho;\n"
+    "VS_OUT vec2 vUV;\n"
+    "#ifdef TINT\n"
+    "VS_IN vec4 aTint;\n"
+    "VS_OUT vec4 vTint;\n"
+    "#endif\n"
+    "void main() {\n"
+    "  gl_Position = uOrtho * vec4(aPosPx, 0.0, 1.0);\n"
+    "  vUV = aUV;\n"
+    "#ifdef TINT\n"
+    "#ifdef PREMULTIPLIED\n"
+    "  vTint = vec4(aTint.rgb * aTint.a, aTint.a);\n"
+    "#else\n"
+    "  vTint = aTint;\n"
+    "#endif\n"
+    "#endif\n"
+    "}\n";
+
+const char* kSpriteFS =
+    "uniform sampler2D uTex;\n"
+    "FS_IN vec2 vUV;\n"
+    "#ifdef TINT\n"
+    "FS_IN vec4 vTint;\n"
+    "#endif\n"
+    "void main() {\n"
+    "#ifdef TINT\n"
+    "  FRAG_COLOR = TEXTURE_2D(uTex, vUV) * vTint;\n"
+    "#else\n"
+    "  FRAG_COLOR = TEXTURE_2D(uTex, vUV);\n"
+    "#endif\n"
+    "}\n";
+} // namespace
+
+SpriteBatch::SpriteBatch()
+    : m_shaders("sprite-batch", { { Feature::Tint,          "TINT" },
+                                  { Feature::Premultiplied, "PREMULTIPLIED" } })
+{
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    Reset();
+}
+
+bool SpriteBatch::Initialize(ShaderBatch* programs)
+{
+    if (m_ready)
+        return true;
+
+    m_programs = programs;
+    m_glsl330  = ShaderVariants::Glsl330Supported();
+    if (!buildShader())
+        return false;
+
+    // Locations are bound, not reflected: the layout does not wait for the link.
+    const int stride = static_cast<int>(sizeof(Vertex));
+    const Mesh::Attrib aPos  { kLocPos,  2, GL_FLOAT,         GL_FALSE, stride, offsetof(Vertex, x) };
+    const Mesh::Attrib aUV   { kLocUV,   2, GL_UNSIGNED_SHORT, GL_TRUE, stride, offsetof(Vertex, u) };
+    const Mesh::Attrib aTint { kLocTint, 4, GL_UNSIGNED_BYTE, GL_TRUE,  stride, offsetof(Vertex, rgba) };
+
+    m_capacity = kInitialCapacity;
+    if (!m_mesh.Create(nullptr, m_capacity * sizeof(Vertex), { aPos, aUV, aTint }, GL_STREAM_DRAW)) {
+        Reset();
+        return false;
+    }
+
+    const unsigned char white[4] = { 255, 255, 255, 255 };
+    if (!m_white.CreateFromPixels(1, 1, white)) {
+        Reset();
+        return false;
+    }
+
+    m_vertices.reserve(m_capacity);
+    m_ready = true;
+    return true;
+}
+
+void SpriteBatch::Begin(const float ortho[16])
+{
+    for (int i = 0; i < 16; ++i) m_ortho[i] = ortho[i];
+    m_vertices.clear();
+    m_batches.clear();
+    m_inFrame = true;
+}
+
+void SpriteBatch::Add(unsigned texture,
+                      float x, float y, float w, float h,
+                      float u0, float v0, float u1, float v1,
+                      std::uint32_t tint,
+                      Blend blend)
+{
+    if (!m_inFrame || w <= 0.f || h <= 0.f)
+        return;
+
+    if (texture == 0)
+        texture = m_white.id();
+
+    // Extend the current batch when state matches; otherwise start a new one.
+    const int first = static_cast<int>(m_vertices.size());
+    if (m_batches.empty() ||
+        m_batches.back().texture != texture ||
+        m_batches.back().blend   != blend) {
+        m_batches.push_back(Batch{ texture, blend, first, 0, false });
+    }
+    m_batches.back().count += kVertsPerQuad;
+    m_batches.back().tinted |= (tint != kWhite);
+
+    const std::uint8_t r = static_cast<std::uint8_t>((tint >> 24) & 0xFF);
+    const std::uint8_t g = static_cast<std::uint8_t>((tint >> 16) & 0xFF);
+    const std::uint8_t b = static_cast<std::uint8_t>((tint >>  8) & 0xFF);
+    const std::uint8_t a = static_cast<std::uint8_t>((tint >>  0) & 0xFF);
+
+    const std::uint16_t s0 = VertexPack::ToUNorm16(u0), t0 = VertexPack::ToUNorm16(v0);
+    const std::uint16_t s1 = VertexPack::ToUNorm16(u1), t1 = VertexPack::ToUNorm16(v1);
+
+    const Vertex tl { x,     y,     s0, t0, { r, g, b, a } };
+    const Vertex tr { x + w, y,     s1, t0, { r, g, b, a } };
+    const Vertex br { x + w, y + h, s1, t1, { r, g, b, a } };
+    const Vertex bl { x,     y + h, s0, t1, { r, g, b, a } };
+
+    m_vertices.push_back(tl);
+    m_vertices.push_back(tr);
+    m_vertices.push_back(br);
+    m_vertices.push_back(tl);
+    m_vertices.push_back(br);
+    m_vertices.push_back(bl);
+}
+
+void SpriteBatch::End(RenderQueue& queue, std::uint8_t layer)
+{
+    m_inFrame = false;
+    m_stats = Stats{};
+
+    if (!m_ready || m_vertices.empty())
+        return;
+
+    // One upload per frame. Re-specifying the store (glBufferData) orphans the
+    // previous contents so the driver does not stall on in-flight draws.
+    if (m_vertices.size() > m_capacity) {
+        while (m_capacity < m_vertices.size()) m_capacity *= 2;
+    }
+    GlState::Current().BindBuffer(GL_ARRAY_BUFFER, m_mesh.vbo());
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_capacity * sizeof(Vertex)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0,
+                    static_cast<GLsizeiptr>(m_vertices.size() * sizeof(Vertex)),
+                    m_vertices.data());
+
+    for (const Batch& b : m_batches) {
+        const ShaderVariants::Program prog = m_shaders.Get(key(b));
+        Shader* fallback = (!prog.shader && m_programs) ? m_programs->Fallback() : nullptr;
+        if (prog.shader) {
+            queue.Push(layer, prog.shader, &m_mesh, b.texture, b.blend, GL_TRIANGLES, b.first, b.count);
+            queue.UniformMat4(prog.slots[kUniformOrtho], m_ortho);
+            queue.UniformInt(prog.slots[kUniformTex], 0);
+        } else if (fallback) {
+            queue.Push(layer, fallback, &m_mesh, b.texture, b.blend, GL_TRIANGLES, b.first, b.count);
+            queue.UniformMat4(m_programs->FallbackMatrix(), m_ortho);
+            queue.UniformVec4(m_programs->FallbackColor(),
+                              kFallbackTint[0], kFallbackTint[1], kFallbackTint[2], kFallbackTint[3]);
+        } else {
+            continue;
+        }
+        ++m_stats.draw_calls;
+    }
+
+    m_stats.vertices = static_cast<int>(m_vertices.size());
+    m_stats.sprites  = m_stats.vertices / kVertsPerQuad;
+}
+
+bool SpriteBatch::buildShader()
+{
+    m_shaders.SetSources(kSpriteVS, kSpriteFS);
+    m_shaders.BindAttrib("aPosPx", kLocPos);
+    m_shaders.BindAttrib("aUV",    kLocUV);
+    m_shaders.BindAttrib("aTint",  kLocTint);
+    m_shaders.SetUniforms({ "uOrtho", "uTex" });
+    m_shaders.SetBatch(m_programs);
+
+    // The overlay's startup variants: tinted placeholders and plain icons.
+    const ShaderKey tinted = ShaderKey(Feature::Tint).Glsl330(m_glsl330);
+    const ShaderKey plain  = ShaderKey().Glsl330(m_glsl330);
+    m_shaders.Get(tinted);
+    m_shaders.Get(plain);
+    return !m_shaders.Failed(tinted) && !m_shaders.Failed(plain);
+}
+
+SpriteBatch::ShaderKey SpriteBatch::key(const Batch& b) const
+{
+    // Premultiplying only changes the tint, so untinted batches share a program.
+    return ShaderKey().With(Feature::Tint, b.tinted)
+                      .With(Feature::Premultiplied, b.tinted && b.blend == Blend::Premultiplied)
+                      .Glsl330(m_glsl330);
+}
+
+void SpriteBatch::Reset()
+{
+    m_shaders.Reset();
+    m_programs = nullptr;
+    m_ready    = false;
+    m_mesh.Reset();
+    m_white.Reset();
+    m_capacity = 0;
+    m_vertices.clear();
+    m_batches.clear();
+    m_inFrame = false;
+    m_stats = Stats{};
+}
@@ -0,0 +1,121 @@
+// src/render/SpriteBatch.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include "ShaderVariants.h"
+#include "Texture.h"
+
+class ShaderBatch;
+
+/**
+ * SpriteBatch
+ * Collects screen-space textured quads for one frame into a single streamed
+ * vertex buffer (position, UV and RGBA8 tint per vertex) and draws them with
+ * as few calls as possible.
+ *
+ * - Begin(ortho) starts a frame; Add() appends a quad; End(queue, layer)
+ *   uploads all vertices once (buffer orphaning) and records one
+ *   RenderQueue command per batch. The commands stay valid (replayable)
+ *   until the next End().
+ * - A new batch starts only when the texture or the blend mode changes,
+ *   so submission order is preserved (correct for alpha blending).
+ * - Texture id 0 draws solid tinted quads (a built-in 1x1 white texture).
+ * - Initialize(programs) submits the program to a ShaderBatch instead of
+ *   waiting for it; until it is linked, quads are drawn as flat translucent
+ *   boxes with the batch's fallback program.
+ * - Each batch draws with the most specialized program variant: untinted
+ *   batches skip the tint multiply, and tinted Blend::Premultiplied batches
+ *   premultiply the tint to match the texels. Variants other than the two
+ *   submitted by Initialize() compile on first use.
+ * - LastStats() reports draw calls/sprites of the most recent End().
+ *
+ * Notes:
+ * - Requires a current GL context for Initialize()/End()/Reset().
+ * - Record into an ordered queue layer to keep alpha blending correct.
+ * - Positions are pixels with a top-left origin; 'ortho' maps them to clip space.
+ */
+class SpriteBatch
+{
+public:
+    using Blend = RenderQueue::Blend;
+
+    struct Stats {
+        int draw_calls {0};
+        int sprites    {0};
+        int vertices   {0};
+    };
+
+    SpriteBatch();
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    // Build shader, stream buffer and the white texture. With 'programs'
+    // the shader completes asynchronously (see ShaderBatch).
+    bool Initialize(ShaderBatch* programs = nullptr);
+
+    // Start collecting quads; 'ortho' is a column-major pixel->clip matrix.
+    void Begin(const float ortho[16]);
+
+    // Append a quad. UVs address the texture's [0..1] space (clamped, stored as
+    // 16-bit normalized); tint is 0xRRGGBBAA.
+    void Add(unsigned texture,
+             float x, float y, float w, float h,
+             float u0, float v0, float u1, float v1,
+             std::uint32_t tint = 0xFFFFFFFFu,
+             Blend blend = Blend::Alpha);
+
+    // Upload everything collected since Begin() and record the batches.
+    void End(RenderQueue& queue, std::uint8_t layer);
+
+    const Stats& LastStats() const { return m_stats; }
+
+    // Release GL resources.
+    void Reset();
+
+private:
+    struct Vertex {
+        float x, y;             // pixels
+        std::uint16_t u, v;     // normalized UV (16 bytes per vertex, not 20)
+        std::uint8_t rgba[4];   // normalized tint
+    };
+
+    struct Batch {
+        unsigned texture;
+        Blend    blend;
+        int      first;         // first vertex
+        int      count;         // vertex count
+        bool     tinted;        // some quad has a tint other than white
+    };
+
+    // Shader features; each combination in use is its own program.
+    enum class Feature : std::uint32_t {
+        Tint          = 1u << 0,   // multiply by the vertex tint
+        Premultiplied = 1u << 1,   // texels are premultiplied; so is the tint
+    };
+    using ShaderKey = VariantKey<Feature>;
+
+    bool buildShader();
+    ShaderKey key(const Batch& b) const;
+
+private:
+    ShaderVariantSet<Feature> m_shaders;
+    ShaderBatch* m_programs {nullptr};   // not owned; fallback source
+    bool     m_glsl330 {false};
+    bool     m_ready   {false};
+    Mesh     m_mesh;              // streamed vertex buffer
+    Texture  m_white;             // 1x1 white for untextured quads
+    std::size_t m_capacity {0};   // vertex capacity of the GL buffer
+
+    std::vector<Vertex> m_vertices;
+    std::vector<Batch>  m_batches;
+    float    m_ortho[16] {};
+    bool     m_inFrame {false};
+
+    Stats    m_stats;
+};
@@ -0,0 +1,212 @@
+// src/render/StreamingTexture.cpp
+#include "StreamingTexture.h"
+
+#include <cstring>
+#include <vector>
+
+#include "glad/glad.h"
+#include "GlCaps.h"
+#include "GlState.h"
+
+StreamingTexture::~StreamingTexture()
+{
+    Reset();
+}
+
+void StreamingTexture::Reset()
+{
+    GlState& gl = GlState::Current();
+    if (m_open && m_mapped) {
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_slots[m_next].buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    for (Slot& s : m_slots) {
+        if (s.fence) {
+            glDeleteSync(static_cast<GLsync>(s.fence));
+            s.fence = nullptr;
+        }
+        if (s.buffer) {
+            gl.OnBufferDeleted(s.buffer);
+            glDeleteBuffers(1, &s.buffer);
+            s.buffer = 0;
+        }
+    }
+    if (m_tex) {
+        gl.OnTextureDeleted(m_tex);
+        glDeleteTextures(1, &m_tex);
+        m_tex = 0;
+    }
+    m_w = m_h = 0;
+    m_next = 0;
+    m_open = false;
+    m_dst  = nullptr;
+    m_staging.clear();
+    m_staging.shrink_to_fit();
+}
+
+bool StreamingTexture::Create(int w, int h)
+{
+    Reset();
+    if (w <= 0 || h <= 0)
+        return false;
+
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    if (!tex)
+        return false;
+
+    GlState& gl = GlState::Current();
+    gl.BindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,    GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,    GL_CLAMP_TO_EDGE);
+
+    // Initial contents from a zeroed PBO-free upload; stream updates follow.
+    const std::vector<unsigned char> zero(static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u, 0);
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    gl.PixelStore(GL_UNPACK_ALIGNMENT, 4);
+    gl.PixelStore(GL_UNPACK_ROW_LENGTH, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, zero.data());
+
+    m_tex = tex;
+    m_w   = w;
+    m_h   = h;
+    m_mapped = (GlCaps::HasVersion(3, 2) ||
+                (GlCaps::HasExtension("GL_ARB_map_buffer_range") && GlCaps::HasExtension("GL_ARB_sync"))) &&
+               glMapBufferRange && glUnmapBuffer && glFenceSync && glClientWaitSync && glDeleteSync;
+
+    // One full-frame slot per ring entry, so any sub-rectangle fits.
+    const GLsizeiptr size = static_cast<GLsizeiptr>(zero.size());
+    for (Slot& s : m_slots) {
+        glGenBuffers(1, &s.buffer);
+        if (!s.buffer) {
+            Reset();
+            return false;
+        }
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, s.buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+bool StreamingTexture::slotReady(Slot& slot)
+{
+    if (!slot.fence)
+        return true;
+
+    // An unflushed fence may never signal: flush on the first poll only.
+    const GLbitfield flags = slot.polled ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT;
+    slot.polled = true;
+    const GLenum r = glClientWaitSync(static_cast<GLsync>(slot.fence), flags, 0);
+    if (r == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    // Signaled (or the wait failed, after which the fence is of no further use).
+    glDeleteSync(static_cast<GLsync>(slot.fence));
+    slot.fence = nullptr;
+    return true;
+}
+
+unsigned char* StreamingTexture::BeginUpdate(int x, int y, int w, int h)
+{
+    if (!m_tex || m_open || w <= 0 || h <= 0)
+        return nullptr;
+    if (x < 0 || y < 0 || x + w > m_w || y + h > m_h)
+        return nullptr;
+
+    const std::size_t bytes = static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u;
+    Slot& slot = m_slots[m_next];
+
+    if (m_mapped) {
+        if (!slotReady(slot)) {
+            ++m_stats.dropped;
+            return nullptr;
+        }
+        // The GPU is done with this slot: nothing for the driver to synchronize.
+        GlState& gl = GlState::Current();
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        void* p = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!p)
+            return nullptr;
+        m_dst = static_cast<unsigned char*>(p);
+    } else {
+        if (m_staging.size() < bytes)
+            m_staging.resize(bytes);
+        m_dst = m_staging.data();
+    }
+
+    m_open = true;
+    m_rect[0] = x;
+    m_rect[1] = y;
+    m_rect[2] = w;
+    m_rect[3] = h;
+    return m_dst;
+}
+
+bool StreamingTexture::EndUpdate()
+{
+    if (!m_open)
+        return false;
+
+    const int w = m_rect[2], h = m_rect[3];
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(w) * h * 4;
+    Slot& slot = m_slots[m_next];
+
+    GlState& gl = GlState::Current();
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (m_mapped) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    } else {
+        // Orphan the previous storage so the driver need not wait for its reader.
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, bytes, m_staging.data());
+    }
+
+    gl.BindTexture(GL_TEXTURE_2D, m_tex);
+    gl.PixelStore(GL_UNPACK_ALIGNMENT, 4);
+    gl.PixelStore(GL_UNPACK_ROW_LENGTH, 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, m_rect[0], m_rect[1], w, h,
+                    GL_RGBA, GL_UNSIGNED_BYTE, nullptr);   // offset 0 into the PBO
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (m_mapped) {
+        slot.fence  = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.polled = false;
+    }
+
+    m_next = (m_next + 1) % kRingSize;
+    m_open = false;
+    m_dst  = nullptr;
+    ++m_stats.uploads;
+    m_stats.bytes += static_cast<std::uint64_t>(bytes);
+    return true;
+}
+
+bool StreamingTexture::Update(int x, int y, int w, int h, const unsigned char* rgba, int rowLength)
+{
+    if (!rgba)
+        return false;
+    unsigned char* dst = BeginUpdate(x, y, w, h);
+    if (!dst)
+        return false;
+
+    const std::size_t row   = static_cast<std::size_t>(w) * 4u;
+    const std::size_t pitch = static_cast<std::size_t>(rowLength > 0 ? rowLength : w) * 4u;
+    if (pitch == row) {
+        std::memcpy(dst, rgba, row * static_cast<std::size_t>(h));
+    } else {
+        for (int j = 0; j < h; ++j)
+            std::memcpy(dst + row * static_cast<std::size_t>(j), rgba + pitch * static_cast<std::size_t>(j), row);
+    }
+    return EndUpdate();
+}
+
+void StreamingTexture::Bind(unsigned target) const
+{
+    GlState::Current().BindTexture(target, m_tex);
+}
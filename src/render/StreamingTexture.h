@@ -0,0 +1,111 @@
+// src/render/StreamingTexture.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * StreamingTexture
+ * RGBA8 texture whose contents change every frame (video, camera, CPU
+ * rendered images), uploaded through a ring of pixel buffer objects so that
+ * neither the producer nor the driver stalls on the other.
+ *
+ * Upload path (per update):
+ *   BeginUpdate(x, y, w, h) -> pointer into the next PBO of the ring (mapped
+ *   write-only, tightly packed w*4 bytes per row); the caller fills it;
+ *   EndUpdate() unmaps, issues glTexSubImage2D sourcing the PBO and fences it.
+ * The copy into the texture then runs asynchronously on the GPU while the
+ * producer moves on to the next PBO.
+ *
+ * Never waits:
+ * - Each slot carries the fence of its last upload. If the next slot is still
+ *   in flight (GPU more than kRingSize updates behind), BeginUpdate returns
+ *   nullptr and the update is dropped (Stats::dropped); the producer decides
+ *   whether to retry or skip the frame. The fence is polled with a zero
+ *   timeout, never waited on; the first poll of each fence flushes it
+ *   (GL_SYNC_FLUSH_COMMANDS_BIT), otherwise it might never signal.
+ * - A slot whose fence has signaled is mapped unsynchronized, so the driver
+ *   does not add an implicit wait either.
+ *
+ * Fallback: without glMapBufferRange/fences (GL < 3.2 and no
+ * ARB_map_buffer_range + ARB_sync) updates go through an
+ * orphaned glBufferData + glBufferSubData per update (BeginUpdate hands out
+ * a CPU staging buffer); UsesPbo() reports which path is active.
+ *
+ * Notes:
+ * - Requires a current GL context for everything except the accessors.
+ * - Sub-rectangle updates only touch w*h*4 bytes of the slot.
+ * - Copy is disabled; one BeginUpdate/EndUpdate pair may be open at a time.
+ */
+class StreamingTexture
+{
+public:
+    static const int kRingSize = 3;
+
+    struct Stats {
+        std::uint64_t uploads {0};
+        std::uint64_t dropped {0};   // BeginUpdate found the next slot in flight
+        std::uint64_t bytes   {0};
+    };
+
+    StreamingTexture() = default;
+    ~StreamingTexture();
+
+    StreamingTexture(const StreamingTexture&) = delete;
+    StreamingTexture& operator=(const StreamingTexture&) = delete;
+
+    // Allocate a w*h RGBA8 texture (cleared to transparent black) and the PBO ring.
+    bool Create(int w, int h);
+
+    // Map the next ring slot for a w*h update at (x, y). Returns nullptr when
+    // the rectangle is invalid or the slot is still in use by the GPU.
+    unsigned char* BeginUpdate(int x, int y, int w, int h);
+
+    // Upload what was written since BeginUpdate. Returns false without one.
+    bool EndUpdate();
+
+    // BeginUpdate + copy + EndUpdate. 'rowLength' is the source pitch in
+    // pixels (0 = w). Returns false when the update was dropped.
+    bool Update(int x, int y, int w, int h, const unsigned char* rgba, int rowLength = 0);
+
+    // Bind to a GL target (pass GL_TEXTURE_2D).
+    void Bind(unsigned target) const;
+
+    // Release the texture, the PBOs and their fences.
+    void Reset();
+
+    // Accessors
+    unsigned id() const { return m_tex; }
+    int width()  const { return m_w; }
+    int height() const { return m_h; }
+    bool valid() const { return m_tex != 0; }
+    bool UsesPbo() const { return m_mapped; }
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = Stats{}; }
+
+private:
+    struct Slot {
+        unsigned buffer {0};
+        void*    fence  {nullptr};   // GLsync of the last upload from this slot
+        bool     polled {false};     // fence flushed by an earlier poll
+    };
+
+    bool slotReady(Slot& slot);
+
+private:
+    unsigned m_tex {0};
+    int      m_w   {0};
+    int      m_h   {0};
+    bool     m_mapped {false};       // map/fence path available
+
+    Slot m_slots[kRingSize];
+    int  m_next {0};
+
+    // Open update
+    bool           m_open {false};
+    int            m_rect[4] {0, 0, 0, 0};
+    unsigned char* m_dst {nullptr};
+    std::vector<unsigned char> m_staging;   // fallback path only
+
+    Stats m_stats;
+};
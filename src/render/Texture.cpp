@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "glad/glad.h"
+#include "GlState.h"
 
 // Limit stb_image to PNG to keep binary small; remove if you need more formats.
 #define STB_IMAGE_IMPLEMENTATION
@@ -40,6 +41,7 @@ void Texture::swap(Texture& rhs) noexcept
 void Texture::Reset()
 {
     if (m_id) {
+        GlState::Current().OnTextureDeleted(m_id);
         glDeleteTextures(1, &m_id);
         m_id = 0;
     }
@@ -52,7 +54,7 @@ bool Texture::LoadFromFile(const std::string& path, bool flipY)
     Reset();
 
     // Decode with stb_image (force RGBA to simplify GL upload and alignment).
-    stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
+    stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
 
     int w = 0, h = 0, comp = 0;
     unsigned char* pixels = stbi_load(path.c_str(), &w, &h, &comp, 4);
@@ -61,15 +63,27 @@ bool Texture::LoadFromFile(const std::string& path, bool flipY)
         return false;
     }
 
+    const bool ok = CreateFromPixels(w, h, pixels);
+    stbi_image_free(pixels);
+    return ok;
+}
+
+bool Texture::CreateFromPixels(int w, int h, const unsigned char* rgba)
+{
+    Reset();
+    if (w <= 0 || h <= 0)
+        return false;
+
     // Create and upload GL texture
     GLuint tex = 0;
     glGenTextures(1, &tex);
-    if (!tex) {
-        stbi_image_free(pixels);
+    if (!tex)
         return false;
-    }
 
-    glBindTexture(GL_TEXTURE_2D, tex);
+    GlState& gl = GlState::Current();
+    gl.BindTexture(GL_TEXTURE_2D, tex);
+    gl.PixelStore(GL_UNPACK_ALIGNMENT, 4);
+    gl.PixelStore(GL_UNPACK_ROW_LENGTH, 0);
     // No mipmaps (icon-sized); use linear filtering and clamp-to-edge.
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -83,10 +97,7 @@ bool Texture::LoadFromFile(const std::string& path, bool flipY)
                  0,                // border
                  GL_RGBA,          // data format
                  GL_UNSIGNED_BYTE, // data type
-                 pixels);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(pixels);
+                 rgba);
 
     m_id = tex;
     m_w  = w;
@@ -94,7 +105,97 @@ bool Texture::LoadFromFile(const std::string& path, bool flipY)
     return true;
 }
 
+bool Texture::CreateFromLevels(unsigned internalFormat, unsigned format, unsigned type,
+                               const Level* levels, int count)
+{
+    Reset();
+    if (!levels || count <= 0 || levels[0].width <= 0 || levels[0].height <= 0)
+        return false;
+
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    if (!tex)
+        return false;
+
+    GlState& gl = GlState::Current();
+    gl.BindTexture(GL_TEXTURE_2D, tex);
+    gl.PixelStore(GL_UNPACK_ALIGNMENT, 1);
+    gl.PixelStore(GL_UNPACK_ROW_LENGTH, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,    GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,    GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, count - 1);
+
+    for (int i = 0; i < count; ++i) {
+        glTexImage2D(GL_TEXTURE_2D, i, static_cast<GLint>(internalFormat),
+                     levels[i].width, levels[i].height, 0, format, type, levels[i].data);
+    }
+
+    m_id = tex;
+    m_w  = levels[0].width;
+    m_h  = levels[0].height;
+    return true;
+}
+
+bool Texture::UpdateRegion(int x, int y, int w, int h,
+                           const unsigned char* rgba, int rowLength)
+{
+    if (!m_id || !rgba || w <= 0 || h <= 0)
+        return false;
+    if (x < 0 || y < 0 || x + w > m_w || y + h > m_h)
+        return false;
+
+    // Unpack state is left as set; every upload path states what it needs.
+    GlState& gl = GlState::Current();
+    gl.BindTexture(GL_TEXTURE_2D, m_id);
+    gl.PixelStore(GL_UNPACK_ALIGNMENT, 1);
+    gl.PixelStore(GL_UNPACK_ROW_LENGTH, rowLength > 0 ? rowLength : 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    return true;
+}
+
+bool Texture::DecodeFile(const std::string& path, bool flipY,
+                         std::vector<unsigned char>& rgba, int& w, int& h)
+{
+    // Per-thread flag: AsyncTextureLoader decodes on several threads at once.
+    stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
+
+    int comp = 0;
+    w = h = 0;
+    unsigned char* pixels = stbi_load(path.c_str(), &w, &h, &comp, 4);
+    if (!pixels || w <= 0 || h <= 0) {
+        if (pixels) stbi_image_free(pixels);
+        return false;
+    }
+
+    rgba.assign(pixels, pixels + static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool Texture::DecodeMemory(const void* data, std::size_t size, bool flipY,
+                           std::vector<unsigned char>& rgba, int& w, int& h)
+{
+    w = h = 0;
+    if (!data || size == 0 || size > 0x7FFFFFFFu)
+        return false;
+    stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
+
+    int comp = 0;
+    unsigned char* pixels = stbi_load_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size),
+                                                  &w, &h, &comp, 4);
+    if (!pixels || w <= 0 || h <= 0) {
+        if (pixels) stbi_image_free(pixels);
+        return false;
+    }
+
+    rgba.assign(pixels, pixels + static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u);
+    stbi_image_free(pixels);
+    return true;
+}
+
 void Texture::Bind(unsigned target) const
 {
-    glBindTexture(target, m_id);
+    GlState::Current().BindTexture(target, m_id);
 }
\ No newline at end of file
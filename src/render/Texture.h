@@ -1,12 +1,18 @@
 // src/render/Texture.h
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 /**
  * Texture
  * Minimal RAII wrapper over an OpenGL 2D texture for PNG icons.
  * - LoadFromFile(path, flipY): decodes image (via stb_image) and uploads RGBA8
+ * - CreateFromPixels(w, h, rgba): uploads caller-provided RGBA8 pixels
+ * - CreateFromLevels(...): uploads a prepared mip chain in any uncompressed
+ *   format (cooked TextureCache entries), without touching the pixels
+ * - UpdateRegion(...): glTexSubImage2D of a sub-rectangle (e.g. atlas pages)
  * - Bind(target): binds texture to given target (e.g. GL_TEXTURE_2D)
  *
  * Notes:
@@ -28,6 +34,35 @@ public:
     // Decode PNG and upload to GL as RGBA8. Returns true on success.
     bool LoadFromFile(const std::string& path, bool flipY);
 
+    // Upload tightly packed RGBA8 pixels (w*h*4 bytes). Returns true on success.
+    bool CreateFromPixels(int w, int h, const unsigned char* rgba);
+
+    // One mip level: tightly packed rows (unpack alignment 1).
+    struct Level {
+        const void* data {nullptr};
+        int width  {0};
+        int height {0};
+    };
+
+    // Upload 'count' levels (level 0 first, each half the previous size) with
+    // the given GL internal format / format / type. Trilinear filtering when
+    // count > 1. Returns true on success.
+    bool CreateFromLevels(unsigned internalFormat, unsigned format, unsigned type,
+                          const Level* levels, int count);
+
+    // Replace a w*h sub-rectangle at (x, y) with RGBA8 pixels. 'rowLength' is
+    // the source row pitch in pixels (0 = tightly packed, i.e. w).
+    bool UpdateRegion(int x, int y, int w, int h,
+                      const unsigned char* rgba, int rowLength);
+
+    // Decode a PNG into tightly packed RGBA8 without touching GL (any thread).
+    static bool DecodeFile(const std::string& path, bool flipY,
+                           std::vector<unsigned char>& rgba, int& w, int& h);
+
+    // DecodeFile for a PNG already in memory (any thread).
+    static bool DecodeMemory(const void* data, std::size_t size, bool flipY,
+                             std::vector<unsigned char>& rgba, int& w, int& h);
+
     // Bind to a GL target (pass GL_TEXTURE_2D).
     void Bind(unsigned target) const;
 
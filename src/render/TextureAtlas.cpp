@@ -0,0 +1,379 @@
+// src/render/TextureAtlas.cpp
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "TextureCache.h"
+
+namespace {
+int clampInt(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
+} // namespace
+
+// Out-of-line definition: kInvalid is bound by reference (e.g. vector fill).
+const TextureAtlas::Handle TextureAtlas::kInvalid;
+
+TextureAtlas::TextureAtlas(int initialPageSize, int maxPageSize, int gutter, int padding)
+    : m_initialSize(initialPageSize > 0 ? initialPageSize : 256),
+      m_maxSize(std::max(maxPageSize, initialPageSize)),
+      m_gutter(gutter > 0 ? gutter : 0),
+      m_padding(padding > 0 ? padding : 0)
+{
+}
+
+TextureAtlas::Handle TextureAtlas::AddPixels(const std::string& key, int w, int h, const unsigned char* rgba)
+{
+    const Handle existing = Find(key);
+    if (existing != kInvalid)
+        return existing;
+    if (!rgba || w <= 0 || h <= 0)
+        return kInvalid;
+
+    Entry e;
+    e.key = key;
+    e.w = w;
+    e.h = h;
+    e.pixels.assign(rgba, rgba + static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u);
+    return addEntry(std::move(e));
+}
+
+TextureAtlas::Handle TextureAtlas::AddFile(const std::string& key, const std::string& path, bool flipY)
+{
+    const Handle existing = Find(key);
+    if (existing != kInvalid)
+        return existing;
+
+    Entry e;
+    e.key = key;
+    if (!decode(path, flipY, e))
+        return kInvalid;
+    return addEntry(std::move(e));
+}
+
+std::vector<TextureAtlas::Handle>
+TextureAtlas::AddFiles(const std::vector<std::pair<std::string, std::string>>& files, bool flipY)
+{
+    std::vector<Handle> handles(files.size(), kInvalid);
+
+    // Decode everything first so the batch can be packed tallest-first.
+    std::vector<Entry> decoded(files.size());
+    std::vector<std::size_t> order;
+    order.reserve(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const Handle existing = Find(files[i].first);
+        if (existing != kInvalid) {
+            handles[i] = existing;
+            continue;
+        }
+        decoded[i].key = files[i].first;
+        if (decode(files[i].second, flipY, decoded[i]))
+            order.push_back(i);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return decoded[a].h > decoded[b].h;
+    });
+    for (std::size_t i : order) {
+        // Duplicate keys inside one batch resolve to the first occurrence.
+        const Handle existing = Find(decoded[i].key);
+        handles[i] = (existing != kInvalid) ? existing : addEntry(std::move(decoded[i]));
+    }
+    return handles;
+}
+
+bool TextureAtlas::decode(const std::string& path, bool flipY, Entry& e) const
+{
+    if (m_cache)
+        return m_cache->LoadPixels(path, flipY, e.pixels, e.w, e.h);
+    return Texture::DecodeFile(path, flipY, e.pixels, e.w, e.h);
+}
+
+TextureAtlas::Handle TextureAtlas::Find(const std::string& key) const
+{
+    const auto it = m_lookup.find(key);
+    return (it != m_lookup.end()) ? it->second : kInvalid;
+}
+
+const TextureAtlas::Region& TextureAtlas::Get(Handle h) const
+{
+    static const Region kNone {};
+    if (h < 0 || h >= static_cast<Handle>(m_entries.size()))
+        return kNone;
+    return m_entries[static_cast<std::size_t>(h)].region;
+}
+
+int TextureAtlas::PageSize(int page) const
+{
+    if (page < 0 || page >= PageCount()) return 0;
+    return m_pages[static_cast<std::size_t>(page)].size;
+}
+
+unsigned TextureAtlas::PageTexture(int page) const
+{
+    if (page < 0 || page >= PageCount()) return 0;
+    return m_pages[static_cast<std::size_t>(page)].texture.id();
+}
+
+TextureAtlas::Handle TextureAtlas::addEntry(Entry&& e)
+{
+    if (cellW(e) > m_maxSize || cellH(e) > m_maxSize)
+        return kInvalid;
+
+    const int idx = static_cast<int>(m_entries.size());
+    m_entries.push_back(std::move(e));
+    const Entry& entry = m_entries.back();
+
+    bool placed = false;
+
+    // 1) Free space on an existing page.
+    for (Page& page : m_pages) {
+        if (placeOnPage(page, idx)) { placed = true; break; }
+    }
+
+    // 2) Grow a page (doubling) and repack it together with the new entry,
+    //    fullest growable page first.
+    std::vector<std::pair<double, std::size_t>> growable;
+    for (std::size_t p = 0; !placed && p < m_pages.size(); ++p) {
+        if (m_pages[p].size * 2 <= m_maxSize)
+            growable.emplace_back(pageFill(m_pages[p]), p);
+    }
+    std::stable_sort(growable.begin(), growable.end(),
+                     [](const std::pair<double, std::size_t>& a, const std::pair<double, std::size_t>& b) {
+                         return a.first > b.first;
+                     });
+    for (std::size_t i = 0; !placed && i < growable.size(); ++i) {
+        Page& page = m_pages[growable[i].second];
+        for (int size = page.size * 2; size <= m_maxSize; size *= 2) {
+            if (repackPage(page, size, idx)) { placed = true; break; }
+        }
+    }
+
+    // 3) Open a new page large enough for the entry.
+    if (!placed) {
+        int size = m_initialSize;
+        while (size < cellW(entry) || size < cellH(entry)) size *= 2;
+        size = std::min(size, m_maxSize);
+
+        m_pages.emplace_back();
+        Page& page = m_pages.back();
+        page.size = size;
+        page.skyline.push_back(SkylineNode{ 0, 0, size });
+        page.pixels.assign(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 4u, 0);
+        page.realloc = true;
+        placed = placeOnPage(page, idx);
+    }
+
+    if (!placed) {
+        m_entries.pop_back();
+        return kInvalid;
+    }
+
+    m_lookup[m_entries[static_cast<std::size_t>(idx)].key] = idx;
+    return idx;
+}
+
+double TextureAtlas::pageFill(const Page& page) const
+{
+    double used = 0.0;
+    for (int i : page.entries) {
+        const Entry& e = m_entries[static_cast<std::size_t>(i)];
+        used += static_cast<double>(cellW(e)) * static_cast<double>(cellH(e));
+    }
+    return used / (static_cast<double>(page.size) * static_cast<double>(page.size));
+}
+
+bool TextureAtlas::findPosition(const Page& page, int w, int h, int& outX, int& outY, int& outNode)
+{
+    int bestBottom = std::numeric_limits<int>::max();
+    int bestWidth  = std::numeric_limits<int>::max();
+    outNode = -1;
+
+    const int n = static_cast<int>(page.skyline.size());
+    for (int i = 0; i < n; ++i) {
+        const int x = page.skyline[static_cast<std::size_t>(i)].x;
+        if (x + w > page.size)
+            break;  // nodes are sorted by x; later ones start even further right
+
+        // Lowest y at which a w-wide cell starting at node i clears the skyline.
+        int y = 0;
+        int widthLeft = w;
+        int j = i;
+        bool fits = true;
+        while (widthLeft > 0) {
+            if (j >= n) { fits = false; break; }
+            const SkylineNode& node = page.skyline[static_cast<std::size_t>(j)];
+            y = std::max(y, node.y);
+            if (y + h > page.size) { fits = false; break; }
+            widthLeft -= node.w;
+            ++j;
+        }
+        if (!fits)
+            continue;
+
+        const int nodeW = page.skyline[static_cast<std::size_t>(i)].w;
+        if (y + h < bestBottom || (y + h == bestBottom && nodeW < bestWidth)) {
+            bestBottom = y + h;
+            bestWidth  = nodeW;
+            outNode = i;
+            outX = x;
+            outY = y;
+        }
+    }
+    return outNode >= 0;
+}
+
+void TextureAtlas::addSkylineLevel(Page& page, int node, int x, int y, int w, int h)
+{
+    auto& sky = page.skyline;
+    sky.insert(sky.begin() + node, SkylineNode{ x, y + h, w });
+
+    // Trim nodes now covered by the new level.
+    for (std::size_t i = static_cast<std::size_t>(node) + 1; i < sky.size(); ) {
+        const SkylineNode& prev = sky[i - 1];
+        SkylineNode& cur = sky[i];
+        const int prevEnd = prev.x + prev.w;
+        if (cur.x >= prevEnd)
+            break;
+        const int shrink = prevEnd - cur.x;
+        cur.x += shrink;
+        cur.w -= shrink;
+        if (cur.w > 0)
+            break;
+        sky.erase(sky.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    // Merge neighbours at the same height.
+    for (std::size_t i = 0; i + 1 < sky.size(); ) {
+        if (sky[i].y == sky[i + 1].y) {
+            sky[i].w += sky[i + 1].w;
+            sky.erase(sky.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool TextureAtlas::placeOnPage(Page& page, int entry)
+{
+    Entry& e = m_entries[static_cast<std::size_t>(entry)];
+    const int w = cellW(e);
+    const int h = cellH(e);
+
+    int x = 0, y = 0, node = -1;
+    if (!findPosition(page, w, h, x, y, node))
+        return false;
+
+    addSkylineLevel(page, node, x, y, w, h);
+    page.entries.push_back(entry);
+    blit(page, e, x, y);
+
+    if (!page.realloc) {
+        // Only the gutter-inclusive cell changed; padding stays empty.
+        page.dirty.push_back(Rect{ x, y, e.w + 2 * m_gutter, e.h + 2 * m_gutter });
+    }
+    return true;
+}
+
+bool TextureAtlas::repackPage(Page& page, int size, int extraEntry)
+{
+    std::vector<int> list = page.entries;
+    if (extraEntry >= 0)
+        list.push_back(extraEntry);
+
+    std::stable_sort(list.begin(), list.end(), [&](int a, int b) {
+        const Entry& ea = m_entries[static_cast<std::size_t>(a)];
+        const Entry& eb = m_entries[static_cast<std::size_t>(b)];
+        return (ea.h != eb.h) ? (ea.h > eb.h) : (ea.w > eb.w);
+    });
+
+    // Dry run on a scratch skyline; commit only if everything fits.
+    Page trial;
+    trial.size = size;
+    trial.skyline.push_back(SkylineNode{ 0, 0, size });
+    std::vector<std::pair<int, int>> positions;
+    positions.reserve(list.size());
+    for (int idx : list) {
+        const Entry& e = m_entries[static_cast<std::size_t>(idx)];
+        int x = 0, y = 0, node = -1;
+        if (!findPosition(trial, cellW(e), cellH(e), x, y, node))
+            return false;
+        addSkylineLevel(trial, node, x, y, cellW(e), cellH(e));
+        positions.emplace_back(x, y);
+    }
+
+    const bool moved = !page.entries.empty();
+    page.size = size;
+    page.skyline.swap(trial.skyline);
+    page.pixels.assign(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 4u, 0);
+    page.entries = list;
+    page.dirty.clear();
+    page.realloc = true;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        blit(page, m_entries[static_cast<std::size_t>(list[i])], positions[i].first, positions[i].second);
+    }
+
+    if (moved)
+        ++m_version;
+    return true;
+}
+
+void TextureAtlas::blit(Page& page, Entry& e, int cellX, int cellY)
+{
+    const int g = m_gutter;
+    const std::size_t pitch = static_cast<std::size_t>(page.size) * 4u;
+
+    // Copy the image and extrude its edge texels into the gutter.
+    for (int yy = -g; yy < e.h + g; ++yy) {
+        const int sy = clampInt(yy, 0, e.h - 1);
+        const unsigned char* srcRow = &e.pixels[static_cast<std::size_t>(sy) * static_cast<std::size_t>(e.w) * 4u];
+        unsigned char* dstRow = &page.pixels[static_cast<std::size_t>(cellY + g + yy) * pitch];
+
+        std::memcpy(dstRow + static_cast<std::size_t>(cellX + g) * 4u, srcRow, static_cast<std::size_t>(e.w) * 4u);
+        for (int k = 1; k <= g; ++k) {
+            std::memcpy(dstRow + static_cast<std::size_t>(cellX + g - k) * 4u, srcRow, 4u);
+            std::memcpy(dstRow + static_cast<std::size_t>(cellX + g + e.w - 1 + k) * 4u,
+                        srcRow + static_cast<std::size_t>(e.w - 1) * 4u, 4u);
+        }
+    }
+
+    const float inv = 1.0f / static_cast<float>(page.size);
+    Region& r = e.region;
+    r.page = static_cast<int>(&page - m_pages.data());
+    r.x = cellX + g;
+    r.y = cellY + g;
+    r.w = e.w;
+    r.h = e.h;
+    r.u0 = static_cast<float>(r.x) * inv;
+    r.v0 = static_cast<float>(r.y) * inv;
+    r.u1 = static_cast<float>(r.x + r.w) * inv;
+    r.v1 = static_cast<float>(r.y + r.h) * inv;
+}
+
+bool TextureAtlas::Upload()
+{
+    bool ok = true;
+    for (Page& page : m_pages) {
+        if (page.realloc || !page.texture.valid()) {
+            ok = page.texture.CreateFromPixels(page.size, page.size, page.pixels.data()) && ok;
+            page.realloc = false;
+            page.dirty.clear();
+            continue;
+        }
+        for (const Rect& r : page.dirty) {
+            const unsigned char* src = &page.pixels[(static_cast<std::size_t>(r.y) * static_cast<std::size_t>(page.size)
+                                                     + static_cast<std::size_t>(r.x)) * 4u];
+            ok = page.texture.UpdateRegion(r.x, r.y, r.w, r.h, src, page.size) && ok;
+        }
+        page.dirty.clear();
+    }
+    return ok;
+}
+
+void TextureAtlas::Reset()
+{
+    m_pages.clear();
+    m_entries.clear();
+    m_lookup.clear();
+    ++m_version;
+}
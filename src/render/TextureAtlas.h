@@ -0,0 +1,135 @@
+// src/render/TextureAtlas.h
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Texture.h"
+
+class TextureCache;
+
+/**
+ * TextureAtlas
+ * Packs many small RGBA images (overlay icons) into one or a few square
+ * texture pages so a whole overlay can be drawn from a single bound texture.
+ *
+ * Packing:
+ * - Skyline bottom-left placement per page.
+ * - Each image is surrounded by a 'gutter' of replicated edge texels (stops
+ *   linear filtering from bleeding neighbours in) plus 'padding' empty texels.
+ * - When an image does not fit, the fullest growable page is doubled (up to
+ *   maxPageSize) and repacked tallest-first; otherwise a new page is opened.
+ *   Repacking moves existing regions, which bumps Version().
+ *
+ * Handles index Region records; a region's UVs are stable until Version()
+ * changes, so consumers may cache them per version.
+ *
+ * Notes:
+ * - With SetCache(), AddFile/AddFiles read cooked pixels from a TextureCache
+ *   instead of decoding the PNGs; the cache must outlive the atlas.
+ * - Adding images is CPU-only; Upload() (GL context required) sends new pages
+ *   with glTexImage2D and incremental additions with glTexSubImage2D.
+ * - Copy is disabled.
+ */
+class TextureAtlas
+{
+public:
+    using Handle = int;
+    static const Handle kInvalid = -1;
+
+    struct Region {
+        int   page {-1};                  // page index
+        int   x {0}, y {0}, w {0}, h {0}; // texel rect (without gutter)
+        float u0 {0.f}, v0 {0.f}, u1 {0.f}, v1 {0.f};
+    };
+
+    explicit TextureAtlas(int initialPageSize = 256,
+                          int maxPageSize     = 2048,
+                          int gutter          = 1,
+                          int padding         = 1);
+    ~TextureAtlas() = default;
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Add tightly packed RGBA8 pixels under 'key'. Adding an existing key
+    // returns the existing handle. Returns kInvalid if the image can never fit.
+    Handle AddPixels(const std::string& key, int w, int h, const unsigned char* rgba);
+
+    // Decode a PNG (see Texture::DecodeFile) and add it.
+    Handle AddFile(const std::string& key, const std::string& path, bool flipY);
+
+    // Decode and add several (key, path) pairs, packing the batch tallest-first
+    // for a tighter fit. Returns one handle per input, in input order.
+    std::vector<Handle> AddFiles(const std::vector<std::pair<std::string, std::string>>& files,
+                                 bool flipY);
+
+    // Optional cooked-pixel source for AddFile/AddFiles (nullptr = decode).
+    void SetCache(TextureCache* cache) { m_cache = cache; }
+
+    Handle Find(const std::string& key) const;
+    const Region& Get(Handle h) const;
+
+    int      PageCount() const { return static_cast<int>(m_pages.size()); }
+    int      PageSize(int page) const;
+    unsigned PageTexture(int page) const;  // GL id, valid after Upload()
+
+    // Send pending page changes to GL. Requires a current GL context.
+    bool Upload();
+
+    // Incremented whenever existing regions move (repack/grow).
+    unsigned Version() const { return m_version; }
+
+    // Drop all images and GL textures.
+    void Reset();
+
+private:
+    struct Entry {
+        std::string key;
+        int w {0}, h {0};
+        std::vector<unsigned char> pixels;  // source RGBA8, kept for repacking
+        Region region;
+    };
+
+    struct SkylineNode { int x, y, w; };
+    struct Rect { int x, y, w, h; };
+
+    struct Page {
+        int size {0};
+        std::vector<SkylineNode> skyline;
+        std::vector<unsigned char> pixels;  // size * size * 4
+        std::vector<int> entries;           // indices into m_entries
+        std::vector<Rect> dirty;            // rects pending glTexSubImage2D
+        bool realloc {true};                // needs a full (re)upload
+        Texture texture;
+    };
+
+    // Fraction of the page covered by its cells (gutter + padding included).
+    double pageFill(const Page& page) const;
+
+    // Skyline helpers (sizes include gutter + padding)
+    static bool findPosition(const Page& page, int w, int h, int& outX, int& outY, int& outNode);
+    static void addSkylineLevel(Page& page, int node, int x, int y, int w, int h);
+
+    bool placeOnPage(Page& page, int entry);                 // incremental add
+    bool repackPage(Page& page, int size, int extraEntry);   // grow + repack
+    void blit(Page& page, Entry& e, int cellX, int cellY);
+    Handle addEntry(Entry&& e);
+    bool decode(const std::string& path, bool flipY, Entry& e) const;
+    int  cellW(const Entry& e) const { return e.w + 2 * m_gutter + m_padding; }
+    int  cellH(const Entry& e) const { return e.h + 2 * m_gutter + m_padding; }
+
+private:
+    int m_initialSize;
+    int m_maxSize;
+    int m_gutter;
+    int m_padding;
+
+    std::vector<Entry> m_entries;
+    std::vector<Page>  m_pages;
+    std::unordered_map<std::string, Handle> m_lookup;
+    unsigned m_version {0};
+    TextureCache* m_cache {nullptr};
+};
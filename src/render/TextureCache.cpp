@@ -0,0 +1,495 @@
+// src/render/TextureCache.cpp
+#include "TextureCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "glad/glad.h"
+#include "GlCaps.h"
+#include "MappedFile.h"
+#include "Texture.h"
+#include "Util.h"
+
+namespace {
+const char          kMagic[4] = { 'W', 'X', 'T', 'X' };
+const std::uint32_t kVersion  = 2;
+const std::uint32_t kMaxLevels = 16;
+
+struct FileHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t format;   // TextureCache::Format, never Auto
+    std::uint32_t levels;
+    std::uint64_t sourceSize;
+    std::int64_t  sourceTime;   // ns since the epoch (MappedFile::Stamp)
+    std::uint64_t sourceHash;   // FNV-1a of the source bytes
+    std::uint64_t reserved;
+};
+
+// What the entry remembers about the PNG it was cooked from.
+struct Source {
+    std::uint64_t size {0};
+    std::int64_t  time {0};
+    std::uint64_t hash {0};
+};
+
+struct LevelRecord {
+    std::uint64_t offset;
+    std::uint64_t bytes;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+
+static_assert(sizeof(FileHeader) == 64, "container header layout");
+static_assert(sizeof(LevelRecord) == 24, "container level layout");
+
+using Format = TextureCache::Format;
+
+bool ReadWholeFile(const std::string& path, std::vector<unsigned char>& out)
+{
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    out.clear();
+    unsigned char chunk[64 * 1024];
+    std::size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+        out.insert(out.end(), chunk, chunk + n);
+    const bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok && !out.empty();
+}
+
+std::size_t BytesPerPixel(Format f)
+{
+    switch (f) {
+    case Format::R8:     return 1;
+    case Format::RG8:    return 2;
+    case Format::RGB565: return 2;
+    case Format::RGBA4:  return 2;
+    default:             return 4;
+    }
+}
+
+std::size_t Align16(std::size_t n) { return (n + 15u) & ~static_cast<std::size_t>(15u); }
+
+// Smallest format that stores the image without loss.
+Format ResolveAuto(const std::vector<unsigned char>& rgba)
+{
+    bool grey = true, opaque = true;
+    for (std::size_t i = 0; i + 3 < rgba.size() && (grey || opaque); i += 4) {
+        grey   = grey && rgba[i] == rgba[i + 1] && rgba[i] == rgba[i + 2];
+        opaque = opaque && rgba[i + 3] == 255;
+    }
+    if (!grey)
+        return Format::RGBA8;
+    return opaque ? Format::R8 : Format::RG8;
+}
+
+// Alpha-weighted 2x2 box filter (transparent texels do not darken edges);
+// odd sizes clamp the last row/column.
+void Downsample(const std::vector<unsigned char>& src, int w, int h,
+                std::vector<unsigned char>& dst, int& dw, int& dh)
+{
+    dw = std::max(1, w / 2);
+    dh = std::max(1, h / 2);
+    dst.assign(static_cast<std::size_t>(dw) * static_cast<std::size_t>(dh) * 4u, 0);
+    for (int y = 0; y < dh; ++y) {
+        const int y0 = std::min(2 * y, h - 1), y1 = std::min(2 * y + 1, h - 1);
+        for (int x = 0; x < dw; ++x) {
+            const int x0 = std::min(2 * x, w - 1), x1 = std::min(2 * x + 1, w - 1);
+            const unsigned char* t[4] = {
+                &src[(static_cast<std::size_t>(y0) * w + x0) * 4u], &src[(static_cast<std::size_t>(y0) * w + x1) * 4u],
+                &src[(static_cast<std::size_t>(y1) * w + x0) * 4u], &src[(static_cast<std::size_t>(y1) * w + x1) * 4u],
+            };
+            unsigned a = 0, rgbA[3] = { 0, 0, 0 }, rgb[3] = { 0, 0, 0 };
+            for (const unsigned char* p : t) {
+                a += p[3];
+                for (int c = 0; c < 3; ++c) {
+                    rgbA[c] += p[c] * p[3];
+                    rgb[c]  += p[c];
+                }
+            }
+            unsigned char* out = &dst[(static_cast<std::size_t>(y) * dw + x) * 4u];
+            for (int c = 0; c < 3; ++c)
+                out[c] = static_cast<unsigned char>(a ? (rgbA[c] + a / 2) / a : (rgb[c] + 2) / 4);
+            out[3] = static_cast<unsigned char>((a + 2) / 4);
+        }
+    }
+}
+
+unsigned Quantize(unsigned v, unsigned maxOut) { return (v * maxOut + 127u) / 255u; }
+
+void Convert(Format f, const std::vector<unsigned char>& rgba, unsigned char* out)
+{
+    const std::size_t px = rgba.size() / 4u;
+    for (std::size_t i = 0; i < px; ++i) {
+        const unsigned char* p = &rgba[i * 4u];
+        std::uint16_t v = 0;
+        switch (f) {
+        case Format::R8:
+            out[i] = p[0];
+            continue;
+        case Format::RG8:
+            out[i * 2u]      = p[0];
+            out[i * 2u + 1u] = p[3];
+            continue;
+        case Format::RGB565:
+            v = static_cast<std::uint16_t>(Quantize(p[0], 31) << 11 | Quantize(p[1], 63) << 5 | Quantize(p[2], 31));
+            break;
+        case Format::RGBA4:
+            v = static_cast<std::uint16_t>(Quantize(p[0], 15) << 12 | Quantize(p[1], 15) << 8 |
+                                           Quantize(p[2], 15) << 4 | Quantize(p[3], 15));
+            break;
+        default:
+            std::memcpy(out + i * 4u, p, 4u);
+            continue;
+        }
+        std::memcpy(out + i * 2u, &v, 2u);   // GL_UNSIGNED_SHORT_*: native order
+    }
+}
+
+// R8 / RG8 back to RGBA8 for contexts without texture swizzles.
+void ExpandGrey(Format f, const unsigned char* src, std::size_t px, std::vector<unsigned char>& out)
+{
+    out.resize(px * 4u);
+    for (std::size_t i = 0; i < px; ++i) {
+        const unsigned char g = (f == Format::RG8) ? src[i * 2u] : src[i];
+        out[i * 4u] = out[i * 4u + 1u] = out[i * 4u + 2u] = g;
+        out[i * 4u + 3u] = (f == Format::RG8) ? src[i * 2u + 1u] : 255;
+    }
+}
+
+struct GlFormat {
+    GLenum internal;
+    GLenum format;
+    GLenum type;
+};
+
+GlFormat ToGl(Format f)
+{
+    switch (f) {
+    case Format::R8:     return { GL_R8,    GL_RED,  GL_UNSIGNED_BYTE };
+    case Format::RG8:    return { GL_RG8,   GL_RG,   GL_UNSIGNED_BYTE };
+    case Format::RGB565: return { GL_RGB5,  GL_RGB,  GL_UNSIGNED_SHORT_5_6_5 };
+    case Format::RGBA4:  return { GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4 };
+    default:             return { GL_RGBA,  GL_RGBA, GL_UNSIGNED_BYTE };
+    }
+}
+
+bool HasTextureSwizzle()
+{
+    return GlCaps::HasVersion(3, 3) || GlCaps::HasExtension("GL_ARB_texture_swizzle");
+}
+
+// Builds the complete container for an RGBA8 image.
+void CookContainer(std::vector<unsigned char> rgba, int w, int h, const TextureCache::Options& options,
+                   std::uint64_t key, const Source& source, std::vector<unsigned char>& out)
+{
+    const Format format = (options.format == Format::Auto) ? ResolveAuto(rgba) : options.format;
+    const std::size_t bpp = BytesPerPixel(format);
+
+    std::vector<std::vector<unsigned char>> chain;
+    std::vector<LevelRecord> records;
+    for (;;) {
+        LevelRecord r {};
+        r.width  = static_cast<std::uint32_t>(w);
+        r.height = static_cast<std::uint32_t>(h);
+        r.bytes  = static_cast<std::uint64_t>(w) * static_cast<std::uint64_t>(h) * bpp;
+        records.push_back(r);
+        if (!options.mips || (w == 1 && h == 1) || records.size() == kMaxLevels) {
+            chain.push_back(std::move(rgba));
+            break;
+        }
+        std::vector<unsigned char> next;
+        int nw = 0, nh = 0;
+        Downsample(rgba, w, h, next, nw, nh);
+        chain.push_back(std::move(rgba));
+        rgba = std::move(next);
+        w = nw;
+        h = nh;
+    }
+
+    std::size_t offset = Align16(sizeof(FileHeader) + records.size() * sizeof(LevelRecord));
+    for (LevelRecord& r : records) {
+        r.offset = offset;
+        offset = Align16(offset + static_cast<std::size_t>(r.bytes));
+    }
+    out.assign(offset, 0);
+
+    FileHeader hdr {};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version = kVersion;
+    hdr.key     = key;
+    hdr.width   = records[0].width;
+    hdr.height  = records[0].height;
+    hdr.format  = static_cast<std::uint32_t>(format);
+    hdr.levels  = static_cast<std::uint32_t>(records.size());
+    hdr.sourceSize = source.size;
+    hdr.sourceTime = source.time;
+    hdr.sourceHash = source.hash;
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(out.data() + sizeof(hdr), records.data(), records.size() * sizeof(LevelRecord));
+    for (std::size_t i = 0; i < records.size(); ++i)
+        Convert(format, chain[i], out.data() + records[i].offset);
+}
+
+bool Validate(const unsigned char* data, std::size_t size, std::uint64_t key)
+{
+    FileHeader hdr;
+    if (size < sizeof(hdr))
+        return false;
+    std::memcpy(&hdr, data, sizeof(hdr));
+    if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 || hdr.version != kVersion || hdr.key != key)
+        return false;
+    if (hdr.levels == 0 || hdr.levels > kMaxLevels || hdr.format >= static_cast<std::uint32_t>(Format::Auto))
+        return false;
+    if (sizeof(hdr) + hdr.levels * sizeof(LevelRecord) > size)
+        return false;
+
+    const std::size_t bpp = BytesPerPixel(static_cast<Format>(hdr.format));
+    for (std::uint32_t i = 0; i < hdr.levels; ++i) {
+        LevelRecord r;
+        std::memcpy(&r, data + sizeof(hdr) + i * sizeof(LevelRecord), sizeof(r));
+        if (r.width == 0 || r.height == 0 || r.bytes != std::uint64_t(r.width) * r.height * bpp)
+            return false;
+        if (r.offset > size || r.bytes > size - r.offset)
+            return false;
+    }
+    return true;
+}
+
+std::string EntryName(std::uint64_t key)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%016llx.wxtex", static_cast<unsigned long long>(key));
+    return buf;
+}
+
+bool WriteEntry(const std::string& file, const std::vector<unsigned char>& data)
+{
+    return MappedFile::WriteAtomic(file, data.data(), data.size());
+}
+} // namespace
+
+struct TextureCache::Entry {
+    MappedFile map;
+    std::vector<unsigned char> owned;   // cooked this time (not mapped)
+    const unsigned char* data {nullptr};
+    std::size_t size {0};
+
+    FileHeader header() const
+    {
+        FileHeader h;
+        std::memcpy(&h, data, sizeof(h));
+        return h;
+    }
+
+    LevelRecord level(std::uint32_t i) const
+    {
+        LevelRecord r;
+        std::memcpy(&r, data + sizeof(FileHeader) + i * sizeof(LevelRecord), sizeof(r));
+        return r;
+    }
+};
+
+TextureCache::TextureCache(const std::string& dir)
+    : m_dir(dir)
+{
+    while (m_dir.size() > 1 && (m_dir.back() == '/' || m_dir.back() == '\\'))
+        m_dir.pop_back();
+}
+
+void TextureCache::count(std::uint64_t Stats::*field, std::uint64_t n)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.*field += n;
+}
+
+TextureCache::Stats TextureCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+const char* TextureCache::FormatName(Format format)
+{
+    switch (format) {
+    case Format::RGBA8:  return "rgba8";
+    case Format::R8:     return "r8";
+    case Format::RG8:    return "rg8";
+    case Format::RGB565: return "rgb565";
+    case Format::RGBA4:  return "rgba4";
+    case Format::Auto:   return "auto";
+    }
+    return "?";
+}
+
+bool TextureCache::acquire(const std::string& path, bool flipY, const Options& options, Entry& entry)
+{
+    Source source;
+    if (!MappedFile::Stamp(path, source.size, source.time)) {
+        count(&Stats::failed);
+        return false;
+    }
+    const std::uint32_t params[4] = { kVersion, flipY ? 1u : 0u,
+                                      static_cast<std::uint32_t>(options.format), options.mips ? 1u : 0u };
+    const std::uint64_t key = Util::Fnv1a(params, sizeof(params), Util::Fnv1a(path.data(), path.size()));
+    const std::string file = m_dir + "/" + EntryName(key);
+
+    FileHeader hdr {};
+    const bool mapped = entry.map.Open(file) && Validate(entry.map.data(), entry.map.size(), key);
+    if (mapped) {
+        entry.data = entry.map.data();
+        entry.size = entry.map.size();
+        hdr = entry.header();
+        if (hdr.sourceSize == source.size && hdr.sourceTime == source.time) {
+            count(&Stats::hits);
+            return true;
+        }
+    }
+
+    // New or touched source: only its content decides whether to cook.
+    std::vector<unsigned char> png;
+    if (!ReadWholeFile(path, png)) {
+        entry.map.Close();
+        count(&Stats::failed);
+        return false;
+    }
+    source.size = png.size();   // what was hashed, should the file change between the two reads
+    source.hash = Util::Fnv1a(png.data(), png.size());
+    if (mapped && hdr.sourceHash == source.hash) {
+        // Same pixels under a new stamp: record it so the next load is a plain hit.
+        entry.owned.assign(entry.data, entry.data + entry.size);
+        entry.map.Close();
+        hdr.sourceSize = source.size;
+        hdr.sourceTime = source.time;
+        std::memcpy(entry.owned.data(), &hdr, sizeof(hdr));
+        (void)WriteEntry(file, entry.owned);
+        entry.data = entry.owned.data();
+        entry.size = entry.owned.size();
+        count(&Stats::hits);
+        return true;
+    }
+    entry.map.Close();
+
+    std::vector<unsigned char> rgba;
+    int w = 0, h = 0;
+    if (!Texture::DecodeMemory(png.data(), png.size(), flipY, rgba, w, h)) {
+        count(&Stats::failed);
+        return false;
+    }
+    CookContainer(std::move(rgba), w, h, options, key, source, entry.owned);
+    (void)WriteEntry(file, entry.owned);   // a read-only cache still serves this load
+    entry.data = entry.owned.data();
+    entry.size = entry.owned.size();
+    count(&Stats::cooked);
+    return true;
+}
+
+TextureCache::Pixels::Pixels() = default;
+TextureCache::Pixels::~Pixels() = default;
+
+TextureCache::Pixels::Pixels(Pixels&& other) noexcept
+    : m_entry(std::move(other.m_entry)), m_data(other.m_data), m_width(other.m_width), m_height(other.m_height)
+{
+    other.m_data  = nullptr;
+    other.m_width = other.m_height = 0;
+}
+
+TextureCache::Pixels& TextureCache::Pixels::operator=(Pixels&& other) noexcept
+{
+    if (this != &other) {
+        m_entry  = std::move(other.m_entry);
+        m_data   = other.m_data;
+        m_width  = other.m_width;
+        m_height = other.m_height;
+        other.m_data  = nullptr;
+        other.m_width = other.m_height = 0;
+    }
+    return *this;
+}
+
+bool TextureCache::MapPixels(const std::string& path, bool flipY, Pixels& out)
+{
+    out = Pixels();
+    std::unique_ptr<Entry> entry(new Entry());
+    if (!acquire(path, flipY, Options(), *entry))
+        return false;
+
+    const LevelRecord r = entry->level(0);
+    out.m_data   = entry->data + r.offset;
+    out.m_width  = static_cast<int>(r.width);
+    out.m_height = static_cast<int>(r.height);
+    out.m_entry  = std::move(entry);
+    count(&Stats::bytes, r.bytes);
+    return true;
+}
+
+bool TextureCache::LoadPixels(const std::string& path, bool flipY,
+                              std::vector<unsigned char>& rgba, int& w, int& h)
+{
+    w = h = 0;
+    Entry entry;
+    if (!acquire(path, flipY, Options(), entry))
+        return false;
+
+    const LevelRecord r = entry.level(0);
+    const unsigned char* p = entry.data + r.offset;
+    rgba.assign(p, p + r.bytes);
+    w = static_cast<int>(r.width);
+    h = static_cast<int>(r.height);
+    count(&Stats::bytes, r.bytes);
+    return true;
+}
+
+bool TextureCache::LoadTexture(const std::string& path, bool flipY, const Options& options, Texture& out)
+{
+    Entry entry;
+    if (!acquire(path, flipY, options, entry))
+        return false;
+
+    const FileHeader hdr = entry.header();
+    const Format format = static_cast<Format>(hdr.format);
+    const bool grey = (format == Format::R8 || format == Format::RG8);
+    const bool swizzle = grey && HasTextureSwizzle();
+
+    Texture::Level levels[kMaxLevels];
+    std::vector<unsigned char> expanded[kMaxLevels];
+    std::uint64_t bytes = 0;
+    for (std::uint32_t i = 0; i < hdr.levels; ++i) {
+        const LevelRecord r = entry.level(i);
+        levels[i].data   = entry.data + r.offset;
+        levels[i].width  = static_cast<int>(r.width);
+        levels[i].height = static_cast<int>(r.height);
+        if (grey && !swizzle) {
+            ExpandGrey(format, entry.data + r.offset, std::size_t(r.width) * r.height, expanded[i]);
+            levels[i].data = expanded[i].data();
+        }
+        bytes += r.bytes;
+    }
+
+    const GlFormat gl = ToGl((grey && !swizzle) ? Format::RGBA8 : format);
+    if (!out.CreateFromLevels(gl.internal, gl.format, gl.type, levels, static_cast<int>(hdr.levels)))
+        return false;
+    if (swizzle) {
+        // Grey in R, alpha in G (RG8) or opaque (R8).
+        out.Bind(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, format == Format::RG8 ? GL_GREEN : GL_ONE);
+    }
+    count(&Stats::bytes, bytes);
+    return true;
+}
+
+bool TextureCache::Cook(const std::string& path, bool flipY, const Options& options)
+{
+    Entry entry;
+    return acquire(path, flipY, options, entry);
+}
@@ -0,0 +1,117 @@
+// src/render/TextureCache.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Texture;
+
+/**
+ * TextureCache
+ * Cooks PNG images into GPU-ready containers on first load and serves later
+ * loads from a memory mapping of the container: no inflate, no unfiltering,
+ * no format conversion at startup.
+ *
+ * Entries:
+ * - One file per (PNG path, flipY, format, mips), named
+ *   <dir>/<16 hex digits>.wxtex after a 64-bit FNV-1a hash of the path and
+ *   the cook parameters.
+ * - The entry records the source's size, modification time and content hash.
+ *   A hit costs one stat(): the PNG is only read when size or mtime differ,
+ *   and then hashed; the same content just refreshes the recorded stamp,
+ *   anything else is cooked again over the old entry.
+ * - Container: 64-byte header ("WXTX", version, key, size, format, level
+ *   count, source size / mtime / hash), a table of 24-byte level records
+ *   (offset, bytes, size), then the levels, 16-byte aligned and tightly
+ *   packed. Host byte order.
+ * - Entries are written to a temporary file and renamed into place, so
+ *   concurrent loaders never map a partial file. When the directory is not
+ *   writable the cooked data is used from memory and the next run cooks again.
+ *
+ * Formats: RGBA8 (exact); R8 / RG8 (exact for grey images, expanded to RGBA
+ * through texture swizzles on GL 3.3+, on the CPU otherwise); RGB565 and
+ * RGBA4 (lossy, half the memory of RGBA8). Auto picks the smallest exact
+ * one. Mip chains use an alpha-weighted 2x2 box filter.
+ *
+ * Threading: MapPixels(), LoadPixels() and Cook() may run concurrently on
+ * any thread (AsyncTextureLoader workers); LoadTexture() needs the GL context.
+ */
+class TextureCache
+{
+    struct Entry;   // mapped or freshly cooked container
+
+public:
+    enum class Format : std::uint32_t { RGBA8, R8, RG8, RGB565, RGBA4, Auto };
+
+    struct Options {
+        Format format {Format::RGBA8};
+        bool   mips   {false};
+    };
+
+    // Level 0 of an RGBA8 entry, read in place from the mapping (or from the
+    // freshly cooked container). Move-only; keeps the mapping alive.
+    class Pixels {
+    public:
+        Pixels();
+        ~Pixels();
+        Pixels(Pixels&& other) noexcept;
+        Pixels& operator=(Pixels&& other) noexcept;
+
+        const unsigned char* data() const { return m_data; }   // tightly packed RGBA8
+        int width() const  { return m_width; }
+        int height() const { return m_height; }
+
+    private:
+        friend class TextureCache;
+        std::unique_ptr<Entry> m_entry;
+        const unsigned char*   m_data {nullptr};
+        int m_width  {0};
+        int m_height {0};
+    };
+
+    struct Stats {
+        std::uint64_t hits   {0};   // served from an existing entry
+        std::uint64_t cooked {0};   // decoded, converted and stored
+        std::uint64_t failed {0};   // unreadable or undecodable sources
+        std::uint64_t bytes  {0};   // level data handed out
+    };
+
+    // 'dir' must exist; entries are created on demand.
+    explicit TextureCache(const std::string& dir);
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    const std::string& Directory() const { return m_dir; }
+
+    // Level 0 as RGBA8 without copying it out of the entry.
+    bool MapPixels(const std::string& path, bool flipY, Pixels& out);
+
+    // Level 0 copied out as tightly packed RGBA8, like Texture::DecodeFile.
+    bool LoadPixels(const std::string& path, bool flipY,
+                    std::vector<unsigned char>& rgba, int& w, int& h);
+
+    // (Re)create 'out' from the cooked levels, uploaded from the mapping.
+    bool LoadTexture(const std::string& path, bool flipY, const Options& options, Texture& out);
+
+    // Make sure the entry exists, e.g. as a build or install step.
+    bool Cook(const std::string& path, bool flipY, const Options& options);
+
+    Stats GetStats() const;
+
+    static const char* FormatName(Format format);
+
+private:
+    bool acquire(const std::string& path, bool flipY, const Options& options, Entry& entry);
+    void count(std::uint64_t Stats::*field, std::uint64_t n = 1);
+
+private:
+    std::string m_dir;
+
+    mutable std::mutex m_mutex;   // guards m_stats
+    Stats m_stats;
+};
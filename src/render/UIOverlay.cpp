@@ -2,38 +2,42 @@
 #include "UIOverlay.h"
 
 #include <cmath>
-#include <new>
+#include <utility>
 
 #include "glad/glad.h"
-#include "Shader.h"
-#include "Texture.h"
+#include "AsyncTextureLoader.h"
+#include "Profiler.h"
+
+namespace {
+    // Button stand-in while its icon decodes (white cell, 25% alpha).
+    const std::uint32_t kPlaceholderTint = 0xFFFFFF40u;
+}
 
 UIOverlay::UIOverlay() = default;
 
-UIOverlay::~UIOverlay()
-{
-    if (m_vbo) {
-        glDeleteBuffers(1, &m_vbo);
-        m_vbo = 0;
-    }
-    delete m_shader; m_shader = nullptr;
-    delete m_icon;   m_icon   = nullptr;
-}
+UIOverlay::~UIOverlay() = default;
 
-bool UIOverlay::Initialize()
+bool UIOverlay::Initialize(ShaderBatch* programs)
 {
     if (m_ready)
         return true;
 
-    if (!BuildGeometry())
+    if (!m_batch.Initialize(programs))
         return false;
 
-    if (!BuildShader())
-        return false;
+    // A small white cell lets solid quads share the icon page texture.
+    const unsigned char white[4 * 4 * 4] = {
+        255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,
+        255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,
+        255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,
+        255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,
+    };
+    m_white = m_atlas.AddPixels("__white", 4, 4, white);
 
     UpdateLayout();
     UpdateOrtho();
 
+    ++m_version;
     m_ready = true;
     return true;
 }
@@ -46,82 +50,171 @@ void UIOverlay::Resize(int width_px, int height_px, float dpi_scale)
 
     UpdateLayout();
     UpdateOrtho();
+    m_damage.SetFull();
+    ++m_version;
 }
 
-void UIOverlay::Render()
+void UIOverlay::Submit(RenderQueue& queue, std::uint8_t layer)
 {
-    if (!m_ready || !m_shader || !m_icon)
+    WXGL_PROFILE_SCOPE("UIOverlay::Submit");
+    if (!m_ready)
         return;
 
-    m_shader->Use();
-    const unsigned int prog = m_shader->Program();
+    // Sends newly packed icons (glTexSubImage2D) or grown pages.
+    m_atlas.Upload();
 
-    // Set uniforms: ortho, rect position & size in pixels, texture unit 0
-    const int locOrtho = glGetUniformLocation(prog, "uOrtho");
-    if (locOrtho >= 0) {
-        glUniformMatrix4fv(locOrtho, 1, GL_FALSE, m_ortho);
-    }
-    const int locPos = glGetUniformLocation(prog, "uPosPx");
-    const int locSize = glGetUniformLocation(prog, "uSizePx");
-    if (locPos >= 0) {
-        glUniform4f(locPos,
-            static_cast<float>(m_btnPx.x),
-            static_cast<float>(m_btnPx.y),
-            0.f, 0.f);
-    }
-    if (locSize >= 0) {
-        glUniform4f(locSize,
-            static_cast<float>(m_btnPx.w),
-            static_cast<float>(m_btnPx.h),
-            0.f, 0.f);
+    m_batch.Begin(m_ortho);
+
+    const auto addQuad = [this](TextureAtlas::Handle icon, const Rect& r, std::uint32_t tint) {
+        const TextureAtlas::Region& reg = m_atlas.Get(icon);
+        if (reg.page < 0)
+            return;
+        m_batch.Add(m_atlas.PageTexture(reg.page),
+                    static_cast<float>(r.x), static_cast<float>(r.y),
+                    static_cast<float>(r.w), static_cast<float>(r.h),
+                    reg.u0, reg.v0, reg.u1, reg.v1, tint);
+    };
+
+    for (const Item& it : m_items) {
+        addQuad(it.icon >= 0 ? it.icon : m_white, Rect{ it.x, it.y, it.w, it.h }, it.tint);
     }
 
-    const int locTex = glGetUniformLocation(prog, "uTex");
-    if (locTex >= 0) {
-        glUniform1i(locTex, 0);
+    // The toggle button is drawn last so it stays on top.
+    if (m_btnIcon != TextureAtlas::kInvalid) {
+        addQuad(m_btnIcon, m_btnPx, 0xFFFFFFFFu);
+    } else if (!m_btnPath.empty()) {
+        addQuad(m_white, m_btnPx, kPlaceholderTint);
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    m_icon->Bind(GL_TEXTURE_2D);
+    m_batch.End(queue, layer);
+}
+
+int UIOverlay::AddItem(const Item& item)
+{
+    m_items.push_back(item);
+    m_damage.Add(DamageRect{ item.x, item.y, item.w, item.h });
+    ++m_version;
+    return static_cast<int>(m_items.size()) - 1;
+}
 
-    // Vertex attributes
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+void UIOverlay::ClearItems()
+{
+    DamageAll();
+    m_items.clear();
+    ++m_version;
+}
+
+bool UIOverlay::LoadIcon(const std::string& png_path)
+{
+    // Flip vertically so that (0,0) UV is top-left in image files.
+    const TextureAtlas::Handle h = m_atlas.AddFile(png_path, png_path, /*flipY=*/true);
+    if (h == TextureAtlas::kInvalid)
+        return false;
+    m_btnIcon = h;
+    m_btnPath.clear();   // supersedes a pending LoadIconAsync()
+    DamageAll();
+    ++m_version;
+    return true;
+}
 
-    const int locPosA = glGetAttribLocation(prog, "aPos01");
-    const int locUvA  = glGetAttribLocation(prog, "aUV");
-    const GLsizei stride = static_cast<GLsizei>(sizeof(float) * 4);
-    const void*   posPtr = reinterpret_cast<const void*>(0);
-    const void*   uvPtr  = reinterpret_cast<const void*>(sizeof(float) * 2);
+int UIOverlay::AddIcon(const std::string& png_path)
+{
+    // New atlas content (and possibly repacked UVs/pages) needs re-recording.
+    DamageAll();
+    ++m_version;
+    return m_atlas.AddFile(png_path, png_path, /*flipY=*/true);
+}
 
-    if (locPosA >= 0) {
-        glEnableVertexAttribArray(static_cast<GLuint>(locPosA));
-        glVertexAttribPointer(static_cast<GLuint>(locPosA), 2, GL_FLOAT, GL_FALSE, stride, posPtr);
-    }
-    if (locUvA >= 0) {
-        glEnableVertexAttribArray(static_cast<GLuint>(locUvA));
-        glVertexAttribPointer(static_cast<GLuint>(locUvA), 2, GL_FLOAT, GL_FALSE, stride, uvPtr);
+std::vector<int> UIOverlay::AddIcons(const std::vector<std::string>& png_paths)
+{
+    std::vector<std::pair<std::string, std::string>> files;
+    files.reserve(png_paths.size());
+    for (const std::string& p : png_paths) {
+        files.emplace_back(p, p);
     }
+    DamageAll();
+    ++m_version;
+    return m_atlas.AddFiles(files, /*flipY=*/true);
+}
 
-    // Ensure blending for alpha PNGs
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+void UIOverlay::LoadIconAsync(AsyncTextureLoader& loader, const std::string& png_path,
+                              const IconLoaded& done)
+{
+    m_btnPath = png_path;
+    m_btnIcon = TextureAtlas::kInvalid;
+    DamageAll();
+    ++m_version;
+    requestIcon(loader, png_path, done);
+}
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+void UIOverlay::AddIconsAsync(AsyncTextureLoader& loader, const std::vector<std::string>& png_paths,
+                              const IconLoaded& done)
+{
+    for (const std::string& p : png_paths)
+        requestIcon(loader, p, done);
+}
 
-    if (locUvA  >= 0) glDisableVertexAttribArray(static_cast<GLuint>(locUvA));
-    if (locPosA >= 0) glDisableVertexAttribArray(static_cast<GLuint>(locPosA));
+void UIOverlay::requestIcon(AsyncTextureLoader& loader, const std::string& png_path,
+                            const IconLoaded& done)
+{
+    const TextureAtlas::Handle existing = m_atlas.Find(png_path);
+    if (existing != TextureAtlas::kInvalid) {
+        iconDecoded(png_path, existing);
+        if (done)
+            done(png_path, true);
+        return;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // One decode per key; later requesters only add their callback.
+    auto it = m_loading.find(png_path);
+    if (it != m_loading.end()) {
+        it->second.push_back(done);
+        return;
+    }
+    m_loading[png_path].push_back(done);
+
+    loader.Request(png_path, /*flipY=*/true, [this](AsyncTextureLoader::Image& img) {
+        TextureAtlas::Handle h = TextureAtlas::kInvalid;
+        if (img.ok)
+            h = m_atlas.AddPixels(img.path, img.width, img.height, img.pixels());
+        // Upload now so the GL work counts against the loader's frame budget.
+        if (h != TextureAtlas::kInvalid)
+            m_atlas.Upload();
+        iconDecoded(img.path, h);
+
+        std::vector<IconLoaded> callbacks;
+        callbacks.swap(m_loading[img.path]);
+        m_loading.erase(img.path);
+        for (const IconLoaded& cb : callbacks) {
+            if (cb)
+                cb(img.path, h != TextureAtlas::kInvalid);
+        }
+    });
 }
 
-bool UIOverlay::LoadIcon(const std::string& png_path)
+void UIOverlay::iconDecoded(const std::string& key, TextureAtlas::Handle h)
 {
-    if (!m_icon) {
-        m_icon = new (std::nothrow) Texture();
-        if (!m_icon) return false;
+    if (key == m_btnPath) {
+        m_btnIcon = h;
+        if (h == TextureAtlas::kInvalid)
+            m_btnPath.clear();   // no icon: no button, as with LoadIcon()
     }
-    // Flip vertically so that (0,0) UV is top-left in image files.
-    return m_icon->LoadFromFile(png_path, /*flipY=*/true);
+    // New atlas content (and possibly repacked UVs/pages) needs re-recording.
+    DamageAll();
+    ++m_version;
+}
+
+void UIOverlay::CollectDamage(DamageRegion& out)
+{
+    out.Add(m_damage);
+    m_damage.Clear();
+}
+
+void UIOverlay::DamageAll()
+{
+    for (const Item& it : m_items)
+        m_damage.Add(DamageRect{ it.x, it.y, it.w, it.h });
+    m_damage.Add(DamageRect{ m_btnPx.x, m_btnPx.y, m_btnPx.w, m_btnPx.h });
 }
 
 bool UIOverlay::HitTest(int x_px, int y_px) const
@@ -133,65 +226,6 @@ bool UIOverlay::HitTest(int x_px, int y_px) const
     return (x_px >= x0 && x_px < x1 && y_px >= y0 && y_px < y1);
 }
 
-bool UIOverlay::BuildGeometry()
-{
-    // Interleaved: [pos01.x, pos01.y, uv.x, uv.y] for 4 vertices
-    // Unit quad in 0..1 (to be scaled/translated in shader by uPosPx/uSizePx)
-    const float quad[4 * 4] = {
-        // x  y   u  v
-         0.f, 0.f, 0.f, 0.f, // top-left
-         1.f, 0.f, 1.f, 0.f, // top-right
-         1.f, 1.f, 1.f, 1.f, // bottom-right
-         0.f, 1.f, 0.f, 1.f, // bottom-left
-    };
-
-    glGenBuffers(1, &m_vbo);
-    if (!m_vbo) return false;
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return (glGetError() == 0);
-}
-
-bool UIOverlay::BuildShader()
-{
-    // #version 120 for broad compatibility (OpenGL 2.1-era)
-    static const char* kVS =
-        "#version 120\n"
-        "attribute vec2 aPos01;\n"
-        "attribute vec2 aUV;\n"
-        "uniform mat4 uOrtho;\n"
-        "uniform vec4 uPosPx;  // x,y in pixels (top-left)\n"
-        "uniform vec4 uSizePx; // w,h in pixels\n"
-        "varying vec2 vUV;\n"
-        "void main() {\n"
-        "  vec2 posPx = uPosPx.xy + aPos01 * uSizePx.xy;\n"
-        "  vec4 posClip = uOrtho * vec4(posPx.xy, 0.0, 1.0);\n"
-        "  gl_Position = posClip;\n"
-        "  vUV = aUV;\n"
-        "}\n";
-
-    static const char* kFS =
-        "#version 120\n"
-        "uniform sampler2D uTex;\n"
-        "varying vec2 vUV;\n"
-        "void main() {\n"
-        "  vec4 tex = texture2D(uTex, vUV);\n"
-        "  gl_FragColor = tex;\n"
-        "}\n";
-
-    m_shader = new (std::nothrow) Shader();
-    if (!m_shader) return false;
-
-    if (!m_shader->CompileFromSource(kVS, kFS, nullptr)) {
-        delete m_shader; m_shader = nullptr;
-        return false;
-    }
-    return true;
-}
-
 void UIOverlay::UpdateLayout()
 {
     const int sizePx = static_cast<int>(std::floor(m_btnSizeDip * m_dpi + 0.5f));
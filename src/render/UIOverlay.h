@@ -1,10 +1,20 @@
 // src/render/UIOverlay.h
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-class Shader;
-class Texture;
+#include "Damage.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+
+class AsyncTextureLoader;
+class ShaderBatch;
+class TextureCache;
 
 /**
  * UIOverlay
@@ -12,35 +22,83 @@ class Texture;
  * - Layout is in device pixels, DPI-aware (anchored at bottom-right).
  * - HitTest() uses the same pixel coordinate system as the canvas mouse events
  *   (origin at top-left, Y increases downward).
+ * - Additional items (icons, badges, status lights) can be added; all of them
+ *   are drawn through one SpriteBatch, i.e. one streamed vertex buffer and
+ *   one draw call per texture/blend run.
+ * - Icons live in a TextureAtlas; solid quads sample a white atlas cell, so
+ *   an overlay whose icons share one atlas page draws from one bound texture.
+ * - Version() changes whenever anything that affects the recorded commands
+ *   changes (items, icons, size), so the owner can replay its queue otherwise.
+ * - Icons can load asynchronously (AsyncTextureLoader): they are packed and
+ *   uploaded when the loader delivers them; meanwhile the button is drawn
+ *   as a translucent placeholder and already hit-tests.
  *
  * No dependency on wxWidgets; the owner (Renderer) forwards input and sizing.
  */
 class UIOverlay
 {
 public:
+    // Extra overlay quad in device pixels (top-left origin).
+    struct Item {
+        int x, y, w, h;
+        std::uint32_t tint;  // 0xRRGGBBAA
+        int icon;            // handle from AddIcon(); -1 = solid tinted quad
+    };
+
     UIOverlay();
     ~UIOverlay();
 
     // GL initialization (shaders, geometry). Requires a current GL context.
-    bool Initialize();
+    // With 'programs' the sprite program links in the background.
+    bool Initialize(ShaderBatch* programs = nullptr);
 
     // Update viewport (device pixels) and DPI scale.
     void Resize(int width_px, int height_px, float dpi_scale);
 
-    // Draw the overlay (if icon and shader are ready).
-    void Render();
+    // Record the overlay (items first, then the button on top) into 'layer'.
+    void Submit(RenderQueue& queue, std::uint8_t layer);
 
-    // Load PNG icon into an OpenGL texture.
+    // Bumped by every change that invalidates previously recorded commands.
+    unsigned Version() const { return m_version; }
+
+    // Move the pixel rectangles changed since the last call into 'out'.
+    void CollectDamage(DamageRegion& out);
+
+    // Load the PNG used by the toggle button (packed into the icon atlas).
     bool LoadIcon(const std::string& png_path);
 
+    // Pack additional PNG icons (key = path); returns atlas handles in order.
+    int AddIcon(const std::string& png_path);
+    std::vector<int> AddIcons(const std::vector<std::string>& png_paths);
+
+    // Cooked-pixel source for the synchronous loads (see TextureAtlas::SetCache).
+    void SetTextureCache(TextureCache* cache) { m_atlas.SetCache(cache); }
+
+    // Asynchronous LoadIcon / AddIcons: decode on 'loader', pack on delivery.
+    // 'done' runs once per path from AsyncTextureLoader::Pump() (GL thread);
+    // icons already packed report at once. The loader must not outlive us.
+    using IconLoaded = std::function<void(const std::string& path, bool ok)>;
+    void LoadIconAsync(AsyncTextureLoader& loader, const std::string& png_path,
+                       const IconLoaded& done = IconLoaded());
+    void AddIconsAsync(AsyncTextureLoader& loader, const std::vector<std::string>& png_paths,
+                       const IconLoaded& done = IconLoaded());
+
     // Return true if (x_px, y_px) hits the button (pixel coords, top-left origin).
     bool HitTest(int x_px, int y_px) const;
 
+    // Extra items drawn below the button; returns the item index.
+    int  AddItem(const Item& item);
+    void ClearItems();
+
+    // Batching statistics of the last Submit() (draw calls, sprites).
+    const SpriteBatch::Stats& LastStats() const { return m_batch.LastStats(); }
+
 private:
-    bool BuildGeometry();     // unit quad VBO (0..1) with UVs
-    bool BuildShader();       // textured quad shader
     void UpdateLayout();      // compute button rect in pixels
     void UpdateOrtho();       // compute NDC matrix from pixel coords
+    void DamageAll();         // every item + the button (e.g. icons repacked)
+    void requestIcon(AsyncTextureLoader& loader, const std::string& png_path, const IconLoaded& done);
+    void iconDecoded(const std::string& key, TextureAtlas::Handle h);
 
 private:
     // Viewport & DPI
@@ -56,9 +114,16 @@ private:
     struct Rect { int x, y, w, h; } m_btnPx {0,0,0,0};
 
     // GL resources
-    unsigned int m_vbo {0};   // unit quad: pos(2) + uv(2), 4 vertices (TRIANGLE_FAN)
-    Shader*  m_shader {nullptr};  // owned
-    Texture* m_icon   {nullptr};  // owned
+    SpriteBatch  m_batch;             // streamed quads for the whole overlay
+    TextureAtlas m_atlas;             // all overlay icons
+    TextureAtlas::Handle m_btnIcon {TextureAtlas::kInvalid};
+    TextureAtlas::Handle m_white   {TextureAtlas::kInvalid};
+
+    std::vector<Item> m_items;
+
+    // Async icons: button icon still loading ("" = none) and pending keys
+    std::string m_btnPath;
+    std::unordered_map<std::string, std::vector<IconLoaded>> m_loading;
 
     // Cached orthographic transform (pixel -> clip space), column-major
     float m_ortho[16] = {
@@ -68,5 +133,7 @@ private:
         -1.f,  1.f, 0.f, 1.f
     };
 
+    DamageRegion m_damage;    // pending, device pixels
+    unsigned m_version {0};
     bool m_ready {false};
-};
\ No newline at end of file
+};
@@ -0,0 +1,62 @@
+// src/render/Util.cpp
+#include "Util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+const std::uint64_t Util::kFnvOffset;
+
+std::uint64_t Util::Fnv1a(const void* data, std::size_t n, std::uint64_t h)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::uint32_t Util::Fnv1a32(const void* data, std::size_t n)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+double Util::Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    const double rank = std::ceil(std::max(0.0, std::min(p, 1.0)) * static_cast<double>(sorted.size()));
+    const std::size_t i = static_cast<std::size_t>(std::max(rank, 1.0)) - 1;
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+std::string Util::JsonEscape(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\r': out += "\\r";  break;
+        case '\t': out += "\\t";  break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                out += buf;
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+    return out;
+}
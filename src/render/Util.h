@@ -0,0 +1,35 @@
+// src/render/Util.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Util
+ * Small helpers shared by the render library, the tools and the app, so
+ * every report and cache agrees on one definition.
+ *
+ * - Fnv1a(): 64-bit FNV-1a. Not cryptographic; used for cache keys and
+ *   entry checksums. Pass the previous result as 'h' to hash several
+ *   buffers as one. Fnv1a32() is the 32-bit variant for in-memory lookup
+ *   tables (shader variable names, vertex welding).
+ * - Percentile(): nearest rank, the ceil(p * n)-th smallest sample (p = 0
+ *   gives the minimum, p = 1 the maximum). Always a measured value, never
+ *   interpolated. Expects ascending order; 0 for no samples.
+ * - JsonEscape(): the contents of a JSON string (without the quotes).
+ *   Escapes quotes, backslashes and control characters.
+ */
+class Util
+{
+public:
+    Util() = delete;
+
+    static const std::uint64_t kFnvOffset = 14695981039346656037ull;
+
+    static std::uint64_t Fnv1a(const void* data, std::size_t n, std::uint64_t h = kFnvOffset);
+    static std::uint32_t Fnv1a32(const void* data, std::size_t n);
+    static double        Percentile(const std::vector<double>& sorted, double p);
+    static std::string   JsonEscape(const std::string& s);
+};
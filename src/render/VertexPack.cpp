@@ -0,0 +1,259 @@
+// src/render/VertexPack.cpp
+#include "VertexPack.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "glad/glad.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define WXGL_VERTEXPACK_SSE2 1
+#  include <emmintrin.h>
+#else
+#  define WXGL_VERTEXPACK_SSE2 0
+#endif
+
+namespace {
+// Float bit patterns used by the half conversion.
+const std::uint32_t kHalfOverflow = 0x47800000u;   // 65536.0f: rounds past 65504
+const std::uint32_t kHalfMinNorm  = 0x38800000u;   // 2^-14: smallest normal half
+const std::uint32_t kFloatInf     = 0x7F800000u;
+const std::uint32_t kRebias       = 0xFFFu - (112u << 23);   // exponent bias 127 -> 15, round bias
+
+// Elements per gather/convert/scatter step of Pack().
+const std::size_t kChunk = 256;
+
+std::uint32_t Bits(float f)
+{
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float FromBits(std::uint32_t u)
+{
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+float Clamp01(float v)
+{
+    // Same operand order as _mm_max_ps/_mm_min_ps, so NaN becomes 0 in both.
+    v = (v > 0.0f) ? v : 0.0f;
+    return (v < 1.0f) ? v : 1.0f;
+}
+
+#if WXGL_VERTEXPACK_SSE2
+// Four floats -> four halves in the low 16 bits of each lane; mirrors ToHalf().
+__m128i HalfSse2(__m128 f)
+{
+    __m128i x = _mm_castps_si128(f);
+    const __m128i sign = _mm_and_si128(x, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    x = _mm_xor_si128(x, sign);
+
+    const __m128i isBig   = _mm_cmpgt_epi32(x, _mm_set1_epi32(static_cast<int>(kHalfOverflow - 1)));
+    const __m128i isNan   = _mm_cmpgt_epi32(x, _mm_set1_epi32(static_cast<int>(kFloatInf)));
+    const __m128i isSmall = _mm_cmplt_epi32(x, _mm_set1_epi32(static_cast<int>(kHalfMinNorm)));
+
+    const __m128i big = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNan, _mm_set1_epi32(0x0200)));
+
+    // Subnormals: adding 0.5f lines the half mantissa up with the float's.
+    const __m128 denorm = _mm_add_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.5f));
+    const __m128i small = _mm_sub_epi32(_mm_castps_si128(denorm), _mm_set1_epi32(0x3F000000));
+
+    const __m128i odd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+    __m128i normal = _mm_add_epi32(x, _mm_set1_epi32(static_cast<int>(kRebias)));
+    normal = _mm_srli_epi32(_mm_add_epi32(normal, odd), 13);
+
+    __m128i r = _mm_or_si128(_mm_and_si128(isSmall, small), _mm_andnot_si128(isSmall, normal));
+    r = _mm_or_si128(_mm_and_si128(isBig, big), _mm_andnot_si128(isBig, r));
+    return _mm_or_si128(r, _mm_srli_epi32(sign, 16));
+}
+
+// Eight 32-bit lanes holding 0..65535 -> eight uint16 (SSE2 has only signed packs).
+__m128i PackU16(__m128i lo, __m128i hi)
+{
+    const __m128i bias = _mm_set1_epi32(0x8000);
+    const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(lo, bias), _mm_sub_epi32(hi, bias));
+    return _mm_xor_si128(packed, _mm_set1_epi16(static_cast<short>(0x8000)));
+}
+
+__m128i UNormSse2(const float* src, __m128 scale)
+{
+    const __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, scale));   // MXCSR default: nearest even
+}
+#endif
+} // namespace
+
+std::size_t VertexPack::ComponentBytes(Format format)
+{
+    switch (format) {
+    case Format::Float:   return 4;
+    case Format::Half:    return 2;
+    case Format::UNorm8:  return 1;
+    case Format::UNorm16: return 2;
+    }
+    return 4;
+}
+
+unsigned VertexPack::GlType(Format format)
+{
+    switch (format) {
+    case Format::Float:   return GL_FLOAT;
+    case Format::Half:    return GL_HALF_FLOAT;
+    case Format::UNorm8:  return GL_UNSIGNED_BYTE;
+    case Format::UNorm16: return GL_UNSIGNED_SHORT;
+    }
+    return GL_FLOAT;
+}
+
+bool VertexPack::Normalized(Format format)
+{
+    return format == Format::UNorm8 || format == Format::UNorm16;
+}
+
+Mesh::Attrib VertexPack::MakeAttrib(unsigned index, int size, Format format,
+                                    int stride, std::size_t offset)
+{
+    return Mesh::Attrib{ index, size, GlType(format),
+                         static_cast<unsigned char>(Normalized(format) ? GL_TRUE : GL_FALSE),
+                         stride, offset };
+}
+
+std::uint16_t VertexPack::ToHalf(float v)
+{
+    std::uint32_t x = Bits(v);
+    const std::uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+
+    std::uint32_t h;
+    if (x >= kHalfOverflow) {
+        h = (x > kFloatInf) ? 0x7E00u : 0x7C00u;   // NaN stays NaN, the rest is infinity
+    } else if (x < kHalfMinNorm) {
+        h = Bits(FromBits(x) + 0.5f) - 0x3F000000u;
+    } else {
+        // Rebias the exponent; 0xFFF plus the odd bit rounds to nearest even.
+        h = (x + kRebias + ((x >> 13) & 1u)) >> 13;
+    }
+    return static_cast<std::uint16_t>(h | (sign >> 16));
+}
+
+std::uint8_t VertexPack::ToUNorm8(float v)
+{
+    return static_cast<std::uint8_t>(std::nearbyint(Clamp01(v) * 255.0f));
+}
+
+std::uint16_t VertexPack::ToUNorm16(float v)
+{
+    return static_cast<std::uint16_t>(std::nearbyint(Clamp01(v) * 65535.0f));
+}
+
+float VertexPack::HalfToFloat(std::uint16_t h)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    const std::uint32_t exp  = (h >> 10) & 0x1Fu;
+    const std::uint32_t mant = h & 0x3FFu;
+    if (exp == 0) {
+        const float f = std::ldexp(static_cast<float>(mant), -24);
+        return sign ? -f : f;
+    }
+    if (exp == 31)
+        return FromBits(sign | kFloatInf | (mant << 13));
+    return FromBits(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+bool VertexPack::SimdEnabled()
+{
+    return WXGL_VERTEXPACK_SSE2 != 0;
+}
+
+void VertexPack::FloatToHalf(const float* src, std::uint16_t* dst, std::size_t n)
+{
+    std::size_t i = 0;
+#if WXGL_VERTEXPACK_SSE2
+    for (; i + 8 <= n; i += 8) {
+        const __m128i lo = HalfSse2(_mm_loadu_ps(src + i));
+        const __m128i hi = HalfSse2(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), PackU16(lo, hi));
+    }
+#endif
+    for (; i < n; ++i)
+        dst[i] = ToHalf(src[i]);
+}
+
+void VertexPack::FloatToUNorm8(const float* src, std::uint8_t* dst, std::size_t n)
+{
+    std::size_t i = 0;
+#if WXGL_VERTEXPACK_SSE2
+    const __m128 scale = _mm_set1_ps(255.0f);
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_packs_epi32(UNormSse2(src + i,      scale), UNormSse2(src + i + 4,  scale));
+        const __m128i b = _mm_packs_epi32(UNormSse2(src + i + 8,  scale), UNormSse2(src + i + 12, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+    }
+#endif
+    for (; i < n; ++i)
+        dst[i] = ToUNorm8(src[i]);
+}
+
+void VertexPack::FloatToUNorm16(const float* src, std::uint16_t* dst, std::size_t n)
+{
+    std::size_t i = 0;
+#if WXGL_VERTEXPACK_SSE2
+    const __m128 scale = _mm_set1_ps(65535.0f);
+    for (; i + 8 <= n; i += 8) {
+        const __m128i packed = PackU16(UNormSse2(src + i, scale), UNormSse2(src + i + 4, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+#endif
+    for (; i < n; ++i)
+        dst[i] = ToUNorm16(src[i]);
+}
+
+void VertexPack::Pack(Format format, const float* src, std::size_t src_stride, int components,
+                      void* dst, std::size_t dst_stride, std::size_t count)
+{
+    if (!src || !dst || components <= 0 || components > 4 || count == 0)
+        return;
+
+    const std::size_t comps = static_cast<std::size_t>(components);
+    const std::size_t outBytes = comps * ComponentBytes(format);
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    unsigned char* out = static_cast<unsigned char*>(dst);
+
+    // Gather a chunk into contiguous floats, convert in bulk, scatter.
+    float         gathered[kChunk * 4];
+    std::uint16_t shorts[kChunk * 4];
+    std::uint8_t  bytes[kChunk * 4];
+    const std::size_t perChunk = kChunk * 4 / comps;
+
+    for (std::size_t first = 0; first < count; first += perChunk) {
+        const std::size_t n = (count - first < perChunk) ? count - first : perChunk;
+        for (std::size_t i = 0; i < n; ++i)
+            std::memcpy(gathered + i * comps, in + (first + i) * src_stride, comps * sizeof(float));
+
+        const std::size_t values = n * comps;
+        const unsigned char* converted = reinterpret_cast<const unsigned char*>(gathered);
+        switch (format) {
+        case Format::Float:
+            break;
+        case Format::Half:
+            FloatToHalf(gathered, shorts, values);
+            converted = reinterpret_cast<const unsigned char*>(shorts);
+            break;
+        case Format::UNorm8:
+            FloatToUNorm8(gathered, bytes, values);
+            converted = bytes;
+            break;
+        case Format::UNorm16:
+            FloatToUNorm16(gathered, shorts, values);
+            converted = reinterpret_cast<const unsigned char*>(shorts);
+            break;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            std::memcpy(out + (first + i) * dst_stride, converted + i * outBytes, outBytes);
+    }
+}
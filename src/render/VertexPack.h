@@ -0,0 +1,63 @@
+// src/render/VertexPack.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Mesh.h"
+
+/**
+ * VertexPack
+ * Converts float vertex data into compact attribute formats, so large meshes
+ * move fewer bytes per vertex through the vertex fetch:
+ *
+ *   Format   bytes/comp  GL type                     typical use
+ *   Float    4           GL_FLOAT                    pixel positions
+ *   Half     2           GL_HALF_FLOAT               positions in a small range
+ *   UNorm8   1           GL_UNSIGNED_BYTE, normalized  colors
+ *   UNorm16  2           GL_UNSIGNED_SHORT, normalized UVs in [0..1]
+ *
+ * - Half rounds to nearest even and keeps infinities/NaN; values beyond
+ *   +-65504 become infinities. It needs Mesh::HalfFloatSupported() (GL 3.0 or
+ *   ARB_half_float_vertex); pick Float otherwise.
+ * - UNorm formats clamp to [0..1] (NaN -> 0) and round to nearest even.
+ * - The bulk converters use SSE2 where the target has it, four floats per
+ *   step; the scalar path produces identical bits.
+ * - Pack() reads and writes strided (interleaved) data, so one call fills
+ *   one attribute of an interleaved vertex buffer.
+ *
+ * No GL calls; any thread.
+ */
+class VertexPack
+{
+public:
+    enum class Format { Float, Half, UNorm8, UNorm16 };
+
+    VertexPack() = delete;
+
+    static std::size_t ComponentBytes(Format format);
+    static unsigned GlType(Format format);
+    static bool Normalized(Format format);
+
+    // Attribute description for 'size' components of 'format'.
+    static Mesh::Attrib MakeAttrib(unsigned index, int size, Format format,
+                                   int stride, std::size_t offset);
+
+    // 'count' elements of 'components' (1..4) floats each; strides are in bytes.
+    static void Pack(Format format, const float* src, std::size_t src_stride, int components,
+                     void* dst, std::size_t dst_stride, std::size_t count);
+
+    // Contiguous bulk conversion of 'n' values.
+    static void FloatToHalf(const float* src, std::uint16_t* dst, std::size_t n);
+    static void FloatToUNorm8(const float* src, std::uint8_t* dst, std::size_t n);
+    static void FloatToUNorm16(const float* src, std::uint16_t* dst, std::size_t n);
+
+    // Single values (scalar path).
+    static std::uint16_t ToHalf(float v);
+    static std::uint8_t  ToUNorm8(float v);
+    static std::uint16_t ToUNorm16(float v);
+    static float HalfToFloat(std::uint16_t h);
+
+    // True when the bulk converters were compiled with SSE2.
+    static bool SimdEnabled();
+};
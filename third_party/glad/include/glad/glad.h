@@ -45,6 +45,9 @@ typedef double        GLdouble;
 typedef ptrdiff_t     GLsizeiptr;
 typedef ptrdiff_t     GLintptr;
 typedef char          GLchar;
+typedef int64_t       GLint64;
+typedef uint64_t      GLuint64;
+typedef struct __GLsync* GLsync;
 
 /* ---- Common tokens (only the ones used in this project) ---- */
 #ifndef GL_FALSE
@@ -67,7 +70,24 @@ typedef char          GLchar;
 #  define GL_TRIANGLE_FAN 0x0006
 #endif
 
+/* Capabilities */
+#ifndef GL_CULL_FACE
+#  define GL_CULL_FACE 0x0B44
+#endif
+#ifndef GL_DEPTH_TEST
+#  define GL_DEPTH_TEST 0x0B71
+#endif
+#ifndef GL_SCISSOR_TEST
+#  define GL_SCISSOR_TEST 0x0C11
+#endif
+
 /* Blending */
+#ifndef GL_ZERO
+#  define GL_ZERO 0
+#endif
+#ifndef GL_ONE
+#  define GL_ONE 1
+#endif
 #ifndef GL_BLEND
 #  define GL_BLEND 0x0BE2
 #endif
@@ -88,6 +108,12 @@ typedef char          GLchar;
 #ifndef GL_STATIC_DRAW
 #  define GL_STATIC_DRAW 0x88E4
 #endif
+#ifndef GL_DYNAMIC_DRAW
+#  define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_STREAM_DRAW
+#  define GL_STREAM_DRAW 0x88E0
+#endif
 #ifndef GL_FLOAT
 #  define GL_FLOAT 0x1406
 #endif
@@ -129,6 +155,72 @@ typedef char          GLchar;
 #ifndef GL_UNSIGNED_BYTE
 #  define GL_UNSIGNED_BYTE 0x1401
 #endif
+#ifndef GL_UNSIGNED_SHORT
+#  define GL_UNSIGNED_SHORT 0x1403
+#endif
+#ifndef GL_UNSIGNED_INT
+#  define GL_UNSIGNED_INT 0x1405
+#endif
+#ifndef GL_HALF_FLOAT
+#  define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_UNPACK_ALIGNMENT
+#  define GL_UNPACK_ALIGNMENT 0x0CF5
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#  define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+#ifndef GL_UNPACK_SKIP_PIXELS
+#  define GL_UNPACK_SKIP_PIXELS 0x0CF4
+#endif
+#ifndef GL_UNPACK_SKIP_ROWS
+#  define GL_UNPACK_SKIP_ROWS 0x0CF3
+#endif
+#ifndef GL_RED
+#  define GL_RED 0x1903
+#endif
+#ifndef GL_GREEN
+#  define GL_GREEN 0x1904
+#endif
+#ifndef GL_RG
+#  define GL_RG 0x8227
+#endif
+#ifndef GL_R8
+#  define GL_R8 0x8229
+#endif
+#ifndef GL_RG8
+#  define GL_RG8 0x822B
+#endif
+#ifndef GL_RGB5
+#  define GL_RGB5 0x8050
+#endif
+#ifndef GL_RGBA4
+#  define GL_RGBA4 0x8056
+#endif
+#ifndef GL_UNSIGNED_SHORT_5_6_5
+#  define GL_UNSIGNED_SHORT_5_6_5 0x8363
+#endif
+#ifndef GL_UNSIGNED_SHORT_4_4_4_4
+#  define GL_UNSIGNED_SHORT_4_4_4_4 0x8033
+#endif
+#ifndef GL_LINEAR_MIPMAP_LINEAR
+#  define GL_LINEAR_MIPMAP_LINEAR 0x2703
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#  define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_R
+#  define GL_TEXTURE_SWIZZLE_R 0x8E42
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_G
+#  define GL_TEXTURE_SWIZZLE_G 0x8E43
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_B
+#  define GL_TEXTURE_SWIZZLE_B 0x8E44
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_A
+#  define GL_TEXTURE_SWIZZLE_A 0x8E45
+#endif
 
 /* Shaders / Programs */
 #ifndef GL_VERTEX_SHADER
@@ -146,22 +238,161 @@ typedef char          GLchar;
 #ifndef GL_INFO_LOG_LENGTH
 #  define GL_INFO_LOG_LENGTH 0x8B84
 #endif
+#ifndef GL_ACTIVE_UNIFORMS
+#  define GL_ACTIVE_UNIFORMS 0x8B86
+#endif
+#ifndef GL_ACTIVE_UNIFORM_MAX_LENGTH
+#  define GL_ACTIVE_UNIFORM_MAX_LENGTH 0x8B87
+#endif
+#ifndef GL_ACTIVE_ATTRIBUTES
+#  define GL_ACTIVE_ATTRIBUTES 0x8B89
+#endif
+#ifndef GL_ACTIVE_ATTRIBUTE_MAX_LENGTH
+#  define GL_ACTIVE_ATTRIBUTE_MAX_LENGTH 0x8B8A
+#endif
+
+/* Uniform/attribute types (reflection) */
+#ifndef GL_FLOAT_VEC2
+#  define GL_FLOAT_VEC2 0x8B50
+#endif
+#ifndef GL_FLOAT_VEC3
+#  define GL_FLOAT_VEC3 0x8B51
+#endif
+#ifndef GL_FLOAT_VEC4
+#  define GL_FLOAT_VEC4 0x8B52
+#endif
+#ifndef GL_INT
+#  define GL_INT 0x1404
+#endif
+#ifndef GL_FLOAT_MAT4
+#  define GL_FLOAT_MAT4 0x8B5C
+#endif
+#ifndef GL_SAMPLER_2D
+#  define GL_SAMPLER_2D 0x8B5E
+#endif
+
+/* Queries (GL 1.5 / ARB_timer_query, GL 3.3) */
+#ifndef GL_QUERY_RESULT
+#  define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#  define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_TIME_ELAPSED
+#  define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_EXTENSIONS
+#  define GL_EXTENSIONS 0x1F03
+#endif
+#ifndef GL_VERSION
+#  define GL_VERSION 0x1F02
+#endif
+#ifndef GL_NUM_EXTENSIONS
+#  define GL_NUM_EXTENSIONS 0x821D
+#endif
+#ifndef GL_VENDOR
+#  define GL_VENDOR 0x1F00
+#endif
+#ifndef GL_RENDERER
+#  define GL_RENDERER 0x1F01
+#endif
+
+/* Framebuffer objects (GL 3.0 / ARB_framebuffer_object) and read-back */
+#ifndef GL_FRAMEBUFFER
+#  define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#  define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#  define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#  define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_RGBA8
+#  define GL_RGBA8 0x8058
+#endif
+#ifndef GL_PACK_ALIGNMENT
+#  define GL_PACK_ALIGNMENT 0x0D05
+#endif
+
+/* Pixel buffers, buffer mapping (GL 3.0 / ARB_map_buffer_range), sync (GL 3.2 / ARB_sync) */
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#  define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#  define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#  define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#  define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#  define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#  define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#  define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#  define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#  define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#  define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_WAIT_FAILED
+#  define GL_WAIT_FAILED 0x911D
+#endif
+
+/* Program binaries (GL 4.1 / ARB_get_program_binary) */
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#  define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#  define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#  define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_SHADING_LANGUAGE_VERSION
+#  define GL_SHADING_LANGUAGE_VERSION 0x8B8C
+#endif
+
+/* Parallel shader compilation (KHR_parallel_shader_compile) */
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#  define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 /* ---- Function pointer typedefs ---- */
 /* GL 1.0/1.1 bits (also loaded to keep code path uniform) */
 typedef void     (APIENTRY *PFNGLCLEARPROC)        (GLbitfield mask);
 typedef void     (APIENTRY *PFNGLCLEARCOLORPROC)   (GLfloat r, GLfloat g, GLfloat b, GLfloat a);
 typedef void     (APIENTRY *PFNGLVIEWPORTPROC)     (GLint x, GLint y, GLsizei w, GLsizei h);
+typedef void     (APIENTRY *PFNGLSCISSORPROC)      (GLint x, GLint y, GLsizei w, GLsizei h);
 typedef void     (APIENTRY *PFNGLENABLEPROC)       (GLenum cap);
 typedef void     (APIENTRY *PFNGLDISABLEPROC)      (GLenum cap);
 typedef void     (APIENTRY *PFNGLBLENDFUNCPROC)    (GLenum sfactor, GLenum dfactor);
 typedef GLenum   (APIENTRY *PFNGLGETERRORPROC)     (void);
 typedef const GLubyte* (APIENTRY *PFNGLGETSTRINGPROC)(GLenum name);
+typedef void     (APIENTRY *PFNGLGETINTEGERVPROC)  (GLenum pname, GLint* data);
+typedef const GLubyte* (APIENTRY *PFNGLGETSTRINGIPROC)(GLenum name, GLuint index);   /* GL 3.0, optional */
 
 /* VBO/VAO (GL 2.0+/3.0) */
 typedef void     (APIENTRY *PFNGLGENBUFFERSPROC)   (GLsizei n, GLuint* buffers);
 typedef void     (APIENTRY *PFNGLBINDBUFFERPROC)   (GLenum target, GLuint buffer);
 typedef void     (APIENTRY *PFNGLBUFFERDATAPROC)   (GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+typedef void     (APIENTRY *PFNGLBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
 typedef void     (APIENTRY *PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
 
 typedef void     (APIENTRY *PFNGLGENVERTEXARRAYSPROC)   (GLsizei n, GLuint* arrays);
@@ -192,13 +423,20 @@ typedef GLint    (APIENTRY *PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const G
 typedef void     (APIENTRY *PFNGLUNIFORM1IPROC)        (GLint location, GLint v0);
 typedef void     (APIENTRY *PFNGLUNIFORMMATRIX4FVPROC) (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
 typedef void     (APIENTRY *PFNGLUNIFORM4FPROC)        (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+typedef void     (APIENTRY *PFNGLUNIFORM1FPROC)        (GLint location, GLfloat v0);
+typedef void     (APIENTRY *PFNGLUNIFORM2FPROC)        (GLint location, GLfloat v0, GLfloat v1);
+typedef void     (APIENTRY *PFNGLGETACTIVEUNIFORMPROC) (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+typedef void     (APIENTRY *PFNGLGETACTIVEATTRIBPROC)  (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
 
 typedef GLint    (APIENTRY *PFNGLGETATTRIBLOCATIONPROC)(GLuint program, const GLchar* name);
+typedef void     (APIENTRY *PFNGLBINDATTRIBLOCATIONPROC)(GLuint program, GLuint index, const GLchar* name);
 
 /* Textures (GL 1.1/2.0) */
 typedef void     (APIENTRY *PFNGLGENTEXTURESPROC)   (GLsizei n, GLuint* textures);
 typedef void     (APIENTRY *PFNGLBINDTEXTUREPROC)   (GLenum target, GLuint texture);
 typedef void     (APIENTRY *PFNGLTEXIMAGE2DPROC)    (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+typedef void     (APIENTRY *PFNGLTEXSUBIMAGE2DPROC) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+typedef void     (APIENTRY *PFNGLPIXELSTOREIPROC)   (GLenum pname, GLint param);
 typedef void     (APIENTRY *PFNGLTEXPARAMETERIPROC) (GLenum target, GLenum pname, GLint param);
 typedef void     (APIENTRY *PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint* textures);
 typedef void     (APIENTRY *PFNGLACTIVETEXTUREPROC) (GLenum texture);
@@ -207,21 +445,68 @@ typedef void     (APIENTRY *PFNGLACTIVETEXTUREPROC) (GLenum texture);
 typedef void     (APIENTRY *PFNGLDRAWARRAYSPROC)    (GLenum mode, GLint first, GLsizei count);
 typedef void     (APIENTRY *PFNGLDRAWELEMENTSPROC)  (GLenum mode, GLsizei count, GLenum type, const void* indices);
 
+/* Instancing (GL 3.1/3.3, ARB_draw_instanced + ARB_instanced_arrays) — optional */
+typedef void     (APIENTRY *PFNGLDRAWARRAYSINSTANCEDPROC)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void     (APIENTRY *PFNGLVERTEXATTRIBDIVISORPROC)(GLuint index, GLuint divisor);
+typedef void     (APIENTRY *PFNGLDRAWELEMENTSINSTANCEDPROC)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+
+/* Queries (GL 1.5 + ARB_timer_query) — optional */
+typedef void     (APIENTRY *PFNGLGENQUERIESPROC)         (GLsizei n, GLuint* ids);
+typedef void     (APIENTRY *PFNGLDELETEQUERIESPROC)      (GLsizei n, const GLuint* ids);
+typedef void     (APIENTRY *PFNGLBEGINQUERYPROC)         (GLenum target, GLuint id);
+typedef void     (APIENTRY *PFNGLENDQUERYPROC)           (GLenum target);
+typedef void     (APIENTRY *PFNGLGETQUERYOBJECTIVPROC)   (GLuint id, GLenum pname, GLint* params);
+typedef void     (APIENTRY *PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64* params);
+
+/* Read-back / sync (GL 1.0) */
+typedef void     (APIENTRY *PFNGLREADPIXELSPROC)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+typedef void     (APIENTRY *PFNGLFINISHPROC)    (void);
+
+/* Framebuffer objects (GL 3.0 / ARB_framebuffer_object / EXT_framebuffer_object) — optional */
+typedef void     (APIENTRY *PFNGLGENFRAMEBUFFERSPROC)        (GLsizei n, GLuint* framebuffers);
+typedef void     (APIENTRY *PFNGLDELETEFRAMEBUFFERSPROC)     (GLsizei n, const GLuint* framebuffers);
+typedef void     (APIENTRY *PFNGLBINDFRAMEBUFFERPROC)        (GLenum target, GLuint framebuffer);
+typedef GLenum   (APIENTRY *PFNGLCHECKFRAMEBUFFERSTATUSPROC) (GLenum target);
+typedef void     (APIENTRY *PFNGLFRAMEBUFFERRENDERBUFFERPROC)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+typedef void     (APIENTRY *PFNGLGENRENDERBUFFERSPROC)       (GLsizei n, GLuint* renderbuffers);
+typedef void     (APIENTRY *PFNGLDELETERENDERBUFFERSPROC)    (GLsizei n, const GLuint* renderbuffers);
+typedef void     (APIENTRY *PFNGLBINDRENDERBUFFERPROC)       (GLenum target, GLuint renderbuffer);
+typedef void     (APIENTRY *PFNGLRENDERBUFFERSTORAGEPROC)    (GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+
+/* Buffer mapping (GL 3.0 / ARB_map_buffer_range) and fences (GL 3.2 / ARB_sync) — optional */
+typedef void*    (APIENTRY *PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRY *PFNGLUNMAPBUFFERPROC)  (GLenum target);
+typedef GLsync   (APIENTRY *PFNGLFENCESYNCPROC)     (GLenum condition, GLbitfield flags);
+typedef GLenum   (APIENTRY *PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void     (APIENTRY *PFNGLDELETESYNCPROC)    (GLsync sync);
+
+/* Program binaries (GL 4.1 / ARB_get_program_binary) — optional */
+typedef void     (APIENTRY *PFNGLGETPROGRAMBINARYPROC) (GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void     (APIENTRY *PFNGLPROGRAMBINARYPROC)    (GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void     (APIENTRY *PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+/* Parallel shader compilation (KHR/ARB_parallel_shader_compile) — optional */
+typedef void     (APIENTRY *PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
 /* ---- Extern function pointers (prefixed), plus convenience macros ---- */
 /* Base */
 extern PFNGLCLEARPROC                 glad_glClear;
 extern PFNGLCLEARCOLORPROC            glad_glClearColor;
 extern PFNGLVIEWPORTPROC              glad_glViewport;
+extern PFNGLSCISSORPROC               glad_glScissor;
 extern PFNGLENABLEPROC                glad_glEnable;
 extern PFNGLDISABLEPROC               glad_glDisable;
 extern PFNGLBLENDFUNCPROC             glad_glBlendFunc;
 extern PFNGLGETERRORPROC              glad_glGetError;
 extern PFNGLGETSTRINGPROC             glad_glGetString;
+extern PFNGLGETINTEGERVPROC           glad_glGetIntegerv;
+extern PFNGLGETSTRINGIPROC            glad_glGetStringi;
 
 /* Buffers/VAO */
 extern PFNGLGENBUFFERSPROC            glad_glGenBuffers;
 extern PFNGLBINDBUFFERPROC            glad_glBindBuffer;
 extern PFNGLBUFFERDATAPROC            glad_glBufferData;
+extern PFNGLBUFFERSUBDATAPROC         glad_glBufferSubData;
 extern PFNGLDELETEBUFFERSPROC         glad_glDeleteBuffers;
 
 extern PFNGLGENVERTEXARRAYSPROC       glad_glGenVertexArrays;
@@ -252,13 +537,20 @@ extern PFNGLGETUNIFORMLOCATIONPROC    glad_glGetUniformLocation;
 extern PFNGLUNIFORM1IPROC             glad_glUniform1i;
 extern PFNGLUNIFORMMATRIX4FVPROC      glad_glUniformMatrix4fv;
 extern PFNGLUNIFORM4FPROC             glad_glUniform4f;
+extern PFNGLUNIFORM1FPROC             glad_glUniform1f;
+extern PFNGLUNIFORM2FPROC             glad_glUniform2f;
+extern PFNGLGETACTIVEUNIFORMPROC      glad_glGetActiveUniform;
+extern PFNGLGETACTIVEATTRIBPROC       glad_glGetActiveAttrib;
 
 extern PFNGLGETATTRIBLOCATIONPROC     glad_glGetAttribLocation;
+extern PFNGLBINDATTRIBLOCATIONPROC    glad_glBindAttribLocation;
 
 /* Textures */
 extern PFNGLGENTEXTURESPROC           glad_glGenTextures;
 extern PFNGLBINDTEXTUREPROC           glad_glBindTexture;
 extern PFNGLTEXIMAGE2DPROC            glad_glTexImage2D;
+extern PFNGLTEXSUBIMAGE2DPROC         glad_glTexSubImage2D;
+extern PFNGLPIXELSTOREIPROC           glad_glPixelStorei;
 extern PFNGLTEXPARAMETERIPROC         glad_glTexParameteri;
 extern PFNGLDELETETEXTURESPROC        glad_glDeleteTextures;
 extern PFNGLACTIVETEXTUREPROC         glad_glActiveTexture;
@@ -267,19 +559,62 @@ extern PFNGLACTIVETEXTUREPROC         glad_glActiveTexture;
 extern PFNGLDRAWARRAYSPROC            glad_glDrawArrays;
 extern PFNGLDRAWELEMENTSPROC          glad_glDrawElements;
 
+/* Instancing (optional: may be NULL on GL 2.1 drivers without the extensions) */
+extern PFNGLDRAWARRAYSINSTANCEDPROC   glad_glDrawArraysInstanced;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced;
+extern PFNGLVERTEXATTRIBDIVISORPROC   glad_glVertexAttribDivisor;
+
+/* Queries (optional: glGetQueryObjectui64v needs GL 3.3 or ARB/EXT_timer_query) */
+extern PFNGLGENQUERIESPROC            glad_glGenQueries;
+extern PFNGLDELETEQUERIESPROC         glad_glDeleteQueries;
+extern PFNGLBEGINQUERYPROC            glad_glBeginQuery;
+extern PFNGLENDQUERYPROC              glad_glEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC      glad_glGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC   glad_glGetQueryObjectui64v;
+
+/* Read-back / sync */
+extern PFNGLREADPIXELSPROC            glad_glReadPixels;
+extern PFNGLFINISHPROC                glad_glFinish;
+
+/* Framebuffer objects (optional) */
+extern PFNGLGENFRAMEBUFFERSPROC         glad_glGenFramebuffers;
+extern PFNGLDELETEFRAMEBUFFERSPROC      glad_glDeleteFramebuffers;
+extern PFNGLBINDFRAMEBUFFERPROC         glad_glBindFramebuffer;
+extern PFNGLCHECKFRAMEBUFFERSTATUSPROC  glad_glCheckFramebufferStatus;
+extern PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer;
+extern PFNGLGENRENDERBUFFERSPROC        glad_glGenRenderbuffers;
+extern PFNGLDELETERENDERBUFFERSPROC     glad_glDeleteRenderbuffers;
+extern PFNGLBINDRENDERBUFFERPROC        glad_glBindRenderbuffer;
+extern PFNGLRENDERBUFFERSTORAGEPROC     glad_glRenderbufferStorage;
+
+/* Buffer mapping and fences (optional: GL 3.0 / 3.2 or ARB_map_buffer_range / ARB_sync) */
+extern PFNGLMAPBUFFERRANGEPROC          glad_glMapBufferRange;
+extern PFNGLUNMAPBUFFERPROC             glad_glUnmapBuffer;
+extern PFNGLFENCESYNCPROC               glad_glFenceSync;
+extern PFNGLCLIENTWAITSYNCPROC          glad_glClientWaitSync;
+extern PFNGLDELETESYNCPROC              glad_glDeleteSync;
+extern PFNGLGETPROGRAMBINARYPROC        glad_glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC           glad_glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC       glad_glProgramParameteri;
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR;
+
 /* Map to standard GL names for user code convenience */
 #define glClear                      glad_glClear
 #define glClearColor                 glad_glClearColor
 #define glViewport                   glad_glViewport
+#define glScissor                    glad_glScissor
 #define glEnable                     glad_glEnable
 #define glDisable                    glad_glDisable
 #define glBlendFunc                  glad_glBlendFunc
 #define glGetError                   glad_glGetError
 #define glGetString                  glad_glGetString
+#define glGetIntegerv                glad_glGetIntegerv
+#define glGetStringi                 glad_glGetStringi
 
 #define glGenBuffers                 glad_glGenBuffers
 #define glBindBuffer                 glad_glBindBuffer
 #define glBufferData                 glad_glBufferData
+#define glBufferSubData              glad_glBufferSubData
 #define glDeleteBuffers              glad_glDeleteBuffers
 
 #define glGenVertexArrays            glad_glGenVertexArrays
@@ -309,12 +644,19 @@ extern PFNGLDRAWELEMENTSPROC          glad_glDrawElements;
 #define glUniform1i                  glad_glUniform1i
 #define glUniformMatrix4fv           glad_glUniformMatrix4fv
 #define glUniform4f                  glad_glUniform4f
+#define glUniform1f                  glad_glUniform1f
+#define glUniform2f                  glad_glUniform2f
+#define glGetActiveUniform           glad_glGetActiveUniform
+#define glGetActiveAttrib            glad_glGetActiveAttrib
 
 #define glGetAttribLocation          glad_glGetAttribLocation
+#define glBindAttribLocation         glad_glBindAttribLocation
 
 #define glGenTextures                glad_glGenTextures
 #define glBindTexture                glad_glBindTexture
 #define glTexImage2D                 glad_glTexImage2D
+#define glTexSubImage2D              glad_glTexSubImage2D
+#define glPixelStorei                glad_glPixelStorei
 #define glTexParameteri              glad_glTexParameteri
 #define glDeleteTextures             glad_glDeleteTextures
 #define glActiveTexture              glad_glActiveTexture
@@ -322,6 +664,39 @@ extern PFNGLDRAWELEMENTSPROC          glad_glDrawElements;
 #define glDrawArrays                 glad_glDrawArrays
 #define glDrawElements               glad_glDrawElements
 
+#define glDrawArraysInstanced        glad_glDrawArraysInstanced
+#define glDrawElementsInstanced      glad_glDrawElementsInstanced
+#define glVertexAttribDivisor        glad_glVertexAttribDivisor
+
+#define glGenQueries                 glad_glGenQueries
+#define glDeleteQueries              glad_glDeleteQueries
+#define glBeginQuery                 glad_glBeginQuery
+#define glEndQuery                   glad_glEndQuery
+#define glGetQueryObjectiv           glad_glGetQueryObjectiv
+#define glGetQueryObjectui64v        glad_glGetQueryObjectui64v
+
+#define glReadPixels                 glad_glReadPixels
+#define glFinish                     glad_glFinish
+
+#define glGenFramebuffers            glad_glGenFramebuffers
+#define glDeleteFramebuffers         glad_glDeleteFramebuffers
+#define glBindFramebuffer            glad_glBindFramebuffer
+#define glCheckFramebufferStatus     glad_glCheckFramebufferStatus
+#define glFramebufferRenderbuffer    glad_glFramebufferRenderbuffer
+#define glGenRenderbuffers           glad_glGenRenderbuffers
+#define glDeleteRenderbuffers        glad_glDeleteRenderbuffers
+#define glBindRenderbuffer           glad_glBindRenderbuffer
+#define glRenderbufferStorage        glad_glRenderbufferStorage
+#define glMapBufferRange             glad_glMapBufferRange
+#define glUnmapBuffer                glad_glUnmapBuffer
+#define glFenceSync                  glad_glFenceSync
+#define glClientWaitSync             glad_glClientWaitSync
+#define glDeleteSync                 glad_glDeleteSync
+#define glGetProgramBinary           glad_glGetProgramBinary
+#define glProgramBinary              glad_glProgramBinary
+#define glProgramParameteri          glad_glProgramParameteri
+#define glMaxShaderCompilerThreadsKHR glad_glMaxShaderCompilerThreadsKHR
+
 /* ---- Loader entry point ---- */
 /* Returns non-zero on success. Must be called with a current GL context. */
 int gladLoadGL(void);
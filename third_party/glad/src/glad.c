@@ -24,16 +24,20 @@
 PFNGLCLEARPROC                 glad_glClear = 0;
 PFNGLCLEARCOLORPROC            glad_glClearColor = 0;
 PFNGLVIEWPORTPROC              glad_glViewport = 0;
+PFNGLSCISSORPROC               glad_glScissor = 0;
 PFNGLENABLEPROC                glad_glEnable = 0;
 PFNGLDISABLEPROC               glad_glDisable = 0;
 PFNGLBLENDFUNCPROC             glad_glBlendFunc = 0;
 PFNGLGETERRORPROC              glad_glGetError = 0;
 PFNGLGETSTRINGPROC             glad_glGetString = 0;
+PFNGLGETINTEGERVPROC           glad_glGetIntegerv = 0;
+PFNGLGETSTRINGIPROC            glad_glGetStringi = 0;
 
 /* Buffers/VAO */
 PFNGLGENBUFFERSPROC            glad_glGenBuffers = 0;
 PFNGLBINDBUFFERPROC            glad_glBindBuffer = 0;
 PFNGLBUFFERDATAPROC            glad_glBufferData = 0;
+PFNGLBUFFERSUBDATAPROC         glad_glBufferSubData = 0;
 PFNGLDELETEBUFFERSPROC         glad_glDeleteBuffers = 0;
 
 PFNGLGENVERTEXARRAYSPROC       glad_glGenVertexArrays = 0;
@@ -64,13 +68,20 @@ PFNGLGETUNIFORMLOCATIONPROC    glad_glGetUniformLocation = 0;
 PFNGLUNIFORM1IPROC             glad_glUniform1i = 0;
 PFNGLUNIFORMMATRIX4FVPROC      glad_glUniformMatrix4fv = 0;
 PFNGLUNIFORM4FPROC             glad_glUniform4f = 0;
+PFNGLUNIFORM1FPROC             glad_glUniform1f = 0;
+PFNGLUNIFORM2FPROC             glad_glUniform2f = 0;
+PFNGLGETACTIVEUNIFORMPROC      glad_glGetActiveUniform = 0;
+PFNGLGETACTIVEATTRIBPROC       glad_glGetActiveAttrib = 0;
 
 PFNGLGETATTRIBLOCATIONPROC     glad_glGetAttribLocation = 0;
+PFNGLBINDATTRIBLOCATIONPROC    glad_glBindAttribLocation = 0;
 
 /* Textures */
 PFNGLGENTEXTURESPROC           glad_glGenTextures = 0;
 PFNGLBINDTEXTUREPROC           glad_glBindTexture = 0;
 PFNGLTEXIMAGE2DPROC            glad_glTexImage2D = 0;
+PFNGLTEXSUBIMAGE2DPROC         glad_glTexSubImage2D = 0;
+PFNGLPIXELSTOREIPROC           glad_glPixelStorei = 0;
 PFNGLTEXPARAMETERIPROC         glad_glTexParameteri = 0;
 PFNGLDELETETEXTURESPROC        glad_glDeleteTextures = 0;
 PFNGLACTIVETEXTUREPROC         glad_glActiveTexture = 0;
@@ -79,6 +90,49 @@ PFNGLACTIVETEXTUREPROC         glad_glActiveTexture = 0;
 PFNGLDRAWARRAYSPROC            glad_glDrawArrays = 0;
 PFNGLDRAWELEMENTSPROC          glad_glDrawElements = 0;
 
+/* Instancing (optional) */
+PFNGLDRAWARRAYSINSTANCEDPROC   glad_glDrawArraysInstanced = 0;
+PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced = 0;
+PFNGLVERTEXATTRIBDIVISORPROC   glad_glVertexAttribDivisor = 0;
+
+/* Queries (optional) */
+PFNGLGENQUERIESPROC            glad_glGenQueries = 0;
+PFNGLDELETEQUERIESPROC         glad_glDeleteQueries = 0;
+PFNGLBEGINQUERYPROC            glad_glBeginQuery = 0;
+PFNGLENDQUERYPROC              glad_glEndQuery = 0;
+PFNGLGETQUERYOBJECTIVPROC      glad_glGetQueryObjectiv = 0;
+PFNGLGETQUERYOBJECTUI64VPROC   glad_glGetQueryObjectui64v = 0;
+
+/* Read-back / sync */
+PFNGLREADPIXELSPROC            glad_glReadPixels = 0;
+PFNGLFINISHPROC                glad_glFinish = 0;
+
+/* Framebuffer objects (optional) */
+PFNGLGENFRAMEBUFFERSPROC         glad_glGenFramebuffers = 0;
+PFNGLDELETEFRAMEBUFFERSPROC      glad_glDeleteFramebuffers = 0;
+PFNGLBINDFRAMEBUFFERPROC         glad_glBindFramebuffer = 0;
+PFNGLCHECKFRAMEBUFFERSTATUSPROC  glad_glCheckFramebufferStatus = 0;
+PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer = 0;
+PFNGLGENRENDERBUFFERSPROC        glad_glGenRenderbuffers = 0;
+PFNGLDELETERENDERBUFFERSPROC     glad_glDeleteRenderbuffers = 0;
+PFNGLBINDRENDERBUFFERPROC        glad_glBindRenderbuffer = 0;
+PFNGLRENDERBUFFERSTORAGEPROC     glad_glRenderbufferStorage = 0;
+
+/* Buffer mapping and fences (optional) */
+PFNGLMAPBUFFERRANGEPROC          glad_glMapBufferRange = 0;
+PFNGLUNMAPBUFFERPROC             glad_glUnmapBuffer = 0;
+PFNGLFENCESYNCPROC               glad_glFenceSync = 0;
+PFNGLCLIENTWAITSYNCPROC          glad_glClientWaitSync = 0;
+PFNGLDELETESYNCPROC              glad_glDeleteSync = 0;
+
+/* Program binaries (optional) */
+PFNGLGETPROGRAMBINARYPROC        glad_glGetProgramBinary = 0;
+PFNGLPROGRAMBINARYPROC           glad_glProgramBinary = 0;
+PFNGLPROGRAMPARAMETERIPROC       glad_glProgramParameteri = 0;
+
+/* Parallel shader compilation (optional) */
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR = 0;
+
 /* ---- Platform loader helpers ---- */
 
 #if defined(_WIN32)
@@ -189,20 +243,31 @@ int gladLoadGL(void) {
         if (!(var)) { missing++; } \
     } while (0)
 
+    /* Optional entry points: a NULL pointer is allowed, callers must check. */
+#define WXGL_LOAD_OPTIONAL(required_type, var, sym, alt) \
+    do { \
+        var = (required_type)wxgl_get_proc(sym); \
+        if (!(var)) { var = (required_type)wxgl_get_proc(alt); } \
+    } while (0)
+
     /* Base */
     WXGL_LOAD(PFNGLCLEARPROC,               glad_glClear,               "glClear");
     WXGL_LOAD(PFNGLCLEARCOLORPROC,          glad_glClearColor,          "glClearColor");
     WXGL_LOAD(PFNGLVIEWPORTPROC,            glad_glViewport,            "glViewport");
+    WXGL_LOAD(PFNGLSCISSORPROC,             glad_glScissor,             "glScissor");
     WXGL_LOAD(PFNGLENABLEPROC,              glad_glEnable,              "glEnable");
     WXGL_LOAD(PFNGLDISABLEPROC,             glad_glDisable,             "glDisable");
     WXGL_LOAD(PFNGLBLENDFUNCPROC,           glad_glBlendFunc,           "glBlendFunc");
     WXGL_LOAD(PFNGLGETERRORPROC,            glad_glGetError,            "glGetError");
     WXGL_LOAD(PFNGLGETSTRINGPROC,           glad_glGetString,           "glGetString");
+    WXGL_LOAD(PFNGLGETINTEGERVPROC,         glad_glGetIntegerv,         "glGetIntegerv");
+    WXGL_LOAD_OPTIONAL(PFNGLGETSTRINGIPROC, glad_glGetStringi,          "glGetStringi",          "glGetStringi");
 
     /* Buffers/VAO */
     WXGL_LOAD(PFNGLGENBUFFERSPROC,          glad_glGenBuffers,          "glGenBuffers");
     WXGL_LOAD(PFNGLBINDBUFFERPROC,          glad_glBindBuffer,          "glBindBuffer");
     WXGL_LOAD(PFNGLBUFFERDATAPROC,          glad_glBufferData,          "glBufferData");
+    WXGL_LOAD(PFNGLBUFFERSUBDATAPROC,       glad_glBufferSubData,       "glBufferSubData");
     WXGL_LOAD(PFNGLDELETEBUFFERSPROC,       glad_glDeleteBuffers,       "glDeleteBuffers");
 
     WXGL_LOAD(PFNGLGENVERTEXARRAYSPROC,     glad_glGenVertexArrays,     "glGenVertexArrays");
@@ -233,8 +298,13 @@ int gladLoadGL(void) {
     WXGL_LOAD(PFNGLUNIFORM1IPROC,           glad_glUniform1i,           "glUniform1i");
     WXGL_LOAD(PFNGLUNIFORMMATRIX4FVPROC,    glad_glUniformMatrix4fv,    "glUniformMatrix4fv");
     WXGL_LOAD(PFNGLUNIFORM4FPROC,           glad_glUniform4f,           "glUniform4f");
+    WXGL_LOAD(PFNGLUNIFORM1FPROC,           glad_glUniform1f,           "glUniform1f");
+    WXGL_LOAD(PFNGLUNIFORM2FPROC,           glad_glUniform2f,           "glUniform2f");
+    WXGL_LOAD(PFNGLGETACTIVEUNIFORMPROC,    glad_glGetActiveUniform,    "glGetActiveUniform");
+    WXGL_LOAD(PFNGLGETACTIVEATTRIBPROC,     glad_glGetActiveAttrib,     "glGetActiveAttrib");
 
     WXGL_LOAD(PFNGLGETATTRIBLOCATIONPROC,   glad_glGetAttribLocation,   "glGetAttribLocation");
+    WXGL_LOAD(PFNGLBINDATTRIBLOCATIONPROC,  glad_glBindAttribLocation,  "glBindAttribLocation");
 
 /* Textures */
 // WXGL_LOAD(PFNGLGENTEXTURESPROC,         glad_glGenTextures,         "glGenTextures");
@@ -247,6 +317,8 @@ int gladLoadGL(void) {
     glad_glGenTextures   = (PFNGLGENTEXTURESPROC)  wxgl_get_proc("glGenTextures");   if (!glad_glGenTextures)   ++missing;
     glad_glBindTexture   = (PFNGLBINDTEXTUREPROC)  wxgl_get_proc("glBindTexture");   if (!glad_glBindTexture)   ++missing;
     glad_glTexImage2D    = (PFNGLTEXIMAGE2DPROC)   wxgl_get_proc("glTexImage2D");    if (!glad_glTexImage2D)    ++missing;
+    glad_glTexSubImage2D = (PFNGLTEXSUBIMAGE2DPROC)wxgl_get_proc("glTexSubImage2D"); if (!glad_glTexSubImage2D) ++missing;
+    glad_glPixelStorei   = (PFNGLPIXELSTOREIPROC)  wxgl_get_proc("glPixelStorei");   if (!glad_glPixelStorei)   ++missing;
     glad_glTexParameteri = (PFNGLTEXPARAMETERIPROC)wxgl_get_proc("glTexParameteri"); if (!glad_glTexParameteri) ++missing;
     glad_glDeleteTextures= (PFNGLDELETETEXTURESPROC)wxgl_get_proc("glDeleteTextures");if (!glad_glDeleteTextures)++missing;
     glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC)wxgl_get_proc("glActiveTexture"); if (!glad_glActiveTexture) ++missing;
@@ -255,6 +327,51 @@ int gladLoadGL(void) {
     WXGL_LOAD(PFNGLDRAWARRAYSPROC,          glad_glDrawArrays,          "glDrawArrays");
     WXGL_LOAD(PFNGLDRAWELEMENTSPROC,        glad_glDrawElements,        "glDrawElements");
 
+    /* Instancing (optional) */
+    WXGL_LOAD_OPTIONAL(PFNGLDRAWARRAYSINSTANCEDPROC, glad_glDrawArraysInstanced, "glDrawArraysInstanced", "glDrawArraysInstancedARB");
+    WXGL_LOAD_OPTIONAL(PFNGLVERTEXATTRIBDIVISORPROC, glad_glVertexAttribDivisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB");
+    WXGL_LOAD_OPTIONAL(PFNGLDRAWELEMENTSINSTANCEDPROC, glad_glDrawElementsInstanced, "glDrawElementsInstanced", "glDrawElementsInstancedARB");
+
+    /* Queries (optional) */
+    WXGL_LOAD_OPTIONAL(PFNGLGENQUERIESPROC,          glad_glGenQueries,          "glGenQueries",          "glGenQueriesARB");
+    WXGL_LOAD_OPTIONAL(PFNGLDELETEQUERIESPROC,       glad_glDeleteQueries,       "glDeleteQueries",       "glDeleteQueriesARB");
+    WXGL_LOAD_OPTIONAL(PFNGLBEGINQUERYPROC,          glad_glBeginQuery,          "glBeginQuery",          "glBeginQueryARB");
+    WXGL_LOAD_OPTIONAL(PFNGLENDQUERYPROC,            glad_glEndQuery,            "glEndQuery",            "glEndQueryARB");
+    WXGL_LOAD_OPTIONAL(PFNGLGETQUERYOBJECTIVPROC,    glad_glGetQueryObjectiv,    "glGetQueryObjectiv",    "glGetQueryObjectivARB");
+    WXGL_LOAD_OPTIONAL(PFNGLGETQUERYOBJECTUI64VPROC, glad_glGetQueryObjectui64v, "glGetQueryObjectui64v", "glGetQueryObjectui64vEXT");
+
+    /* Read-back / sync */
+    WXGL_LOAD(PFNGLREADPIXELSPROC,          glad_glReadPixels,          "glReadPixels");
+    WXGL_LOAD(PFNGLFINISHPROC,              glad_glFinish,              "glFinish");
+
+    /* Framebuffer objects (optional) */
+    WXGL_LOAD_OPTIONAL(PFNGLGENFRAMEBUFFERSPROC,         glad_glGenFramebuffers,         "glGenFramebuffers",         "glGenFramebuffersEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLDELETEFRAMEBUFFERSPROC,      glad_glDeleteFramebuffers,      "glDeleteFramebuffers",      "glDeleteFramebuffersEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLBINDFRAMEBUFFERPROC,         glad_glBindFramebuffer,         "glBindFramebuffer",         "glBindFramebufferEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLCHECKFRAMEBUFFERSTATUSPROC,  glad_glCheckFramebufferStatus,  "glCheckFramebufferStatus",  "glCheckFramebufferStatusEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glad_glFramebufferRenderbuffer, "glFramebufferRenderbuffer", "glFramebufferRenderbufferEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLGENRENDERBUFFERSPROC,        glad_glGenRenderbuffers,        "glGenRenderbuffers",        "glGenRenderbuffersEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLDELETERENDERBUFFERSPROC,     glad_glDeleteRenderbuffers,     "glDeleteRenderbuffers",     "glDeleteRenderbuffersEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLBINDRENDERBUFFERPROC,        glad_glBindRenderbuffer,        "glBindRenderbuffer",        "glBindRenderbufferEXT");
+    WXGL_LOAD_OPTIONAL(PFNGLRENDERBUFFERSTORAGEPROC,     glad_glRenderbufferStorage,     "glRenderbufferStorage",     "glRenderbufferStorageEXT");
+
+    /* Buffer mapping and fences (optional; same names in the ARB extensions) */
+    WXGL_LOAD_OPTIONAL(PFNGLMAPBUFFERRANGEPROC,  glad_glMapBufferRange,  "glMapBufferRange",  "glMapBufferRange");
+    WXGL_LOAD_OPTIONAL(PFNGLUNMAPBUFFERPROC,     glad_glUnmapBuffer,     "glUnmapBuffer",     "glUnmapBufferARB");
+    WXGL_LOAD_OPTIONAL(PFNGLFENCESYNCPROC,       glad_glFenceSync,       "glFenceSync",       "glFenceSync");
+    WXGL_LOAD_OPTIONAL(PFNGLCLIENTWAITSYNCPROC,  glad_glClientWaitSync,  "glClientWaitSync",  "glClientWaitSync");
+    WXGL_LOAD_OPTIONAL(PFNGLDELETESYNCPROC,      glad_glDeleteSync,      "glDeleteSync",      "glDeleteSync");
+
+    /* Program binaries (optional; same names in ARB_get_program_binary) */
+    WXGL_LOAD_OPTIONAL(PFNGLGETPROGRAMBINARYPROC,  glad_glGetProgramBinary,  "glGetProgramBinary",  "glGetProgramBinary");
+    WXGL_LOAD_OPTIONAL(PFNGLPROGRAMBINARYPROC,     glad_glProgramBinary,     "glProgramBinary",     "glProgramBinary");
+    WXGL_LOAD_OPTIONAL(PFNGLPROGRAMPARAMETERIPROC, glad_glProgramParameteri, "glProgramParameteri", "glProgramParameteri");
+
+    /* Parallel shader compilation (optional; KHR and ARB variants) */
+    WXGL_LOAD_OPTIONAL(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, glad_glMaxShaderCompilerThreadsKHR,
+                       "glMaxShaderCompilerThreadsKHR", "glMaxShaderCompilerThreadsARB");
+
+#undef WXGL_LOAD_OPTIONAL
 #undef WXGL_LOAD
 
     return missing == 0 ? 1 : 0;